@@ -6,4 +6,11 @@
 // =============================================================================
 #define M_UNUSED_PARAMETER(x) ((void)x)
 
+/**
+ * @brief This macro fails the compilation if the given condition is false.
+ *        The name must be unique in the file.
+ */
+#define M_STATIC_ASSERT(name, condition) \
+    typedef char ta_staticAssert_##name[(condition) ? 1 : -1]
+
 #endif // __INC_COMMON_H__
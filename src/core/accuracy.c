@@ -0,0 +1,216 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "core/accuracy.h"
+#include "core/aot.h"
+#include "core/bus.h"
+#include "core/cpu.h"
+#include "core/hle.h"
+#include "core/instance.h"
+#include "core/metrics.h"
+#include "core/rom.h"
+#include "core/scheduler.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This constant contains the opcode of BRA with a displacement of -2,
+ *        which branches to itself.
+ */
+#define C_ACCURACY_OPCODE_BRA_SELF 0x40feU
+
+/**
+ * @brief This constant contains the opcode of BRA with a displacement of -4,
+ *        which branches to the previous instruction.
+ */
+#define C_ACCURACY_OPCODE_BRA_PREVIOUS 0x40fcU
+
+/**
+ * @brief This constant contains the opcode of SLEEP.
+ */
+#define C_ACCURACY_OPCODE_SLEEP 0x0180U
+
+/**
+ * @brief This macro gives access to the accuracy settings of the current
+ *        instance.
+ */
+#define M_ACCURACY_INSTANCE (g_coreInstance->accuracy)
+
+/**
+ * @brief This macro gives access to the CPU state of the current instance.
+ */
+#define M_CPU (g_coreInstance->state.cpu)
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Runs nothing natively: every instruction is interpreted.
+ *
+ * @returns false.
+ */
+static bool accuracyStepNone(void);
+
+/**
+ * @brief Does nothing at the end of a step.
+ */
+static void accuracyEndStepNone(void);
+
+/**
+ * @brief Runs the next step natively if possible, with the recognized firmware
+ *        routines, the recompiled code or by skipping an idle loop.
+ *
+ * @returns A boolean value that indicates whether a step was run.
+ */
+static bool accuracyStepNative(void);
+
+/**
+ * @brief Applies the deferred cycles once there are enough of them.
+ */
+static void accuracyEndStepFast(void);
+
+/**
+ * @brief Skips the idle loop at PC, if there is one. Without interrupts, an
+ *        idle loop never exits on its own, so it is run once to measure its
+ *        length, then the cycles of as many iterations as possible before the
+ *        next event are added at once.
+ *
+ * @returns A boolean value that indicates whether an idle loop was run.
+ */
+static bool accuracySkipIdleLoop(void);
+
+/**
+ * @brief Reads a word from the bus without performing a bus cycle.
+ *
+ * @param[in] p_address The address of the word.
+ *
+ * @returns The word read.
+ */
+static uint16_t accuracyPeek16(uint16_t p_address);
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This table contains the accuracy profiles.
+ */
+static const struct ts_accuracyProfile
+    s_accuracyProfiles[E_CORE_ACCURACY_COUNT] = {
+    [E_CORE_ACCURACY_CYCLE_EXACT] = {
+        .accuracy = E_CORE_ACCURACY_CYCLE_EXACT,
+        .deferCycles = false,
+        .stepNative = accuracyStepNone,
+        .endStep = accuracyEndStepNone
+    },
+    [E_CORE_ACCURACY_INSTRUCTION] = {
+        .accuracy = E_CORE_ACCURACY_INSTRUCTION,
+        .deferCycles = true,
+        .stepNative = accuracyStepNone,
+        .endStep = busSync
+    },
+    [E_CORE_ACCURACY_FAST] = {
+        .accuracy = E_CORE_ACCURACY_FAST,
+        .deferCycles = true,
+        .stepNative = accuracyStepNative,
+        .endStep = accuracyEndStepFast
+    }
+};
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+void accuracyInitInstance(enum te_coreAccuracy p_accuracy) {
+    M_ACCURACY_INSTANCE.profile = &s_accuracyProfiles[p_accuracy];
+    M_ACCURACY_INSTANCE.deferCycles = M_ACCURACY_INSTANCE.profile->deferCycles;
+}
+
+int accuracySet(enum te_coreAccuracy p_accuracy) {
+    if((unsigned int)p_accuracy >= E_CORE_ACCURACY_COUNT) {
+        return 1;
+    }
+
+    busSync();
+    M_ACCURACY_INSTANCE.profile = &s_accuracyProfiles[p_accuracy];
+    M_ACCURACY_INSTANCE.deferCycles = M_ACCURACY_INSTANCE.profile->deferCycles;
+
+    return 0;
+}
+
+enum te_coreAccuracy accuracyGet(void) {
+    return M_ACCURACY_INSTANCE.profile->accuracy;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static bool accuracyStepNone(void) {
+    return false;
+}
+
+static void accuracyEndStepNone(void) {
+    // Nothing to do: the cycle-exact profile never defers cycles.
+}
+
+static bool accuracyStepNative(void) {
+    return hleStep() || aotStep() || accuracySkipIdleLoop();
+}
+
+static void accuracyEndStepFast(void) {
+    if(schedulerGetDeferredCycles() >= C_ACCURACY_FAST_SYNC_CYCLES) {
+        busSync();
+    }
+}
+
+static bool accuracySkipIdleLoop(void) {
+    uint16_t l_pc = M_CPU.registerPC;
+    int l_instructionCount;
+
+    if(l_pc >= C_ROM_SIZE_BYTES) {
+        return false;
+    } else if(accuracyPeek16(l_pc) == C_ACCURACY_OPCODE_BRA_SELF) {
+        l_instructionCount = 1;
+    } else if(
+        (accuracyPeek16(l_pc) == C_ACCURACY_OPCODE_SLEEP)
+        && (accuracyPeek16(l_pc + 2U) == C_ACCURACY_OPCODE_BRA_PREVIOUS)
+    ) {
+        l_instructionCount = 2;
+    } else {
+        return false;
+    }
+
+    busSync();
+
+    uint64_t l_startCycles = schedulerGetCycles();
+
+    for(int l_index = 0; l_index < l_instructionCount; l_index++) {
+        cpuInterpret();
+    }
+
+    busSync();
+
+    uint64_t l_loopCycles = schedulerGetCycles() - l_startCycles;
+    uint64_t l_skippedCycles = schedulerGetCyclesToNextEvent();
+
+    if(l_skippedCycles > C_ACCURACY_IDLE_SKIP_MAX_CYCLES) {
+        l_skippedCycles = C_ACCURACY_IDLE_SKIP_MAX_CYCLES;
+    }
+
+    // The loop only fetches its own instructions, so running it for a whole
+    // number of iterations only advances the peripherals.
+    if((M_CPU.registerPC == l_pc) && (l_loopCycles != 0U)) {
+        l_skippedCycles -= l_skippedCycles % l_loopCycles;
+        M_METRICS_ADD(idleCycles, l_skippedCycles);
+        busAdvance(l_skippedCycles);
+    }
+
+    return true;
+}
+
+static uint16_t accuracyPeek16(uint16_t p_address) {
+    return (busPeek8(p_address) << 8) | busPeek8(p_address + 1U);
+}
@@ -0,0 +1,103 @@
+#ifndef __INC_CORE_ACCURACY_H__
+#define __INC_CORE_ACCURACY_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+
+#include "core/core.h"
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the number of deferred cycles after which the
+ *        fast profile advances the peripherals, which is about the length of
+ *        a basic block.
+ */
+#define C_ACCURACY_FAST_SYNC_CYCLES 64U
+
+/**
+ * @brief This constant defines the maximum number of cycles skipped at once in
+ *        an idle loop (1 ms), so that the callers of coreStep() still get
+ *        control regularly.
+ */
+#define C_ACCURACY_IDLE_SKIP_MAX_CYCLES (C_CORE_CLOCK_RATE_HZ / 1000U)
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure describes an accuracy profile. Selecting a profile
+ *        swaps the whole table, so the steps call the functions of the profile
+ *        without checking which profile is selected.
+ */
+struct ts_accuracyProfile {
+    enum te_coreAccuracy accuracy;
+
+    /**
+     * @brief This member indicates whether the bus cycles are deferred until
+     *        the end of the step instead of advancing the peripherals at once.
+     */
+    bool deferCycles;
+
+    /**
+     * @brief This member contains the function that tries to run the next step
+     *        without the interpreter. It returns false if the instruction at
+     *        PC must be interpreted.
+     */
+    bool (*stepNative)(void);
+
+    /**
+     * @brief This member contains the function called at the end of every
+     *        step, which decides when the deferred cycles are applied.
+     */
+    void (*endStep)(void);
+};
+
+/**
+ * @brief This structure contains the accuracy settings of a core instance.
+ *        They are not part of the emulated state.
+ */
+struct ts_accuracyInstance {
+    const struct ts_accuracyProfile *profile;
+
+    /**
+     * @brief This member contains the deferCycles member of the profile. It is
+     *        tested on every bus cycle, so it is copied next to the profile
+     *        pointer instead of being read through it.
+     */
+    bool deferCycles;
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Initializes the accuracy settings of the current instance.
+ *
+ * @param[in] p_accuracy The accuracy profile to use.
+ */
+void accuracyInitInstance(enum te_coreAccuracy p_accuracy);
+
+/**
+ * @brief Selects the accuracy profile of the current instance. The cycles
+ *        deferred by the previous profile are applied first.
+ *
+ * @param[in] p_accuracy The accuracy profile to use.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval 1 if the profile does not exist.
+ */
+int accuracySet(enum te_coreAccuracy p_accuracy);
+
+/**
+ * @brief Returns the accuracy profile of the current instance.
+ *
+ * @returns The accuracy profile of the current instance.
+ */
+enum te_coreAccuracy accuracyGet(void);
+
+#endif // __INC_CORE_ACCURACY_H__
@@ -0,0 +1,226 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "core/aot.h"
+#include "core/cpu.h"
+#include "core/instance.h"
+#include "core/rom.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This macro gives access to the CPU state of the current instance.
+ */
+#define M_CPU (g_coreInstance->state.cpu)
+
+/**
+ * @brief This macro gives access to the recompiled code settings of the
+ *        current instance.
+ */
+#define M_AOT_INSTANCE (g_coreInstance->aot)
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Executes one instruction for recompiled code.
+ *
+ * @param[in] p_opcode0 The first word of the opcode buffer.
+ * @param[in] p_opcode1 The second word of the opcode buffer.
+ * @param[in] p_decodeWordCount The number of words read by the decoder.
+ * @param[in] p_handlerIndex The index of the opcode handler.
+ *
+ * @returns A boolean value that indicates whether the FLASH ROM area of the
+ *          running block is still the one that was recompiled.
+ */
+static bool aotExecute(
+    uint16_t p_opcode0,
+    uint16_t p_opcode1,
+    uint8_t p_decodeWordCount,
+    uint8_t p_handlerIndex
+);
+
+/**
+ * @brief Drops the blocks of the current instance that overlap a modified
+ *        area of its FLASH ROM, or restores all of them when the instance
+ *        reads the shared FLASH ROM buffer again.
+ *
+ * @param[in] p_address The address of the first modified byte.
+ * @param[in] p_size The number of modified bytes.
+ * @param[in] p_context Unused.
+ */
+static void aotOnRomInvalidated(
+    uint16_t p_address,
+    uint16_t p_size,
+    void *p_context
+);
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This table contains, for each word of the FLASH ROM, the recompiled
+ *        block that starts there, or NULL if there is none. It is NULL when no
+ *        recompiled code is installed.
+ */
+static tf_aotBlock *s_aotBlockAtAddress;
+
+/**
+ * @brief This table contains, for each word of the FLASH ROM, the size of the
+ *        recompiled block that starts there.
+ */
+static uint16_t *s_aotBlockSizeAtAddress;
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int aotInstall(tf_aotGetImage p_getImage) {
+    const struct ts_aotImage *l_image = p_getImage(aotExecute);
+
+    if(l_image->interfaceVersion != C_AOT_INTERFACE_VERSION) {
+        fprintf(stderr, "Error: unsupported recompiled code version.\n");
+        return 1;
+    } else if(l_image->opcodeTableHash != cpuGetOpcodeTableHash()) {
+        fprintf(
+            stderr,
+            "Error: the recompiled code was made for another version of the "
+            "emulator.\n"
+        );
+        return 1;
+    } else if(l_image->flashRomHash != romGetHash()) {
+        fprintf(
+            stderr,
+            "Error: the recompiled code was made for another FLASH ROM.\n"
+        );
+        return 1;
+    }
+
+    tf_aotBlock *l_table = calloc(C_ROM_SIZE_BYTES / 2U, sizeof(tf_aotBlock));
+    uint16_t *l_sizeTable = calloc(C_ROM_SIZE_BYTES / 2U, sizeof(uint16_t));
+
+    if((l_table == NULL) || (l_sizeTable == NULL)) {
+        fprintf(stderr, "Error: failed to allocate the block table.\n");
+        free(l_table);
+        free(l_sizeTable);
+        return 2;
+    }
+
+    for(uint32_t l_index = 0U; l_index < l_image->blockCount; l_index++) {
+        const struct ts_aotBlock *l_block = &l_image->blocks[l_index];
+
+        if(
+            (l_block->address < C_ROM_SIZE_BYTES)
+            && (l_block->size <= C_AOT_MAX_BLOCK_SIZE_BYTES)
+        ) {
+            l_table[l_block->address >> 1] = l_block->function;
+            l_sizeTable[l_block->address >> 1] = l_block->size;
+        }
+    }
+
+    aotUninstall();
+    s_aotBlockAtAddress = l_table;
+    s_aotBlockSizeAtAddress = l_sizeTable;
+
+    return 0;
+}
+
+void aotUninstall(void) {
+    free(s_aotBlockAtAddress);
+    free(s_aotBlockSizeAtAddress);
+    s_aotBlockAtAddress = NULL;
+    s_aotBlockSizeAtAddress = NULL;
+}
+
+void aotInitInstance(void) {
+    romAddInvalidationListener(aotOnRomInvalidated, NULL);
+}
+
+bool aotStep(void) {
+    uint32_t l_pc = M_CPU.registerPC;
+
+    if((s_aotBlockAtAddress == NULL) || (l_pc >= C_ROM_SIZE_BYTES)) {
+        return false;
+    }
+
+    tf_aotBlock l_block = s_aotBlockAtAddress[l_pc >> 1];
+
+    if(
+        (l_block == NULL)
+        || romIsUnitMarked(M_AOT_INSTANCE.droppedUnits, l_pc)
+    ) {
+        return false;
+    }
+
+    M_AOT_INSTANCE.blockAddress = l_pc;
+    l_block();
+
+    return true;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static bool aotExecute(
+    uint16_t p_opcode0,
+    uint16_t p_opcode1,
+    uint8_t p_decodeWordCount,
+    uint8_t p_handlerIndex
+) {
+    cpuExecuteInstruction(
+        p_opcode0,
+        p_opcode1,
+        p_decodeWordCount,
+        p_handlerIndex
+    );
+
+    return !romIsUnitMarked(
+        M_AOT_INSTANCE.droppedUnits,
+        M_AOT_INSTANCE.blockAddress
+    );
+}
+
+static void aotOnRomInvalidated(
+    uint16_t p_address,
+    uint16_t p_size,
+    void *p_context
+) {
+    M_UNUSED_PARAMETER(p_context);
+
+    if(romGetModifiedData() == NULL) {
+        memset(
+            M_AOT_INSTANCE.droppedUnits,
+            0,
+            sizeof(M_AOT_INSTANCE.droppedUnits)
+        );
+        return;
+    }
+
+    // A block that starts before the area can still overlap it. Without
+    // recompiled code, every block that could overlap it is dropped, in case
+    // some code is installed later.
+    uint32_t l_address = 0U;
+    uint32_t l_endAddress = (uint32_t)p_address + p_size;
+
+    if(p_address >= C_AOT_MAX_BLOCK_SIZE_BYTES) {
+        l_address = p_address - C_AOT_MAX_BLOCK_SIZE_BYTES + 2U;
+    }
+
+    for(; l_address < l_endAddress; l_address += 2U) {
+        if(
+            (s_aotBlockSizeAtAddress == NULL)
+            || ((l_address + s_aotBlockSizeAtAddress[l_address >> 1])
+                > p_address)
+        ) {
+            romMarkUnit(M_AOT_INSTANCE.droppedUnits, l_address);
+        }
+    }
+}
@@ -0,0 +1,165 @@
+#ifndef __INC_CORE_AOT_H__
+#define __INC_CORE_AOT_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "core/rom.h"
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the version of the interface between the core
+ *        and the recompiled code. It must be incremented everytime one of the
+ *        types below changes.
+ */
+#define C_AOT_INTERFACE_VERSION 2U
+
+/**
+ * @brief This constant defines the name of the function exported by the
+ *        shared objects that contain recompiled code.
+ */
+#define C_AOT_ENTRY_POINT_NAME "emuwalkerAotGetImage"
+
+/**
+ * @brief This constant defines the maximum size of a recompiled block in
+ *        bytes of FLASH ROM. Larger blocks are ignored.
+ */
+#define C_AOT_MAX_BLOCK_SIZE_BYTES 1024U
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This type defines the function called by recompiled code to execute
+ *        one instruction (see cpuExecuteInstruction()).
+ *
+ * @returns A boolean value that indicates whether the recompiled code can go
+ *          on with the next instruction. It is false when the instruction
+ *          modified the FLASH ROM area of the running block.
+ */
+typedef bool (*tf_aotExecute)(
+    uint16_t p_opcode0,
+    uint16_t p_opcode1,
+    uint8_t p_decodeWordCount,
+    uint8_t p_handlerIndex
+);
+
+/**
+ * @brief This type defines a recompiled basic block. It is called with PC set
+ *        to the address of the block, and leaves PC set to the address of the
+ *        next instruction to execute.
+ */
+typedef void (*tf_aotBlock)(void);
+
+/**
+ * @brief This structure describes a recompiled basic block.
+ */
+struct ts_aotBlock {
+    uint16_t address;
+
+    /**
+     * @brief This member contains the number of FLASH ROM bytes that the block
+     *        was recompiled from.
+     */
+    uint16_t size;
+
+    tf_aotBlock function;
+};
+
+/**
+ * @brief This structure describes the recompiled code of a FLASH ROM image.
+ */
+struct ts_aotImage {
+    /**
+     * @brief This member contains C_AOT_INTERFACE_VERSION.
+     */
+    uint32_t interfaceVersion;
+
+    /**
+     * @brief This member contains the value of cpuGetOpcodeTableHash() in the
+     *        recompiler.
+     */
+    uint64_t opcodeTableHash;
+
+    /**
+     * @brief This member contains the hash of the FLASH ROM image (see
+     *        romGetHash()).
+     */
+    uint64_t flashRomHash;
+
+    uint32_t blockCount;
+    const struct ts_aotBlock *blocks;
+};
+
+/**
+ * @brief This type defines the function exported by the shared objects that
+ *        contain recompiled code, under the name C_AOT_ENTRY_POINT_NAME.
+ *
+ * @param[in] p_execute The function that executes one instruction.
+ *
+ * @returns The description of the recompiled code.
+ */
+typedef const struct ts_aotImage *(*tf_aotGetImage)(tf_aotExecute p_execute);
+
+/**
+ * @brief This structure contains the recompiled code settings of a core
+ *        instance. They are not part of the emulated state.
+ */
+struct ts_aotInstance {
+    /**
+     * @brief This member contains one bit per program unit of the FLASH ROM,
+     *        set if the blocks that start in the unit were modified by this
+     *        instance.
+     */
+    uint8_t droppedUnits[C_ROM_UNIT_BITMAP_SIZE_BYTES];
+
+    /**
+     * @brief This member contains the address of the block being executed.
+     */
+    uint16_t blockAddress;
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Installs recompiled code for the loaded FLASH ROM. It is shared by
+ *        all the instances, and is uninstalled when another FLASH ROM is
+ *        loaded.
+ *
+ * @param[in] p_getImage The entry point of the recompiled code.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval 1 if the recompiled code does not match the loaded FLASH ROM or
+ *         this version of the core.
+ * @retval 2 if a memory allocation failed.
+ */
+int aotInstall(tf_aotGetImage p_getImage);
+
+/**
+ * @brief Uninstalls the recompiled code, if any.
+ */
+void aotUninstall(void);
+
+/**
+ * @brief Subscribes the current instance to the FLASH ROM modifications.
+ * @details This function shall only be called when an instance is created.
+ */
+void aotInitInstance(void);
+
+/**
+ * @brief Executes the recompiled block at PC, if there is one. Code in RAM,
+ *        code that was not found by the recompiler and blocks that overlap an
+ *        area that the instance reprogrammed are left to the interpreter.
+ *
+ * @returns A boolean value that indicates whether a block was executed.
+ */
+bool aotStep(void);
+
+#endif // __INC_CORE_AOT_H__
@@ -0,0 +1,282 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/audio.h"
+#include "core/core.h"
+#include "core/event.h"
+#include "core/instance.h"
+#include "core/scheduler.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the height of an edge in the samples.
+ */
+#define C_AUDIO_AMPLITUDE 8192
+
+/**
+ * @brief This constant defines the number of fractional bits of the sample
+ *        positions.
+ */
+#define C_AUDIO_PHASE_BITS 16
+
+/**
+ * @brief This constant defines how slowly the DC level follows the output,
+ *        as a power of two of samples (about 30 Hz at 48 kHz).
+ */
+#define C_AUDIO_DC_SHIFT 8
+
+/**
+ * @brief This constant defines the longest batch that is synthesized. Longer
+ *        batches only happen when the frames are not emulated, and they are
+ *        dropped.
+ */
+#define C_AUDIO_MAX_BATCH_CYCLES C_CORE_CLOCK_RATE_HZ
+
+/**
+ * @brief This macro gives access to the audio synthesis data of the current
+ *        instance.
+ */
+#define M_AUDIO_INSTANCE (g_coreInstance->audio)
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief These variables contain the steps and the samples of the batch being
+ *        synthesized. They are not part of the instance: a batch is
+ *        synthesized and sent at once, so one buffer per thread is enough.
+ */
+static __thread int32_t
+    s_audioDeltas[C_AUDIO_MAX_EVENT_SAMPLES + C_AUDIO_STEP_WIDTH];
+static __thread int16_t s_audioSamples[C_AUDIO_MAX_EVENT_SAMPLES];
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Starts a new batch at the given cycle, dropping the edges of the
+ *        current batch.
+ *
+ * @param[in] p_cycle The cycle at which the new batch starts.
+ */
+static void audioRestartBatch(uint64_t p_cycle);
+
+/**
+ * @brief Returns the position of a cycle of the current batch, in samples
+ *        with C_AUDIO_PHASE_BITS fractional bits.
+ *
+ * @param[in] p_offset The number of cycles since the start of the batch.
+ *
+ * @returns The position of the cycle.
+ */
+static inline uint64_t audioGetPosition(uint64_t p_offset);
+
+/**
+ * @brief Adds a band-limited step to the deltas. The step is the integral of
+ *        a triangle that is 2 samples wide, so it spreads over 3 samples.
+ *
+ * @param[in,out] p_deltas The deltas of the sample that contains the edge
+ *                         and of the 2 following samples.
+ * @param[in] p_phase The position of the edge within its sample.
+ * @param[in] p_rising A boolean value that indicates whether the output rises
+ *                     or falls.
+ */
+static void audioAddStep(int32_t *p_deltas, uint32_t p_phase, bool p_rising);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+void audioInitInstance(void) {
+    M_AUDIO_INSTANCE.sampleRate = C_AUDIO_DEFAULT_SAMPLE_RATE_HZ;
+    M_AUDIO_INSTANCE.level = false;
+    audioRestartBatch(0U);
+}
+
+void audioRecordEdge(uint64_t p_cycle, bool p_level) {
+    if(p_level == M_AUDIO_INSTANCE.level) {
+        return;
+    }
+
+    M_AUDIO_INSTANCE.level = p_level;
+
+    // The cycle counter goes back when a state is loaded.
+    if(p_cycle < M_AUDIO_INSTANCE.batchCycle) {
+        audioRestartBatch(p_cycle);
+    }
+
+    if(M_AUDIO_INSTANCE.edgeCount == C_AUDIO_MAX_EDGES) {
+        audioEndBatch();
+    }
+
+    uint64_t l_offset = (p_cycle > M_AUDIO_INSTANCE.batchCycle)
+        ? (p_cycle - M_AUDIO_INSTANCE.batchCycle)
+        : 0U;
+
+    if(l_offset > C_AUDIO_MAX_BATCH_CYCLES) {
+        l_offset = C_AUDIO_MAX_BATCH_CYCLES;
+    }
+
+    M_AUDIO_INSTANCE.edges[M_AUDIO_INSTANCE.edgeCount++] =
+        ((uint32_t)l_offset << 1) | (p_level ? 1U : 0U);
+}
+
+void audioEndBatch(void) {
+    uint64_t l_cycle = schedulerGetCycles();
+
+    if(
+        (l_cycle < M_AUDIO_INSTANCE.batchCycle)
+        || ((l_cycle - M_AUDIO_INSTANCE.batchCycle) > C_AUDIO_MAX_BATCH_CYCLES)
+        || !eventHasListeners(E_CORE_EVENT_AUDIO)
+    ) {
+        audioRestartBatch(l_cycle);
+        return;
+    }
+
+    uint64_t l_endPosition =
+        audioGetPosition(l_cycle - M_AUDIO_INSTANCE.batchCycle);
+    size_t l_sampleCount = l_endPosition >> C_AUDIO_PHASE_BITS;
+    size_t l_base = 0U;
+    uint32_t l_edgeIndex = 0U;
+
+    // The batch is sent in chunks that fit the buffers. Every edge falls on a
+    // chunk, and the end of its step is carried over to the next one.
+    do {
+        size_t l_chunkSize = l_sampleCount - l_base;
+        bool l_lastChunk = l_chunkSize <= C_AUDIO_MAX_EVENT_SAMPLES;
+
+        if(!l_lastChunk) {
+            l_chunkSize = C_AUDIO_MAX_EVENT_SAMPLES;
+        }
+
+        memset(
+            s_audioDeltas,
+            0,
+            (l_chunkSize + C_AUDIO_STEP_WIDTH) * sizeof(int32_t)
+        );
+
+        for(size_t l_index = 0U; l_index < C_AUDIO_STEP_WIDTH; l_index++) {
+            s_audioDeltas[l_index] = M_AUDIO_INSTANCE.carry[l_index];
+        }
+
+        while(l_edgeIndex < M_AUDIO_INSTANCE.edgeCount) {
+            uint32_t l_edge = M_AUDIO_INSTANCE.edges[l_edgeIndex];
+            uint64_t l_position = audioGetPosition(l_edge >> 1);
+            size_t l_sample = (l_position >> C_AUDIO_PHASE_BITS) - l_base;
+
+            if(!l_lastChunk && (l_sample >= l_chunkSize)) {
+                break;
+            }
+
+            audioAddStep(
+                &s_audioDeltas[l_sample],
+                l_position & ((1U << C_AUDIO_PHASE_BITS) - 1U),
+                (l_edge & 1U) != 0U
+            );
+            l_edgeIndex++;
+        }
+
+        // The samples are the sum of the steps, minus its DC level.
+        for(size_t l_index = 0U; l_index < l_chunkSize; l_index++) {
+            int32_t l_sample;
+
+            M_AUDIO_INSTANCE.sum += s_audioDeltas[l_index];
+            M_AUDIO_INSTANCE.dcLevel +=
+                (M_AUDIO_INSTANCE.sum - M_AUDIO_INSTANCE.dcLevel)
+                    / (1 << C_AUDIO_DC_SHIFT);
+            l_sample = M_AUDIO_INSTANCE.sum - M_AUDIO_INSTANCE.dcLevel;
+
+            if(l_sample > INT16_MAX) {
+                l_sample = INT16_MAX;
+            } else if(l_sample < INT16_MIN) {
+                l_sample = INT16_MIN;
+            }
+
+            s_audioSamples[l_index] = l_sample;
+        }
+
+        for(size_t l_index = 0U; l_index < C_AUDIO_STEP_WIDTH; l_index++) {
+            M_AUDIO_INSTANCE.carry[l_index] =
+                s_audioDeltas[l_chunkSize + l_index];
+        }
+
+        if(l_chunkSize > 0U) {
+            struct ts_coreAudioEvent l_event = {
+                .samples = s_audioSamples,
+                .sampleCount = l_chunkSize
+            };
+
+            eventRaise(E_CORE_EVENT_AUDIO, &l_event);
+        }
+
+        l_base += l_chunkSize;
+    } while(l_base < l_sampleCount);
+
+    M_AUDIO_INSTANCE.batchCycle = l_cycle;
+    M_AUDIO_INSTANCE.batchPhase =
+        l_endPosition & ((1U << C_AUDIO_PHASE_BITS) - 1U);
+    M_AUDIO_INSTANCE.edgeCount = 0U;
+}
+
+int coreSetAudioSampleRate(uint32_t p_sampleRateHz) {
+    if(
+        (p_sampleRateHz == 0U)
+        || (p_sampleRateHz > C_AUDIO_MAX_SAMPLE_RATE_HZ)
+    ) {
+        fprintf(stderr, "Error: invalid audio sample rate.\n");
+        return 1;
+    }
+
+    M_AUDIO_INSTANCE.sampleRate = p_sampleRateHz;
+
+    return 0;
+}
+
+uint32_t coreGetAudioSampleRate(void) {
+    return M_AUDIO_INSTANCE.sampleRate;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static void audioRestartBatch(uint64_t p_cycle) {
+    M_AUDIO_INSTANCE.batchCycle = p_cycle;
+    M_AUDIO_INSTANCE.batchPhase = 0U;
+    M_AUDIO_INSTANCE.edgeCount = 0U;
+
+    // The output restarts from the current level, without a step.
+    for(size_t l_index = 0U; l_index < C_AUDIO_STEP_WIDTH; l_index++) {
+        M_AUDIO_INSTANCE.carry[l_index] = 0;
+    }
+
+    M_AUDIO_INSTANCE.sum = M_AUDIO_INSTANCE.level ? C_AUDIO_AMPLITUDE : 0;
+    M_AUDIO_INSTANCE.dcLevel = M_AUDIO_INSTANCE.sum;
+}
+
+static inline uint64_t audioGetPosition(uint64_t p_offset) {
+    return M_AUDIO_INSTANCE.batchPhase
+        + ((p_offset * M_AUDIO_INSTANCE.sampleRate) << C_AUDIO_PHASE_BITS)
+            / C_CORE_CLOCK_RATE_HZ;
+}
+
+static void audioAddStep(int32_t *p_deltas, uint32_t p_phase, bool p_rising) {
+    // The parts of the step on the 3 samples are (1 - f)^2 / 2, the rest, and
+    // f^2 / 2, where f is the position of the edge within its sample.
+    uint64_t l_before = (1U << C_AUDIO_PHASE_BITS) - p_phase;
+    int32_t l_first = (l_before * l_before * C_AUDIO_AMPLITUDE)
+        >> (2 * C_AUDIO_PHASE_BITS + 1);
+    int32_t l_last = ((uint64_t)p_phase * p_phase * C_AUDIO_AMPLITUDE)
+        >> (2 * C_AUDIO_PHASE_BITS + 1);
+    int32_t l_sign = p_rising ? 1 : -1;
+
+    p_deltas[0] += l_sign * l_first;
+    p_deltas[1] += l_sign * (C_AUDIO_AMPLITUDE - l_first - l_last);
+    p_deltas[2] += l_sign * l_last;
+}
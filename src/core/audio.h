@@ -0,0 +1,122 @@
+#ifndef __INC_CORE_AUDIO_H__
+#define __INC_CORE_AUDIO_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stdint.h>
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the sample rate of a new instance in Hz.
+ */
+#define C_AUDIO_DEFAULT_SAMPLE_RATE_HZ 48000U
+
+/**
+ * @brief This constant defines the maximum sample rate in Hz.
+ */
+#define C_AUDIO_MAX_SAMPLE_RATE_HZ 96000U
+
+/**
+ * @brief This constant defines the maximum number of buzzer edges recorded
+ *        between two batches. The batch is synthesized early when it is
+ *        full.
+ */
+#define C_AUDIO_MAX_EDGES 512U
+
+/**
+ * @brief This constant defines the maximum number of samples sent with one
+ *        audio event. Longer batches are sent in several events.
+ */
+#define C_AUDIO_MAX_EVENT_SAMPLES 2048U
+
+/**
+ * @brief This constant defines the number of samples that the band-limited
+ *        step of an edge spreads over.
+ */
+#define C_AUDIO_STEP_WIDTH 3U
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure contains the audio synthesis data of a core instance.
+ *        It is not part of the emulated state: it only converts the edges of
+ *        the buzzer output to samples.
+ */
+struct ts_audioInstance {
+    uint32_t sampleRate;
+
+    /**
+     * @brief This member contains the cycle at which the current batch
+     *        starts.
+     */
+    uint64_t batchCycle;
+
+    /**
+     * @brief This member contains the position of the start of the current
+     *        batch within its sample, in 1/65536 of a sample.
+     */
+    uint32_t batchPhase;
+
+    /**
+     * @brief This member contains the edges of the current batch. Each edge
+     *        is stored as its cycle relative to batchCycle, shifted left by
+     *        one bit, with the new level of the output in bit 0.
+     */
+    uint32_t edges[C_AUDIO_MAX_EDGES];
+    uint32_t edgeCount;
+
+    /**
+     * @brief This member contains the level of the buzzer output after the
+     *        last edge.
+     */
+    bool level;
+
+    /**
+     * @brief This member contains the part of the steps of the previous batch
+     *        that falls on the samples of the current batch.
+     */
+    int32_t carry[C_AUDIO_STEP_WIDTH];
+
+    /**
+     * @brief This member contains the sum of all the steps, which is the
+     *        output level before the DC is removed.
+     */
+    int32_t sum;
+
+    /**
+     * @brief This member contains the DC level of the output, which follows
+     *        sum slowly and is subtracted from it, as the piezo buzzer does
+     *        not reproduce it.
+     */
+    int32_t dcLevel;
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Initializes the audio synthesis of the current instance.
+ */
+void audioInitInstance(void);
+
+/**
+ * @brief Records an edge of the buzzer output.
+ *
+ * @param[in] p_cycle The cycle at which the edge occurs.
+ * @param[in] p_level The new level of the buzzer output.
+ */
+void audioRecordEdge(uint64_t p_cycle, bool p_level);
+
+/**
+ * @brief Ends the current batch at the current cycle: if the audio event has
+ *        listeners, the edges are converted to band-limited samples and sent
+ *        with the event. This function is called at the end of every frame.
+ */
+void audioEndBatch(void);
+
+#endif // __INC_CORE_AUDIO_H__
@@ -10,11 +10,26 @@
 // Public function declarations
 // =============================================================================
 /**
- * @brief Performs a bus cycle.
+ * @brief Performs a bus cycle. The cycle-exact profile advances the
+ *        peripherals immediately. The other profiles only count the cycle,
+ *        and apply the cycles later with busSync().
  * @details This function shall only be called by the CPU module.
  */
 void busCycle(void);
 
+/**
+ * @brief Advances the peripherals by the bus cycles counted by
+ *        busCycle() since the last call.
+ */
+void busSync(void);
+
+/**
+ * @brief Advances the peripherals by the given number of cycles at once.
+ *
+ * @param[in] p_cycles The number of cycles to advance by.
+ */
+void busAdvance(uint64_t p_cycles);
+
 /**
  * @brief Reads a byte from the bus.
  *
@@ -24,6 +39,17 @@ void busCycle(void);
  */
 uint8_t busRead8(uint16_t p_address);
 
+/**
+ * @brief Reads a byte from the bus without performing a bus cycle. This is
+ *        meant for debuggers and tools: the read side effects of peripheral
+ *        registers still happen.
+ *
+ * @param[in] p_address The address to read the byte from.
+ *
+ * @returns The byte read.
+ */
+uint8_t busPeek8(uint16_t p_address);
+
 /**
  * @brief Reads a word from the bus.
  *
@@ -1,27 +1,450 @@
 // =============================================================================
 // File inclusion
 // =============================================================================
-#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include "common.h"
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include "core/accuracy.h"
+#include "core/aot.h"
+#include "core/audio.h"
 #include "core/core.h"
 #include "core/cpu.h"
+#include "core/eeprom.h"
+#include "core/hash.h"
+#include "core/hle.h"
+#include "core/instance.h"
+#include "core/lcd.h"
+#include "core/metrics.h"
+#include "core/port.h"
 #include "core/ram.h"
 #include "core/rom.h"
+#include "core/scheduler.h"
 #include "core/ssu.h"
+#include "core/timerw.h"
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+/**
+ * @brief This structure describes the header of a saved state. The header is
+ *        followed by the ts_coreState structure, by the private EEPROM pages,
+ *        and by the FLASH ROM contents if they were modified.
+ */
+struct ts_coreStateHeader {
+    uint32_t version;
+    uint32_t flashRomModified;
+    uint64_t flashRomHash;
+    uint64_t eepromHash;
+    uint32_t eepromPageCount;
+};
+
+// =============================================================================
+// Public variable definitions
+// =============================================================================
+__thread struct ts_coreInstance *g_coreInstance;
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Allocates an instance aligned on a cache line.
+ *
+ * @returns A pointer to the uninitialized instance.
+ * @retval NULL if the allocation failed.
+ */
+static struct ts_coreInstance *coreAllocateInstance(void);
+
+/**
+ * @brief Frees an instance allocated with coreAllocateInstance().
+ *
+ * @param[in] p_instance The instance to free.
+ */
+static void coreFreeInstance(struct ts_coreInstance *p_instance);
+
+/**
+ * @brief Continues the computation of a state hash with an integer member of
+ *        the state, widened to 64 bits.
+ *
+ * @param[in] p_hash The hash of the previous members.
+ * @param[in] p_value The value of the member.
+ *
+ * @returns The hash of the previous members and the given member.
+ */
+static uint64_t coreHashInteger(uint64_t p_hash, uint64_t p_value);
 
 // =============================================================================
 // Public functions definitions
 // =============================================================================
+struct ts_coreInstance *coreCreateInstance(void) {
+    struct ts_coreInstance *l_instance = coreAllocateInstance();
+
+    if(l_instance == NULL) {
+        fprintf(stderr, "Error: failed to allocate the instance.\n");
+        return NULL;
+    }
+
+    memset(l_instance, 0, sizeof(*l_instance));
+
+    struct ts_coreInstance *l_previousInstance = g_coreInstance;
+
+    g_coreInstance = l_instance;
+
+    if(l_previousInstance != NULL) {
+        accuracyInitInstance(l_previousInstance->accuracy.profile->accuracy);
+    } else {
+        accuracyInitInstance(E_CORE_ACCURACY_CYCLE_EXACT);
+    }
+
+    romInitInstance();
+    hleInitInstance();
+    aotInitInstance();
+    eepromInitInstance();
+    audioInitInstance();
+    coreReset();
+    g_coreInstance = l_previousInstance;
+
+    return l_instance;
+}
+
+void coreDestroyInstance(struct ts_coreInstance *p_instance) {
+    if(p_instance == NULL) {
+        return;
+    }
+
+    struct ts_coreInstance *l_previousInstance = g_coreInstance;
+
+    g_coreInstance = p_instance;
+    romDeinitInstance();
+    eepromDeinitInstance();
+
+    if(l_previousInstance == p_instance) {
+        g_coreInstance = NULL;
+    } else {
+        g_coreInstance = l_previousInstance;
+    }
+
+    coreFreeInstance(p_instance);
+}
+
+void coreSelectInstance(struct ts_coreInstance *p_instance) {
+    // Every thread that runs an instance selects it first.
+    metricsRegisterThread();
+    g_coreInstance = p_instance;
+}
+
+struct ts_coreInstance *coreGetInstance(void) {
+    return g_coreInstance;
+}
+
 int coreReset(void) {
+    schedulerReset();
     cpuReset();
     ramReset();
+    romReset();
     ssuReset();
+    portReset();
+    eepromReset();
+    timerWReset();
+    lcdReset();
+
+    return 0;
+}
+
+size_t coreGetStateSize(void) {
+    size_t l_size = sizeof(struct ts_coreStateHeader)
+        + sizeof(struct ts_coreState)
+        + (g_coreInstance->state.eeprom.privatePageCount
+            * C_EEPROM_PAGE_SIZE_BYTES);
+
+    if(romGetModifiedData() != NULL) {
+        l_size += C_ROM_SIZE_BYTES;
+    }
+
+    return l_size;
+}
+
+size_t coreGetMaxStateSize(void) {
+    return sizeof(struct ts_coreStateHeader)
+        + sizeof(struct ts_coreState)
+        + (C_EEPROM_PAGE_COUNT * C_EEPROM_PAGE_SIZE_BYTES)
+        + C_ROM_SIZE_BYTES;
+}
+
+int coreSaveState(uint8_t *p_buffer, size_t p_size) {
+    if(p_size < coreGetStateSize()) {
+        return 1;
+    }
+
+    const uint8_t *l_flashRomData = romGetModifiedData();
+
+    struct ts_coreStateHeader l_header = {
+        .version = C_CORE_STATE_VERSION,
+        .flashRomModified = l_flashRomData != NULL,
+        .flashRomHash = romGetHash(),
+        .eepromHash = eepromGetHash(),
+        .eepromPageCount = g_coreInstance->state.eeprom.privatePageCount
+    };
+
+    memcpy(p_buffer, &l_header, sizeof(l_header));
+    p_buffer += sizeof(l_header);
+
+    memcpy(p_buffer, &g_coreInstance->state, sizeof(struct ts_coreState));
+    p_buffer += sizeof(struct ts_coreState);
+
+    if(l_header.eepromPageCount > 0U) {
+        memcpy(
+            p_buffer,
+            eepromGetPrivatePages(),
+            l_header.eepromPageCount * C_EEPROM_PAGE_SIZE_BYTES
+        );
+        p_buffer += l_header.eepromPageCount * C_EEPROM_PAGE_SIZE_BYTES;
+    }
+
+    // The FLASH ROM contents are only saved if they differ from the shared
+    // buffer.
+    if(l_flashRomData != NULL) {
+        memcpy(p_buffer, l_flashRomData, C_ROM_SIZE_BYTES);
+    }
 
     return 0;
 }
+
+int coreLoadState(const uint8_t *p_buffer, size_t p_size) {
+    struct ts_coreStateHeader l_header;
+
+    if(p_size < sizeof(l_header)) {
+        return 1;
+    }
+
+    memcpy(&l_header, p_buffer, sizeof(l_header));
+    p_buffer += sizeof(l_header);
+
+    size_t l_expectedSize = sizeof(l_header) + sizeof(struct ts_coreState)
+        + ((size_t)l_header.eepromPageCount * C_EEPROM_PAGE_SIZE_BYTES);
+
+    if(l_header.flashRomModified != 0U) {
+        l_expectedSize += C_ROM_SIZE_BYTES;
+    }
+
+    if(
+        (l_header.version != C_CORE_STATE_VERSION)
+        || (l_header.flashRomHash != romGetHash())
+        || (l_header.eepromHash != eepromGetHash())
+        || (l_header.eepromPageCount > C_EEPROM_PAGE_COUNT)
+        || (p_size != l_expectedSize)
+    ) {
+        fprintf(stderr, "Error: invalid or truncated state.\n");
+        return 1;
+    }
+
+    memcpy(&g_coreInstance->state, p_buffer, sizeof(struct ts_coreState));
+    p_buffer += sizeof(struct ts_coreState);
+
+    const uint8_t *l_eepromPages = p_buffer;
+    const uint8_t *l_flashRomData = NULL;
+
+    p_buffer += l_header.eepromPageCount * C_EEPROM_PAGE_SIZE_BYTES;
+
+    if(l_header.flashRomModified != 0U) {
+        l_flashRomData = p_buffer;
+    }
+
+    if(
+        (g_coreInstance->state.eeprom.privatePageCount
+            != l_header.eepromPageCount)
+        || (eepromSetPrivatePages(l_eepromPages) != 0)
+        || (romSetModifiedData(l_flashRomData) != 0)
+    ) {
+        fprintf(stderr, "Error: invalid state.\n");
+        eepromInitInstance();
+        coreReset();
+        return 1;
+    }
+
+    return 0;
+}
+
+uint64_t coreGetCycles(void) {
+    return schedulerGetCycles();
+}
+
+uint64_t coreGetStateHash(void) {
+    const struct ts_coreState *l_state = &g_coreInstance->state;
+    const uint8_t *l_flashRomData = romGetModifiedData();
+    uint64_t l_cycles = l_state->scheduler.cycles;
+    uint64_t l_timerWCycles = schedulerGetCycles();
+    uint64_t l_hash = C_HASH_INITIAL_VALUE;
+
+    // The members are hashed one by one, so that the padding bytes of the
+    // structures are not hashed. The cycle counts are hashed relative to the
+    // current cycle, so that the hash does not depend on the time it took to
+    // reach the state.
+    for(int l_index = 0; l_index < 8; l_index++) {
+        l_hash = coreHashInteger(
+            l_hash,
+            l_state->cpu.generalRegisters[l_index].longWord
+        );
+    }
+
+    l_hash = coreHashInteger(l_hash, l_state->cpu.registerPC);
+    l_hash = coreHashInteger(l_hash, l_state->cpu.flagsRegister.byte);
+    l_hash = coreHashInteger(l_hash, l_state->cpu.initialized);
+    l_hash = coreHashInteger(l_hash, l_state->cpu.opcodeBuffer[0]);
+    l_hash = coreHashInteger(l_hash, l_state->cpu.opcodeBuffer[1]);
+
+    // The next deadline is derived from the events, and the deadline of an
+    // event that is not pending is meaningless.
+    l_hash = coreHashInteger(l_hash, l_state->scheduler.deferredCycles);
+
+    for(int l_event = 0; l_event < E_SCHEDULER_EVENT_COUNT; l_event++) {
+        const struct ts_schedulerEvent *l_schedulerEvent =
+            &l_state->scheduler.events[l_event];
+
+        l_hash = coreHashInteger(l_hash, l_schedulerEvent->pending);
+
+        if(l_schedulerEvent->pending) {
+            l_hash = coreHashInteger(
+                l_hash,
+                l_schedulerEvent->deadline - l_cycles
+            );
+        }
+    }
+
+    l_hash = coreHashInteger(l_hash, l_state->rom.flmcr1.byte);
+    l_hash = coreHashInteger(l_hash, l_state->rom.flmcr2.byte);
+    l_hash = coreHashInteger(l_hash, l_state->rom.ebr1.byte);
+    l_hash = coreHashInteger(l_hash, l_state->rom.flpwcr.byte);
+    l_hash = coreHashInteger(l_hash, l_state->rom.fenr.byte);
+    l_hash = hashUpdate(
+        l_hash,
+        l_state->rom.programBuffer,
+        sizeof(l_state->rom.programBuffer)
+    );
+    l_hash = coreHashInteger(l_hash, l_state->rom.programAddress);
+    l_hash = coreHashInteger(l_hash, l_state->rom.programBufferUsed);
+    l_hash = coreHashInteger(l_hash, l_state->rom.pendingOperation);
+
+    l_hash = coreHashInteger(l_hash, l_state->ssu.sscrh.byte);
+    l_hash = coreHashInteger(l_hash, l_state->ssu.sscrl.byte);
+    l_hash = coreHashInteger(l_hash, l_state->ssu.ssmr.byte);
+    l_hash = coreHashInteger(l_hash, l_state->ssu.sser.byte);
+    l_hash = coreHashInteger(l_hash, l_state->ssu.sssr.byte);
+    l_hash = coreHashInteger(l_hash, l_state->ssu.ssrdr);
+    l_hash = coreHashInteger(l_hash, l_state->ssu.sstdr);
+    l_hash = coreHashInteger(l_hash, l_state->ssu.sstrsr);
+    l_hash = coreHashInteger(l_hash, l_state->ssu.transferring);
+    l_hash = coreHashInteger(l_hash, (uint64_t)l_state->ssu.clockCounter);
+    l_hash = coreHashInteger(l_hash, (uint64_t)l_state->ssu.bitCounter);
+
+    l_hash = coreHashInteger(l_hash, l_state->port.inputs);
+    l_hash = coreHashInteger(l_hash, l_state->port.pdr1);
+
+    // The timer W cycles are based on schedulerGetCycles(), which includes the
+    // deferred cycles. The match cycle is UINT64_MAX if no match is expected.
+    l_hash = coreHashInteger(l_hash, l_state->timerW.tmrw.byte);
+    l_hash = coreHashInteger(l_hash, l_state->timerW.tcrw.byte);
+    l_hash = coreHashInteger(l_hash, l_state->timerW.tierw);
+    l_hash = coreHashInteger(l_hash, l_state->timerW.tsrw);
+    l_hash = coreHashInteger(l_hash, l_state->timerW.tior0);
+    l_hash = coreHashInteger(l_hash, l_state->timerW.tior1);
+    l_hash = coreHashInteger(l_hash, l_state->timerW.outputs);
+
+    for(int l_channel = 0; l_channel < C_TIMER_W_CHANNEL_COUNT; l_channel++) {
+        l_hash = coreHashInteger(l_hash, l_state->timerW.gr[l_channel]);
+    }
+
+    l_hash = coreHashInteger(l_hash, l_state->timerW.tcnt);
+    l_hash = coreHashInteger(
+        l_hash,
+        l_timerWCycles - l_state->timerW.tcntCycle
+    );
+    l_hash = coreHashInteger(
+        l_hash,
+        (l_state->timerW.matchCycle == UINT64_MAX) ? UINT64_MAX
+            : (l_state->timerW.matchCycle - l_timerWCycles)
+    );
+
+    l_hash = hashUpdate(
+        l_hash,
+        l_state->lcd.vram,
+        sizeof(l_state->lcd.vram)
+    );
+    l_hash = hashUpdate(
+        l_hash,
+        l_state->lcd.frame,
+        sizeof(l_state->lcd.frame)
+    );
+
+    // The EEPROM page table is not hashed: it depends on the write history,
+    // not on the contents.
+    l_hash = coreHashInteger(l_hash, l_state->ram.hash);
+    l_hash = coreHashInteger(l_hash, l_state->eeprom.hash);
+    l_hash = coreHashInteger(l_hash, l_state->eeprom.selected);
+    l_hash = coreHashInteger(l_hash, l_state->eeprom.writeEnabled);
+    l_hash = coreHashInteger(l_hash, l_state->eeprom.instruction);
+    l_hash = coreHashInteger(l_hash, l_state->eeprom.byteCount);
+    l_hash = coreHashInteger(l_hash, l_state->eeprom.address);
+
+    if(l_flashRomData != NULL) {
+        l_hash = hashUpdate(l_hash, l_flashRomData, C_ROM_SIZE_BYTES);
+    }
+
+    return l_hash;
+}
+
+int coreSetHleRoutineEnabled(const char *p_name, bool p_enabled) {
+    return hleSetRoutineEnabled(p_name, p_enabled);
+}
+
+int coreSetAccuracy(enum te_coreAccuracy p_accuracy) {
+    return accuracySet(p_accuracy);
+}
+
+enum te_coreAccuracy coreGetAccuracy(void) {
+    return accuracyGet();
+}
+
+// =============================================================================
+// Private functions definitions
+// =============================================================================
+static struct ts_coreInstance *coreAllocateInstance(void) {
+#ifdef _WIN32
+    return (struct ts_coreInstance *)_aligned_malloc(
+        sizeof(struct ts_coreInstance),
+        C_INSTANCE_CACHE_LINE_SIZE
+    );
+#else
+    void *l_instance;
+
+    if(
+        posix_memalign(
+            &l_instance,
+            C_INSTANCE_CACHE_LINE_SIZE,
+            sizeof(struct ts_coreInstance)
+        ) != 0
+    ) {
+        return NULL;
+    }
+
+    return (struct ts_coreInstance *)l_instance;
+#endif
+}
+
+static void coreFreeInstance(struct ts_coreInstance *p_instance) {
+#ifdef _WIN32
+    _aligned_free(p_instance);
+#else
+    free(p_instance);
+#endif
+}
+
+static uint64_t coreHashInteger(uint64_t p_hash, uint64_t p_value) {
+    return hashUpdate(p_hash, &p_value, sizeof(p_value));
+}
@@ -4,9 +4,39 @@
 // =============================================================================
 // File inclusion
 // =============================================================================
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+// =============================================================================
+// Public constants declarations
+// =============================================================================
+/**
+ * @brief This constant contains the version of the emulator.
+ */
+#define C_CORE_VERSION "0.1.0"
+
+/**
+ * @brief This constant contains the version of the format of the saved states.
+ *        It must be incremented everytime the state of a module changes.
+ */
+#define C_CORE_STATE_VERSION 9U
+
+/**
+ * @brief This constant defines the frequency of the system clock in Hz.
+ */
+#define C_CORE_CLOCK_RATE_HZ 3686400U
+
+/**
+ * @brief This constant defines the maximum amount of memory used by an
+ *        instance, so that 10000 instances fit in 1 GB. It covers the instance
+ *        itself and a private copy of every EEPROM page. The FLASH ROM and the
+ *        EEPROM image are shared by every instance, and the video buffer is
+ *        only rendered on demand. The only memory not covered is the private
+ *        copy of the FLASH ROM made if the firmware reprograms it.
+ */
+#define C_CORE_INSTANCE_MEMORY_BUDGET_BYTES (100U * 1024U)
+
 // =============================================================================
 // Public types declarations
 // =============================================================================
@@ -26,6 +56,199 @@ enum te_coreInputState {
     E_CORE_INPUT_PRESSED
 };
 
+/**
+ * @brief This enumeration lists the memory regions of an instance that can be
+ *        accessed directly with coreGetMemoryRegion().
+ */
+enum te_coreMemoryRegion {
+    /**
+     * @brief The on-chip RAM, from address 0xf780.
+     */
+    E_CORE_MEMORY_REGION_RAM,
+
+    /**
+     * @brief The frame displayed by the LCD panel, as latched by the last
+     *        refresh. It is organized in pages of 8 rows, and in a page each
+     *        column is described by 2 bytes: the low bits of the 8 pixels,
+     *        then their high bits.
+     */
+    E_CORE_MEMORY_REGION_FRAME
+};
+
+/**
+ * @brief This enumeration lists the peripherals of the bus, whose accesses are
+ *        counted by coreGetMetrics().
+ */
+enum te_coreBusPeripheral {
+    E_CORE_BUS_PERIPHERAL_OPEN_BUS,
+    E_CORE_BUS_PERIPHERAL_ROM,
+    E_CORE_BUS_PERIPHERAL_RAM,
+    E_CORE_BUS_PERIPHERAL_SSU,
+    E_CORE_BUS_PERIPHERAL_PORT,
+    E_CORE_BUS_PERIPHERAL_TIMER_W,
+
+    E_CORE_BUS_PERIPHERAL_COUNT
+};
+
+/**
+ * @brief This structure contains the activity counters of the core, summed
+ *        over all the instances and all the threads since the start of the
+ *        process.
+ */
+struct ts_coreMetrics {
+    /**
+     * @brief This member contains the number of emulated cycles, including
+     *        the idle cycles.
+     */
+    uint64_t cycles;
+
+    /**
+     * @brief This member contains the number of cycles skipped in idle loops
+     *        (see E_CORE_ACCURACY_FAST), during which the CPU is asleep or
+     *        waiting for an event.
+     */
+    uint64_t idleCycles;
+
+    /**
+     * @brief This member contains the number of instructions run by the
+     *        interpreter or by recompiled code. The routines run natively
+     *        (HLE) are not counted.
+     */
+    uint64_t instructions;
+
+    uint64_t frames;
+    uint64_t schedulerEvents;
+    uint64_t eepromBytesWritten;
+
+    /**
+     * @brief This member contains the number of bus accesses of each
+     *        peripheral, indexed by te_coreBusPeripheral.
+     */
+    uint64_t busAccesses[E_CORE_BUS_PERIPHERAL_COUNT];
+};
+
+/**
+ * @brief This enumeration lists the accuracy profiles. Each profile trades
+ *        timing accuracy for speed, and can be selected at runtime.
+ */
+enum te_coreAccuracy {
+    /**
+     * @brief The peripherals advance on every bus access, the SSU shifts one
+     *        bit at a time, and every instruction is interpreted. This is the
+     *        reference profile.
+     */
+    E_CORE_ACCURACY_CYCLE_EXACT,
+
+    /**
+     * @brief The bus accesses of an instruction are counted, and the
+     *        peripherals advance once at the end of the instruction. The SSU
+     *        advances one byte at a time.
+     */
+    E_CORE_ACCURACY_INSTRUCTION,
+
+    /**
+     * @brief The peripherals advance at least every
+     *        C_ACCURACY_FAST_SYNC_CYCLES cycles or after each recompiled block,
+     *        idle loops are skipped up to the next event, and the recognized
+     *        firmware routines and the recompiled code are run natively.
+     */
+    E_CORE_ACCURACY_FAST,
+
+    E_CORE_ACCURACY_COUNT
+};
+
+/**
+ * @brief This enumeration lists the events that can end coreRunUntil() or be
+ *        listened to with coreAddEventListener(). The values are bits that
+ *        can be combined in an event mask.
+ */
+enum te_coreEvent {
+    /**
+     * @brief The cycle budget of coreRunUntil() is spent. This event is always
+     *        enabled and is not sent to listeners.
+     */
+    E_CORE_EVENT_BUDGET = 0x01,
+
+    /**
+     * @brief The LCD panel was refreshed and entered VBlank, every
+     *        C_LCD_REFRESH_PERIOD_CYCLES cycles. There is no data: listeners
+     *        render the new frame where they need it, with
+     *        coreGetVideoBuffer() or coreRenderVideo().
+     */
+    E_CORE_EVENT_VBLANK = 0x02,
+
+    /**
+     * @brief The CPU executed a SLEEP instruction. There is no data.
+     */
+    E_CORE_EVENT_SLEEP = 0x04,
+
+    /**
+     * @brief PC reached a breakpoint (see coreAddBreakpoint()). This event is
+     *        not sent to listeners.
+     */
+    E_CORE_EVENT_BREAKPOINT = 0x08,
+
+    /**
+     * @brief A byte was received on the IR port. The data is the byte. The IR
+     *        port is not emulated yet, so this event does not occur.
+     */
+    E_CORE_EVENT_IR_DATA = 0x10,
+
+    /**
+     * @brief A byte of the EEPROM was changed by a WRITE instruction received
+     *        through the SSU. Writing the value that is already stored does
+     *        not raise it. The data is a ts_coreEepromWriteEvent structure.
+     */
+    E_CORE_EVENT_EEPROM_WRITE = 0x20,
+
+    /**
+     * @brief The CPU left the sleep mode. There is no data. Interrupts are not
+     *        emulated yet, so this event does not occur.
+     */
+    E_CORE_EVENT_WAKE = 0x40,
+
+    /**
+     * @brief A block of band-limited samples of the buzzer output is ready,
+     *        at the end of a frame. The data is a ts_coreAudioEvent structure.
+     *        The samples are only synthesized if this event has listeners.
+     */
+    E_CORE_EVENT_AUDIO = 0x80
+};
+
+/**
+ * @brief This structure describes the data of E_CORE_EVENT_EEPROM_WRITE.
+ */
+struct ts_coreEepromWriteEvent {
+    uint16_t address;
+    uint8_t value;
+};
+
+/**
+ * @brief This structure describes the data of E_CORE_EVENT_AUDIO. The samples
+ *        are mono, at the rate set with coreSetAudioSampleRate(), and are only
+ *        valid during the call to the listener.
+ */
+struct ts_coreAudioEvent {
+    const int16_t *samples;
+    size_t sampleCount;
+};
+
+/**
+ * @brief This type describes a function called when an event occurs in an
+ *        instance. It is called by the thread that runs the instance, in the
+ *        middle of a step: it must not run or modify the instance.
+ *
+ * @param[in] p_event The event that occurred.
+ * @param[in] p_data The data of the event (see te_coreEvent). It is shared by
+ *                   all the listeners and only valid during the call.
+ * @param[in] p_context The context given to coreAddEventListener().
+ */
+typedef void (*tf_coreEventListener)(
+    enum te_coreEvent p_event,
+    const void *p_data,
+    void *p_context
+);
+
 enum te_coreRegister {
     E_CORE_REGISTER_ER0
 };
@@ -36,12 +259,19 @@ union tu_coreRegister {
     uint32_t dword;
 };
 
+/**
+ * @brief This structure contains the state of one emulated pokéwalker. Its
+ *        contents are private to the core.
+ */
+struct ts_coreInstance;
+
 // =============================================================================
 // Public functions declarations
 // =============================================================================
 /**
  * @brief Pre-initializes the core module (necessary before calling any core*
- *        function).
+ *        function). A default instance is created and selected for the calling
+ *        thread.
  *
  * @returns An integer that indicates the result of the operation.
  * @retval 0 if the operation was successful.
@@ -58,6 +288,55 @@ int corePreinit(void);
  */
 int coreInit(void);
 
+/**
+ * @brief Creates a new instance. The instance is allocated in one block and
+ *        is reset. The FLASH ROM and EEPROM buffers given to coreLoadFile()
+ *        are shared with the other instances until the instance writes to
+ *        them. See C_CORE_INSTANCE_MEMORY_BUDGET_BYTES for the memory used
+ *        by an instance.
+ *
+ * @returns A pointer to the new instance.
+ * @retval NULL if the instance could not be allocated.
+ */
+struct ts_coreInstance *coreCreateInstance(void);
+
+/**
+ * @brief Destroys an instance created with coreCreateInstance(). If the
+ *        instance is selected by the calling thread, no instance is selected
+ *        afterwards.
+ *
+ * @param[in] p_instance The instance to destroy.
+ */
+void coreDestroyInstance(struct ts_coreInstance *p_instance);
+
+/**
+ * @brief Selects the instance that the calling thread will run. Every other
+ *        core* function operates on the selected instance. Each thread has its
+ *        own selection, and an instance must not be selected by two threads
+ *        at the same time.
+ *
+ * @param[in] p_instance The instance to select.
+ */
+void coreSelectInstance(struct ts_coreInstance *p_instance);
+
+/**
+ * @brief Returns the instance selected by the calling thread.
+ *
+ * @returns A pointer to the selected instance.
+ * @retval NULL if no instance is selected.
+ */
+struct ts_coreInstance *coreGetInstance(void);
+
+/**
+ * @brief Returns the activity counters of the core. Each thread counts in its
+ *        own counters, which are only summed here, so that counting never
+ *        makes the threads wait for each other. This function can be called
+ *        from any thread while the instances run.
+ *
+ * @param[out] p_metrics The counters.
+ */
+void coreGetMetrics(struct ts_coreMetrics *p_metrics);
+
 /**
  * @brief Resets the core.
  *
@@ -71,9 +350,14 @@ int coreReset(void);
  * @brief Loads a file buffer in the core.
  *
  * @param[in] p_coreFile The type of the file to load.
- * @param[in] p_buffer A pointer to the buffer to load. Note that the core
- *                     will make a copy of this buffer and therefore the passed
- *                     buffer's contents will not be modified.
+ * @param[in] p_buffer A pointer to the buffer to load. The passed buffer's
+ *                     contents will never be modified. The FLASH ROM buffer is
+ *                     not copied and must remain valid while the core is used:
+ *                     it can be a read-only mapping shared by every instance.
+ *                     The EEPROM buffer is not copied either: it is the image
+ *                     shared by every instance, and only the pages that an
+ *                     instance writes to are copied to it. Files must be
+ *                     loaded before creating additional instances.
  * @param[in] p_size The size of the buffer.
  *
  * @returns An integer that indicates the result of the operation.
@@ -82,10 +366,21 @@ int coreReset(void);
  */
 int coreLoadFile(
     enum te_coreFile p_coreFile,
-    uint8_t *p_buffer,
+    const uint8_t *p_buffer,
     size_t p_size
 );
 
+/**
+ * @brief Returns the hash of the contents of a file loaded in the core. The
+ *        hash is computed once when the file is loaded.
+ *
+ * @param[in] p_coreFile The type of the file.
+ *
+ * @returns The hash of the file contents.
+ * @retval 0 if the file was not loaded or is not hashed.
+ */
+uint64_t coreGetFileHash(enum te_coreFile p_coreFile);
+
 /**
  * @brief Saves a file buffer from the core.
  *
@@ -105,7 +400,203 @@ int coreSaveFile(
 );
 
 /**
- * @brief Runs the core until the next VBlank event is triggered.
+ * @brief Returns the size of the current state of the core.
+ *
+ * @returns The size of the state in bytes.
+ */
+size_t coreGetStateSize(void);
+
+/**
+ * @brief Returns the largest size that a state of the core can have, when
+ *        every EEPROM page was written and the FLASH ROM was programmed.
+ *
+ * @returns The maximum size of a state in bytes.
+ */
+size_t coreGetMaxStateSize(void);
+
+/**
+ * @brief Saves the state of the core in the given buffer.
+ *
+ * @param[out] p_buffer The buffer to fill.
+ * @param[in] p_size The size of the buffer.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the state was saved successfully.
+ * @retval Any other value if the buffer is too small.
+ */
+int coreSaveState(uint8_t *p_buffer, size_t p_size);
+
+/**
+ * @brief Loads the state of the core from the given buffer. The state must have
+ *        been saved with the same FLASH ROM and the same state version.
+ *
+ * @param[in] p_buffer The buffer that contains the state.
+ * @param[in] p_size The size of the buffer.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the state was loaded successfully.
+ * @retval Any other value if the state is invalid.
+ */
+int coreLoadState(const uint8_t *p_buffer, size_t p_size);
+
+/**
+ * @brief Returns the number of cycles elapsed since the last reset.
+ *
+ * @returns The number of cycles elapsed since the last reset.
+ */
+uint64_t coreGetCycles(void);
+
+/**
+ * @brief Returns a 64-bit hash of the state of the core. Two instances with the
+ *        same state have the same hash, so it can be used to detect
+ *        nondeterminism or to deduplicate states. The RAM and EEPROM hashes
+ *        are maintained on every write, so this function only hashes the
+ *        registers and the LCD display RAM (about 2 KiB), plus the FLASH ROM
+ *        if the firmware modified it. The number of elapsed cycles is not
+ *        part of the hash: the scheduler and timer deadlines are hashed
+ *        relative to the current cycle.
+ *
+ * @returns The hash of the state.
+ */
+uint64_t coreGetStateHash(void);
+
+/**
+ * @brief Enables or disables the native execution of a recognized firmware
+ *        routine for the selected instance. All the routines are enabled by
+ *        default. Disabling them is only useful to check that they behave
+ *        like the interpreter, as the emulated state is the same either way.
+ *
+ * @param[in] p_name The name of the routine ("memcpy8", "memset8" or
+ *                   "divu32"), or NULL for all the routines.
+ * @param[in] p_enabled true to enable the routine, false to disable it.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval 1 if there is no routine with this name.
+ */
+int coreSetHleRoutineEnabled(const char *p_name, bool p_enabled);
+
+/**
+ * @brief Selects the accuracy profile of the selected instance. Instances use
+ *        E_CORE_ACCURACY_CYCLE_EXACT by default, and new instances use the
+ *        profile of the instance selected when they are created.
+ *
+ * @param[in] p_accuracy The accuracy profile to use.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval 1 if the profile does not exist.
+ */
+int coreSetAccuracy(enum te_coreAccuracy p_accuracy);
+
+/**
+ * @brief Returns the accuracy profile of the selected instance.
+ *
+ * @returns The accuracy profile of the selected instance.
+ */
+enum te_coreAccuracy coreGetAccuracy(void);
+
+/**
+ * @brief Sets the rate of the audio samples of the selected instance. The
+ *        rate can be changed at any time, for example to follow the rate at
+ *        which the host consumes the samples.
+ *
+ * @param[in] p_sampleRateHz The sample rate in Hz.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval 1 if the sample rate is 0 or above 96000 Hz.
+ */
+int coreSetAudioSampleRate(uint32_t p_sampleRateHz);
+
+/**
+ * @brief Returns the rate of the audio samples of the selected instance.
+ *
+ * @returns The sample rate in Hz.
+ */
+uint32_t coreGetAudioSampleRate(void);
+
+/**
+ * @brief Runs the core until the cycle budget is spent or one of the given
+ *        events occurs. The event checks are done by the modules that raise
+ *        the events and by the scheduler, so the run loop only tests a flag
+ *        per instruction (plus PC when breakpoints are enabled).
+ * @details The run stops at the end of the step that raised the event: with
+ *          the fast accuracy profile, a step can be a whole recompiled block
+ *          or an iteration of a native routine, so breakpoints are only seen
+ *          at step boundaries and the budget can be exceeded by a few cycles.
+ *
+ * @param[in] p_cycleBudget The maximum number of cycles to run, or 0 for no
+ *                          limit.
+ * @param[in] p_eventMask The te_coreEvent values that end the run, combined
+ *                        with a bitwise OR.
+ * @param[out] p_reason The event that ended the run. If several events occur
+ *                      in the same step, the first one is returned. It can be
+ *                      NULL.
+ */
+void coreRunUntil(
+    uint64_t p_cycleBudget,
+    uint32_t p_eventMask,
+    enum te_coreEvent *p_reason
+);
+
+/**
+ * @brief Adds a PC breakpoint to the selected instance. coreRunUntil() stops
+ *        before executing the instruction at this address when
+ *        E_CORE_EVENT_BREAKPOINT is in the event mask.
+ *
+ * @param[in] p_address The address of the instruction.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval 1 if there are already C_RUN_MAX_BREAKPOINTS breakpoints.
+ */
+int coreAddBreakpoint(uint16_t p_address);
+
+/**
+ * @brief Removes a PC breakpoint from the selected instance.
+ *
+ * @param[in] p_address The address of the instruction.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval 1 if there is no breakpoint at this address.
+ */
+int coreRemoveBreakpoint(uint16_t p_address);
+
+/**
+ * @brief Adds a listener to the selected instance for the given events. The
+ *        listeners of each event are called in the order they were added,
+ *        and each one receives the same data.
+ *
+ * @param[in] p_eventMask The te_coreEvent values to listen to, combined with
+ *                        a bitwise OR.
+ * @param[in] p_listener The function to call.
+ * @param[in] p_context The value passed to the function.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval 1 if one of the events already has C_EVENT_MAX_LISTENERS listeners.
+ *         The listener is not added for any event in that case.
+ */
+int coreAddEventListener(
+    uint32_t p_eventMask,
+    tf_coreEventListener p_listener,
+    void *p_context
+);
+
+/**
+ * @brief Removes a listener added with coreAddEventListener() from all the
+ *        events of the selected instance.
+ *
+ * @param[in] p_listener The function given to coreAddEventListener().
+ * @param[in] p_context The context given to coreAddEventListener().
+ */
+void coreRemoveEventListener(tf_coreEventListener p_listener, void *p_context);
+
+/**
+ * @brief Runs the core until the next VBlank event is triggered, at the end of
+ *        the step during which the LCD panel was refreshed.
  */
 void coreFrameAdvance(void);
 
@@ -126,12 +617,32 @@ void coreSetInput(
 );
 
 /**
- * @brief Gets a pointer to the video buffer of the core.
+ * @brief Renders the frame displayed by the LCD panel, as latched by the last
+ *        refresh, and returns a pointer to the image. The image is only valid
+ *        until the next call from the same thread.
  *
  * @returns A pointer to the video buffer of the core.
  */
 const uint32_t *coreGetVideoBuffer(void);
 
+/**
+ * @brief Renders the frame displayed by the LCD panel into the given buffer,
+ *        so that a front-end can render it directly into its own video
+ *        memory. The pixels are stored as R, G, B, A bytes.
+ *
+ * @param[out] p_buffer The buffer to fill with 64 rows of 96 pixels.
+ * @param[in] p_pitch The number of bytes between the start of two rows.
+ */
+void coreRenderVideo(uint32_t *p_buffer, size_t p_pitch);
+
+/**
+ * @brief Returns a hash of the frame displayed by the LCD panel, so that a
+ *        front-end can check if the frame changed without rendering it.
+ *
+ * @returns The hash of the displayed frame.
+ */
+uint64_t coreGetVideoHash(void);
+
 /**
  * @brief Returns the value of the given core register.
  *
@@ -150,6 +661,23 @@ union tu_coreRegister coreReadRegister(enum te_coreRegister p_register);
  */
 uint8_t coreReadMemory(uint16_t p_address);
 
+/**
+ * @brief Returns a pointer to a memory region of the selected instance, so
+ *        that a front-end can read it without copying it. The pointer remains
+ *        valid until the instance is destroyed, and the contents change as
+ *        the instance runs.
+ *
+ * @param[in] p_region The memory region.
+ * @param[out] p_size The size of the memory region in bytes.
+ *
+ * @returns A pointer to the memory region.
+ * @retval NULL if the region is invalid.
+ */
+const uint8_t *coreGetMemoryRegion(
+    enum te_coreMemoryRegion p_region,
+    size_t *p_size
+);
+
 /**
  * @brief Writes the given value in the given register.
  *
@@ -9,34 +9,27 @@
 #include <string.h>
 
 #include "common.h"
+#include "core/bus.h"
 #include "core/core.h"
+#include "core/eeprom.h"
+#include "core/instance.h"
+#include "core/lcd.h"
+#include "core/port.h"
+#include "core/ram.h"
 #include "core/rom.h"
 
-// =============================================================================
-// Constants declaration
-// =============================================================================
-/**
- * @brief This constant defines the size of the FLASH ROM.
- */
-#define C_FLASH_ROM_SIZE_BYTES 49152
-
-/**
- * @brief This constant defines the size of the EEPROM.
- */
-#define C_EEPROM_SIZE_BYTES 65536
-
 // =============================================================================
 // Private variables declarations
 // =============================================================================
 /**
  * @brief This variable stores a pointer to the FLASH ROM buffer.
  */
-static uint8_t *s_flashRomBuffer;
+static const uint8_t *s_flashRomBuffer;
 
 /**
  * @brief This variable stores a pointer to the EEPROM buffer.
  */
-static uint8_t *s_eepromBuffer;
+static const uint8_t *s_eepromBuffer;
 
 // =============================================================================
 // Private functions declarations
@@ -49,6 +42,16 @@ int corePreinit(void) {
     s_flashRomBuffer = NULL;
     s_eepromBuffer = NULL;
 
+    if(g_coreInstance == NULL) {
+        struct ts_coreInstance *l_instance = coreCreateInstance();
+
+        if(l_instance == NULL) {
+            return 1;
+        }
+
+        coreSelectInstance(l_instance);
+    }
+
     return 0;
 }
 
@@ -58,14 +61,14 @@ int coreInit(void) {
 
 int coreLoadFile(
     enum te_coreFile p_coreFile,
-    uint8_t *p_buffer,
+    const uint8_t *p_buffer,
     size_t p_size
 ) {
     bool l_error = false;
 
     switch(p_coreFile) {
         case E_CORE_FILE_FLASH_ROM:
-            if(p_size != C_FLASH_ROM_SIZE_BYTES) {
+            if(p_size != C_ROM_SIZE_BYTES) {
                 l_error = true;
                 fprintf(stderr, "Error: invalid FLASH ROM file size.\n");
             } else {
@@ -81,6 +84,7 @@ int coreLoadFile(
                 fprintf(stderr, "Error: invalid EEPROM file size.\n");
             } else {
                 s_eepromBuffer = p_buffer;
+                eepromInit(s_eepromBuffer);
             }
 
             break;
@@ -106,22 +110,59 @@ int coreLoadFile(
     return l_returnValue;
 }
 
+uint64_t coreGetFileHash(enum te_coreFile p_coreFile) {
+    if((p_coreFile == E_CORE_FILE_FLASH_ROM) && (s_flashRomBuffer != NULL)) {
+        return romGetHash();
+    } else if((p_coreFile == E_CORE_FILE_EEPROM) && (s_eepromBuffer != NULL)) {
+        return eepromGetHash();
+    }
+
+    return 0U;
+}
+
 int coreSaveFile(
     enum te_coreFile p_coreFile,
     uint8_t *p_buffer,
     size_t p_size
 ) {
-    M_UNUSED_PARAMETER(p_coreFile);
-    M_UNUSED_PARAMETER(p_buffer);
-    M_UNUSED_PARAMETER(p_size);
-
-    // TODO
+    if(p_coreFile == E_CORE_FILE_FLASH_ROM) {
+        const uint8_t *l_data = romGetModifiedData();
+
+        if(l_data == NULL) {
+            l_data = s_flashRomBuffer;
+        }
+
+        if(l_data == NULL) {
+            return -2;
+        } else if(p_size < C_ROM_SIZE_BYTES) {
+            return -1;
+        }
+
+        memcpy(p_buffer, l_data, C_ROM_SIZE_BYTES);
+    } else if(p_coreFile == E_CORE_FILE_EEPROM) {
+        if(p_size < C_EEPROM_SIZE_BYTES) {
+            return -1;
+        }
+
+        eepromCopyData(p_buffer);
+    } else {
+        return -2;
+    }
 
     return 0;
 }
 
+void coreSetInput(
+    enum te_coreInput p_input,
+    enum te_coreInputState p_inputState
+) {
+    portSetInput(p_input, p_inputState == E_CORE_INPUT_PRESSED);
+}
+
 void coreFrameAdvance(void) {
-    // TODO
+    enum te_coreEvent l_reason;
+
+    coreRunUntil(0U, E_CORE_EVENT_VBLANK, &l_reason);
 }
 
 union tu_coreRegister coreReadRegister(enum te_coreRegister p_register) {
@@ -137,11 +178,26 @@ union tu_coreRegister coreReadRegister(enum te_coreRegister p_register) {
 }
 
 uint8_t coreReadMemory(uint16_t p_address) {
-    M_UNUSED_PARAMETER(p_address);
+    return busPeek8(p_address);
+}
 
-    // TODO
+const uint8_t *coreGetMemoryRegion(
+    enum te_coreMemoryRegion p_region,
+    size_t *p_size
+) {
+    switch(p_region) {
+        case E_CORE_MEMORY_REGION_RAM:
+            *p_size = C_RAM_SIZE;
+            return g_coreInstance->state.ram.data;
 
-    return 0;
+        case E_CORE_MEMORY_REGION_FRAME:
+            *p_size = C_LCD_VRAM_SIZE_BYTES;
+            return g_coreInstance->state.lcd.frame;
+
+        default:
+            *p_size = 0U;
+            return NULL;
+    }
 }
 
 void coreWriteRegister(
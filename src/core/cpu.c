@@ -2,10 +2,41 @@
 // File inclusion
 // =============================================================================
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "core/bus.h"
+#include "core/cpu.h"
+#include "core/event.h"
+#include "core/hash.h"
+#include "core/instance.h"
+#include "core/metrics.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This macro gives access to the CPU state of the current instance.
+ */
+#define M_CPU (g_coreInstance->state.cpu)
+
+/**
+ * @brief This macro gives access to the accuracy settings of the current
+ *        instance.
+ */
+#define M_ACCURACY_INSTANCE (g_coreInstance->accuracy)
+
+/**
+ * @brief This macro defines an entry of the opcode handler table.
+ */
+#define M_CPU_OPCODE(name, endsBlock) {#name, cpuOpcode##name, endsBlock}
+
+/**
+ * @brief This constant defines the number of opcode handlers.
+ */
+#define C_CPU_OPCODE_COUNT (sizeof(s_cpuOpcodes) / sizeof(s_cpuOpcodes[0]))
 
 // =============================================================================
 // Private type declarations
@@ -72,51 +103,28 @@ enum te_cpuConditionCode {
     E_CPUCONDITIONCODE_LE,
 };
 
-union tu_cpuGeneralRegister {
-    uint32_t longWord;
-
-    struct {
-        uint16_t r : 16;
-        uint16_t e : 16;
-    } word;
-
-    struct {
-        uint32_t rl : 8;
-        uint32_t rh : 8;
-        uint32_t unused : 16;
-    } byte;
-};
-
-union tu_cpuFlagsRegister {
-    uint8_t byte;
-
-    struct {
-        uint8_t carry : 1;
-        uint8_t overflow : 1;
-        uint8_t zero : 1;
-        uint8_t negative : 1;
-        uint8_t user1 : 1;
-        uint8_t halfCarry : 1;
-        uint8_t user2 : 1;
-        uint8_t interruptMask : 1;
-    } bitField;
-};
-
 typedef void (*tf_opcodeHandler)(void);
 
-// =============================================================================
-// Private variable declarations
-// =============================================================================
-static union tu_cpuFlagsRegister s_cpuFlagsRegister;
-static union tu_cpuGeneralRegister s_cpuGeneralRegisters[8];
-static uint32_t s_cpuRegisterPC;
-
 /**
- * @brief This variable indicates whether the CPU has fetched the reset vector
- *        from ROM.
+ * @brief This structure describes an opcode handler.
  */
-static bool s_cpuInitialized;
-static uint16_t s_cpuOpcodeBuffer[2];
+struct ts_cpuOpcode {
+    /**
+     * @brief This member contains the name of the handler.
+     */
+    const char *name;
+
+    /**
+     * @brief This member contains the handler.
+     */
+    tf_opcodeHandler handler;
+
+    /**
+     * @brief This member indicates whether the handler can change the flow of
+     *        the program, which ends a basic block.
+     */
+    bool endsBlock;
+};
 
 // =============================================================================
 // Private function declarations
@@ -807,28 +815,164 @@ static void cpuOpcodeXorc(void);
  */
 static void cpuOpcodeUndefined(void);
 
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This table lists the opcode handlers. The index of a handler in this
+ *        table identifies it in recompiled code (see cpuExecuteInstruction()).
+ */
+static const struct ts_cpuOpcode s_cpuOpcodes[] = {
+    M_CPU_OPCODE(AddB, false),
+    M_CPU_OPCODE(AddW, false),
+    M_CPU_OPCODE(AddL, false),
+    M_CPU_OPCODE(AddS, false),
+    M_CPU_OPCODE(AddX, false),
+    M_CPU_OPCODE(AndB, false),
+    M_CPU_OPCODE(AndW, false),
+    M_CPU_OPCODE(AndL, false),
+    M_CPU_OPCODE(AndC, false),
+    M_CPU_OPCODE(Band, false),
+    M_CPU_OPCODE(Bcc, true),
+    M_CPU_OPCODE(Bclr, false),
+    M_CPU_OPCODE(Biand, false),
+    M_CPU_OPCODE(Bild, false),
+    M_CPU_OPCODE(Bior, false),
+    M_CPU_OPCODE(Bist, false),
+    M_CPU_OPCODE(Bixor, false),
+    M_CPU_OPCODE(Bld, false),
+    M_CPU_OPCODE(Bnot, false),
+    M_CPU_OPCODE(Bor, false),
+    M_CPU_OPCODE(Bset, false),
+    M_CPU_OPCODE(Bsr, true),
+    M_CPU_OPCODE(Bst, false),
+    M_CPU_OPCODE(Btst, false),
+    M_CPU_OPCODE(Bxor, false),
+    M_CPU_OPCODE(CmpB, false),
+    M_CPU_OPCODE(CmpW, false),
+    M_CPU_OPCODE(CmpL, false),
+    M_CPU_OPCODE(Daa, false),
+    M_CPU_OPCODE(Das, false),
+    M_CPU_OPCODE(DecB, false),
+    M_CPU_OPCODE(DecW, false),
+    M_CPU_OPCODE(DecL, false),
+    M_CPU_OPCODE(DivxsB, false),
+    M_CPU_OPCODE(DivxsW, false),
+    M_CPU_OPCODE(DivxuB, false),
+    M_CPU_OPCODE(DivxuW, false),
+    M_CPU_OPCODE(EepmovB, false),
+    M_CPU_OPCODE(EepmovW, false),
+    M_CPU_OPCODE(ExtsW, false),
+    M_CPU_OPCODE(ExtsL, false),
+    M_CPU_OPCODE(ExtuW, false),
+    M_CPU_OPCODE(ExtuL, false),
+    M_CPU_OPCODE(IncB, false),
+    M_CPU_OPCODE(IncW, false),
+    M_CPU_OPCODE(IncL, false),
+    M_CPU_OPCODE(Jmp, true),
+    M_CPU_OPCODE(Jsr, true),
+    M_CPU_OPCODE(LdcB, false),
+    M_CPU_OPCODE(LdcW, false),
+    M_CPU_OPCODE(MovB1, false),
+    M_CPU_OPCODE(MovW1, false),
+    M_CPU_OPCODE(MovL1, false),
+    M_CPU_OPCODE(MovB2, false),
+    M_CPU_OPCODE(MovW2, false),
+    M_CPU_OPCODE(MovL2, false),
+    M_CPU_OPCODE(MovB3, false),
+    M_CPU_OPCODE(MovW3, false),
+    M_CPU_OPCODE(MovL3, false),
+    M_CPU_OPCODE(Movfpe, false),
+    M_CPU_OPCODE(Movtpe, false),
+    M_CPU_OPCODE(MulxsB, false),
+    M_CPU_OPCODE(MulxsW, false),
+    M_CPU_OPCODE(MulxuB, false),
+    M_CPU_OPCODE(MulxuW, false),
+    M_CPU_OPCODE(NegB, false),
+    M_CPU_OPCODE(NegW, false),
+    M_CPU_OPCODE(NegL, false),
+    M_CPU_OPCODE(Nop, false),
+    M_CPU_OPCODE(NotB, false),
+    M_CPU_OPCODE(NotW, false),
+    M_CPU_OPCODE(NotL, false),
+    M_CPU_OPCODE(OrB, false),
+    M_CPU_OPCODE(OrW, false),
+    M_CPU_OPCODE(OrL, false),
+    M_CPU_OPCODE(Orc, false),
+    M_CPU_OPCODE(RotlB, false),
+    M_CPU_OPCODE(RotlW, false),
+    M_CPU_OPCODE(RotlL, false),
+    M_CPU_OPCODE(RotrB, false),
+    M_CPU_OPCODE(RotrW, false),
+    M_CPU_OPCODE(RotrL, false),
+    M_CPU_OPCODE(RotxlB, false),
+    M_CPU_OPCODE(RotxlW, false),
+    M_CPU_OPCODE(RotxlL, false),
+    M_CPU_OPCODE(RotxrB, false),
+    M_CPU_OPCODE(RotxrW, false),
+    M_CPU_OPCODE(RotxrL, false),
+    M_CPU_OPCODE(Rte, true),
+    M_CPU_OPCODE(Rts, true),
+    M_CPU_OPCODE(ShalB, false),
+    M_CPU_OPCODE(ShalW, false),
+    M_CPU_OPCODE(ShalL, false),
+    M_CPU_OPCODE(SharB, false),
+    M_CPU_OPCODE(SharW, false),
+    M_CPU_OPCODE(SharL, false),
+    M_CPU_OPCODE(ShllB, false),
+    M_CPU_OPCODE(ShllW, false),
+    M_CPU_OPCODE(ShllL, false),
+    M_CPU_OPCODE(ShlrB, false),
+    M_CPU_OPCODE(ShlrW, false),
+    M_CPU_OPCODE(ShlrL, false),
+    M_CPU_OPCODE(Sleep, true),
+    M_CPU_OPCODE(StcB, false),
+    M_CPU_OPCODE(StcW, false),
+    M_CPU_OPCODE(SubB, false),
+    M_CPU_OPCODE(SubW, false),
+    M_CPU_OPCODE(SubL, false),
+    M_CPU_OPCODE(Subs, false),
+    M_CPU_OPCODE(Subx, false),
+    M_CPU_OPCODE(Trapa, true),
+    M_CPU_OPCODE(XorB, false),
+    M_CPU_OPCODE(XorW, false),
+    M_CPU_OPCODE(XorL, false),
+    M_CPU_OPCODE(Xorc, false),
+    M_CPU_OPCODE(Undefined, true)
+};
+
 // =============================================================================
 // Public function definitions
 // =============================================================================
 void cpuReset(void) {
     for(int l_registerIndex = 0; l_registerIndex < 8; l_registerIndex++) {
-        s_cpuGeneralRegisters[l_registerIndex].longWord = 0x00000000U;
+        M_CPU.generalRegisters[l_registerIndex].longWord = 0x00000000U;
     }
 
-    s_cpuFlagsRegister.byte = 0x00U;
-    s_cpuFlagsRegister.bitField.interruptMask = 1;
-    s_cpuRegisterPC = 0x00000000U;
-    s_cpuInitialized = false;
+    M_CPU.flagsRegister.byte = 0x00U;
+    M_CPU.flagsRegister.bitField.interruptMask = 1;
+    M_CPU.registerPC = 0x00000000U;
+    M_CPU.initialized = false;
 }
 
 void coreStep(void) {
-    if(!s_cpuInitialized) {
-        s_cpuRegisterPC = busRead16(0x0000U);
-        s_cpuInitialized = true;
+    if(!M_CPU.initialized) {
+        M_CPU.registerPC = busRead16(0x0000U);
+        M_CPU.initialized = true;
+    }
+
+    if(!M_ACCURACY_INSTANCE.profile->stepNative()) {
+        cpuInterpret();
     }
 
+    M_ACCURACY_INSTANCE.profile->endStep();
+}
+
+void cpuInterpret(void) {
+    M_METRICS_ADD(instructions, 1U);
+
     // Fetch
-    s_cpuOpcodeBuffer[0] = cpuFetch16();
+    M_CPU.opcodeBuffer[0] = cpuFetch16();
 
     // Decode
     tf_opcodeHandler l_opcodeHandler = cpuDecode();
@@ -837,28 +981,127 @@ void coreStep(void) {
     l_opcodeHandler();
 }
 
+uint64_t cpuGetOpcodeTableHash(void) {
+    // The names only change when handlers are added or removed. The build
+    // time also changes when the decoder or a handler is modified.
+    static const char l_buildTime[] = __DATE__ " " __TIME__;
+    uint64_t l_hash = C_HASH_INITIAL_VALUE;
+
+    for(size_t l_index = 0U; l_index < C_CPU_OPCODE_COUNT; l_index++) {
+        const char *l_name = s_cpuOpcodes[l_index].name;
+
+        // The terminating null character separates the names.
+        l_hash = hashUpdate(l_hash, l_name, strlen(l_name) + 1U);
+    }
+
+    return hashUpdate(l_hash, l_buildTime, sizeof(l_buildTime));
+}
+
+void cpuDecodeInstruction(
+    uint16_t p_address,
+    struct ts_cpuInstruction *p_instruction
+) {
+    M_CPU.registerPC = p_address;
+    M_CPU.opcodeBuffer[0] = cpuFetch16();
+    M_CPU.opcodeBuffer[1] = 0x0000U;
+
+    tf_opcodeHandler l_opcodeHandler = cpuDecode();
+    size_t l_index = 0U;
+
+    while(s_cpuOpcodes[l_index].handler != l_opcodeHandler) {
+        l_index++;
+    }
+
+    p_instruction->opcode[0] = M_CPU.opcodeBuffer[0];
+    p_instruction->opcode[1] = M_CPU.opcodeBuffer[1];
+    p_instruction->decodeWordCount = (M_CPU.registerPC - p_address) / 2U;
+    p_instruction->handlerIndex = l_index;
+    p_instruction->endsBlock = s_cpuOpcodes[l_index].endsBlock;
+
+    if(p_instruction->endsBlock) {
+        p_instruction->size = 0U;
+    } else {
+        // The handler reads the remaining words of the instruction, so the
+        // size is measured by executing it. Non-zero register values avoid
+        // divisions by zero.
+        for(int l_registerIndex = 0; l_registerIndex < 8; l_registerIndex++) {
+            M_CPU.generalRegisters[l_registerIndex].longWord = 0x01010101U;
+        }
+
+        l_opcodeHandler();
+
+        p_instruction->size = M_CPU.registerPC - p_address;
+    }
+}
+
+void cpuExecuteInstruction(
+    uint16_t p_opcode0,
+    uint16_t p_opcode1,
+    uint8_t p_decodeWordCount,
+    uint8_t p_handlerIndex
+) {
+    M_METRICS_ADD(instructions, 1U);
+
+    // The words read by cpuDecode() are known in advance, but reading them
+    // still takes one bus cycle each.
+    for(uint8_t l_index = 0U; l_index < p_decodeWordCount; l_index++) {
+        busCycle();
+    }
+
+    M_CPU.registerPC += p_decodeWordCount * 2U;
+    M_CPU.opcodeBuffer[0] = p_opcode0;
+
+    if(p_decodeWordCount > 1U) {
+        M_CPU.opcodeBuffer[1] = p_opcode1;
+    }
+
+    s_cpuOpcodes[p_handlerIndex].handler();
+}
+
+bool cpuStepDecoded(const struct ts_cpuInstruction *p_instruction) {
+    // The instruction does not apply to an instance that has not fetched the
+    // reset vector yet.
+    if(!M_CPU.initialized) {
+        coreStep();
+        return false;
+    }
+
+    if(!M_ACCURACY_INSTANCE.profile->stepNative()) {
+        cpuExecuteInstruction(
+            p_instruction->opcode[0],
+            p_instruction->opcode[1],
+            p_instruction->decodeWordCount,
+            p_instruction->handlerIndex
+        );
+    }
+
+    M_ACCURACY_INSTANCE.profile->endStep();
+
+    return true;
+}
+
 // =============================================================================
 // Private function definitions
 // =============================================================================
 static inline uint16_t cpuFetch16(void) {
-    uint16_t l_returnValue = busRead16(s_cpuRegisterPC);
-    s_cpuRegisterPC += 2;
+    uint16_t l_returnValue = busRead16(M_CPU.registerPC);
+    M_CPU.registerPC += 2;
 
     return l_returnValue;
 }
 
 static inline uint32_t cpuFetch32(void) {
     uint32_t l_returnValue =
-        (busRead16(s_cpuRegisterPC) << 16)
-        | busRead16(s_cpuRegisterPC + 2);
+        (busRead16(M_CPU.registerPC) << 16)
+        | busRead16(M_CPU.registerPC + 2);
 
-    s_cpuRegisterPC += 4;
+    M_CPU.registerPC += 4;
 
     return l_returnValue;
 }
 
 static inline tf_opcodeHandler cpuDecode(void) {
-    switch((uint8_t)(s_cpuOpcodeBuffer[0] >> 8)) {
+    switch((uint8_t)(M_CPU.opcodeBuffer[0] >> 8)) {
         case 0x00: return cpuOpcodeNop;
         case 0x01: return cpuDecodeGroup2();
         case 0x02: return cpuOpcodeStcB;
@@ -963,7 +1206,7 @@ static inline tf_opcodeHandler cpuDecode(void) {
         case 0x65: return cpuOpcodeXorW;
         case 0x66: return cpuOpcodeAndW;
         case 0x67:
-            if((s_cpuOpcodeBuffer[0] & 0x0080) == 0x0000) {
+            if((M_CPU.opcodeBuffer[0] & 0x0080) == 0x0000) {
                 return cpuOpcodeBst;
             } else {
                 return cpuOpcodeBist;
@@ -974,19 +1217,19 @@ static inline tf_opcodeHandler cpuDecode(void) {
         case 0x68:
         case 0x6c:
         case 0x6e:
-            if((s_cpuOpcodeBuffer[0] & 0x0080) == 0x0000) { // MOV.B (EAs), ERd
+            if((M_CPU.opcodeBuffer[0] & 0x0080) == 0x0000) { // MOV.B (EAs), ERd
                 return cpuOpcodeMovB2;
             } else { // MOV.B Rs, (EAd)
                 return cpuOpcodeMovB3;
             }
 
         case 0x6a:
-            if((s_cpuOpcodeBuffer[0] & 0x00c0) == 0x0000) { // MOV.B (EAs), ERd
+            if((M_CPU.opcodeBuffer[0] & 0x00c0) == 0x0000) { // MOV.B (EAs), ERd
                 return cpuOpcodeMovB2;
-            } else if((s_cpuOpcodeBuffer[0] & 0x00c0) == 0x0040) { // MOVFPE
+            } else if((M_CPU.opcodeBuffer[0] & 0x00c0) == 0x0040) { // MOVFPE
                                                                    // @aa:16, Rd
                 return cpuOpcodeMovfpe;
-            } else if((s_cpuOpcodeBuffer[0] & 0x00c0) == 0x0080) { // MOV.B
+            } else if((M_CPU.opcodeBuffer[0] & 0x00c0) == 0x0080) { // MOV.B
                                                                    // (EAs), ERd
                 return cpuOpcodeMovB3;
             } else { // MOVTPE @aa:16, Rd
@@ -997,7 +1240,7 @@ static inline tf_opcodeHandler cpuDecode(void) {
         case 0x6b:
         case 0x6d:
         case 0x6f:
-            if((s_cpuOpcodeBuffer[0] & 0x0080) == 0x0000) { // MOV.W (EAs), ERd
+            if((M_CPU.opcodeBuffer[0] & 0x0080) == 0x0000) { // MOV.W (EAs), ERd
                 return cpuOpcodeMovW2;
             } else { // MOV.W Rs, (EAd)
                 return cpuOpcodeMovW3;
@@ -1009,7 +1252,7 @@ static inline tf_opcodeHandler cpuDecode(void) {
         case 0x72: return cpuOpcodeBclr;
         case 0x73: return cpuOpcodeBtst;
         case 0x74:
-            if((s_cpuOpcodeBuffer[0] & 0x0080) == 0x0000) {
+            if((M_CPU.opcodeBuffer[0] & 0x0080) == 0x0000) {
                 return cpuOpcodeBor;
             } else {
                 return cpuOpcodeBior;
@@ -1018,7 +1261,7 @@ static inline tf_opcodeHandler cpuDecode(void) {
             break;
 
         case 0x75:
-            if((s_cpuOpcodeBuffer[0] & 0x0080) == 0x0000) {
+            if((M_CPU.opcodeBuffer[0] & 0x0080) == 0x0000) {
                 return cpuOpcodeBxor;
             } else {
                 return cpuOpcodeBixor;
@@ -1027,7 +1270,7 @@ static inline tf_opcodeHandler cpuDecode(void) {
             break;
 
         case 0x76:
-            if((s_cpuOpcodeBuffer[0] & 0x0080) == 0x0000) {
+            if((M_CPU.opcodeBuffer[0] & 0x0080) == 0x0000) {
                 return cpuOpcodeBand;
             } else {
                 return cpuOpcodeBiand;
@@ -1036,7 +1279,7 @@ static inline tf_opcodeHandler cpuDecode(void) {
             break;
 
         case 0x77:
-            if((s_cpuOpcodeBuffer[0] & 0x0080) == 0x0000) {
+            if((M_CPU.opcodeBuffer[0] & 0x0080) == 0x0000) {
                 return cpuOpcodeBld;
             } else {
                 return cpuOpcodeBild;
@@ -1045,14 +1288,14 @@ static inline tf_opcodeHandler cpuDecode(void) {
             break;
 
         case 0x78:
-            s_cpuOpcodeBuffer[1] = cpuFetch16();
+            M_CPU.opcodeBuffer[1] = cpuFetch16();
 
-            if((s_cpuOpcodeBuffer[1] & 0xfff0) == 0x6a20) { // MOV.B (EAs), Rd
+            if((M_CPU.opcodeBuffer[1] & 0xfff0) == 0x6a20) { // MOV.B (EAs), Rd
                 return cpuOpcodeMovB2;
-            } else if((s_cpuOpcodeBuffer[1] & 0xfff0) == 0x6aa0) { // MOV.B Rd,
+            } else if((M_CPU.opcodeBuffer[1] & 0xfff0) == 0x6aa0) { // MOV.B Rd,
                                                                  // (EAs)
                 return cpuOpcodeMovB3;
-            } else if((s_cpuOpcodeBuffer[1] & 0xfff0) == 0x6b20) { // MOV.W
+            } else if((M_CPU.opcodeBuffer[1] & 0xfff0) == 0x6b20) { // MOV.W
                                                                    // (EAs), Rd
                 return cpuOpcodeMovW2;
             } else { // MOV.W Rd, (EAs)
@@ -1063,7 +1306,7 @@ static inline tf_opcodeHandler cpuDecode(void) {
         case 0x7b:
             cpuFetch16(); // We don't care about the 3rd and 4th bytes.
 
-            if(s_cpuOpcodeBuffer[0] == 0x7b5c) {
+            if(M_CPU.opcodeBuffer[0] == 0x7b5c) {
                 return cpuOpcodeEepmovB;
             } else {
                 return cpuOpcodeEepmovW;
@@ -1204,19 +1447,19 @@ static inline tf_opcodeHandler cpuDecode(void) {
 }
 
 static inline tf_opcodeHandler cpuDecodeGroup2(void) {
-    switch(s_cpuOpcodeBuffer[0] >> 4) {
+    switch(M_CPU.opcodeBuffer[0] >> 4) {
         case 0x010:
-            s_cpuOpcodeBuffer[1] = cpuFetch16();
+            M_CPU.opcodeBuffer[1] = cpuFetch16();
 
-            if((s_cpuOpcodeBuffer[1] & 0x0080) == 0x0000) { // MOV.L (EAs), ERd
+            if((M_CPU.opcodeBuffer[1] & 0x0080) == 0x0000) { // MOV.L (EAs), ERd
                 return cpuOpcodeMovL2;
             } else { // MOV.L ERd, (EAs)
                 return cpuOpcodeMovL3;
             }
         case 0x014:
-            s_cpuOpcodeBuffer[1] = cpuFetch16();
+            M_CPU.opcodeBuffer[1] = cpuFetch16();
 
-            if((s_cpuOpcodeBuffer[1] & 0x0008) == 0x0000) {
+            if((M_CPU.opcodeBuffer[1] & 0x0008) == 0x0000) {
                 return cpuOpcodeLdcW;
             } else {
                 return cpuOpcodeStcW;
@@ -1351,35 +1594,35 @@ static inline tf_opcodeHandler cpuDecodeGroup2(void) {
 }
 
 static inline tf_opcodeHandler cpuDecodeGroup3(void) {
-    s_cpuOpcodeBuffer[1] = cpuFetch16();
+    M_CPU.opcodeBuffer[1] = cpuFetch16();
 
-    switch(s_cpuOpcodeBuffer[0] >> 8) {
+    switch(M_CPU.opcodeBuffer[0] >> 8) {
         case 0x01:
             if(
-                ((s_cpuOpcodeBuffer[0] & 0x00ff) == 0x00c0)
-                && ((s_cpuOpcodeBuffer[1] & 0xfd00) == 0x5000)
+                ((M_CPU.opcodeBuffer[0] & 0x00ff) == 0x00c0)
+                && ((M_CPU.opcodeBuffer[1] & 0xfd00) == 0x5000)
             ) {
-                if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x5000) { // MULXS.B Rs,
+                if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x5000) { // MULXS.B Rs,
                                                                 // Rd
                     return cpuOpcodeMulxsB;
                 } else { // MULXS.W Rs, Rd
                     return cpuOpcodeMulxsW;
                 }
             } else if(
-                ((s_cpuOpcodeBuffer[0] & 0x00ff) == 0x00d0)
-                && ((s_cpuOpcodeBuffer[1] & 0xfd00) == 0x5100)
+                ((M_CPU.opcodeBuffer[0] & 0x00ff) == 0x00d0)
+                && ((M_CPU.opcodeBuffer[1] & 0xfd00) == 0x5100)
             ) {
-                if((s_cpuOpcodeBuffer[1] & 0x0200) == 0x0000) {
+                if((M_CPU.opcodeBuffer[1] & 0x0200) == 0x0000) {
                     return cpuOpcodeDivxsB;
                 } else {
                     return cpuOpcodeDivxsW;
                 }
-            } else if((s_cpuOpcodeBuffer[0] & 0x00ff) == 0x00f0) {
-                if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6400) {
+            } else if((M_CPU.opcodeBuffer[0] & 0x00ff) == 0x00f0) {
+                if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6400) {
                     return cpuOpcodeOrL;
-                } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6500) {
+                } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6500) {
                     return cpuOpcodeXorL;
-                } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6600) {
+                } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6600) {
                     return cpuOpcodeAndL;
                 }
             }
@@ -1387,31 +1630,31 @@ static inline tf_opcodeHandler cpuDecodeGroup3(void) {
             break;
 
         case 0x7c:
-            if((s_cpuOpcodeBuffer[0] & 0x000f) == 0x0000) {
-                if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6300) {
+            if((M_CPU.opcodeBuffer[0] & 0x000f) == 0x0000) {
+                if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6300) {
                     return cpuOpcodeBtst;
-                } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7300) {
+                } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7300) {
                     return cpuOpcodeBtst;
-                } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7400) {
-                    if((s_cpuOpcodeBuffer[1] & 0x0080) == 0x0000) {
+                } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7400) {
+                    if((M_CPU.opcodeBuffer[1] & 0x0080) == 0x0000) {
                         return cpuOpcodeBor;
                     } else {
                         return cpuOpcodeBior;
                     }
-                } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7500) {
-                    if((s_cpuOpcodeBuffer[1] & 0x0080) == 0x0000) {
+                } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7500) {
+                    if((M_CPU.opcodeBuffer[1] & 0x0080) == 0x0000) {
                         return cpuOpcodeBxor;
                     } else {
                         return cpuOpcodeBixor;
                     }
-                } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7600) {
-                    if((s_cpuOpcodeBuffer[1] & 0x0080) == 0x0000) {
+                } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7600) {
+                    if((M_CPU.opcodeBuffer[1] & 0x0080) == 0x0000) {
                         return cpuOpcodeBand;
                     } else {
                         return cpuOpcodeBiand;
                     }
-                } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7700) {
-                    if((s_cpuOpcodeBuffer[1] & 0x0080) == 0x0000) {
+                } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7700) {
+                    if((M_CPU.opcodeBuffer[1] & 0x0080) == 0x0000) {
                         return cpuOpcodeBld;
                     } else {
                         return cpuOpcodeBild;
@@ -1422,27 +1665,27 @@ static inline tf_opcodeHandler cpuDecodeGroup3(void) {
             break;
 
         case 0x7d:
-            if((s_cpuOpcodeBuffer[0] & 0x000f) == 0x0000) {
-                if((s_cpuOpcodeBuffer[1] & 0xf000) == 0x6000) {
-                    if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0000) {
+            if((M_CPU.opcodeBuffer[0] & 0x000f) == 0x0000) {
+                if((M_CPU.opcodeBuffer[1] & 0xf000) == 0x6000) {
+                    if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0000) {
                         return cpuOpcodeBset;
-                    } else if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0100) {
+                    } else if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0100) {
                         return cpuOpcodeBnot;
-                    } else if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0200) {
+                    } else if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0200) {
                         return cpuOpcodeBclr;
-                    } else if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0700) {
-                        if((s_cpuOpcodeBuffer[1] & 0x0080) == 0x0000) {
+                    } else if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0700) {
+                        if((M_CPU.opcodeBuffer[1] & 0x0080) == 0x0000) {
                             return cpuOpcodeBst;
                         } else {
                             return cpuOpcodeBist;
                         }
                     }
-                } else if((s_cpuOpcodeBuffer[1] & 0xf000) == 0x7000) {
-                    if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0000) {
+                } else if((M_CPU.opcodeBuffer[1] & 0xf000) == 0x7000) {
+                    if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0000) {
                         return cpuOpcodeBset;
-                    } else if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0100) {
+                    } else if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0100) {
                         return cpuOpcodeBnot;
-                    } else if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0200) {
+                    } else if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0200) {
                         return cpuOpcodeBclr;
                     }
                 }
@@ -1451,30 +1694,30 @@ static inline tf_opcodeHandler cpuDecodeGroup3(void) {
             break;
 
         case 0x7e:
-            if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6300) {
+            if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6300) {
                 return cpuOpcodeBtst;
-            } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7300) {
+            } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7300) {
                 return cpuOpcodeBtst;
-            } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7400) {
-                if((s_cpuOpcodeBuffer[1] & 0x0080) == 0x0000) {
+            } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7400) {
+                if((M_CPU.opcodeBuffer[1] & 0x0080) == 0x0000) {
                     return cpuOpcodeBor;
                 } else {
                     return cpuOpcodeBior;
                 }
-            } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7500) {
-                if((s_cpuOpcodeBuffer[1] & 0x0080) == 0x0000) {
+            } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7500) {
+                if((M_CPU.opcodeBuffer[1] & 0x0080) == 0x0000) {
                     return cpuOpcodeBxor;
                 } else {
                     return cpuOpcodeBixor;
                 }
-            } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7600) {
-                if((s_cpuOpcodeBuffer[1] & 0x0080) == 0x0000) {
+            } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7600) {
+                if((M_CPU.opcodeBuffer[1] & 0x0080) == 0x0000) {
                    return cpuOpcodeBand;
                 } else {
                     return cpuOpcodeBiand;
                 }
-            } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7700) {
-                if((s_cpuOpcodeBuffer[1] & 0x0080) == 0x0000) {
+            } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7700) {
+                if((M_CPU.opcodeBuffer[1] & 0x0080) == 0x0000) {
                     return cpuOpcodeBld;
                 } else {
                     return cpuOpcodeBild;
@@ -1484,26 +1727,26 @@ static inline tf_opcodeHandler cpuDecodeGroup3(void) {
             break;
 
         case 0x7f:
-            if((s_cpuOpcodeBuffer[1] & 0xf000) == 0x6000) {
-                if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0000) {
+            if((M_CPU.opcodeBuffer[1] & 0xf000) == 0x6000) {
+                if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0000) {
                     return cpuOpcodeBset;
-                } else if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0100) {
+                } else if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0100) {
                     return cpuOpcodeBnot;
-                } else if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0200) {
+                } else if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0200) {
                     return cpuOpcodeBclr;
-                } else if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0700) {
-                    if((s_cpuOpcodeBuffer[1] & 0x0080) == 0x0000) {
+                } else if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0700) {
+                    if((M_CPU.opcodeBuffer[1] & 0x0080) == 0x0000) {
                         return cpuOpcodeBst;
                     } else {
                         return cpuOpcodeBist;
                     }
                 }
-            } else if((s_cpuOpcodeBuffer[1] & 0xf000) == 0x7000) {
-                if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0000) {
+            } else if((M_CPU.opcodeBuffer[1] & 0xf000) == 0x7000) {
+                if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0000) {
                     return cpuOpcodeBset;
-                } else if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0100) {
+                } else if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0100) {
                     return cpuOpcodeBnot;
-                } else if((s_cpuOpcodeBuffer[1] & 0x0f00) == 0x0200) {
+                } else if((M_CPU.opcodeBuffer[1] & 0x0f00) == 0x0200) {
                     return cpuOpcodeBclr;
                 }
             }
@@ -1519,9 +1762,9 @@ static inline tf_opcodeHandler cpuDecodeGroup3(void) {
 
 static inline uint8_t cpuGetRegister8(enum te_cpuRegister p_register) {
     if((p_register & 0x08U) == 0U) {
-        return (uint8_t)s_cpuGeneralRegisters[p_register & 0x07U].byte.rh;
+        return (uint8_t)M_CPU.generalRegisters[p_register & 0x07U].byte.rh;
     } else {
-        return (uint8_t)s_cpuGeneralRegisters[p_register & 0x07U].byte.rl;
+        return (uint8_t)M_CPU.generalRegisters[p_register & 0x07U].byte.rl;
     }
 }
 
@@ -1530,17 +1773,17 @@ static inline void cpuSetRegister8(
     uint8_t p_value
 ) {
     if((p_register & 0x08U) == 0U) {
-        s_cpuGeneralRegisters[p_register & 0x07U].byte.rh = p_value;
+        M_CPU.generalRegisters[p_register & 0x07U].byte.rh = p_value;
     } else {
-        s_cpuGeneralRegisters[p_register & 0x07U].byte.rl = p_value;
+        M_CPU.generalRegisters[p_register & 0x07U].byte.rl = p_value;
     }
 }
 
 static inline uint16_t cpuGetRegister16(enum te_cpuRegister p_register) {
     if((p_register & 0x08U) == 0U) {
-        return (uint8_t)s_cpuGeneralRegisters[p_register & 0x07U].word.r;
+        return (uint8_t)M_CPU.generalRegisters[p_register & 0x07U].word.r;
     } else {
-        return (uint8_t)s_cpuGeneralRegisters[p_register & 0x07U].word.e;
+        return (uint8_t)M_CPU.generalRegisters[p_register & 0x07U].word.e;
     }
 }
 
@@ -1549,21 +1792,21 @@ static inline void cpuSetRegister16(
     uint16_t p_value
 ) {
     if((p_register & 0x08U) == 0U) {
-        s_cpuGeneralRegisters[p_register & 0x07U].word.r = p_value;
+        M_CPU.generalRegisters[p_register & 0x07U].word.r = p_value;
     } else {
-        s_cpuGeneralRegisters[p_register & 0x07U].word.e = p_value;
+        M_CPU.generalRegisters[p_register & 0x07U].word.e = p_value;
     }
 }
 
 static inline uint32_t cpuGetRegister32(enum te_cpuRegister p_register) {
-    return s_cpuGeneralRegisters[p_register].longWord;
+    return M_CPU.generalRegisters[p_register].longWord;
 }
 
 static inline void cpuSetRegister32(
     enum te_cpuRegister p_register,
     uint32_t p_value
 ) {
-    s_cpuGeneralRegisters[p_register].longWord = p_value;
+    M_CPU.generalRegisters[p_register].longWord = p_value;
 }
 
 static inline bool cpuCheckConditionCode(
@@ -1573,51 +1816,53 @@ static inline bool cpuCheckConditionCode(
         case E_CPUCONDITIONCODE_AL: return true;
         case E_CPUCONDITIONCODE_HI:
             return !(
-                s_cpuFlagsRegister.bitField.carry
-                | s_cpuFlagsRegister.bitField.zero
+                M_CPU.flagsRegister.bitField.carry
+                | M_CPU.flagsRegister.bitField.zero
             );
 
         case E_CPUCONDITIONCODE_LS:
-            return s_cpuFlagsRegister.bitField.carry
-                | s_cpuFlagsRegister.bitField.zero;
+            return M_CPU.flagsRegister.bitField.carry
+                | M_CPU.flagsRegister.bitField.zero;
 
-        case E_CPUCONDITIONCODE_CC: return !s_cpuFlagsRegister.bitField.carry;
-        case E_CPUCONDITIONCODE_CS: return s_cpuFlagsRegister.bitField.carry;
-        case E_CPUCONDITIONCODE_NE: return !s_cpuFlagsRegister.bitField.zero;
-        case E_CPUCONDITIONCODE_EQ: return s_cpuFlagsRegister.bitField.zero;
+        case E_CPUCONDITIONCODE_CC: return !M_CPU.flagsRegister.bitField.carry;
+        case E_CPUCONDITIONCODE_CS: return M_CPU.flagsRegister.bitField.carry;
+        case E_CPUCONDITIONCODE_NE: return !M_CPU.flagsRegister.bitField.zero;
+        case E_CPUCONDITIONCODE_EQ: return M_CPU.flagsRegister.bitField.zero;
         case E_CPUCONDITIONCODE_VC:
-            return !s_cpuFlagsRegister.bitField.overflow;
+            return !M_CPU.flagsRegister.bitField.overflow;
 
-        case E_CPUCONDITIONCODE_VS: return s_cpuFlagsRegister.bitField.overflow;
+        case E_CPUCONDITIONCODE_VS:
+            return M_CPU.flagsRegister.bitField.overflow;
         case E_CPUCONDITIONCODE_PL:
-            return !s_cpuFlagsRegister.bitField.negative;
+            return !M_CPU.flagsRegister.bitField.negative;
 
-        case E_CPUCONDITIONCODE_MI: return s_cpuFlagsRegister.bitField.negative;
+        case E_CPUCONDITIONCODE_MI:
+            return M_CPU.flagsRegister.bitField.negative;
         case E_CPUCONDITIONCODE_GE:
             return !(
-                s_cpuFlagsRegister.bitField.negative
-                ^ s_cpuFlagsRegister.bitField.overflow
+                M_CPU.flagsRegister.bitField.negative
+                ^ M_CPU.flagsRegister.bitField.overflow
             );
 
         case E_CPUCONDITIONCODE_LT:
-            return s_cpuFlagsRegister.bitField.negative
-                ^ s_cpuFlagsRegister.bitField.overflow;
+            return M_CPU.flagsRegister.bitField.negative
+                ^ M_CPU.flagsRegister.bitField.overflow;
 
         case E_CPUCONDITIONCODE_GT:
             return !(
-                s_cpuFlagsRegister.bitField.zero
+                M_CPU.flagsRegister.bitField.zero
                 | (
-                    s_cpuFlagsRegister.bitField.negative
-                    ^ s_cpuFlagsRegister.bitField.overflow
+                    M_CPU.flagsRegister.bitField.negative
+                    ^ M_CPU.flagsRegister.bitField.overflow
                 )
             );
 
         case E_CPUCONDITIONCODE_LE:
             return
-                s_cpuFlagsRegister.bitField.zero
+                M_CPU.flagsRegister.bitField.zero
                 | (
-                    s_cpuFlagsRegister.bitField.negative
-                    ^ s_cpuFlagsRegister.bitField.overflow
+                    M_CPU.flagsRegister.bitField.negative
+                    ^ M_CPU.flagsRegister.bitField.overflow
                 );
 
         default:
@@ -1630,19 +1875,19 @@ static void cpuOpcodeAddB(void) {
     uint8_t l_operand2;
     int l_rd;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x0800) { // ADD.B Rs, Rd
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
-        l_operand1 = cpuGetRegister8((s_cpuOpcodeBuffer[0] & 0x00f0) >> 4);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x0800) { // ADD.B Rs, Rd
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
+        l_operand1 = cpuGetRegister8((M_CPU.opcodeBuffer[0] & 0x00f0) >> 4);
     } else { // ADD.B #xx:8, Rd
-        l_rd = (s_cpuOpcodeBuffer[0] & 0x0f00) >> 8;
-        l_operand1 = s_cpuOpcodeBuffer[0] & 0x00ff;
+        l_rd = (M_CPU.opcodeBuffer[0] & 0x0f00) >> 8;
+        l_operand1 = M_CPU.opcodeBuffer[0] & 0x00ff;
     }
 
     l_operand2 = cpuGetRegister8(l_rd);
 
     uint16_t l_result = l_operand1 + l_operand2;
 
-    s_cpuFlagsRegister.bitField.halfCarry = (
+    M_CPU.flagsRegister.bitField.halfCarry = (
         (
             (
                 (l_operand1 & 0x0f)
@@ -1650,13 +1895,13 @@ static void cpuOpcodeAddB(void) {
             ) & 0x10
         ) != 0
     );
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = (
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = (
         (((l_operand1 ^ l_operand2) & 0x80) == 0)
         && (((l_operand1 ^ l_result) & 0x80) != 0)
     );
-    s_cpuFlagsRegister.bitField.carry = (l_result & 0x0100) != 0;
+    M_CPU.flagsRegister.bitField.carry = (l_result & 0x0100) != 0;
 
     cpuSetRegister8(l_rd, l_result);
 }
@@ -1666,18 +1911,18 @@ static void cpuOpcodeAddW(void) {
     uint16_t l_operand2;
     int l_rd;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x0900) { // ADD.W Rs, Rd
-        l_operand1 = cpuGetRegister16((s_cpuOpcodeBuffer[0] & 0x00f0) >> 4);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x0900) { // ADD.W Rs, Rd
+        l_operand1 = cpuGetRegister16((M_CPU.opcodeBuffer[0] & 0x00f0) >> 4);
     } else { // ADD.W #xx:16, Rd
         l_operand2 = cpuFetch16();
     }
 
-    l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     l_operand2 = cpuGetRegister16(l_rd);
 
     uint32_t l_result = l_operand1 + l_operand2;
 
-    s_cpuFlagsRegister.bitField.halfCarry = (
+    M_CPU.flagsRegister.bitField.halfCarry = (
         (
             (
                 (l_operand1 & 0x0fff)
@@ -1685,13 +1930,13 @@ static void cpuOpcodeAddW(void) {
             ) & 0x1000
         ) != 0
     );
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = (
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = (
         (((l_operand1 ^ l_operand2) & 0x8000) == 0)
         && (((l_operand1 ^ l_result) & 0x8000) != 0)
     );
-    s_cpuFlagsRegister.bitField.carry = (l_result & 0x00010000) != 0;
+    M_CPU.flagsRegister.bitField.carry = (l_result & 0x00010000) != 0;
 
     cpuSetRegister16(l_rd, l_result);
 }
@@ -1701,18 +1946,18 @@ static void cpuOpcodeAddL(void) {
     uint32_t l_operand2;
     int l_erd;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x0900) { // ADD.W Rs, Rd
-        l_operand1 = cpuGetRegister32((s_cpuOpcodeBuffer[0] & 0x00f0) >> 4);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x0900) { // ADD.W Rs, Rd
+        l_operand1 = cpuGetRegister32((M_CPU.opcodeBuffer[0] & 0x00f0) >> 4);
     } else { // ADD.L #xx:32, Rd
         l_operand1 = cpuFetch32();
     }
 
-    l_erd = s_cpuOpcodeBuffer[0] & 0x000f;
+    l_erd = M_CPU.opcodeBuffer[0] & 0x000f;
     l_operand2 = cpuGetRegister32(l_erd);
 
     uint32_t l_result = l_operand1 + l_operand2;
 
-    s_cpuFlagsRegister.bitField.halfCarry = (
+    M_CPU.flagsRegister.bitField.halfCarry = (
         (
             (
                 (l_operand1 & 0x0fffffff)
@@ -1720,51 +1965,51 @@ static void cpuOpcodeAddL(void) {
             ) & 0x10000000
         ) != 0
     );
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = (
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = (
         (((l_operand1 ^ l_operand2) & 0x80000000) == 0)
         && (((l_operand1 ^ l_result) & 0x80000000) != 0)
     );
-    s_cpuFlagsRegister.bitField.carry = l_result < l_operand1;
+    M_CPU.flagsRegister.bitField.carry = l_result < l_operand1;
 
     cpuSetRegister32(l_erd, l_result);
 }
 
 static void cpuOpcodeAddS(void) {
-    int l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    int l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
     int32_t l_erdValue =
-        (int32_t)((int16_t)s_cpuGeneralRegisters[l_erd].word.r);
+        (int32_t)((int16_t)M_CPU.generalRegisters[l_erd].word.r);
 
     int32_t l_operand2;
 
-    if((s_cpuOpcodeBuffer[0] & 0x00f0) == 0x0000) { // ADDS #1, ERd
+    if((M_CPU.opcodeBuffer[0] & 0x00f0) == 0x0000) { // ADDS #1, ERd
         l_operand2 = 1;
-    } else if((s_cpuOpcodeBuffer[0] & 0x00f0) == 0x0080) { // ADDS #2, ERd
+    } else if((M_CPU.opcodeBuffer[0] & 0x00f0) == 0x0080) { // ADDS #2, ERd
         l_operand2 = 2;
-    } else if((s_cpuOpcodeBuffer[0] & 0x00f0) == 0x0090) { // ADDS #4, ERd
+    } else if((M_CPU.opcodeBuffer[0] & 0x00f0) == 0x0090) { // ADDS #4, ERd
         l_operand2 = 4;
     }
 
-    s_cpuGeneralRegisters[l_erd].longWord = l_erdValue + l_operand2;
+    M_CPU.generalRegisters[l_erd].longWord = l_erdValue + l_operand2;
 }
 
 static void cpuOpcodeAddX(void) {
     int l_rd;
     uint8_t l_operand1;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x0e00) { // ADDX #xx:8, Rd
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x0e00) { // ADDX #xx:8, Rd
 
     } else { // ADDX Rs, Rd
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
-        l_operand1 = cpuGetRegister8((s_cpuOpcodeBuffer[0] & 0x00f0) >> 4);
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
+        l_operand1 = cpuGetRegister8((M_CPU.opcodeBuffer[0] & 0x00f0) >> 4);
     }
 
     uint8_t l_operand2 = cpuGetRegister8(l_rd);
-    uint16_t l_carry = s_cpuFlagsRegister.bitField.carry ? 1 : 0;
+    uint16_t l_carry = M_CPU.flagsRegister.bitField.carry ? 1 : 0;
     uint16_t l_result = l_operand1 + l_operand2 + l_carry;
 
-    s_cpuFlagsRegister.bitField.halfCarry = (
+    M_CPU.flagsRegister.bitField.halfCarry = (
         (
             (
                 (l_operand1 & 0x0f)
@@ -1772,13 +2017,13 @@ static void cpuOpcodeAddX(void) {
             ) & 0x10
         ) != 0
     );
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = (
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = (
         (((l_operand1 ^ l_operand2) & 0x80) == 0)
         && (((l_operand1 ^ l_result) & 0x80) != 0)
     );
-    s_cpuFlagsRegister.bitField.carry = (l_result & 0x0100) != 0;
+    M_CPU.flagsRegister.bitField.carry = (l_result & 0x0100) != 0;
 
     cpuSetRegister8(l_rd, l_result);
 }
@@ -1788,21 +2033,21 @@ static void cpuOpcodeAndB(void) {
     uint8_t l_operand2;
     int l_rd;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x1600) { // AND.B Rs, Rd
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
-        l_operand1 = cpuGetRegister8((s_cpuOpcodeBuffer[0] & 0x00f0) >> 4);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x1600) { // AND.B Rs, Rd
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
+        l_operand1 = cpuGetRegister8((M_CPU.opcodeBuffer[0] & 0x00f0) >> 4);
     } else { // AND.B #xx:8, Rd
-        l_rd = (s_cpuOpcodeBuffer[0] & 0x0f00) >> 8;
-        l_operand1 = s_cpuOpcodeBuffer[0] & 0x00ff;
+        l_rd = (M_CPU.opcodeBuffer[0] & 0x0f00) >> 8;
+        l_operand1 = M_CPU.opcodeBuffer[0] & 0x00ff;
     }
 
     l_operand2 = cpuGetRegister8(l_rd);
 
     uint16_t l_result = l_operand1 & l_operand2;
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 
     cpuSetRegister8(l_rd, l_result);
 }
@@ -1812,20 +2057,20 @@ static void cpuOpcodeAndW(void) {
     uint16_t l_operand2;
     int l_rd;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6600) { // AND.W Rs, Rd
-        l_operand1 = cpuGetRegister16((s_cpuOpcodeBuffer[0] & 0x00f0) >> 4);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6600) { // AND.W Rs, Rd
+        l_operand1 = cpuGetRegister16((M_CPU.opcodeBuffer[0] & 0x00f0) >> 4);
     } else { // ADD.W #xx:16, Rd
         l_operand2 = cpuFetch16();
     }
 
-    l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     l_operand2 = cpuGetRegister16(l_rd);
 
     uint32_t l_result = l_operand1 & l_operand2;
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 
     cpuSetRegister16(l_rd, l_result);
 }
@@ -1835,92 +2080,92 @@ static void cpuOpcodeAndL(void) {
     uint32_t l_operand2;
     int l_erd;
 
-    if((s_cpuOpcodeBuffer[0] & 0xfff8) == 0x7a60) { // AND.L ERs, ERd
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
+    if((M_CPU.opcodeBuffer[0] & 0xfff8) == 0x7a60) { // AND.L ERs, ERd
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
 
-        l_operand1 = cpuGetRegister32((s_cpuOpcodeBuffer[1] & 0x0070) >> 4);
-        l_erd = s_cpuOpcodeBuffer[1] & 0x0007;
+        l_operand1 = cpuGetRegister32((M_CPU.opcodeBuffer[1] & 0x0070) >> 4);
+        l_erd = M_CPU.opcodeBuffer[1] & 0x0007;
     } else { // AND.L #xx:32, ERd
         l_operand1 = cpuFetch32();
-        l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+        l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
     }
 
     l_operand2 = cpuGetRegister32(l_erd);
 
     uint32_t l_result = l_operand1 & l_operand2;
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 
     cpuSetRegister32(l_erd, l_result);
 }
 
 static void cpuOpcodeAndC(void) {
-    s_cpuFlagsRegister.byte &= s_cpuOpcodeBuffer[0];
+    M_CPU.flagsRegister.byte &= M_CPU.opcodeBuffer[0];
 }
 
 static void cpuOpcodeBand(void) {
     int l_imm;
     uint8_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7600) { // BAND #xx:3.Rd
-        l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_operand = cpuGetRegister8(s_cpuOpcodeBuffer[0] & 0x000f);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7600) { // BAND #xx:3.Rd
+        l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_operand = cpuGetRegister8(M_CPU.opcodeBuffer[0] & 0x000f);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
-        l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
+        l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
-        if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7c00) { // BAND #xx:3, @ERd
-            int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7c00) { // BAND #xx:3, @ERd
+            int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
             uint32_t l_erdValue = cpuGetRegister32(l_erd);
             l_operand = busRead8(l_erdValue);
         } else { // BAND #xx:3, @aa:8
-            uint32_t l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
+            uint32_t l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
             l_operand = busRead8(l_address);
         }
     }
 
-    s_cpuFlagsRegister.bitField.carry &= (l_operand & (1 << l_imm)) != 0;
+    M_CPU.flagsRegister.bitField.carry &= (l_operand & (1 << l_imm)) != 0;
 }
 
 static void cpuOpcodeBcc(void) {
     enum te_cpuConditionCode l_conditionCode;
     int16_t l_disp;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x5800) {
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x5800) {
         l_disp = cpuFetch16();
-        l_conditionCode = (s_cpuOpcodeBuffer[0] & 0x00f0) >> 4;
+        l_conditionCode = (M_CPU.opcodeBuffer[0] & 0x00f0) >> 4;
     } else {
-        l_disp = (int16_t)((int8_t)s_cpuOpcodeBuffer[0]);
-        l_conditionCode = (s_cpuOpcodeBuffer[0] & 0x0f00) >> 8;
+        l_disp = (int16_t)((int8_t)M_CPU.opcodeBuffer[0]);
+        l_conditionCode = (M_CPU.opcodeBuffer[0] & 0x0f00) >> 8;
     }
 
     if(cpuCheckConditionCode(l_conditionCode)) {
-        s_cpuRegisterPC += l_disp;
+        M_CPU.registerPC += l_disp;
     }
 }
 
 static void cpuOpcodeBclr(void) {
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6200) { // BCLR Rn, Rd
-        int l_rn = (s_cpuOpcodeBuffer[0] & 0x00f0) >> 4;
-        int l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6200) { // BCLR Rn, Rd
+        int l_rn = (M_CPU.opcodeBuffer[0] & 0x00f0) >> 4;
+        int l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         int l_mask = ~(1 << cpuGetRegister8(l_rn));
 
         cpuSetRegister8(l_rd, cpuGetRegister8(l_rd) & l_mask);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7200) { // BCLR #xx:3, Rd
-        int l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        int l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7200) { // BCLR #xx:3, Rd
+        int l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        int l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         int l_mask = ~(1 << l_imm);
 
         cpuSetRegister8(l_rd, cpuGetRegister8(l_rd) & l_mask);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
 
-        if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6200) {
-            if((s_cpuOpcodeBuffer[0] = 0xff00) == 0x7d00) { // BCLR Rn, @ERd
-                int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-                int l_rn = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
+        if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6200) {
+            if((M_CPU.opcodeBuffer[0] = 0xff00) == 0x7d00) { // BCLR Rn, @ERd
+                int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+                int l_rn = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
                 int l_mask = ~(1 << cpuGetRegister8(l_rn));
 
                 busWrite8(
@@ -1928,16 +2173,16 @@ static void cpuOpcodeBclr(void) {
                     busRead8(cpuGetRegister32(l_erd)) & l_mask
                 );
             } else { // BCLR Rn, @aa:8
-                int l_abs = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
-                int l_rn = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
+                int l_abs = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
+                int l_rn = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
                 int l_mask = ~(1 << cpuGetRegister8(l_rn));
 
                 busWrite8(l_abs, busRead8(l_abs) & l_mask);
             }
         } else {
-            if((s_cpuOpcodeBuffer[0] = 0xff00) == 0x7d00) { // BCLR #xx:3, @ERd
-                int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-                int l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+            if((M_CPU.opcodeBuffer[0] = 0xff00) == 0x7d00) { // BCLR #xx:3, @ERd
+                int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+                int l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
                 int l_mask = ~(1 << l_imm);
 
                 busWrite8(
@@ -1945,8 +2190,8 @@ static void cpuOpcodeBclr(void) {
                     busRead8(cpuGetRegister32(l_erd)) & l_mask
                 );
             } else { // BCLR #xx:3, @aa:8
-                int l_abs = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
-                int l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+                int l_abs = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
+                int l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
                 int l_mask = ~(1 << l_imm);
 
                 busWrite8(l_abs, busRead8(l_abs) & l_mask);
@@ -1959,72 +2204,72 @@ static void cpuOpcodeBiand(void) {
     int l_imm;
     uint8_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7600) { // BIAND #xx:3.Rd
-        l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_operand = cpuGetRegister8(s_cpuOpcodeBuffer[0] & 0x000f);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7600) { // BIAND #xx:3.Rd
+        l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_operand = cpuGetRegister8(M_CPU.opcodeBuffer[0] & 0x000f);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
-        l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
+        l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
-        if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7c00) { // BIAND #xx:3, @ERd
-            int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7c00) { // BIAND #xx:3, @ERd
+            int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
             uint32_t l_erdValue = cpuGetRegister32(l_erd);
             l_operand = busRead8(l_erdValue);
         } else { // BIAND #xx:3, @aa:8
-            uint32_t l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
+            uint32_t l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
             l_operand = busRead8(l_address);
         }
     }
 
-    s_cpuFlagsRegister.bitField.carry &= (l_operand & (1 << l_imm)) == 0;
+    M_CPU.flagsRegister.bitField.carry &= (l_operand & (1 << l_imm)) == 0;
 }
 
 static void cpuOpcodeBild(void) {
     int l_imm;
     uint8_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7700) { // BILD #xx:3.Rd
-        l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_operand = cpuGetRegister8(s_cpuOpcodeBuffer[0] & 0x000f);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7700) { // BILD #xx:3.Rd
+        l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_operand = cpuGetRegister8(M_CPU.opcodeBuffer[0] & 0x000f);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
-        l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
+        l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
-        if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7c00) { // BILD #xx:3, @ERd
-            int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7c00) { // BILD #xx:3, @ERd
+            int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
             uint32_t l_erdValue = cpuGetRegister32(l_erd);
             l_operand = busRead8(l_erdValue);
         } else { // BILD #xx:3, @aa:8
-            uint32_t l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
+            uint32_t l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
             l_operand = busRead8(l_address);
         }
     }
 
-    s_cpuFlagsRegister.bitField.carry = (l_operand & (1 << l_imm)) == 0;
+    M_CPU.flagsRegister.bitField.carry = (l_operand & (1 << l_imm)) == 0;
 }
 
 static void cpuOpcodeBior(void) {
     int l_imm;
     uint8_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7400) { // BIOR #xx:3.Rd
-        l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_operand = cpuGetRegister8(s_cpuOpcodeBuffer[0] & 0x000f);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7400) { // BIOR #xx:3.Rd
+        l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_operand = cpuGetRegister8(M_CPU.opcodeBuffer[0] & 0x000f);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
-        l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
+        l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
-        if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7c00) { // BIOR #xx:3, @ERd
-            int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7c00) { // BIOR #xx:3, @ERd
+            int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
             uint32_t l_erdValue = cpuGetRegister32(l_erd);
             l_operand = busRead8(l_erdValue);
         } else { // BIOR #xx:3, @aa:8
-            uint32_t l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
+            uint32_t l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
             l_operand = busRead8(l_address);
         }
     }
 
-    s_cpuFlagsRegister.bitField.carry |= (l_operand & (1 << l_imm)) == 0;
+    M_CPU.flagsRegister.bitField.carry |= (l_operand & (1 << l_imm)) == 0;
 }
 
 static void cpuOpcodeBist(void) {
@@ -2032,31 +2277,31 @@ static void cpuOpcodeBist(void) {
     uint8_t l_operand;
     uint32_t l_address;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6700) { // BIST #xx:3.Rd
-        l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_operand = cpuGetRegister8(s_cpuOpcodeBuffer[0] & 0x000f);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6700) { // BIST #xx:3.Rd
+        l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_operand = cpuGetRegister8(M_CPU.opcodeBuffer[0] & 0x000f);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
-        l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
+        l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
-        if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7d00) { // BIST #xx:3, @ERd
-            int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7d00) { // BIST #xx:3, @ERd
+            int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
             l_address = cpuGetRegister32(l_erd);
             l_operand = busRead8(l_address);
         } else { // BIST #xx:3, @aa:8
-            l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
+            l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
             l_operand = busRead8(l_address);
         }
     }
 
-    if(s_cpuFlagsRegister.bitField.carry) {
+    if(M_CPU.flagsRegister.bitField.carry) {
         l_operand |= 1 << l_imm;
     } else {
         l_operand &= 1 << l_imm;
     }
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6700) { // BIST #xx:3.Rd
-        cpuSetRegister8(s_cpuOpcodeBuffer[0] & 0x000f, l_operand);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6700) { // BIST #xx:3.Rd
+        cpuSetRegister8(M_CPU.opcodeBuffer[0] & 0x000f, l_operand);
     } else { // BIST #xx:3, @Erd or BIST #xx:3, @aa:8
         busWrite8(l_address, l_operand);
     }
@@ -2066,70 +2311,70 @@ static void cpuOpcodeBixor(void) {
     int l_imm;
     uint8_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7500) { // BIXOR #xx:3.Rd
-        l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_operand = cpuGetRegister8(s_cpuOpcodeBuffer[0] & 0x000f);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7500) { // BIXOR #xx:3.Rd
+        l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_operand = cpuGetRegister8(M_CPU.opcodeBuffer[0] & 0x000f);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
-        l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
+        l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
-        if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7c00) { // BIXOR #xx:3, @ERd
-            int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7c00) { // BIXOR #xx:3, @ERd
+            int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
             uint32_t l_erdValue = cpuGetRegister32(l_erd);
             l_operand = busRead8(l_erdValue);
         } else { // BIXOR #xx:3, @aa:8
-            uint32_t l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
+            uint32_t l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
             l_operand = busRead8(l_address);
         }
     }
 
-    s_cpuFlagsRegister.bitField.carry ^= (l_operand & (1 << l_imm)) == 0;
+    M_CPU.flagsRegister.bitField.carry ^= (l_operand & (1 << l_imm)) == 0;
 }
 
 static void cpuOpcodeBld(void) {
     int l_imm;
     uint8_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7700) { // BLD #xx:3.Rd
-        l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_operand = cpuGetRegister8(s_cpuOpcodeBuffer[0] & 0x000f);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7700) { // BLD #xx:3.Rd
+        l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_operand = cpuGetRegister8(M_CPU.opcodeBuffer[0] & 0x000f);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
-        l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
+        l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
-        if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7c00) { // BLD #xx:3, @ERd
-            int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7c00) { // BLD #xx:3, @ERd
+            int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
             uint32_t l_erdValue = cpuGetRegister32(l_erd);
             l_operand = busRead8(l_erdValue);
         } else { // BLD #xx:3, @aa:8
-            uint32_t l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
+            uint32_t l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
             l_operand = busRead8(l_address);
         }
     }
 
-    s_cpuFlagsRegister.bitField.carry = (l_operand & (1 << l_imm)) != 0;
+    M_CPU.flagsRegister.bitField.carry = (l_operand & (1 << l_imm)) != 0;
 }
 
 static void cpuOpcodeBnot(void) {
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6100) { // BNOT Rn, Rd
-        int l_rn = (s_cpuOpcodeBuffer[0] & 0x00f0) >> 4;
-        int l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6100) { // BNOT Rn, Rd
+        int l_rn = (M_CPU.opcodeBuffer[0] & 0x00f0) >> 4;
+        int l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         int l_mask = 1 << cpuGetRegister8(l_rn);
 
         cpuSetRegister8(l_rd, cpuGetRegister8(l_rd) ^ l_mask);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7100) { // BNOT #xx:3, Rd
-        int l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        int l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7100) { // BNOT #xx:3, Rd
+        int l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        int l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         int l_mask = 1 << l_imm;
 
         cpuSetRegister8(l_rd, cpuGetRegister8(l_rd) ^ l_mask);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
 
-        if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6100) {
-            if((s_cpuOpcodeBuffer[0] = 0xff00) == 0x7d00) { // BNOT Rn, @ERd
-                int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-                int l_rn = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
+        if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6100) {
+            if((M_CPU.opcodeBuffer[0] = 0xff00) == 0x7d00) { // BNOT Rn, @ERd
+                int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+                int l_rn = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
                 int l_mask = 1 << cpuGetRegister8(l_rn);
 
                 busWrite8(
@@ -2137,16 +2382,16 @@ static void cpuOpcodeBnot(void) {
                     busRead8(cpuGetRegister32(l_erd)) ^ l_mask
                 );
             } else { // BNOT Rn, @aa:8
-                int l_abs = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
-                int l_rn = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
+                int l_abs = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
+                int l_rn = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
                 int l_mask = 1 << cpuGetRegister8(l_rn);
 
                 busWrite8(l_abs, busRead8(l_abs) ^ l_mask);
             }
         } else {
-            if((s_cpuOpcodeBuffer[0] = 0xff00) == 0x7d00) { // BNOT #xx:3, @ERd
-                int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-                int l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+            if((M_CPU.opcodeBuffer[0] = 0xff00) == 0x7d00) { // BNOT #xx:3, @ERd
+                int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+                int l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
                 int l_mask = 1 << l_imm;
 
                 busWrite8(
@@ -2154,8 +2399,8 @@ static void cpuOpcodeBnot(void) {
                     busRead8(cpuGetRegister32(l_erd)) ^ l_mask
                 );
             } else { // BNOT #xx:3, @aa:8
-                int l_abs = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
-                int l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+                int l_abs = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
+                int l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
                 int l_mask = 1 << l_imm;
 
                 busWrite8(l_abs, busRead8(l_abs) ^ l_mask);
@@ -2168,46 +2413,46 @@ static void cpuOpcodeBor(void) {
     int l_imm;
     uint8_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7400) { // BOR #xx:3, Rd
-        l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_operand = cpuGetRegister8(s_cpuOpcodeBuffer[0] & 0x000f);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7400) { // BOR #xx:3, Rd
+        l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_operand = cpuGetRegister8(M_CPU.opcodeBuffer[0] & 0x000f);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
-        l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
+        l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
-        if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7c00) { // BOR #xx:3, @ERd
-            int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7c00) { // BOR #xx:3, @ERd
+            int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
             uint32_t l_erdValue = cpuGetRegister32(l_erd);
             l_operand = busRead8(l_erdValue);
         } else { // BOR #xx:3, @aa:8
-            uint32_t l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
+            uint32_t l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
             l_operand = busRead8(l_address);
         }
     }
 
-    s_cpuFlagsRegister.bitField.carry |= (l_operand & (1 << l_imm)) != 0;
+    M_CPU.flagsRegister.bitField.carry |= (l_operand & (1 << l_imm)) != 0;
 }
 
 static void cpuOpcodeBset(void) {
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6000) { // BSET Rn, Rd
-        int l_rn = (s_cpuOpcodeBuffer[0] & 0x00f0) >> 4;
-        int l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6000) { // BSET Rn, Rd
+        int l_rn = (M_CPU.opcodeBuffer[0] & 0x00f0) >> 4;
+        int l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         int l_mask = 1 << cpuGetRegister8(l_rn);
 
         cpuSetRegister8(l_rd, cpuGetRegister8(l_rd) | l_mask);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7000) { // BSET #xx:3, Rd
-        int l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        int l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7000) { // BSET #xx:3, Rd
+        int l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        int l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         int l_mask = 1 << l_imm;
 
         cpuSetRegister8(l_rd, cpuGetRegister8(l_rd) | l_mask);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
 
-        if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6000) {
-            if((s_cpuOpcodeBuffer[0] = 0xff00) == 0x7d00) { // BSET Rn, @ERd
-                int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-                int l_rn = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
+        if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6000) {
+            if((M_CPU.opcodeBuffer[0] = 0xff00) == 0x7d00) { // BSET Rn, @ERd
+                int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+                int l_rn = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
                 int l_mask = 1 << cpuGetRegister8(l_rn);
 
                 busWrite8(
@@ -2215,16 +2460,16 @@ static void cpuOpcodeBset(void) {
                     busRead8(cpuGetRegister32(l_erd)) | l_mask
                 );
             } else { // BSET Rn, @aa:8
-                int l_abs = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
-                int l_rn = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
+                int l_abs = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
+                int l_rn = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
                 int l_mask = 1 << cpuGetRegister8(l_rn);
 
                 busWrite8(l_abs, busRead8(l_abs) | l_mask);
             }
         } else {
-            if((s_cpuOpcodeBuffer[0] = 0xff00) == 0x7d00) { // BSET #xx:3, @ERd
-                int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-                int l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+            if((M_CPU.opcodeBuffer[0] = 0xff00) == 0x7d00) { // BSET #xx:3, @ERd
+                int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+                int l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
                 int l_mask = 1 << l_imm;
 
                 busWrite8(
@@ -2232,8 +2477,8 @@ static void cpuOpcodeBset(void) {
                     busRead8(cpuGetRegister32(l_erd)) | l_mask
                 );
             } else { // BSET #xx:3, @aa:8
-                int l_abs = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
-                int l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+                int l_abs = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
+                int l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
                 int l_mask = 1 << l_imm;
 
                 busWrite8(l_abs, busRead8(l_abs) | l_mask);
@@ -2245,50 +2490,50 @@ static void cpuOpcodeBset(void) {
 static void cpuOpcodeBsr(void) {
     uint32_t l_disp;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x5500) { // BSR d:8
-        l_disp = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x5500) { // BSR d:8
+        l_disp = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
     } else { // BSR d:16
         l_disp = 0xffff0000 | cpuFetch16();
     }
 
-    s_cpuGeneralRegisters[E_CPUREGISTER_ER7].longWord -= 2;
+    M_CPU.generalRegisters[E_CPUREGISTER_ER7].longWord -= 2;
 
     busWrite16(
-        s_cpuGeneralRegisters[E_CPUREGISTER_ER7].longWord,
-        s_cpuRegisterPC
+        M_CPU.generalRegisters[E_CPUREGISTER_ER7].longWord,
+        M_CPU.registerPC
     );
 
-    s_cpuRegisterPC += l_disp;
+    M_CPU.registerPC += l_disp;
 }
 
 static void cpuOpcodeBst(void) {
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6700) { // BST #xx:3.Rd
-        int l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        uint8_t l_operand = cpuGetRegister8(s_cpuOpcodeBuffer[0] & 0x000f);
-        uint8_t l_mask = (s_cpuFlagsRegister.bitField.carry ? 1 : 0) << l_imm;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6700) { // BST #xx:3.Rd
+        int l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        uint8_t l_operand = cpuGetRegister8(M_CPU.opcodeBuffer[0] & 0x000f);
+        uint8_t l_mask = (M_CPU.flagsRegister.bitField.carry ? 1 : 0) << l_imm;
 
-        if(s_cpuFlagsRegister.bitField.carry) {
+        if(M_CPU.flagsRegister.bitField.carry) {
             l_operand |= l_mask;
         } else {
             l_operand &= ~l_mask;
         }
 
-        cpuSetRegister8(s_cpuOpcodeBuffer[0] & 0x000f, l_operand);
+        cpuSetRegister8(M_CPU.opcodeBuffer[0] & 0x000f, l_operand);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
-        int l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
+        int l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
         uint8_t l_mask = 1 << l_imm;
         uint32_t l_address;
 
-        if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7d00) { // BST #xx:3, @ERd
-            l_address = cpuGetRegister32((s_cpuOpcodeBuffer[0] & 0x0070) >> 4);
+        if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7d00) { // BST #xx:3, @ERd
+            l_address = cpuGetRegister32((M_CPU.opcodeBuffer[0] & 0x0070) >> 4);
         } else { // BST #xx:3, @aa:8
-            l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
+            l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
         }
 
         uint8_t l_operand = busRead8(l_address);
 
-        if(s_cpuFlagsRegister.bitField.carry) {
+        if(M_CPU.flagsRegister.bitField.carry) {
             l_operand |= l_mask;
         } else {
             l_operand &= ~l_mask;
@@ -2302,45 +2547,45 @@ static void cpuOpcodeBtst(void) {
     uint8_t l_mask;
     uint8_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6300) { // BTST Rn, Rd
-        int l_rn = (s_cpuOpcodeBuffer[0] & 0x00f0) >> 4;
-        int l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6300) { // BTST Rn, Rd
+        int l_rn = (M_CPU.opcodeBuffer[0] & 0x00f0) >> 4;
+        int l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
         l_mask = 1 << cpuGetRegister8(l_rn);
         l_operand = cpuGetRegister8(l_rd);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7300) { // BTST #xx:3, Rd
-        int l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        int l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7300) { // BTST #xx:3, Rd
+        int l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        int l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
         l_mask = 1 << l_imm;
         l_operand = cpuGetRegister8(l_rd);
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
 
-        if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6300) {
-            if((s_cpuOpcodeBuffer[0] = 0xff00) == 0x7c00) { // BTST Rn, @ERd
-                int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-                int l_rn = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
+        if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6300) {
+            if((M_CPU.opcodeBuffer[0] = 0xff00) == 0x7c00) { // BTST Rn, @ERd
+                int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+                int l_rn = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
 
                 l_mask = 1 << cpuGetRegister8(l_rn);
                 l_operand = busRead8(cpuGetRegister32(l_erd));
             } else { // BTST Rn, @aa:8
-                int l_abs = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
-                int l_rn = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
+                int l_abs = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
+                int l_rn = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
 
                 l_mask = 1 << cpuGetRegister8(l_rn);
                 l_operand = busRead8(l_abs);
             }
         } else {
-            if((s_cpuOpcodeBuffer[0] = 0xff00) == 0x7c00) { // BTST #xx:3, @ERd
-                int l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-                int l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+            if((M_CPU.opcodeBuffer[0] = 0xff00) == 0x7c00) { // BTST #xx:3, @ERd
+                int l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+                int l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
                 l_mask = 1 << l_imm;
                 l_operand = busRead8(cpuGetRegister32(l_erd));
             } else { // BTST #xx:3, @aa:8
-                int l_abs = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
-                int l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+                int l_abs = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
+                int l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
                 l_mask = 1 << l_imm;
                 l_operand = busRead8(l_abs);
@@ -2348,7 +2593,7 @@ static void cpuOpcodeBtst(void) {
         }
     }
 
-    s_cpuFlagsRegister.bitField.zero = (l_operand & l_mask) == 0;
+    M_CPU.flagsRegister.bitField.zero = (l_operand & l_mask) == 0;
 }
 
 static void cpuOpcodeBxor(void) {
@@ -2356,155 +2601,155 @@ static void cpuOpcodeBxor(void) {
     uint8_t l_operand;
     uint8_t l_mask;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7500) { // BXOR #xx:3.Rd
-        l_imm = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_operand = cpuGetRegister8(s_cpuOpcodeBuffer[0] & 0x000f);
-        l_mask = s_cpuFlagsRegister.bitField.carry << l_imm;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7500) { // BXOR #xx:3.Rd
+        l_imm = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_operand = cpuGetRegister8(M_CPU.opcodeBuffer[0] & 0x000f);
+        l_mask = M_CPU.flagsRegister.bitField.carry << l_imm;
     } else {
-        s_cpuOpcodeBuffer[1] = cpuFetch16();
-        l_imm = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        M_CPU.opcodeBuffer[1] = cpuFetch16();
+        l_imm = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
         l_mask = 1 << l_imm;
         uint32_t l_address;
 
-        if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7c00) { // BXOR #xx:3, @ERd
-            l_address = cpuGetRegister32((s_cpuOpcodeBuffer[0] & 0x0070) >> 4);
+        if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7c00) { // BXOR #xx:3, @ERd
+            l_address = cpuGetRegister32((M_CPU.opcodeBuffer[0] & 0x0070) >> 4);
         } else { // BXOR #xx:3, @aa:8
-            l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
+            l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
         }
 
         l_operand = busRead8(l_address);
     }
 
-    s_cpuFlagsRegister.bitField.carry ^= ((l_operand & l_mask) != 0) ? 1 : 0;
+    M_CPU.flagsRegister.bitField.carry ^= ((l_operand & l_mask) != 0) ? 1 : 0;
 }
 
 static void cpuOpcodeCmpB(void) {
     uint8_t l_operand;
     enum te_cpuRegister l_rd;
 
-    if((s_cpuOpcodeBuffer[0] & 0xf000) == 0xa000) { // CMP.B #xx:8, Rd
-        l_operand = s_cpuOpcodeBuffer[0];
-        l_rd = (s_cpuOpcodeBuffer[0] & 0x0f00) >> 8;
+    if((M_CPU.opcodeBuffer[0] & 0xf000) == 0xa000) { // CMP.B #xx:8, Rd
+        l_operand = M_CPU.opcodeBuffer[0];
+        l_rd = (M_CPU.opcodeBuffer[0] & 0x0f00) >> 8;
     } else { // CMP.B Rs, Rd
-        l_operand = cpuGetRegister8((s_cpuOpcodeBuffer[0] & 0x00f0) >> 4);
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+        l_operand = cpuGetRegister8((M_CPU.opcodeBuffer[0] & 0x00f0) >> 4);
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     }
 
     uint8_t l_operand2 = cpuGetRegister8(l_rd);
     uint8_t l_result = l_operand2 - l_operand;
 
-    s_cpuFlagsRegister.bitField.halfCarry =
+    M_CPU.flagsRegister.bitField.halfCarry =
         (l_operand & 0x0f) > (l_operand2 & 0x0f);
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         (((l_operand2 ^ l_operand) & ~(l_operand ^ l_result)) & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.carry = l_operand > l_operand2;
+    M_CPU.flagsRegister.bitField.carry = l_operand > l_operand2;
 }
 
 static void cpuOpcodeCmpW(void) {
     uint16_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7900) { // CMP.W #xx:16, Rd
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7900) { // CMP.W #xx:16, Rd
         l_operand = cpuFetch16();
     } else { // CMP.W Rs, Rd
-        l_operand = cpuGetRegister16((s_cpuOpcodeBuffer[0] & 0x00f0) >> 4);
+        l_operand = cpuGetRegister16((M_CPU.opcodeBuffer[0] & 0x00f0) >> 4);
     }
 
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint16_t l_operand2 = cpuGetRegister16(l_rd);
     uint16_t l_result = l_operand2 - l_operand;
 
-    s_cpuFlagsRegister.bitField.halfCarry =
+    M_CPU.flagsRegister.bitField.halfCarry =
         (l_operand & 0x0fff) > (l_operand2 & 0x0fff);
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         (((l_operand2 ^ l_operand) & ~(l_operand ^ l_result)) & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.carry = l_operand > l_operand2;
+    M_CPU.flagsRegister.bitField.carry = l_operand > l_operand2;
 }
 
 static void cpuOpcodeCmpL(void) {
     uint32_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xfff8) == 0x7a20) { // CMP.L #xx:32, ERd
+    if((M_CPU.opcodeBuffer[0] & 0xfff8) == 0x7a20) { // CMP.L #xx:32, ERd
         l_operand = cpuFetch32();
     } else { // CMP.L ERs, ERd
-        l_operand = cpuGetRegister32((s_cpuOpcodeBuffer[0] & 0x0070) >> 4);
+        l_operand = cpuGetRegister32((M_CPU.opcodeBuffer[0] & 0x0070) >> 4);
     }
 
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint32_t l_operand2 = cpuGetRegister32(l_erd);
     uint32_t l_result = l_operand2 - l_operand;
 
-    s_cpuFlagsRegister.bitField.halfCarry =
+    M_CPU.flagsRegister.bitField.halfCarry =
         (l_operand & 0x0fffffff) > (l_operand2 & 0x0fffffff);
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         (((l_operand2 ^ l_operand) & ~(l_operand ^ l_result)) & 0x80000000)
         != 0;
-    s_cpuFlagsRegister.bitField.carry = l_operand > l_operand2;
+    M_CPU.flagsRegister.bitField.carry = l_operand > l_operand2;
 }
 
 static void cpuOpcodeDaa(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint8_t l_operand = cpuGetRegister8(l_rd);
 
-    if(s_cpuFlagsRegister.bitField.carry || (l_operand > 0x99)) {
+    if(M_CPU.flagsRegister.bitField.carry || (l_operand > 0x99)) {
         l_operand += 0x60;
-        s_cpuFlagsRegister.bitField.carry = true;
+        M_CPU.flagsRegister.bitField.carry = true;
     } else {
-        s_cpuFlagsRegister.bitField.carry = false;
+        M_CPU.flagsRegister.bitField.carry = false;
     }
 
-    if(s_cpuFlagsRegister.bitField.halfCarry || (l_operand > 0x09)) {
+    if(M_CPU.flagsRegister.bitField.halfCarry || (l_operand > 0x09)) {
         l_operand += 0x06;
     }
 
-    s_cpuFlagsRegister.bitField.zero = l_operand == 0;
-    s_cpuFlagsRegister.bitField.negative = (l_operand & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_operand == 0;
+    M_CPU.flagsRegister.bitField.negative = (l_operand & 0x80) != 0;
 
     cpuSetRegister8(l_rd, l_operand);
 }
 
 static void cpuOpcodeDas(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint8_t l_operand = cpuGetRegister8(l_rd);
 
-    if(s_cpuFlagsRegister.bitField.halfCarry || ((l_operand & 0x0f) > 9)) {
+    if(M_CPU.flagsRegister.bitField.halfCarry || ((l_operand & 0x0f) > 9)) {
         l_operand -= 6;
     }
 
-    if(s_cpuFlagsRegister.bitField.carry || (l_operand > 0x9f)) {
+    if(M_CPU.flagsRegister.bitField.carry || (l_operand > 0x9f)) {
         l_operand -= 0x60;
     }
 
-    s_cpuFlagsRegister.bitField.zero = l_operand == 0;
-    s_cpuFlagsRegister.bitField.negative = (l_operand & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_operand == 0;
+    M_CPU.flagsRegister.bitField.negative = (l_operand & 0x80) != 0;
 
     cpuSetRegister8(l_rd, l_operand);
 }
 
 static void cpuOpcodeDecB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint8_t l_operand = cpuGetRegister8(l_rd);
 
     l_operand--;
 
-    s_cpuFlagsRegister.bitField.negative = (l_operand & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_operand == 0;
-    s_cpuFlagsRegister.bitField.overflow = l_operand == 0x7f;
+    M_CPU.flagsRegister.bitField.negative = (l_operand & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_operand == 0;
+    M_CPU.flagsRegister.bitField.overflow = l_operand == 0x7f;
 
     cpuSetRegister8(l_rd, l_operand);
 }
 
 static void cpuOpcodeDecW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint16_t l_operand = cpuGetRegister16(l_rd);
     uint16_t l_operand2;
 
-    if((s_cpuOpcodeBuffer[0] & 0xfff0) == 0x1b50) { // DEC.W #1, Rd
+    if((M_CPU.opcodeBuffer[0] & 0xfff0) == 0x1b50) { // DEC.W #1, Rd
         l_operand2 = 1;
     } else { // DEC.W #2, Rd
         l_operand2 = 2;
@@ -2512,18 +2757,20 @@ static void cpuOpcodeDecW(void) {
 
     uint16_t l_result = l_operand - l_operand2;
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    cpuSetRegister16(l_rd, l_result);
+
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         ((l_operand ^ l_result) & 0x8000) != 0;
 }
 
 static void cpuOpcodeDecL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
     uint32_t l_operand = cpuGetRegister32(l_erd);
     uint32_t l_operand2;
 
-    if((s_cpuOpcodeBuffer[0] & 0xfff0) == 0x1b70) { // DEC.L #1, ERd
+    if((M_CPU.opcodeBuffer[0] & 0xfff0) == 0x1b70) { // DEC.L #1, ERd
         l_operand2 = 1;
     } else { // DEC.W #2, Rd
         l_operand2 = 2;
@@ -2531,15 +2778,17 @@ static void cpuOpcodeDecL(void) {
 
     uint32_t l_result = l_operand - l_operand2;
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    cpuSetRegister32(l_erd, l_result);
+
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         ((l_operand ^ l_result) & 0x80000000) != 0;
 }
 
 static void cpuOpcodeDivxsB(void) {
-    enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[1] & 0x000f;
+    enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[1] & 0x000f;
 
     int16_t l_dividend = (int16_t)cpuGetRegister16(l_rd);
     int8_t l_divisor = (int8_t)cpuGetRegister8(l_rs);
@@ -2547,16 +2796,16 @@ static void cpuOpcodeDivxsB(void) {
     int8_t l_quotient = l_dividend / l_divisor;
     int8_t l_remainder = l_dividend % l_divisor;
 
-    s_cpuFlagsRegister.bitField.negative = l_quotient < 0;
-    s_cpuFlagsRegister.bitField.zero = l_quotient == 0;
+    M_CPU.flagsRegister.bitField.negative = l_quotient < 0;
+    M_CPU.flagsRegister.bitField.zero = l_quotient == 0;
 
-    s_cpuGeneralRegisters[l_rd].byte.rl = l_quotient;
-    s_cpuGeneralRegisters[l_rd].byte.rh = l_remainder;
+    M_CPU.generalRegisters[l_rd].byte.rl = l_quotient;
+    M_CPU.generalRegisters[l_rd].byte.rh = l_remainder;
 }
 
 static void cpuOpcodeDivxsW(void) {
-    enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[1] & 0x000f;
+    enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[1] & 0x000f;
 
     int32_t l_dividend = (int16_t)cpuGetRegister32(l_rd);
     int16_t l_divisor = (int8_t)cpuGetRegister16(l_rs);
@@ -2564,16 +2813,16 @@ static void cpuOpcodeDivxsW(void) {
     int16_t l_quotient = l_dividend / l_divisor;
     int16_t l_remainder = l_dividend % l_divisor;
 
-    s_cpuFlagsRegister.bitField.negative = l_quotient < 0;
-    s_cpuFlagsRegister.bitField.zero = l_quotient == 0;
+    M_CPU.flagsRegister.bitField.negative = l_quotient < 0;
+    M_CPU.flagsRegister.bitField.zero = l_quotient == 0;
 
-    s_cpuGeneralRegisters[l_rd].word.r = l_quotient;
-    s_cpuGeneralRegisters[l_rd].word.e = l_remainder;
+    M_CPU.generalRegisters[l_rd].word.r = l_quotient;
+    M_CPU.generalRegisters[l_rd].word.e = l_remainder;
 }
 
 static void cpuOpcodeDivxuB(void) {
-    enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[1] & 0x000f;
+    enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[1] & 0x000f;
 
     uint16_t l_dividend = cpuGetRegister16(l_rd);
     uint8_t l_divisor = cpuGetRegister8(l_rs);
@@ -2581,16 +2830,16 @@ static void cpuOpcodeDivxuB(void) {
     uint8_t l_quotient = l_dividend / l_divisor;
     uint8_t l_remainder = l_dividend % l_divisor;
 
-    s_cpuFlagsRegister.bitField.negative = (l_quotient & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_quotient == 0;
+    M_CPU.flagsRegister.bitField.negative = (l_quotient & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_quotient == 0;
 
-    s_cpuGeneralRegisters[l_rd].byte.rl = l_quotient;
-    s_cpuGeneralRegisters[l_rd].byte.rh = l_remainder;
+    M_CPU.generalRegisters[l_rd].byte.rl = l_quotient;
+    M_CPU.generalRegisters[l_rd].byte.rh = l_remainder;
 }
 
 static void cpuOpcodeDivxuW(void) {
-    enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[1] & 0x000f;
+    enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[1] & 0x000f;
 
     uint32_t l_dividend = cpuGetRegister32(l_rd);
     uint16_t l_divisor = cpuGetRegister16(l_rs);
@@ -2598,118 +2847,118 @@ static void cpuOpcodeDivxuW(void) {
     uint16_t l_quotient = l_dividend / l_divisor;
     uint16_t l_remainder = l_dividend % l_divisor;
 
-    s_cpuFlagsRegister.bitField.negative = (l_quotient & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_quotient == 0;
+    M_CPU.flagsRegister.bitField.negative = (l_quotient & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_quotient == 0;
 
-    s_cpuGeneralRegisters[l_rd].word.r = l_quotient;
-    s_cpuGeneralRegisters[l_rd].word.e = l_remainder;
+    M_CPU.generalRegisters[l_rd].word.r = l_quotient;
+    M_CPU.generalRegisters[l_rd].word.e = l_remainder;
 }
 
 static void cpuOpcodeEepmovB(void) {
     uint32_t l_sourceAddress =
-        s_cpuGeneralRegisters[E_CPUREGISTER_ER5].longWord;
+        M_CPU.generalRegisters[E_CPUREGISTER_ER5].longWord;
     uint32_t l_destinationAddress =
-        s_cpuGeneralRegisters[E_CPUREGISTER_ER6].longWord;
+        M_CPU.generalRegisters[E_CPUREGISTER_ER6].longWord;
 
-    while(s_cpuGeneralRegisters[E_CPUREGISTER_R4].byte.rl != 0) {
+    while(M_CPU.generalRegisters[E_CPUREGISTER_R4].byte.rl != 0) {
         busWrite8(l_destinationAddress, busRead8(l_sourceAddress));
 
         l_destinationAddress++;
         l_sourceAddress++;
 
-        s_cpuGeneralRegisters[E_CPUREGISTER_R4].byte.rl--;
+        M_CPU.generalRegisters[E_CPUREGISTER_R4].byte.rl--;
     }
 
-    s_cpuGeneralRegisters[E_CPUREGISTER_ER5].longWord = l_sourceAddress;
-    s_cpuGeneralRegisters[E_CPUREGISTER_ER6].longWord = l_destinationAddress;
+    M_CPU.generalRegisters[E_CPUREGISTER_ER5].longWord = l_sourceAddress;
+    M_CPU.generalRegisters[E_CPUREGISTER_ER6].longWord = l_destinationAddress;
 }
 
 static void cpuOpcodeEepmovW(void) {
     uint32_t l_sourceAddress =
-        s_cpuGeneralRegisters[E_CPUREGISTER_ER5].longWord;
+        M_CPU.generalRegisters[E_CPUREGISTER_ER5].longWord;
     uint32_t l_destinationAddress =
-        s_cpuGeneralRegisters[E_CPUREGISTER_ER6].longWord;
+        M_CPU.generalRegisters[E_CPUREGISTER_ER6].longWord;
 
-    while(s_cpuGeneralRegisters[E_CPUREGISTER_R4].word.r != 0) {
+    while(M_CPU.generalRegisters[E_CPUREGISTER_R4].word.r != 0) {
         busWrite8(l_destinationAddress, busRead8(l_sourceAddress));
 
         l_destinationAddress++;
         l_sourceAddress++;
 
-        s_cpuGeneralRegisters[E_CPUREGISTER_R4].word.r--;
+        M_CPU.generalRegisters[E_CPUREGISTER_R4].word.r--;
     }
 
-    s_cpuGeneralRegisters[E_CPUREGISTER_ER5].longWord = l_sourceAddress;
-    s_cpuGeneralRegisters[E_CPUREGISTER_ER6].longWord = l_destinationAddress;
+    M_CPU.generalRegisters[E_CPUREGISTER_ER5].longWord = l_sourceAddress;
+    M_CPU.generalRegisters[E_CPUREGISTER_ER6].longWord = l_destinationAddress;
 }
 
 static void cpuOpcodeExtsW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     int16_t l_result = (int8_t)cpuGetRegister16(l_rd);
 
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.negative = l_result < 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.negative = l_result < 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 
     cpuSetRegister16(l_rd, l_result);
 }
 
 static void cpuOpcodeExtsL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
 
     int32_t l_result = (int16_t)cpuGetRegister32(l_erd);
 
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.negative = l_result < 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.negative = l_result < 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 
     cpuSetRegister32(l_erd, l_result);
 }
 
 static void cpuOpcodeExtuW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     uint16_t l_result = (uint8_t)cpuGetRegister16(l_rd);
 
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.negative = false;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.negative = false;
+    M_CPU.flagsRegister.bitField.overflow = false;
 
     cpuSetRegister16(l_rd, l_result);
 }
 
 static void cpuOpcodeExtuL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
 
     uint32_t l_result = (uint16_t)cpuGetRegister32(l_erd);
 
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.negative = false;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.negative = false;
+    M_CPU.flagsRegister.bitField.overflow = false;
 
     cpuSetRegister32(l_erd, l_result);
 }
 
 static void cpuOpcodeIncB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint8_t l_operand = cpuGetRegister8(l_rd);
 
     l_operand--;
 
-    s_cpuFlagsRegister.bitField.negative = (l_operand & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_operand == 0;
-    s_cpuFlagsRegister.bitField.overflow = l_operand == 0x80;
+    M_CPU.flagsRegister.bitField.negative = (l_operand & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_operand == 0;
+    M_CPU.flagsRegister.bitField.overflow = l_operand == 0x80;
 
     cpuSetRegister8(l_rd, l_operand);
 }
 
 static void cpuOpcodeIncW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint16_t l_operand = cpuGetRegister16(l_rd);
     uint16_t l_operand2;
 
-    if((s_cpuOpcodeBuffer[0] & 0xfff0) == 0x0b50) { // INC.W #1, Rd
+    if((M_CPU.opcodeBuffer[0] & 0xfff0) == 0x0b50) { // INC.W #1, Rd
         l_operand2 = 1;
     } else { // INC.W #2, Rd
         l_operand2 = 2;
@@ -2717,18 +2966,20 @@ static void cpuOpcodeIncW(void) {
 
     uint16_t l_result = l_operand + l_operand2;
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    cpuSetRegister16(l_rd, l_result);
+
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         ((l_operand ^ l_result) & 0x8000) != 0;
 }
 
 static void cpuOpcodeIncL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
     uint32_t l_operand = cpuGetRegister32(l_erd);
     uint32_t l_operand2;
 
-    if((s_cpuOpcodeBuffer[0] & 0xfff0) == 0x0b70) { // INC.L #1, ERd
+    if((M_CPU.opcodeBuffer[0] & 0xfff0) == 0x0b70) { // INC.L #1, ERd
         l_operand2 = 1;
     } else { // DEC.W #2, Rd
         l_operand2 = 2;
@@ -2736,319 +2987,327 @@ static void cpuOpcodeIncL(void) {
 
     uint32_t l_result = l_operand + l_operand2;
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    cpuSetRegister32(l_erd, l_result);
+
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         ((l_operand ^ l_result) & 0x80000000) != 0;
 }
 
 static void cpuOpcodeJmp(void) {
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x5900) { // JMP @ERn
-        s_cpuRegisterPC =
-            cpuGetRegister32((s_cpuOpcodeBuffer[0] & 0x0070) >> 4);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x5a00) { // JMP @aa:24
-        s_cpuRegisterPC = ((s_cpuOpcodeBuffer[0] & 0x00ff) << 16)
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x5900) { // JMP @ERn
+        M_CPU.registerPC =
+            cpuGetRegister32((M_CPU.opcodeBuffer[0] & 0x0070) >> 4);
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x5a00) { // JMP @aa:24
+        M_CPU.registerPC = ((M_CPU.opcodeBuffer[0] & 0x00ff) << 16)
             | cpuFetch16();
     } else { // JMP @@aa:8
-        uint32_t l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
-        s_cpuRegisterPC = busRead16(l_address);
+        uint32_t l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
+        M_CPU.registerPC = busRead16(l_address);
     }
 }
 
 static void cpuOpcodeJsr(void) {
-    s_cpuGeneralRegisters[E_CPUREGISTER_ER7].longWord -= 2;
-    busWrite16(
-        s_cpuGeneralRegisters[E_CPUREGISTER_ER7].longWord,
-        s_cpuRegisterPC
-    );
-
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x5d00) { // JSR @ERn
-        s_cpuRegisterPC =
-            cpuGetRegister32((s_cpuOpcodeBuffer[0] & 0x0070) >> 4);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x5e00) { // JSR @aa:24
-        s_cpuRegisterPC = ((s_cpuOpcodeBuffer[0] & 0x00ff) << 16)
+    uint32_t l_targetAddress;
+
+    // The target is read first, so that the return address pushed on the
+    // stack is the address of the next instruction.
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x5d00) { // JSR @ERn
+        l_targetAddress =
+            cpuGetRegister32((M_CPU.opcodeBuffer[0] & 0x0070) >> 4);
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x5e00) { // JSR @aa:24
+        l_targetAddress = ((M_CPU.opcodeBuffer[0] & 0x00ff) << 16)
             | cpuFetch16();
     } else { // JSR @@aa:8
-        uint32_t l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
-        s_cpuRegisterPC = busRead16(l_address);
+        uint32_t l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
+        l_targetAddress = busRead16(l_address);
     }
+
+    M_CPU.generalRegisters[E_CPUREGISTER_ER7].longWord -= 2;
+    busWrite16(
+        M_CPU.generalRegisters[E_CPUREGISTER_ER7].longWord,
+        M_CPU.registerPC
+    );
+
+    M_CPU.registerPC = l_targetAddress;
 }
 
 static void cpuOpcodeLdcB(void) {
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x0700) { // LDC.B #xx:8, CCR
-        s_cpuFlagsRegister.byte = s_cpuOpcodeBuffer[0];
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x0700) { // LDC.B #xx:8, CCR
+        M_CPU.flagsRegister.byte = M_CPU.opcodeBuffer[0];
     } else { // LDC.B Rs, CCR
-        s_cpuFlagsRegister.byte =
-            cpuGetRegister8(s_cpuOpcodeBuffer[0] & 0x000f);
+        M_CPU.flagsRegister.byte =
+            cpuGetRegister8(M_CPU.opcodeBuffer[0] & 0x000f);
     }
 }
 
 static void cpuOpcodeLdcW(void) {
     uint32_t l_address;
 
-    s_cpuOpcodeBuffer[1] = cpuFetch16();
+    M_CPU.opcodeBuffer[1] = cpuFetch16();
 
-    if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6900) { // LDC.W @ERs, CCR
-        l_address = cpuGetRegister32((s_cpuOpcodeBuffer[1] & 0x0070) >> 4);
-    } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6f00) { // LDC.W
+    if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6900) { // LDC.W @ERs, CCR
+        l_address = cpuGetRegister32((M_CPU.opcodeBuffer[1] & 0x0070) >> 4);
+    } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6f00) { // LDC.W
                                                            // @(d:16, ERs), CCR
-        l_address = cpuGetRegister32((s_cpuOpcodeBuffer[1] & 0x0070) >> 4)
+        l_address = cpuGetRegister32((M_CPU.opcodeBuffer[1] & 0x0070) >> 4)
             + cpuFetch16();
-    } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7800) { // LDC.W
+    } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7800) { // LDC.W
                                                            // @(d:24, ERs), CCR
         cpuFetch16(); // Discard useless bytes
 
         uint32_t l_disp = cpuFetch16() << 16;
         l_disp |= cpuFetch16();
 
-        l_address = cpuGetRegister32((s_cpuOpcodeBuffer[1] & 0x0070) >> 4)
+        l_address = cpuGetRegister32((M_CPU.opcodeBuffer[1] & 0x0070) >> 4)
             + l_disp;
-    } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6d00) { // LDC.W @ERs+, CCR
-        enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+    } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6d00) { // LDC.W @ERs+, CCR
+        enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
         l_address = cpuGetRegister32(l_ers);
         cpuSetRegister32(l_ers, l_address + 1);
-    } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6b00) { // LDC.W @aa:16, CCR
+    } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6b00) { // LDC.W @aa:16, CCR
         l_address = cpuFetch16();
     } else { // LDC.W @aa:24, CCR
         l_address = cpuFetch16() << 16;
         l_address |= cpuFetch16();
     }
 
-    s_cpuFlagsRegister.byte = busRead16(l_address);
+    M_CPU.flagsRegister.byte = busRead16(l_address);
 }
 
 static void cpuOpcodeMovB1(void) {
-    uint8_t l_value = cpuGetRegister8((s_cpuOpcodeBuffer[0] & 0x00f0) >> 4);
+    uint8_t l_value = cpuGetRegister8((M_CPU.opcodeBuffer[0] & 0x00f0) >> 4);
 
-    cpuSetRegister8(s_cpuOpcodeBuffer[0] & 0x000f, l_value);
+    cpuSetRegister8(M_CPU.opcodeBuffer[0] & 0x000f, l_value);
 
-    s_cpuFlagsRegister.bitField.negative = (l_value & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_value == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_value & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_value == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeMovW1(void) {
-    uint16_t l_value = cpuGetRegister16((s_cpuOpcodeBuffer[0] & 0x00f0) >> 4);
+    uint16_t l_value = cpuGetRegister16((M_CPU.opcodeBuffer[0] & 0x00f0) >> 4);
 
-    cpuSetRegister16(s_cpuOpcodeBuffer[0] & 0x000f, l_value);
+    cpuSetRegister16(M_CPU.opcodeBuffer[0] & 0x000f, l_value);
 
-    s_cpuFlagsRegister.bitField.negative = (l_value & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_value == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_value & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_value == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeMovL1(void) {
-    uint32_t l_value = cpuGetRegister32((s_cpuOpcodeBuffer[0] & 0x0070) >> 4);
+    uint32_t l_value = cpuGetRegister32((M_CPU.opcodeBuffer[0] & 0x0070) >> 4);
 
-    cpuSetRegister32(s_cpuOpcodeBuffer[0] & 0x0007, l_value);
+    cpuSetRegister32(M_CPU.opcodeBuffer[0] & 0x0007, l_value);
 
-    s_cpuFlagsRegister.bitField.negative = (l_value & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_value == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_value & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_value == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeMovB2(void) {
     uint8_t l_operand;
     enum te_cpuRegister l_rd;
 
-    if((s_cpuOpcodeBuffer[0] & 0xf000) == 0xf000) { // MOV.B #xx:8, Rd
-        l_rd = (s_cpuOpcodeBuffer[0] & 0x0f00) >> 8;
-        l_operand = s_cpuOpcodeBuffer[0];
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6800) { // MOV.B @ERs, Rd
-        enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    if((M_CPU.opcodeBuffer[0] & 0xf000) == 0xf000) { // MOV.B #xx:8, Rd
+        l_rd = (M_CPU.opcodeBuffer[0] & 0x0f00) >> 8;
+        l_operand = M_CPU.opcodeBuffer[0];
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6800) { // MOV.B @ERs, Rd
+        enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
         l_operand = busRead8(cpuGetRegister32(l_ers));
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6e00) { // MOV.B
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6e00) { // MOV.B
                                                            // @(d:16, ERs), Rd
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
-        enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
+        enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
         uint16_t l_disp = cpuFetch16();
         l_operand = busRead8(cpuGetRegister32(l_ers) + l_disp);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7800) { // MOV.B
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7800) { // MOV.B
                                                            // @(d:24, ERs), Rd
-        l_rd = s_cpuOpcodeBuffer[1] & 0x000f;
-        enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        l_rd = M_CPU.opcodeBuffer[1] & 0x000f;
+        enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
         uint32_t l_disp = cpuFetch32();
 
         l_operand = busRead8(cpuGetRegister32(l_ers) + l_disp);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6c00) { // MOV.B @ERs+, Rd
-        enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6c00) { // MOV.B @ERs+, Rd
+        enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
         uint32_t l_address = cpuGetRegister32(l_ers);
         l_operand = busRead8(l_address);
 
         cpuSetRegister32(l_ers, l_address + 1);
-    } else if((s_cpuOpcodeBuffer[0] & 0xf000) == 0x2000) { // MOV.B @aa:8, Rd
-        l_rd = (s_cpuOpcodeBuffer[0] & 0x0f00) >> 8;
-        uint32_t l_address = 0xffffff00 | s_cpuOpcodeBuffer[0];
+    } else if((M_CPU.opcodeBuffer[0] & 0xf000) == 0x2000) { // MOV.B @aa:8, Rd
+        l_rd = (M_CPU.opcodeBuffer[0] & 0x0f00) >> 8;
+        uint32_t l_address = 0xffffff00 | M_CPU.opcodeBuffer[0];
 
         l_operand = busRead8(l_address);
-    } else if((s_cpuOpcodeBuffer[0] & 0xfff0) == 0x6a00) { // MOV.B @aa:16, Rd
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    } else if((M_CPU.opcodeBuffer[0] & 0xfff0) == 0x6a00) { // MOV.B @aa:16, Rd
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         l_operand = busRead8(cpuFetch16());
     } else { // MOV.B @aa:24, Rd
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         l_operand = busRead8(cpuFetch32());
     }
 
     cpuSetRegister8(l_rd, l_operand);
 
-    s_cpuFlagsRegister.bitField.negative = (l_operand & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_operand == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_operand & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_operand == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeMovW2(void) {
     uint16_t l_operand;
     enum te_cpuRegister l_rd;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7900) { // MOV.W #xx:16, Rd
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7900) { // MOV.W #xx:16, Rd
         l_operand = cpuFetch16();
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6900) { // MOV.W @ERs, Rd
-        enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6900) { // MOV.W @ERs, Rd
+        enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
         l_operand = busRead16(cpuGetRegister32(l_ers));
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6f00) { // MOV.W
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6f00) { // MOV.W
                                                            // @(d:16, ERs), Rd
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
-        enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
+        enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
         uint16_t l_disp = cpuFetch16();
         l_operand = busRead16(cpuGetRegister32(l_ers) + l_disp);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7800) { // MOV.W
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7800) { // MOV.W
                                                            // @(d:24, ERs), Rd
-        l_rd = s_cpuOpcodeBuffer[1] & 0x000f;
-        enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        l_rd = M_CPU.opcodeBuffer[1] & 0x000f;
+        enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
         uint32_t l_disp = cpuFetch32();
 
         l_operand = busRead16(cpuGetRegister32(l_ers) + l_disp);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6d00) { // MOV.W @ERs+, Rd
-        enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6d00) { // MOV.W @ERs+, Rd
+        enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
         uint32_t l_address = cpuGetRegister32(l_ers);
         l_operand = busRead16(l_address);
 
         cpuSetRegister32(l_ers, l_address + 2);
-    } else if((s_cpuOpcodeBuffer[0] & 0xfff0) == 0x6b00) { // MOV.W @aa:16, Rd
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    } else if((M_CPU.opcodeBuffer[0] & 0xfff0) == 0x6b00) { // MOV.W @aa:16, Rd
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         l_operand = busRead16(cpuFetch16());
     } else { // MOV.W @aa:24, Rd
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         l_operand = busRead16(cpuFetch32());
     }
 
     cpuSetRegister16(l_rd, l_operand);
 
-    s_cpuFlagsRegister.bitField.negative = (l_operand & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_operand == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_operand & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_operand == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeMovL2(void) {
     uint32_t l_operand;
     enum te_cpuRegister l_erd;
 
-    if(s_cpuOpcodeBuffer[0] == 0x0100) {
-        if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6900) { // MOV.L @ERs, ERd
-            enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
-            l_erd = s_cpuOpcodeBuffer[1] & 0x0007;
+    if(M_CPU.opcodeBuffer[0] == 0x0100) {
+        if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6900) { // MOV.L @ERs, ERd
+            enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
+            l_erd = M_CPU.opcodeBuffer[1] & 0x0007;
 
             l_operand = busRead32(cpuGetRegister32(l_ers));
-        } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6f00) { // MOV.L
+        } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6f00) { // MOV.L
                                                                // @(d:16, ERs),
                                                                // ERd
-            l_erd = s_cpuOpcodeBuffer[1] & 0x0007;
-            enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+            l_erd = M_CPU.opcodeBuffer[1] & 0x0007;
+            enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
             uint16_t l_disp = cpuFetch16();
             l_operand = busRead32(cpuGetRegister32(l_ers) + l_disp);
-        } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7800) { // MOV.L
+        } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7800) { // MOV.L
                                                                // @(d:24, ERs),
                                                                // ERd
-            l_erd = s_cpuOpcodeBuffer[1] & 0x0007;
-            enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+            l_erd = M_CPU.opcodeBuffer[1] & 0x0007;
+            enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
             uint32_t l_disp = cpuFetch32();
 
             l_operand = busRead32(cpuGetRegister32(l_ers) + l_disp);
-        } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6d00) { // MOV.L @ERs+,
+        } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6d00) { // MOV.L @ERs+,
                                                                // ERd
-            enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
-            l_erd = s_cpuOpcodeBuffer[1] & 0x0007;
+            enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
+            l_erd = M_CPU.opcodeBuffer[1] & 0x0007;
 
             uint32_t l_address = cpuGetRegister32(l_ers);
             l_operand = busRead32(l_address);
 
             cpuSetRegister32(l_ers, l_address + 4);
-        } else if((s_cpuOpcodeBuffer[1] & 0xfff0) == 0x6b00) { // MOV.L @aa:16,
+        } else if((M_CPU.opcodeBuffer[1] & 0xfff0) == 0x6b00) { // MOV.L @aa:16,
                                                                // ERd
-            l_erd = s_cpuOpcodeBuffer[1] & 0x0007;
+            l_erd = M_CPU.opcodeBuffer[1] & 0x0007;
             l_operand = busRead32(cpuFetch16());
         } else { // MOV.L @aa:24, ERd
-            l_erd = s_cpuOpcodeBuffer[1] & 0x0007;
+            l_erd = M_CPU.opcodeBuffer[1] & 0x0007;
             l_operand = busRead32(cpuFetch32());
         }
     } else { // MOV.L #xx:32, ERd
-        l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+        l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
         l_operand = cpuFetch32();
     }
 
     cpuSetRegister32(l_erd, l_operand);
 
-    s_cpuFlagsRegister.bitField.negative = (l_operand & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_operand == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_operand & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_operand == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeMovB3(void) {
     enum te_cpuRegister l_rs;
     uint32_t l_address;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6800) { // MOV.B Rs, @ERd
-        l_rs = s_cpuOpcodeBuffer[0] & 0x000f;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6800) { // MOV.B Rs, @ERd
+        l_rs = M_CPU.opcodeBuffer[0] & 0x000f;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
 
         l_address = cpuGetRegister32(l_erd);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6e00) { // MOV.B Rs,
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6e00) { // MOV.B Rs,
                                                            // @(d:16, ERd)
-        l_rs = s_cpuOpcodeBuffer[0] & 0x000f;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        l_rs = M_CPU.opcodeBuffer[0] & 0x000f;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
         uint16_t l_disp = cpuFetch16();
 
         l_address = cpuGetRegister32(l_erd) + l_disp;
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7800) { // MOV.B Rs,
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7800) { // MOV.B Rs,
                                                            // @(d:24, ERd)
-        l_rs = s_cpuOpcodeBuffer[1] & 0x000f;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        l_rs = M_CPU.opcodeBuffer[1] & 0x000f;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
         uint32_t l_disp = cpuFetch32();
 
         l_address = cpuGetRegister32(l_erd) + l_disp;
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6c00) { // MOV.B Rs, @-ERd
-        l_rs = s_cpuOpcodeBuffer[0] & 0x000f;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6c00) { // MOV.B Rs, @-ERd
+        l_rs = M_CPU.opcodeBuffer[0] & 0x000f;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
         l_address = cpuGetRegister32(l_erd);
 
         l_address--;
 
         cpuSetRegister32(l_erd, l_address);
-    } else if((s_cpuOpcodeBuffer[0] & 0xf000) == 0x3000) { // MOV.B Rs, @aa:8
-        l_rs = (s_cpuOpcodeBuffer[0] & 0x0f00) >> 16;
-        l_address = 0xffffff00 | (s_cpuOpcodeBuffer[0] & 0x00ff);
-    } else if((s_cpuOpcodeBuffer[0] & 0xfff0) == 0x6a80) { // MOV.B Rs, @aa:16
-        l_rs = s_cpuOpcodeBuffer[0] & 0x000f;
+    } else if((M_CPU.opcodeBuffer[0] & 0xf000) == 0x3000) { // MOV.B Rs, @aa:8
+        l_rs = (M_CPU.opcodeBuffer[0] & 0x0f00) >> 8;
+        l_address = 0xffffff00 | (M_CPU.opcodeBuffer[0] & 0x00ff);
+    } else if((M_CPU.opcodeBuffer[0] & 0xfff0) == 0x6a80) { // MOV.B Rs, @aa:16
+        l_rs = M_CPU.opcodeBuffer[0] & 0x000f;
         l_address = 0xffff0000 | cpuFetch16();
     } else { // MOV.B Rs, @aa:24
-        l_rs = s_cpuOpcodeBuffer[0] & 0x000f;
+        l_rs = M_CPU.opcodeBuffer[0] & 0x000f;
         l_address = cpuFetch32();
     }
 
     uint8_t l_operand = cpuGetRegister8(l_rs);
 
-    s_cpuFlagsRegister.bitField.negative = (l_operand & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_operand == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_operand & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_operand == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 
     busWrite8(l_address, l_operand);
 }
@@ -3057,42 +3316,42 @@ static void cpuOpcodeMovW3(void) {
     enum te_cpuRegister l_rs;
     uint32_t l_address;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6900) { // MOV.W Rs, @ERd
-        l_rs = s_cpuOpcodeBuffer[0] & 0x000f;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6900) { // MOV.W Rs, @ERd
+        l_rs = M_CPU.opcodeBuffer[0] & 0x000f;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
 
         l_address = cpuGetRegister32(l_erd);
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6f00) { // MOV.W Rs,
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6f00) { // MOV.W Rs,
                                                            // @(d:16, ERd)
-        l_rs = s_cpuOpcodeBuffer[0] & 0x000f;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        l_rs = M_CPU.opcodeBuffer[0] & 0x000f;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
         l_address = cpuGetRegister32(l_erd) + cpuFetch16();
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7800) { // MOV.W Rs,
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7800) { // MOV.W Rs,
                                                            // @(d:24, ERd)
-        l_rs = s_cpuOpcodeBuffer[1] & 0x000f;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+        l_rs = M_CPU.opcodeBuffer[1] & 0x000f;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
         l_address = cpuGetRegister32(l_erd) + cpuFetch32();
-    } else if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6d00) { // MOV.W Rs, @-ERd
-        l_rs = s_cpuOpcodeBuffer[0] & 0x000f;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[0] & 0x0070) >> 4;
+    } else if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6d00) { // MOV.W Rs, @-ERd
+        l_rs = M_CPU.opcodeBuffer[0] & 0x000f;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[0] & 0x0070) >> 4;
         l_address = cpuGetRegister32(l_erd);
 
         l_address -= 2;
 
         cpuSetRegister32(l_erd, l_address);
-    } else if((s_cpuOpcodeBuffer[0] & 0xfff0) == 0x6b80) { // MOV.W Rs, @aa:16
-        l_rs = s_cpuOpcodeBuffer[0] & 0x000f;
+    } else if((M_CPU.opcodeBuffer[0] & 0xfff0) == 0x6b80) { // MOV.W Rs, @aa:16
+        l_rs = M_CPU.opcodeBuffer[0] & 0x000f;
         l_address = cpuFetch16();
     } else { // MOV.W Rs, @aa:24
-        l_rs = s_cpuOpcodeBuffer[0] & 0x000f;
+        l_rs = M_CPU.opcodeBuffer[0] & 0x000f;
         l_address = cpuFetch32();
     }
 
     uint16_t l_operand = cpuGetRegister16(l_rs);
 
-    s_cpuFlagsRegister.bitField.negative = (l_operand & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_operand == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_operand & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_operand == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 
     busWrite16(l_address, l_operand);
 }
@@ -3101,76 +3360,76 @@ static void cpuOpcodeMovL3(void) {
     enum te_cpuRegister l_ers;
     uint32_t l_address;
 
-    if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6900) { // MOV.L ERs, @ERd
-        l_ers = s_cpuOpcodeBuffer[1] & 0x0007;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+    if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6900) { // MOV.L ERs, @ERd
+        l_ers = M_CPU.opcodeBuffer[1] & 0x0007;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
         l_address = cpuGetRegister32(l_erd);
-    } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6f00) { // MOV.L ERs,
+    } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6f00) { // MOV.L ERs,
                                                            // @(d:16, ERd)
-        l_ers = s_cpuOpcodeBuffer[1] & 0x0007;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        l_ers = M_CPU.opcodeBuffer[1] & 0x0007;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
         l_address = cpuGetRegister32(l_erd) + cpuFetch16();
-    } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7800) { // MOV.L ERs,
+    } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7800) { // MOV.L ERs,
                                                            // @(d:24, ERd)
-        l_ers = s_cpuOpcodeBuffer[2] & 0x0007;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+        l_ers = M_CPU.opcodeBuffer[2] & 0x0007;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
 
         l_address = cpuGetRegister32(l_erd) + cpuFetch32();
-    } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6d00) { // MOV.L ERs, @-ERd
-        l_ers = s_cpuOpcodeBuffer[2] & 0x0007;
-        enum te_cpuRegister l_erd = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
+    } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6d00) { // MOV.L ERs, @-ERd
+        l_ers = M_CPU.opcodeBuffer[2] & 0x0007;
+        enum te_cpuRegister l_erd = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
         l_address = cpuGetRegister32(l_erd);
 
         l_address -= 4;
 
         cpuSetRegister32(l_erd, l_address);
-    } else if((s_cpuOpcodeBuffer[1] & 0xfff0) == 0x6b80) { // MOV.L ERs, @aa:16
-        l_ers = s_cpuOpcodeBuffer[2] & 0x0007;
+    } else if((M_CPU.opcodeBuffer[1] & 0xfff0) == 0x6b80) { // MOV.L ERs, @aa:16
+        l_ers = M_CPU.opcodeBuffer[2] & 0x0007;
         l_address = cpuFetch16();
     } else { // MOV.L ERs, @aa:24
-        l_ers = s_cpuOpcodeBuffer[2] & 0x0007;
+        l_ers = M_CPU.opcodeBuffer[2] & 0x0007;
         l_address = cpuFetch32();
     }
 
     uint32_t l_operand = cpuGetRegister32(l_ers);
 
-    s_cpuFlagsRegister.bitField.negative = (l_operand & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_operand == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_operand & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_operand == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 
     busWrite32(l_address, l_operand);
 }
 
 static void cpuOpcodeMovfpe(void) {
     uint16_t l_address = cpuFetch16();
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     uint8_t l_value = busRead8(l_address);
 
     cpuSetRegister8(l_rd, l_value);
 
-    s_cpuFlagsRegister.bitField.negative = (l_value & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_value == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_value & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_value == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeMovtpe(void) {
     uint16_t l_address = cpuFetch16();
-    enum te_cpuRegister l_rs = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rs = M_CPU.opcodeBuffer[0] & 0x000f;
 
     uint8_t l_value = cpuGetRegister8(l_rs);
 
     busWrite8(l_address, l_value);
 
-    s_cpuFlagsRegister.bitField.negative = (l_value & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_value == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_value & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_value == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeMulxsB(void) {
-    enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[1] & 0x000f;
+    enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[1] & 0x000f;
 
     int8_t l_multiplicand = cpuGetRegister16(l_rd);
     int8_t l_multiplier = cpuGetRegister8(l_rs);
@@ -3178,27 +3437,27 @@ static void cpuOpcodeMulxsB(void) {
 
     cpuSetRegister16(l_rd, l_product);
 
-    s_cpuFlagsRegister.bitField.negative = l_product < 0;
-    s_cpuFlagsRegister.bitField.zero = l_product == 0;
+    M_CPU.flagsRegister.bitField.negative = l_product < 0;
+    M_CPU.flagsRegister.bitField.zero = l_product == 0;
 }
 
 static void cpuOpcodeMulxsW(void) {
-    enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[1] & 0x0007;
+    enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[1] & 0x0007;
 
     int16_t l_multiplicand = cpuGetRegister32(l_erd);
     int16_t l_multiplier = cpuGetRegister16(l_rs);
     int32_t l_product = l_multiplicand * l_multiplier;
 
-    s_cpuFlagsRegister.bitField.negative = l_product < 0;
-    s_cpuFlagsRegister.bitField.zero = l_product == 0;
+    M_CPU.flagsRegister.bitField.negative = l_product < 0;
+    M_CPU.flagsRegister.bitField.zero = l_product == 0;
 
     cpuSetRegister32(l_erd, l_product);
 }
 
 static void cpuOpcodeMulxuB(void) {
-    enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[1] & 0x000f;
+    enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[1] & 0x000f;
 
     uint8_t l_multiplicand = cpuGetRegister16(l_rd);
     uint8_t l_multiplier = cpuGetRegister8(l_rs);
@@ -3208,8 +3467,8 @@ static void cpuOpcodeMulxuB(void) {
 }
 
 static void cpuOpcodeMulxuW(void) {
-    enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[1] & 0x00f0) >> 4;
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[1] & 0x0007;
+    enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[1] & 0x00f0) >> 4;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[1] & 0x0007;
 
     uint16_t l_multiplicand = cpuGetRegister32(l_erd);
     uint16_t l_multiplier = cpuGetRegister16(l_rs);
@@ -3219,51 +3478,51 @@ static void cpuOpcodeMulxuW(void) {
 }
 
 static void cpuOpcodeNegB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     int8_t l_rdValue = cpuGetRegister8(l_rd);
     int8_t l_result = -l_rdValue;
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.halfCarry = (l_rdValue & 0x0f) != 0;
-    s_cpuFlagsRegister.bitField.negative = l_result < 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.halfCarry = (l_rdValue & 0x0f) != 0;
+    M_CPU.flagsRegister.bitField.negative = l_result < 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         ((l_rdValue & ~(l_rdValue ^ l_result)) & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.carry = l_rdValue > 0;
+    M_CPU.flagsRegister.bitField.carry = l_rdValue > 0;
 }
 
 static void cpuOpcodeNegW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     int16_t l_rdValue = cpuGetRegister16(l_rd);
     int16_t l_result = -l_rdValue;
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.halfCarry = (l_rdValue & 0x0fff) != 0;
-    s_cpuFlagsRegister.bitField.negative = l_result < 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.halfCarry = (l_rdValue & 0x0fff) != 0;
+    M_CPU.flagsRegister.bitField.negative = l_result < 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         ((l_rdValue & ~(l_rdValue ^ l_result)) & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.carry = l_rdValue > 0;
+    M_CPU.flagsRegister.bitField.carry = l_rdValue > 0;
 }
 
 static void cpuOpcodeNegL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
 
     int32_t l_rdValue = cpuGetRegister32(l_erd);
     int32_t l_result = -l_rdValue;
 
     cpuSetRegister32(l_erd, l_result);
 
-    s_cpuFlagsRegister.bitField.halfCarry = (l_rdValue & 0x0fffffff) != 0;
-    s_cpuFlagsRegister.bitField.negative = l_result < 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.halfCarry = (l_rdValue & 0x0fffffff) != 0;
+    M_CPU.flagsRegister.bitField.negative = l_result < 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         ((l_rdValue & ~(l_rdValue ^ l_result)) & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.carry = l_rdValue > 0;
+    M_CPU.flagsRegister.bitField.carry = l_rdValue > 0;
 }
 
 static void cpuOpcodeNop(void) {
@@ -3271,55 +3530,55 @@ static void cpuOpcodeNop(void) {
 }
 
 static void cpuOpcodeNotB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     uint8_t l_rdValue = cpuGetRegister8(l_rd);
     uint8_t l_result = ~l_rdValue;
 
     cpuSetRegister8(l_rd, l_rdValue);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeNotW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     uint16_t l_rdValue = cpuGetRegister16(l_rd);
     uint16_t l_result = ~l_rdValue;
 
     cpuSetRegister8(l_rd, l_rdValue);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeNotL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     uint8_t l_erdValue = cpuGetRegister32(l_erd);
     uint8_t l_result = ~l_erdValue;
 
     cpuSetRegister32(l_erd, l_erdValue);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeOrB(void) {
     enum te_cpuRegister l_rd;
     uint8_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x1400) {
-        enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[0] & 0x00f0) >> 4;
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x1400) {
+        enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[0] & 0x00f0) >> 4;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         l_operand = cpuGetRegister8(l_rs);
     } else {
-        l_rd = (s_cpuOpcodeBuffer[0] & 0x0f00) >> 8;
-        l_operand = s_cpuOpcodeBuffer[0];
+        l_rd = (M_CPU.opcodeBuffer[0] & 0x0f00) >> 8;
+        l_operand = M_CPU.opcodeBuffer[0];
     }
 
     uint8_t l_rdValue = cpuGetRegister8(l_rd);
@@ -3327,21 +3586,21 @@ static void cpuOpcodeOrB(void) {
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeOrW(void) {
     enum te_cpuRegister l_rd;
     uint16_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6400) {
-        enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[0] & 0x00f0) >> 4;
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6400) {
+        enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[0] & 0x00f0) >> 4;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         l_operand = cpuGetRegister16(l_rs);
     } else {
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         l_operand = cpuFetch16();
     }
 
@@ -3350,21 +3609,21 @@ static void cpuOpcodeOrW(void) {
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeOrL(void) {
     enum te_cpuRegister l_erd;
     uint16_t l_operand;
 
-    if(s_cpuOpcodeBuffer[0] == 0x01f0) {
-        enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
-        l_erd = s_cpuOpcodeBuffer[1] & 0x0007;
+    if(M_CPU.opcodeBuffer[0] == 0x01f0) {
+        enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
+        l_erd = M_CPU.opcodeBuffer[1] & 0x0007;
         l_operand = cpuGetRegister32(l_ers);
     } else {
-        l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+        l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
         l_operand = cpuFetch32();
     }
 
@@ -3373,184 +3632,184 @@ static void cpuOpcodeOrL(void) {
 
     cpuSetRegister32(l_erd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeOrc(void) {
-    uint8_t l_imm = s_cpuOpcodeBuffer[0];
+    uint8_t l_imm = M_CPU.opcodeBuffer[0];
 
-    s_cpuFlagsRegister.byte |= l_imm;
+    M_CPU.flagsRegister.byte |= l_imm;
 }
 
 static void cpuOpcodeRotlB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint8_t l_rdValue = cpuGetRegister8(l_rd);
     uint8_t l_result = (l_rdValue << 1) | (l_rdValue >> 7);
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x80) != 0;
 }
 
 static void cpuOpcodeRotlW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint16_t l_rdValue = cpuGetRegister16(l_rd);
     uint16_t l_result = (l_rdValue << 1) | (l_rdValue >> 15);
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x8000) != 0;
 }
 
 static void cpuOpcodeRotlL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
     uint32_t l_erdValue = cpuGetRegister32(l_erd);
     uint32_t l_result = (l_erdValue << 1) | (l_erdValue >> 7);
 
     cpuSetRegister32(l_erd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_erdValue & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_erdValue & 0x80000000) != 0;
 }
 
 static void cpuOpcodeRotrB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint8_t l_rdValue = cpuGetRegister8(l_rd);
     uint8_t l_result = (l_rdValue >> 1) | (l_rdValue << 7);
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x01) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x01) != 0;
 }
 
 static void cpuOpcodeRotrW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint16_t l_rdValue = cpuGetRegister16(l_rd);
     uint16_t l_result = (l_rdValue >> 1) | (l_rdValue << 15);
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x0001) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x0001) != 0;
 }
 
 static void cpuOpcodeRotrL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
     uint32_t l_erdValue = cpuGetRegister32(l_erd);
     uint32_t l_result = (l_erdValue >> 1) | (l_erdValue << 7);
 
     cpuSetRegister32(l_erd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_erdValue & 0x00000001) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_erdValue & 0x00000001) != 0;
 }
 
 static void cpuOpcodeRotxlB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint8_t l_rdValue = cpuGetRegister8(l_rd);
-    uint8_t l_carry = s_cpuFlagsRegister.bitField.carry ? 1 : 0;
+    uint8_t l_carry = M_CPU.flagsRegister.bitField.carry ? 1 : 0;
     uint8_t l_result = (l_rdValue << 1) | l_carry;
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x80) != 0;
 }
 
 static void cpuOpcodeRotxlW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint16_t l_rdValue = cpuGetRegister16(l_rd);
-    uint16_t l_carry = s_cpuFlagsRegister.bitField.carry ? 1 : 0;
+    uint16_t l_carry = M_CPU.flagsRegister.bitField.carry ? 1 : 0;
     uint16_t l_result = (l_rdValue << 1) | l_carry;
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x8000) != 0;
 }
 
 static void cpuOpcodeRotxlL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
     uint32_t l_erdValue = cpuGetRegister32(l_erd);
-    uint32_t l_carry = s_cpuFlagsRegister.bitField.carry ? 1 : 0;
+    uint32_t l_carry = M_CPU.flagsRegister.bitField.carry ? 1 : 0;
     uint32_t l_result = (l_erdValue << 1) | l_carry;
 
     cpuSetRegister32(l_erd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_erdValue & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_erdValue & 0x80000000) != 0;
 }
 
 static void cpuOpcodeRotxrB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint8_t l_rdValue = cpuGetRegister8(l_rd);
-    uint8_t l_carry = s_cpuFlagsRegister.bitField.carry ? 1 : 0;
+    uint8_t l_carry = M_CPU.flagsRegister.bitField.carry ? 1 : 0;
     uint8_t l_result = (l_rdValue >> 1) | (l_carry << 7);
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x01) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x01) != 0;
 }
 
 static void cpuOpcodeRotxrW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint16_t l_rdValue = cpuGetRegister16(l_rd);
-    uint16_t l_carry = s_cpuFlagsRegister.bitField.carry ? 1 : 0;
+    uint16_t l_carry = M_CPU.flagsRegister.bitField.carry ? 1 : 0;
     uint16_t l_result = (l_rdValue >> 1) | (l_carry << 15);
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x0001) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x0001) != 0;
 }
 
 static void cpuOpcodeRotxrL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
     uint32_t l_erdValue = cpuGetRegister32(l_erd);
-    uint32_t l_carry = s_cpuFlagsRegister.bitField.carry ? 1 : 0;
+    uint32_t l_carry = M_CPU.flagsRegister.bitField.carry ? 1 : 0;
     uint32_t l_result = (l_erdValue >> 1) | (l_carry << 31);
 
     cpuSetRegister32(l_erd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_erdValue & 0x00000001) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_erdValue & 0x00000001) != 0;
 }
 
 static void cpuOpcodeRte(void) {
     uint32_t l_spValue = cpuGetRegister32(E_CPUREGISTER_ER7);
 
-    s_cpuFlagsRegister.byte = busRead16(l_spValue);
-    s_cpuRegisterPC = busRead16(l_spValue + 2);
+    M_CPU.flagsRegister.byte = busRead16(l_spValue);
+    M_CPU.registerPC = busRead16(l_spValue + 2);
 
     cpuSetRegister32(E_CPUREGISTER_ER7, l_spValue + 4);
 }
@@ -3558,229 +3817,231 @@ static void cpuOpcodeRte(void) {
 static void cpuOpcodeRts(void) {
     uint32_t l_spValue = cpuGetRegister32(E_CPUREGISTER_ER7);
 
-    s_cpuRegisterPC = busRead16(l_spValue);
+    M_CPU.registerPC = busRead16(l_spValue);
 
     cpuSetRegister32(E_CPUREGISTER_ER7, l_spValue + 2);
 }
 
 static void cpuOpcodeShalB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     int8_t l_rdValue = cpuGetRegister8(l_rd);
     int8_t l_result = l_rdValue << 1;
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = ((l_rdValue ^ l_result) & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
+        ((l_rdValue ^ l_result) & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x80) != 0;
 }
 
 static void cpuOpcodeShalW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     int16_t l_rdValue = cpuGetRegister16(l_rd);
     int16_t l_result = l_rdValue << 1;
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         ((l_rdValue ^ l_result) & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x8000) != 0;
 }
 
 static void cpuOpcodeShalL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
 
     int32_t l_erdValue = cpuGetRegister32(l_erd);
     int32_t l_result = l_erdValue << 1;
 
     cpuSetRegister32(l_erd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         ((l_erdValue ^ l_result) & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.carry = (l_erdValue & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.carry = (l_erdValue & 0x80000000) != 0;
 }
 
 static void cpuOpcodeSharB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     int8_t l_rdValue = cpuGetRegister8(l_rd);
     int8_t l_result = l_rdValue >> 1;
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x01) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x01) != 0;
 }
 
 static void cpuOpcodeSharW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     int16_t l_rdValue = cpuGetRegister16(l_rd);
     int16_t l_result = l_rdValue >> 1;
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x0001) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x0001) != 0;
 }
 
 static void cpuOpcodeSharL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
 
     int32_t l_erdValue = cpuGetRegister32(l_erd);
     int32_t l_result = l_erdValue >> 1;
 
     cpuSetRegister32(l_erd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_erdValue & 0x00000001) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_erdValue & 0x00000001) != 0;
 }
 
 static void cpuOpcodeShllB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     uint8_t l_rdValue = cpuGetRegister8(l_rd);
     uint8_t l_result = l_rdValue << 1;
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x80) != 0;
 }
 
 static void cpuOpcodeShllW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     uint16_t l_rdValue = cpuGetRegister16(l_rd);
     uint16_t l_result = l_rdValue << 1;
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x8000) != 0;
 }
 
 static void cpuOpcodeShllL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
 
     uint32_t l_erdValue = cpuGetRegister32(l_erd);
     uint32_t l_result = l_erdValue << 1;
 
     cpuSetRegister32(l_erd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_erdValue & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_erdValue & 0x80000000) != 0;
 }
 
 static void cpuOpcodeShlrB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     uint8_t l_rdValue = cpuGetRegister8(l_rd);
     uint8_t l_result = l_rdValue >> 1;
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x01) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x01) != 0;
 }
 
 static void cpuOpcodeShlrW(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     uint16_t l_rdValue = cpuGetRegister16(l_rd);
     uint16_t l_result = l_rdValue >> 1;
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_rdValue & 0x0001) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_rdValue & 0x0001) != 0;
 }
 
 static void cpuOpcodeShlrL(void) {
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
 
     uint32_t l_erdValue = cpuGetRegister32(l_erd);
     uint32_t l_result = l_erdValue >> 1;
 
     cpuSetRegister32(l_erd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
-    s_cpuFlagsRegister.bitField.carry = (l_erdValue & 0x00000001) != 0;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.carry = (l_erdValue & 0x00000001) != 0;
 }
 
 static void cpuOpcodeSleep(void) {
     // TODO: SLEEP
+    eventRaise(E_CORE_EVENT_SLEEP, NULL);
 }
 
 static void cpuOpcodeStcB(void) {
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
-    cpuSetRegister8(l_rd, s_cpuFlagsRegister.byte);
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
+    cpuSetRegister8(l_rd, M_CPU.flagsRegister.byte);
 }
 
 static void cpuOpcodeStcW(void) {
     uint32_t l_address;
 
-    if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6900) { // STC.W CCR, @ERd
-        enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6900) { // STC.W CCR, @ERd
+        enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
 
         l_address = cpuGetRegister32(l_erd);
-    } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6f00) { // STC.W CCR,
+    } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6f00) { // STC.W CCR,
                                                            // @(d:16, ERd)
-        enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+        enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
         int16_t l_disp = cpuFetch16();
 
         l_address = cpuGetRegister32(l_erd) + l_disp;
-    } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x7800) { // STC.W CCR,
+    } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x7800) { // STC.W CCR,
                                                            // @(d:24, ERd)
-        enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+        enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
         cpuFetch16();
         int32_t l_disp = cpuFetch32();
 
         l_address = cpuGetRegister32(l_erd) + l_disp;
-    } else if((s_cpuOpcodeBuffer[1] & 0xff00) == 0x6d00) { // STC.W CCR, @-ERd
-        enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    } else if((M_CPU.opcodeBuffer[1] & 0xff00) == 0x6d00) { // STC.W CCR, @-ERd
+        enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
         l_address = cpuGetRegister32(l_erd);
 
         l_address -= 2;
 
         cpuSetRegister32(l_erd, l_address);
-    } else if((s_cpuOpcodeBuffer[1] & 0xfff0) == 0x6b80) { // STC.W CCR, @aa:16
+    } else if((M_CPU.opcodeBuffer[1] & 0xfff0) == 0x6b80) { // STC.W CCR, @aa:16
         l_address = cpuFetch16();
     } else { // STC.W CCR, @aa:24
         l_address = cpuFetch32();
     }
 
-    busWrite16(l_address, s_cpuFlagsRegister.byte);
+    busWrite16(l_address, M_CPU.flagsRegister.byte);
 }
 
 static void cpuOpcodeSubB(void) {
-    enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[0] & 0x00f0) >> 4;
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[0] & 0x00f0) >> 4;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
     uint8_t l_operand = cpuGetRegister8(l_rs);
     uint8_t l_operand2 = cpuGetRegister8(l_rd);
@@ -3788,74 +4049,76 @@ static void cpuOpcodeSubB(void) {
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.halfCarry =
+    M_CPU.flagsRegister.bitField.halfCarry =
         (l_operand & 0x0f) > (l_operand2 & 0x0f);
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         (((l_operand2 ^ l_operand) & ~(l_operand ^ l_result)) & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.carry = l_operand > l_operand2;
+    M_CPU.flagsRegister.bitField.carry = l_operand > l_operand2;
 }
 
 static void cpuOpcodeSubW(void) {
     uint8_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x7900) { // SUB.W #xx:16, Rd
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x7900) { // SUB.W #xx:16, Rd
         l_operand = cpuFetch16();
     } else { // SUB.W Rs, Rd
-        l_operand = cpuGetRegister16((s_cpuOpcodeBuffer[0] & 0x00f0) >> 4);
+        l_operand = cpuGetRegister16((M_CPU.opcodeBuffer[0] & 0x00f0) >> 4);
     }
 
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint16_t l_operand2 = cpuGetRegister16(l_rd);
     uint16_t l_result = l_operand2 - l_operand;
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.halfCarry =
+    M_CPU.flagsRegister.bitField.halfCarry =
         (l_operand & 0x0fff) > (l_operand2 & 0x0fff);
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         (((l_operand2 ^ l_operand) & ~(l_operand ^ l_result)) & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.carry = l_operand > l_operand2;
+    M_CPU.flagsRegister.bitField.carry = l_operand > l_operand2;
 }
 
 static void cpuOpcodeSubL(void) {
     uint32_t l_operand;
 
-    if((s_cpuOpcodeBuffer[0] & 0xfff8) == 0x7a30) { // CMP.L #xx:32, ERd
+    if((M_CPU.opcodeBuffer[0] & 0xfff8) == 0x7a30) { // SUB.L #xx:32, ERd
         l_operand = cpuFetch32();
-    } else { // CMP.L ERs, ERd
-        l_operand = cpuGetRegister32((s_cpuOpcodeBuffer[0] & 0x0070) >> 4);
+    } else { // SUB.L ERs, ERd
+        l_operand = cpuGetRegister32((M_CPU.opcodeBuffer[0] & 0x0070) >> 4);
     }
 
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x000f;
     uint32_t l_operand2 = cpuGetRegister32(l_erd);
     uint32_t l_result = l_operand2 - l_operand;
 
-    s_cpuFlagsRegister.bitField.halfCarry =
+    cpuSetRegister32(l_erd, l_result);
+
+    M_CPU.flagsRegister.bitField.halfCarry =
         (l_operand & 0x0fffffff) > (l_operand2 & 0x0fffffff);
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         (((l_operand2 ^ l_operand) & ~(l_operand ^ l_result)) & 0x80000000)
         != 0;
-    s_cpuFlagsRegister.bitField.carry = l_operand > l_operand2;
+    M_CPU.flagsRegister.bitField.carry = l_operand > l_operand2;
 }
 
 static void cpuOpcodeSubs(void) {
     uint32_t l_immediate;
 
-    if((s_cpuOpcodeBuffer[0] & 0xfff8) == 0x1b00) {
+    if((M_CPU.opcodeBuffer[0] & 0xfff8) == 0x1b00) {
         l_immediate = 1;
-    } else if((s_cpuOpcodeBuffer[0] & 0xfff8) == 0x1b80) {
+    } else if((M_CPU.opcodeBuffer[0] & 0xfff8) == 0x1b80) {
         l_immediate = 2;
     } else {
         l_immediate = 4;
     }
 
-    enum te_cpuRegister l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+    enum te_cpuRegister l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
     uint32_t l_erdValue = cpuGetRegister32(l_erd);
 
     cpuSetRegister32(l_erd, l_erdValue - l_immediate);
@@ -3863,57 +4126,57 @@ static void cpuOpcodeSubs(void) {
 
 static void cpuOpcodeSubx(void) {
     uint16_t l_operand;
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x1e00) {
-        enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[0] & 0x00f0) >> 4;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x1e00) {
+        enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[0] & 0x00f0) >> 4;
         l_operand = cpuGetRegister8(l_rs);
     } else {
-        l_operand = s_cpuOpcodeBuffer[0] & 0xff;
+        l_operand = M_CPU.opcodeBuffer[0] & 0xff;
     }
 
-    l_operand += s_cpuFlagsRegister.bitField.carry ? 1 : 0;
+    l_operand += M_CPU.flagsRegister.bitField.carry ? 1 : 0;
 
     uint8_t l_operand2 = cpuGetRegister8(l_rd);
     uint8_t l_result = l_operand2 - l_operand;
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.halfCarry =
+    M_CPU.flagsRegister.bitField.halfCarry =
         (l_operand & 0x0f) > (l_operand2 & 0x0f);
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow =
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow =
         (((l_operand2 ^ l_operand) & ~(l_operand ^ l_result)) & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.carry = l_operand > l_operand2;
+    M_CPU.flagsRegister.bitField.carry = l_operand > l_operand2;
 }
 
 static void cpuOpcodeTrapa(void) {
-    uint8_t l_immediate = (s_cpuOpcodeBuffer[0] & 0x0030) >> 4;
+    uint8_t l_immediate = (M_CPU.opcodeBuffer[0] & 0x0030) >> 4;
 
-    s_cpuFlagsRegister.bitField.interruptMask = true;
+    M_CPU.flagsRegister.bitField.interruptMask = true;
 
     // TODO: UI bit?
 
     uint32_t l_sp = cpuGetRegister32(E_CPUREGISTER_ER7);
-    busWrite16(l_sp - 2, s_cpuRegisterPC);
-    busWrite16(l_sp - 4, s_cpuFlagsRegister.byte);
+    busWrite16(l_sp - 2, M_CPU.registerPC);
+    busWrite16(l_sp - 4, M_CPU.flagsRegister.byte);
     cpuSetRegister32(E_CPUREGISTER_ER7, l_sp - 4);
 
-    s_cpuRegisterPC = 0x0010 + (l_immediate << 1);
+    M_CPU.registerPC = 0x0010 + (l_immediate << 1);
 }
 
 static void cpuOpcodeXorB(void) {
     uint8_t l_operand;
     enum te_cpuRegister l_rd;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x1500) {
-        enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[0] & 0x00f0) >> 4;
-        l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x1500) {
+        enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[0] & 0x00f0) >> 4;
+        l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
         l_operand = cpuGetRegister8(l_rs);
     } else {
-        l_rd = (s_cpuOpcodeBuffer[0] & 0x0f00) >> 8;
-        l_operand = s_cpuOpcodeBuffer[0] & 0xff;
+        l_rd = (M_CPU.opcodeBuffer[0] & 0x0f00) >> 8;
+        l_operand = M_CPU.opcodeBuffer[0] & 0xff;
     }
 
     uint8_t l_rdValue = cpuGetRegister8(l_rd);
@@ -3921,17 +4184,17 @@ static void cpuOpcodeXorB(void) {
 
     cpuSetRegister8(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeXorW(void) {
     uint16_t l_operand;
-    enum te_cpuRegister l_rd = s_cpuOpcodeBuffer[0] & 0x000f;
+    enum te_cpuRegister l_rd = M_CPU.opcodeBuffer[0] & 0x000f;
 
-    if((s_cpuOpcodeBuffer[0] & 0xff00) == 0x6500) {
-        enum te_cpuRegister l_rs = (s_cpuOpcodeBuffer[0] & 0x00f0) >> 4;
+    if((M_CPU.opcodeBuffer[0] & 0xff00) == 0x6500) {
+        enum te_cpuRegister l_rs = (M_CPU.opcodeBuffer[0] & 0x00f0) >> 4;
         l_operand = cpuGetRegister16(l_rs);
     } else {
         l_operand = cpuFetch16();
@@ -3942,21 +4205,21 @@ static void cpuOpcodeXorW(void) {
 
     cpuSetRegister16(l_rd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x8000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x8000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeXorL(void) {
     enum te_cpuRegister l_erd;
     uint16_t l_operand;
 
-    if(s_cpuOpcodeBuffer[0] == 0x01f0) {
-        enum te_cpuRegister l_ers = (s_cpuOpcodeBuffer[1] & 0x0070) >> 4;
-        l_erd = s_cpuOpcodeBuffer[1] & 0x0007;
+    if(M_CPU.opcodeBuffer[0] == 0x01f0) {
+        enum te_cpuRegister l_ers = (M_CPU.opcodeBuffer[1] & 0x0070) >> 4;
+        l_erd = M_CPU.opcodeBuffer[1] & 0x0007;
         l_operand = cpuGetRegister32(l_ers);
     } else {
-        l_erd = s_cpuOpcodeBuffer[0] & 0x0007;
+        l_erd = M_CPU.opcodeBuffer[0] & 0x0007;
         l_operand = cpuFetch32();
     }
 
@@ -3965,14 +4228,14 @@ static void cpuOpcodeXorL(void) {
 
     cpuSetRegister32(l_erd, l_result);
 
-    s_cpuFlagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
-    s_cpuFlagsRegister.bitField.zero = l_result == 0;
-    s_cpuFlagsRegister.bitField.overflow = false;
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000) != 0;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0;
+    M_CPU.flagsRegister.bitField.overflow = false;
 }
 
 static void cpuOpcodeXorc(void) {
-    uint8_t l_immediate = s_cpuOpcodeBuffer[0];
-    s_cpuFlagsRegister.byte ^= l_immediate;
+    uint8_t l_immediate = M_CPU.opcodeBuffer[0];
+    M_CPU.flagsRegister.byte ^= l_immediate;
 }
 
 static void cpuOpcodeUndefined(void) {
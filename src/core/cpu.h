@@ -1,11 +1,105 @@
-#ifndef __INC_CORE_BUS_H__
-#define __INC_CORE_BUS_H__
+#ifndef __INC_CORE_CPU_H__
+#define __INC_CORE_CPU_H__
 
 // =============================================================================
 // File inclusion
 // =============================================================================
+#include <stdbool.h>
 #include <stdint.h>
 
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the size of the longest instruction in bytes
+ *        (MOV.L with a 24-bit displacement).
+ */
+#define C_CPU_MAX_INSTRUCTION_SIZE_BYTES 10U
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+union tu_cpuGeneralRegister {
+    uint32_t longWord;
+
+    struct {
+        uint16_t r : 16;
+        uint16_t e : 16;
+    } word;
+
+    struct {
+        uint32_t rl : 8;
+        uint32_t rh : 8;
+        uint32_t unused : 16;
+    } byte;
+};
+
+union tu_cpuFlagsRegister {
+    uint8_t byte;
+
+    struct {
+        uint8_t carry : 1;
+        uint8_t overflow : 1;
+        uint8_t zero : 1;
+        uint8_t negative : 1;
+        uint8_t user1 : 1;
+        uint8_t halfCarry : 1;
+        uint8_t user2 : 1;
+        uint8_t interruptMask : 1;
+    } bitField;
+};
+
+/**
+ * @brief This structure contains the state of the CPU.
+ */
+struct ts_cpuState {
+    union tu_cpuGeneralRegister generalRegisters[8];
+    uint32_t registerPC;
+    union tu_cpuFlagsRegister flagsRegister;
+
+    /**
+     * @brief This member indicates whether the CPU has fetched the reset
+     *        vector from ROM.
+     */
+    bool initialized;
+    uint16_t opcodeBuffer[2];
+};
+
+/**
+ * @brief This structure describes an instruction decoded by
+ *        cpuDecodeInstruction(), in the form expected by
+ *        cpuExecuteInstruction().
+ */
+struct ts_cpuInstruction {
+    /**
+     * @brief This member contains the opcode buffer after decoding.
+     */
+    uint16_t opcode[2];
+
+    /**
+     * @brief This member contains the number of words read by the decoder.
+     */
+    uint8_t decodeWordCount;
+
+    /**
+     * @brief This member contains the index of the opcode handler.
+     */
+    uint8_t handlerIndex;
+
+    /**
+     * @brief This member contains the size of the instruction in bytes, or 0
+     *        if the instruction ends a basic block.
+     */
+    uint8_t size;
+
+    /**
+     * @brief This member indicates whether the instruction can change the flow
+     *        of the program (branches, calls, returns, traps, SLEEP and
+     *        undefined opcodes).
+     */
+    bool endsBlock;
+};
+
 // =============================================================================
 // Public function declarations
 // =============================================================================
@@ -14,4 +108,65 @@
  */
 void cpuReset(void);
 
-#endif
+/**
+ * @brief Fetches, decodes and executes the instruction at PC with the
+ *        interpreter. Unlike coreStep(), the instruction is never run natively
+ *        and the accuracy profile does not apply the deferred cycles.
+ */
+void cpuInterpret(void);
+
+/**
+ * @brief Computes a hash of the list of opcode handlers and of the build time
+ *        of the CPU module. Recompiled code that refers to handlers by index is
+ *        only valid for the same hash.
+ *
+ * @returns The hash of the opcode handler list.
+ */
+uint64_t cpuGetOpcodeTableHash(void);
+
+/**
+ * @brief Decodes the instruction at the given address.
+ * @details The size of the instructions that do not end a basic block is
+ *          measured by executing them, so this function must only be called
+ *          on a scratch instance.
+ *
+ * @param[in] p_address The address of the instruction.
+ * @param[out] p_instruction The decoded instruction.
+ */
+void cpuDecodeInstruction(
+    uint16_t p_address,
+    struct ts_cpuInstruction *p_instruction
+);
+
+/**
+ * @brief Executes an instruction decoded in advance. The effects are the same
+ *        as interpreting the instruction at PC, including the bus cycles of
+ *        the words read by the decoder.
+ *
+ * @param[in] p_opcode0 The first word of the opcode buffer.
+ * @param[in] p_opcode1 The second word of the opcode buffer.
+ * @param[in] p_decodeWordCount The number of words read by the decoder.
+ * @param[in] p_handlerIndex The index of the opcode handler.
+ */
+void cpuExecuteInstruction(
+    uint16_t p_opcode0,
+    uint16_t p_opcode1,
+    uint8_t p_decodeWordCount,
+    uint8_t p_handlerIndex
+);
+
+/**
+ * @brief Runs one instruction like coreStep(), with the instruction at PC
+ *        decoded in advance by cpuDecodeInstruction(). The caller must make
+ *        sure that the FLASH ROM area of the instruction was not modified by
+ *        the current instance since it was decoded.
+ *
+ * @param[in] p_instruction The decoded instruction at PC.
+ *
+ * @returns A boolean value that indicates whether the decoded instruction was
+ *          used. It is false when the CPU has not fetched the reset vector
+ *          yet: the step is then interpreted by coreStep().
+ */
+bool cpuStepDecoded(const struct ts_cpuInstruction *p_instruction);
+
+#endif // __INC_CORE_CPU_H__
@@ -0,0 +1,383 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/eeprom.h"
+#include "core/event.h"
+#include "core/hash.h"
+#include "core/instance.h"
+#include "core/metrics.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This macro gives access to the EEPROM state of the current instance.
+ */
+#define M_EEPROM (g_coreInstance->state.eeprom)
+
+/**
+ * @brief This macro gives access to the private EEPROM pages of the current
+ *        instance.
+ */
+#define M_EEPROM_INSTANCE (g_coreInstance->eeprom)
+
+/**
+ * @brief These constants define the instructions of the EEPROM.
+ */
+#define C_EEPROM_INSTRUCTION_WRITE 0x02U
+#define C_EEPROM_INSTRUCTION_READ 0x03U
+#define C_EEPROM_INSTRUCTION_WRDI 0x04U
+#define C_EEPROM_INSTRUCTION_RDSR 0x05U
+#define C_EEPROM_INSTRUCTION_WREN 0x06U
+
+/**
+ * @brief This constant defines the WEL bit of the status register.
+ */
+#define C_EEPROM_STATUS_WEL 0x02U
+
+/**
+ * @brief This constant defines the number of bytes of an instruction before
+ *        its data: the instruction itself and a 16-bit address.
+ */
+#define C_EEPROM_HEADER_SIZE_BYTES 3U
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This variable contains a pointer to the buffer given to eepromInit().
+ */
+static const uint8_t *s_eepromSharedData;
+
+/**
+ * @brief This variable contains the hash of the buffer given to eepromInit().
+ */
+static uint64_t s_eepromHash;
+
+/**
+ * @brief This variable contains the hashMemory() hash of the shared EEPROM
+ *        contents, which every instance starts from.
+ */
+static uint64_t s_eepromSharedContentHash;
+
+/**
+ * @brief This variable indicates whether s_eepromSharedContentHash is valid.
+ */
+static bool s_eepromSharedContentHashValid;
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Makes sure that the current instance can hold the given number of
+ *        private pages.
+ *
+ * @param[in] p_pageCount The number of private pages.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if the allocation failed.
+ */
+static int eepromReservePages(uint16_t p_pageCount);
+
+/**
+ * @brief Returns a pointer to the given page of the shared EEPROM image.
+ *
+ * @param[in] p_page The index of the page.
+ *
+ * @returns A pointer to the page.
+ * @retval NULL if no EEPROM image was given.
+ */
+static inline const uint8_t *eepromGetSharedPage(uint16_t p_page);
+
+/**
+ * @brief Returns the hashMemory() hash of the shared EEPROM contents.
+ *
+ * @returns The hash of the shared EEPROM contents.
+ */
+static uint64_t eepromGetSharedContentHash(void);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+void eepromInit(const uint8_t *p_eepromBuffer) {
+    s_eepromSharedData = p_eepromBuffer;
+    s_eepromHash = hashCompute(p_eepromBuffer, C_EEPROM_SIZE_BYTES);
+    s_eepromSharedContentHash =
+        hashMemory(p_eepromBuffer, C_EEPROM_SIZE_BYTES);
+    s_eepromSharedContentHashValid = true;
+
+    if(g_coreInstance != NULL) {
+        eepromInitInstance();
+    }
+}
+
+uint64_t eepromGetHash(void) {
+    return s_eepromHash;
+}
+
+void eepromInitInstance(void) {
+    memset(M_EEPROM.pageSlots, 0, sizeof(M_EEPROM.pageSlots));
+    M_EEPROM.privatePageCount = 0U;
+    M_EEPROM.hash = eepromGetSharedContentHash();
+}
+
+void eepromDeinitInstance(void) {
+    free(M_EEPROM_INSTANCE.privatePages);
+
+    M_EEPROM_INSTANCE.privatePages = NULL;
+    M_EEPROM_INSTANCE.allocatedPageCount = 0U;
+    eepromInitInstance();
+}
+
+void eepromReset(void) {
+    M_EEPROM.selected = false;
+    M_EEPROM.writeEnabled = false;
+    M_EEPROM.instruction = 0x00U;
+    M_EEPROM.byteCount = 0U;
+    M_EEPROM.address = 0x0000U;
+}
+
+void eepromSetChipSelect(bool p_selected) {
+    if(p_selected == M_EEPROM.selected) {
+        return;
+    }
+
+    M_EEPROM.selected = p_selected;
+
+    if(p_selected) {
+        M_EEPROM.byteCount = 0U;
+    } else if(M_EEPROM.byteCount == 1U) {
+        if(M_EEPROM.instruction == C_EEPROM_INSTRUCTION_WREN) {
+            M_EEPROM.writeEnabled = true;
+        } else if(M_EEPROM.instruction == C_EEPROM_INSTRUCTION_WRDI) {
+            M_EEPROM.writeEnabled = false;
+        }
+    } else if(
+        (M_EEPROM.instruction == C_EEPROM_INSTRUCTION_WRITE)
+        && (M_EEPROM.byteCount > C_EEPROM_HEADER_SIZE_BYTES)
+    ) {
+        M_EEPROM.writeEnabled = false;
+    }
+}
+
+uint8_t eepromTransfer(uint8_t p_value) {
+    uint8_t l_result = 0xffU;
+
+    if(!M_EEPROM.selected) {
+        return l_result;
+    }
+
+    if(M_EEPROM.byteCount == 0U) {
+        M_EEPROM.instruction = p_value;
+    } else if(M_EEPROM.instruction == C_EEPROM_INSTRUCTION_RDSR) {
+        l_result = M_EEPROM.writeEnabled ? C_EEPROM_STATUS_WEL : 0x00U;
+    } else if(
+        (M_EEPROM.instruction != C_EEPROM_INSTRUCTION_READ)
+        && (M_EEPROM.instruction != C_EEPROM_INSTRUCTION_WRITE)
+    ) {
+        // The other instructions, such as WRSR, have no effect.
+    } else if(M_EEPROM.byteCount < C_EEPROM_HEADER_SIZE_BYTES) {
+        M_EEPROM.address = (M_EEPROM.address << 8U) | p_value;
+    } else if(M_EEPROM.instruction == C_EEPROM_INSTRUCTION_READ) {
+        l_result = eepromRead8(M_EEPROM.address);
+        M_EEPROM.address++;
+    } else if(M_EEPROM.writeEnabled) {
+        eepromWrite8(M_EEPROM.address, p_value);
+
+        // The address wraps around within the write page.
+        uint16_t l_offsetMask = C_EEPROM_PAGE_SIZE_BYTES - 1U;
+
+        M_EEPROM.address = (M_EEPROM.address & ~l_offsetMask)
+            | ((M_EEPROM.address + 1U) & l_offsetMask);
+    }
+
+    if(M_EEPROM.byteCount <= C_EEPROM_HEADER_SIZE_BYTES) {
+        M_EEPROM.byteCount++;
+    }
+
+    return l_result;
+}
+
+uint8_t eepromRead8(uint16_t p_address) {
+    uint16_t l_page = p_address / C_EEPROM_PAGE_SIZE_BYTES;
+    uint16_t l_slot = M_EEPROM.pageSlots[l_page];
+
+    if(l_slot != 0U) {
+        return M_EEPROM_INSTANCE.privatePages[
+            ((l_slot - 1U) * C_EEPROM_PAGE_SIZE_BYTES)
+            + (p_address % C_EEPROM_PAGE_SIZE_BYTES)
+        ];
+    } else if(s_eepromSharedData != NULL) {
+        return s_eepromSharedData[p_address];
+    } else {
+        return 0xffU;
+    }
+}
+
+int eepromWrite8(uint16_t p_address, uint8_t p_value) {
+    uint16_t l_page = p_address / C_EEPROM_PAGE_SIZE_BYTES;
+    uint8_t l_oldValue = eepromRead8(p_address);
+
+    // Writing the value that is already there does not need a copy.
+    if(l_oldValue == p_value) {
+        return 0;
+    }
+
+    if(M_EEPROM.pageSlots[l_page] == 0U) {
+        if(eepromReservePages(M_EEPROM.privatePageCount + 1U) != 0) {
+            return 1;
+        }
+
+        uint8_t *l_privatePage = &M_EEPROM_INSTANCE.privatePages[
+            M_EEPROM.privatePageCount * C_EEPROM_PAGE_SIZE_BYTES
+        ];
+        const uint8_t *l_sharedPage = eepromGetSharedPage(l_page);
+
+        if(l_sharedPage != NULL) {
+            memcpy(l_privatePage, l_sharedPage, C_EEPROM_PAGE_SIZE_BYTES);
+        } else {
+            memset(l_privatePage, 0xff, C_EEPROM_PAGE_SIZE_BYTES);
+        }
+
+        M_EEPROM.privatePageCount++;
+        M_EEPROM.pageSlots[l_page] = M_EEPROM.privatePageCount;
+    }
+
+    M_EEPROM_INSTANCE.privatePages[
+        ((M_EEPROM.pageSlots[l_page] - 1U) * C_EEPROM_PAGE_SIZE_BYTES)
+        + (p_address % C_EEPROM_PAGE_SIZE_BYTES)
+    ] = p_value;
+
+    M_EEPROM.hash ^= hashMemoryByte(p_address, l_oldValue)
+        ^ hashMemoryByte(p_address, p_value);
+
+    struct ts_coreEepromWriteEvent l_event = {
+        .address = p_address,
+        .value = p_value
+    };
+
+    M_METRICS_ADD(eepromBytesWritten, 1U);
+    eventRaise(E_CORE_EVENT_EEPROM_WRITE, &l_event);
+
+    return 0;
+}
+
+void eepromCopyData(uint8_t *p_buffer) {
+    for(uint16_t l_page = 0U; l_page < C_EEPROM_PAGE_COUNT; l_page++) {
+        uint16_t l_slot = M_EEPROM.pageSlots[l_page];
+        uint8_t *l_destination = &p_buffer[l_page * C_EEPROM_PAGE_SIZE_BYTES];
+        const uint8_t *l_source;
+
+        if(l_slot != 0U) {
+            l_source = &M_EEPROM_INSTANCE.privatePages[
+                (l_slot - 1U) * C_EEPROM_PAGE_SIZE_BYTES
+            ];
+        } else {
+            l_source = eepromGetSharedPage(l_page);
+        }
+
+        if(l_source != NULL) {
+            memcpy(l_destination, l_source, C_EEPROM_PAGE_SIZE_BYTES);
+        } else {
+            memset(l_destination, 0xff, C_EEPROM_PAGE_SIZE_BYTES);
+        }
+    }
+}
+
+const uint8_t *eepromGetPrivatePages(void) {
+    return M_EEPROM_INSTANCE.privatePages;
+}
+
+int eepromSetPrivatePages(const uint8_t *p_pages) {
+    if(M_EEPROM.privatePageCount > C_EEPROM_PAGE_COUNT) {
+        return 1;
+    }
+
+    for(uint16_t l_page = 0U; l_page < C_EEPROM_PAGE_COUNT; l_page++) {
+        if(M_EEPROM.pageSlots[l_page] > M_EEPROM.privatePageCount) {
+            return 1;
+        }
+    }
+
+    if(eepromReservePages(M_EEPROM.privatePageCount) != 0) {
+        return 1;
+    }
+
+    if(M_EEPROM.privatePageCount > 0U) {
+        memcpy(
+            M_EEPROM_INSTANCE.privatePages,
+            p_pages,
+            M_EEPROM.privatePageCount * C_EEPROM_PAGE_SIZE_BYTES
+        );
+    }
+
+    return 0;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static int eepromReservePages(uint16_t p_pageCount) {
+    if(p_pageCount <= M_EEPROM_INSTANCE.allocatedPageCount) {
+        return 0;
+    }
+
+    // The allocation grows by powers of two so that an instance that keeps
+    // writing to new pages is not reallocated on every page.
+    uint16_t l_allocatedPageCount = 1U;
+
+    while(l_allocatedPageCount < p_pageCount) {
+        l_allocatedPageCount *= 2U;
+    }
+
+    uint8_t *l_privatePages = (uint8_t *)realloc(
+        M_EEPROM_INSTANCE.privatePages,
+        l_allocatedPageCount * C_EEPROM_PAGE_SIZE_BYTES
+    );
+
+    if(l_privatePages == NULL) {
+        fprintf(stderr, "Error: failed to copy an EEPROM page.\n");
+        return 1;
+    }
+
+    M_EEPROM_INSTANCE.privatePages = l_privatePages;
+    M_EEPROM_INSTANCE.allocatedPageCount = l_allocatedPageCount;
+
+    return 0;
+}
+
+static inline const uint8_t *eepromGetSharedPage(uint16_t p_page) {
+    if(s_eepromSharedData == NULL) {
+        return NULL;
+    }
+
+    return &s_eepromSharedData[p_page * C_EEPROM_PAGE_SIZE_BYTES];
+}
+
+static uint64_t eepromGetSharedContentHash(void) {
+    if(!s_eepromSharedContentHashValid) {
+        // Without an image, the EEPROM reads as erased.
+        uint64_t l_hash = 0U;
+
+        for(
+            uint32_t l_offset = 0U;
+            l_offset < C_EEPROM_SIZE_BYTES;
+            l_offset++
+        ) {
+            l_hash ^= hashMemoryByte(l_offset, 0xffU);
+        }
+
+        s_eepromSharedContentHash = l_hash;
+        s_eepromSharedContentHashValid = true;
+    }
+
+    return s_eepromSharedContentHash;
+}
@@ -0,0 +1,206 @@
+#ifndef __INC_CORE_EEPROM_H__
+#define __INC_CORE_EEPROM_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the size of the EEPROM.
+ */
+#define C_EEPROM_SIZE_BYTES 65536U
+
+/**
+ * @brief This constant defines the size of an EEPROM page. It matches the
+ *        write page size of the chip.
+ */
+#define C_EEPROM_PAGE_SIZE_BYTES 128U
+
+/**
+ * @brief This constant defines the number of pages of the EEPROM.
+ */
+#define C_EEPROM_PAGE_COUNT (C_EEPROM_SIZE_BYTES / C_EEPROM_PAGE_SIZE_BYTES)
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure contains the state of the EEPROM. The EEPROM contents
+ *        are the image given to eepromInit(), shared by every instance, except
+ *        for the pages that the instance has written to, which are copied to
+ *        the instance on the first write.
+ */
+struct ts_eepromState {
+    /**
+     * @brief This member indicates whether the chip select of the EEPROM is
+     *        asserted.
+     */
+    bool selected;
+
+    /**
+     * @brief This member represents the write enable latch of the EEPROM. It
+     *        is set by the WREN instruction, and cleared by WRDI or after a
+     *        WRITE instruction.
+     */
+    bool writeEnabled;
+
+    /**
+     * @brief This member contains the instruction received since the chip
+     *        select was asserted.
+     */
+    uint8_t instruction;
+
+    /**
+     * @brief This member contains the number of bytes received since the chip
+     *        select was asserted. It stops counting after the first data byte
+     *        (4).
+     */
+    uint8_t byteCount;
+
+    /**
+     * @brief This member contains the address of the next byte read or
+     *        written by the current instruction.
+     */
+    uint16_t address;
+
+    /**
+     * @brief This table contains, for every page, 0 if the page is read from
+     *        the shared image, or the index + 1 of its private copy.
+     */
+    uint16_t pageSlots[C_EEPROM_PAGE_COUNT];
+
+    /**
+     * @brief This member contains the number of private pages in use.
+     */
+    uint16_t privatePageCount;
+
+    /**
+     * @brief This member contains the hash of the EEPROM contents, updated on
+     *        every write. See hashMemory().
+     */
+    uint64_t hash;
+};
+
+/**
+ * @brief This structure contains the private EEPROM pages of an instance. It
+ *        is not part of the saved state because it contains pointers.
+ */
+struct ts_eepromInstance {
+    uint8_t *privatePages;
+    uint16_t allocatedPageCount;
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Sets the EEPROM image that every instance reads from, and discards
+ *        the private pages of the current instance.
+ *
+ * @param[in] p_eepromBuffer The EEPROM image. This buffer is not copied and
+ *                           must remain valid while the core is used.
+ */
+void eepromInit(const uint8_t *p_eepromBuffer);
+
+/**
+ * @brief Returns the hash of the buffer given to eepromInit().
+ *
+ * @returns The hash of the EEPROM image.
+ * @retval 0 if no EEPROM image was given.
+ */
+uint64_t eepromGetHash(void);
+
+/**
+ * @brief Makes the current instance read the shared EEPROM image only.
+ * @details This function shall only be called when an instance is created.
+ */
+void eepromInitInstance(void);
+
+/**
+ * @brief Frees the private pages of the current instance.
+ */
+void eepromDeinitInstance(void);
+
+/**
+ * @brief Resets the serial interface of the EEPROM. The contents are kept.
+ */
+void eepromReset(void);
+
+/**
+ * @brief Asserts or releases the chip select of the EEPROM. The WREN and WRDI
+ *        instructions take effect when the chip select is released.
+ *
+ * @param[in] p_selected true to assert the chip select, false to release it.
+ */
+void eepromSetChipSelect(bool p_selected);
+
+/**
+ * @brief Exchanges a byte with the EEPROM on the serial bus. The EEPROM
+ *        implements the READ, WRITE, RDSR, WREN and WRDI instructions of
+ *        25-series SPI EEPROMs. Writes complete immediately, so the status
+ *        register never reports a write in progress.
+ *
+ * @param[in] p_value The byte sent to the EEPROM.
+ *
+ * @returns The byte sent back by the EEPROM, or 0xff if it is not selected.
+ */
+uint8_t eepromTransfer(uint8_t p_value);
+
+/**
+ * @brief Reads a byte from the EEPROM. If no image was given to eepromInit(),
+ *        the EEPROM reads as erased (0xff).
+ *
+ * @param[in] p_address The address to read from.
+ *
+ * @returns The byte at the given address.
+ */
+uint8_t eepromRead8(uint16_t p_address);
+
+/**
+ * @brief Writes a byte to the EEPROM. The page that contains the byte is
+ *        copied to the instance first if needed.
+ *
+ * @param[in] p_address The address to write to.
+ * @param[in] p_value The value to write.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if the page could not be copied.
+ */
+int eepromWrite8(uint16_t p_address, uint8_t p_value);
+
+/**
+ * @brief Copies the EEPROM contents of the current instance.
+ *
+ * @param[out] p_buffer The buffer to fill with C_EEPROM_SIZE_BYTES bytes.
+ */
+void eepromCopyData(uint8_t *p_buffer);
+
+/**
+ * @brief Returns the private pages of the current instance, in the order of
+ *        their slots. There are privatePageCount pages.
+ *
+ * @returns A pointer to the private pages.
+ */
+const uint8_t *eepromGetPrivatePages(void);
+
+/**
+ * @brief Replaces the private pages of the current instance, after its state
+ *        was loaded.
+ *
+ * @param[in] p_pages A pointer to privatePageCount pages to copy.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if the state is invalid or if the pages could not
+ *         be allocated.
+ */
+int eepromSetPrivatePages(const uint8_t *p_pages);
+
+#endif // __INC_CORE_EEPROM_H__
@@ -0,0 +1,118 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "core/core.h"
+#include "core/event.h"
+#include "core/instance.h"
+#include "core/run.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This macro gives access to the event listeners of the current
+ *        instance.
+ */
+#define M_EVENT_INSTANCE (g_coreInstance->event)
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Returns the index of an event type in the listener tables.
+ *
+ * @param[in] p_event The event.
+ *
+ * @returns The index of the event type.
+ */
+static inline unsigned int eventGetTypeIndex(enum te_coreEvent p_event);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int coreAddEventListener(
+    uint32_t p_eventMask,
+    tf_coreEventListener p_listener,
+    void *p_context
+) {
+    for(unsigned int l_type = 0U; l_type < C_EVENT_TYPE_COUNT; l_type++) {
+        if(
+            ((p_eventMask & (1U << l_type)) != 0U)
+            && (M_EVENT_INSTANCE.listenerCounts[l_type]
+                == C_EVENT_MAX_LISTENERS)
+        ) {
+            return 1;
+        }
+    }
+
+    for(unsigned int l_type = 0U; l_type < C_EVENT_TYPE_COUNT; l_type++) {
+        if((p_eventMask & (1U << l_type)) != 0U) {
+            struct ts_eventListener *l_listener =
+                &M_EVENT_INSTANCE.listeners[l_type][
+                    M_EVENT_INSTANCE.listenerCounts[l_type]++
+                ];
+
+            l_listener->function = p_listener;
+            l_listener->context = p_context;
+        }
+    }
+
+    return 0;
+}
+
+void coreRemoveEventListener(tf_coreEventListener p_listener, void *p_context) {
+    for(unsigned int l_type = 0U; l_type < C_EVENT_TYPE_COUNT; l_type++) {
+        struct ts_eventListener *l_listeners =
+            M_EVENT_INSTANCE.listeners[l_type];
+        unsigned int l_count = 0U;
+
+        // The remaining listeners keep their order.
+        for(
+            unsigned int l_index = 0U;
+            l_index < M_EVENT_INSTANCE.listenerCounts[l_type];
+            l_index++
+        ) {
+            if(
+                (l_listeners[l_index].function != p_listener)
+                || (l_listeners[l_index].context != p_context)
+            ) {
+                l_listeners[l_count++] = l_listeners[l_index];
+            }
+        }
+
+        M_EVENT_INSTANCE.listenerCounts[l_type] = l_count;
+    }
+}
+
+void eventRaise(enum te_coreEvent p_event, const void *p_data) {
+    unsigned int l_type = eventGetTypeIndex(p_event);
+
+    for(
+        unsigned int l_index = 0U;
+        l_index < M_EVENT_INSTANCE.listenerCounts[l_type];
+        l_index++
+    ) {
+        const struct ts_eventListener *l_listener =
+            &M_EVENT_INSTANCE.listeners[l_type][l_index];
+
+        l_listener->function(p_event, p_data, l_listener->context);
+    }
+
+    runNotifyEvent(p_event);
+}
+
+bool eventHasListeners(enum te_coreEvent p_event) {
+    return M_EVENT_INSTANCE.listenerCounts[eventGetTypeIndex(p_event)] != 0U;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static inline unsigned int eventGetTypeIndex(enum te_coreEvent p_event) {
+    return __builtin_ctz((unsigned int)p_event);
+}
@@ -0,0 +1,69 @@
+#ifndef __INC_CORE_EVENT_H__
+#define __INC_CORE_EVENT_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "core/core.h"
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the number of event types, which is the number
+ *        of bits used by te_coreEvent.
+ */
+#define C_EVENT_TYPE_COUNT 8U
+
+/**
+ * @brief This constant defines the maximum number of listeners of each event
+ *        type in an instance.
+ */
+#define C_EVENT_MAX_LISTENERS 4U
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+struct ts_eventListener {
+    tf_coreEventListener function;
+    void *context;
+};
+
+/**
+ * @brief This structure contains the event listeners of a core instance. They
+ *        are grouped by event type, so that raising an event only goes
+ *        through its own listeners. They are not part of the emulated state.
+ */
+struct ts_eventInstance {
+    struct ts_eventListener
+        listeners[C_EVENT_TYPE_COUNT][C_EVENT_MAX_LISTENERS];
+    uint8_t listenerCounts[C_EVENT_TYPE_COUNT];
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Raises an event in the current instance: the listeners of the event
+ *        are called, and the current coreRunUntil() call stops at the end of
+ *        the step if the event is in its event mask.
+ *
+ * @param[in] p_event The event that occurred.
+ * @param[in] p_data The data of the event (see te_coreEvent).
+ */
+void eventRaise(enum te_coreEvent p_event, const void *p_data);
+
+/**
+ * @brief Checks if an event has listeners in the current instance, so that
+ *        the data of the event is only prepared if it is needed.
+ *
+ * @param[in] p_event The event to check.
+ *
+ * @returns A boolean value that indicates whether the event has listeners.
+ */
+bool eventHasListeners(enum te_coreEvent p_event);
+
+#endif // __INC_CORE_EVENT_H__
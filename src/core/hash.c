@@ -0,0 +1,41 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/hash.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+#define C_HASH_PRIME 0x00000100000001b3ULL
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+uint64_t hashCompute(const void *p_buffer, size_t p_size) {
+    return hashUpdate(C_HASH_INITIAL_VALUE, p_buffer, p_size);
+}
+
+uint64_t hashUpdate(uint64_t p_hash, const void *p_buffer, size_t p_size) {
+    const uint8_t *l_buffer = (const uint8_t *)p_buffer;
+    uint64_t l_hash = p_hash;
+
+    for(size_t l_index = 0; l_index < p_size; l_index++) {
+        l_hash ^= l_buffer[l_index];
+        l_hash *= C_HASH_PRIME;
+    }
+
+    return l_hash;
+}
+
+uint64_t hashMemory(const uint8_t *p_buffer, size_t p_size) {
+    uint64_t l_hash = 0U;
+
+    for(size_t l_index = 0; l_index < p_size; l_index++) {
+        l_hash ^= hashMemoryByte(l_index, p_buffer[l_index]);
+    }
+
+    return l_hash;
+}
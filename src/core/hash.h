@@ -0,0 +1,83 @@
+#ifndef __INC_CORE_HASH_H__
+#define __INC_CORE_HASH_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the initial value of a hash.
+ */
+#define C_HASH_INITIAL_VALUE 0xcbf29ce484222325ULL
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Computes the 64-bit FNV-1a hash of the given buffer.
+ *
+ * @param[in] p_buffer The buffer to hash.
+ * @param[in] p_size The size of the buffer in bytes.
+ *
+ * @returns The hash of the buffer.
+ */
+uint64_t hashCompute(const void *p_buffer, size_t p_size);
+
+/**
+ * @brief Continues the computation of a 64-bit FNV-1a hash with the given
+ *        buffer. This can be used to compute the hash of several buffers.
+ *
+ * @param[in] p_hash The hash of the previous buffers, or C_HASH_INITIAL_VALUE.
+ * @param[in] p_buffer The buffer to hash.
+ * @param[in] p_size The size of the buffer in bytes.
+ *
+ * @returns The hash of the previous buffers and the given buffer.
+ */
+uint64_t hashUpdate(uint64_t p_hash, const void *p_buffer, size_t p_size);
+
+/**
+ * @brief Computes the hash of a memory area as the XOR of the hashes of its
+ *        bytes (see hashMemoryByte()). Unlike hashCompute(), this hash can be
+ *        updated in constant time when one byte changes.
+ *
+ * @param[in] p_buffer The memory area to hash.
+ * @param[in] p_size The size of the memory area in bytes.
+ *
+ * @returns The hash of the memory area.
+ */
+uint64_t hashMemory(const uint8_t *p_buffer, size_t p_size);
+
+/**
+ * @brief Mixes the bits of the given value (splitmix64 finalizer).
+ *
+ * @param[in] p_value The value to mix.
+ *
+ * @returns The mixed value.
+ */
+static inline uint64_t hashMix64(uint64_t p_value) {
+    p_value = (p_value ^ (p_value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    p_value = (p_value ^ (p_value >> 27)) * 0x94d049bb133111ebULL;
+
+    return p_value ^ (p_value >> 31);
+}
+
+/**
+ * @brief Computes the contribution of one byte to the hash of a memory area.
+ *        When a byte changes, the hash of the area is updated by XORing it
+ *        with the contributions of the old and the new value.
+ *
+ * @param[in] p_offset The offset of the byte in the memory area.
+ * @param[in] p_value The value of the byte.
+ *
+ * @returns The contribution of the byte.
+ */
+static inline uint64_t hashMemoryByte(uint32_t p_offset, uint8_t p_value) {
+    return hashMix64(((uint64_t)p_offset << 8) | p_value);
+}
+
+#endif // __INC_CORE_HASH_H__
@@ -0,0 +1,539 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "common.h"
+#include "core/bus.h"
+#include "core/cpu.h"
+#include "core/hash.h"
+#include "core/hle.h"
+#include "core/instance.h"
+#include "core/rom.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This macro gives access to the CPU state of the current instance.
+ */
+#define M_CPU (g_coreInstance->state.cpu)
+
+/**
+ * @brief This macro gives access to the HLE settings of the current instance.
+ */
+#define M_HLE_INSTANCE (g_coreInstance->hle)
+
+/**
+ * @brief This constant defines the number of HLE routines.
+ */
+#define C_HLE_ROUTINE_COUNT 3U
+
+/**
+ * @brief This constant defines the opcode of the RTS instruction.
+ */
+#define C_HLE_OPCODE_RTS 0x5470U
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+/**
+ * @brief This type defines the native implementation of a routine. It is
+ *        called with PC set to the entry point of the routine, and must leave
+ *        the CPU as the interpreter would after the same instructions.
+ */
+typedef void (*tf_hleHandler)(void);
+
+/**
+ * @brief This structure describes a firmware routine that can be executed
+ *        natively.
+ */
+struct ts_hleRoutine {
+    /**
+     * @brief This member contains the name of the routine, used to enable or
+     *        disable it.
+     */
+    const char *name;
+
+    /**
+     * @brief This member points to the machine code of the routine, starting
+     *        at its entry point.
+     */
+    const uint8_t *signature;
+
+    /**
+     * @brief This member contains the size of the machine code in bytes.
+     */
+    uint16_t signatureSize;
+
+    /**
+     * @brief This member contains the native implementation of the routine.
+     */
+    tf_hleHandler handler;
+};
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Accounts for the fetch of a one-word instruction.
+ */
+static inline void hleFetch(void);
+
+/**
+ * @brief Executes a RTS instruction.
+ */
+static void hleReturn(void);
+
+/**
+ * @brief Subtracts two 32-bit values and sets the flags as CMP.L and SUB.L do.
+ *
+ * @param[in] p_minuend The value to subtract from.
+ * @param[in] p_subtrahend The value to subtract.
+ *
+ * @returns The difference.
+ */
+static uint32_t hleSubtract32(uint32_t p_minuend, uint32_t p_subtrahend);
+
+/**
+ * @brief Executes one iteration of the byte copy loop.
+ */
+static void hleMemcpy8(void);
+
+/**
+ * @brief Executes one iteration of the byte fill loop.
+ */
+static void hleMemset8(void);
+
+/**
+ * @brief Executes the 32-bit unsigned division routine.
+ */
+static void hleDivideU32(void);
+
+/**
+ * @brief Drops the routines of the current instance that overlap a modified
+ *        area of its FLASH ROM, or restores all of them when the instance
+ *        reads the shared FLASH ROM buffer again.
+ *
+ * @param[in] p_address The address of the first modified byte.
+ * @param[in] p_size The number of modified bytes.
+ * @param[in] p_context Unused.
+ */
+static void hleOnRomInvalidated(
+    uint16_t p_address,
+    uint16_t p_size,
+    void *p_context
+);
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief Byte copy loop: copies R2 bytes from @ER1 to @ER0. The loop head is
+ *        the entry point, so each call executes one iteration.
+ *
+ *     loop: MOV.B @ER1+, R3L
+ *           MOV.B R3L, @ER0
+ *           INC.L #1, ER0
+ *           DEC.W #1, R2
+ *           BNE loop
+ *           RTS
+ */
+static const uint8_t s_hleSignatureMemcpy8[] = {
+    0x6c, 0x1b, 0x68, 0x8b, 0x0b, 0x70, 0x1b, 0x52, 0x46, 0xf6, 0x54, 0x70
+};
+
+/**
+ * @brief Byte fill loop: writes R1L to R2 bytes at @ER0. The loop head is the
+ *        entry point, so each call executes one iteration.
+ *
+ *     loop: MOV.B R1L, @ER0
+ *           INC.L #1, ER0
+ *           DEC.W #1, R2
+ *           BNE loop
+ *           RTS
+ */
+static const uint8_t s_hleSignatureMemset8[] = {
+    0x68, 0x89, 0x0b, 0x70, 0x1b, 0x52, 0x46, 0xf8, 0x54, 0x70
+};
+
+/**
+ * @brief 32-bit unsigned division by shifts and subtractions: divides ER0 by
+ *        ER1, and returns the quotient in ER0 and the remainder in ER2.
+ *
+ *           SUB.L ER2, ER2
+ *           MOV.B #32, R3L
+ *     loop: SHLL.L ER0
+ *           ROTXL.L ER2
+ *           CMP.L ER1, ER2
+ *           BCS next
+ *           SUB.L ER1, ER2
+ *           INC.L #1, ER0
+ *     next: DEC.B R3L
+ *           BNE loop
+ *           RTS
+ */
+static const uint8_t s_hleSignatureDivideU32[] = {
+    0x1a, 0xa2, 0xfb, 0x20, 0x10, 0x30, 0x12, 0x32, 0x1f, 0x92, 0x45, 0x04,
+    0x1a, 0x92, 0x0b, 0x70, 0x1a, 0x0b, 0x46, 0xf0, 0x54, 0x70
+};
+
+/**
+ * @brief This table contains the routines that can be executed natively. The
+ *        index of a routine is its bit in ts_hleInstance::disabledRoutines.
+ */
+static const struct ts_hleRoutine s_hleRoutines[C_HLE_ROUTINE_COUNT] = {
+    {
+        .name = "memcpy8",
+        .signature = s_hleSignatureMemcpy8,
+        .signatureSize = sizeof(s_hleSignatureMemcpy8),
+        .handler = hleMemcpy8
+    },
+    {
+        .name = "memset8",
+        .signature = s_hleSignatureMemset8,
+        .signatureSize = sizeof(s_hleSignatureMemset8),
+        .handler = hleMemset8
+    },
+    {
+        .name = "divu32",
+        .signature = s_hleSignatureDivideU32,
+        .signatureSize = sizeof(s_hleSignatureDivideU32),
+        .handler = hleDivideU32
+    }
+};
+
+M_STATIC_ASSERT(
+    hleRoutineCount,
+    C_HLE_ROUTINE_COUNT <= (sizeof(uint32_t) * 8U)
+);
+
+/**
+ * @brief This table contains, for each word of the FLASH ROM, the index of
+ *        the routine that starts there plus one, or 0 if there is none. It is
+ *        built from the shared FLASH ROM buffer by hleInit(). An instance does
+ *        not use the routines that overlap an area that it reprogrammed.
+ */
+static uint8_t s_hleRoutineAtAddress[C_ROM_SIZE_BYTES / 2U];
+
+/**
+ * @brief This variable contains the number of routines recognized by
+ *        hleInit().
+ */
+static unsigned int s_hleMatchCount;
+
+/**
+ * @brief This variable contains the size of the largest routine signature.
+ */
+static uint16_t s_hleMaxSignatureSize;
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+void hleInit(const uint8_t *p_romBuffer) {
+    memset(s_hleRoutineAtAddress, 0, sizeof(s_hleRoutineAtAddress));
+    s_hleMatchCount = 0U;
+    s_hleMaxSignatureSize = 0U;
+
+    for(unsigned int l_index = 0U; l_index < C_HLE_ROUTINE_COUNT; l_index++) {
+        const struct ts_hleRoutine *l_routine = &s_hleRoutines[l_index];
+
+        if(l_routine->signatureSize > s_hleMaxSignatureSize) {
+            s_hleMaxSignatureSize = l_routine->signatureSize;
+        }
+        uint64_t l_hash =
+            hashCompute(l_routine->signature, l_routine->signatureSize);
+
+        for(
+            uint32_t l_address = 0U;
+            l_address <= (C_ROM_SIZE_BYTES - l_routine->signatureSize);
+            l_address += 2U
+        ) {
+            // Only hash the windows that start with the right opcode.
+            if(
+                (p_romBuffer[l_address] != l_routine->signature[0])
+                || (p_romBuffer[l_address + 1] != l_routine->signature[1])
+                || (s_hleRoutineAtAddress[l_address >> 1] != 0U)
+            ) {
+                continue;
+            }
+
+            uint64_t l_windowHash = hashCompute(
+                &p_romBuffer[l_address],
+                l_routine->signatureSize
+            );
+
+            if(l_windowHash == l_hash) {
+                s_hleRoutineAtAddress[l_address >> 1] = l_index + 1U;
+                s_hleMatchCount++;
+            }
+        }
+    }
+}
+
+void hleInitInstance(void) {
+    romAddInvalidationListener(hleOnRomInvalidated, NULL);
+}
+
+bool hleStep(void) {
+    uint32_t l_pc = M_CPU.registerPC;
+
+    if(l_pc >= C_ROM_SIZE_BYTES) {
+        return false;
+    }
+
+    unsigned int l_entry = s_hleRoutineAtAddress[l_pc >> 1];
+
+    if(
+        (l_entry == 0U)
+        || ((M_HLE_INSTANCE.disabledRoutines & (1U << (l_entry - 1U))) != 0U)
+        || romIsUnitMarked(M_HLE_INSTANCE.droppedUnits, l_pc)
+    ) {
+        return false;
+    }
+
+    s_hleRoutines[l_entry - 1U].handler();
+
+    return true;
+}
+
+int hleSetRoutineEnabled(const char *p_name, bool p_enabled) {
+    uint32_t l_mask = 0U;
+
+    for(unsigned int l_index = 0U; l_index < C_HLE_ROUTINE_COUNT; l_index++) {
+        if(
+            (p_name == NULL)
+            || (strcmp(p_name, s_hleRoutines[l_index].name) == 0)
+        ) {
+            l_mask |= 1U << l_index;
+        }
+    }
+
+    if(l_mask == 0U) {
+        return 1;
+    }
+
+    if(p_enabled) {
+        M_HLE_INSTANCE.disabledRoutines &= ~l_mask;
+    } else {
+        M_HLE_INSTANCE.disabledRoutines |= l_mask;
+    }
+
+    return 0;
+}
+
+unsigned int hleGetMatchCount(void) {
+    return s_hleMatchCount;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static inline void hleFetch(void) {
+    // The interpreter reads each instruction word from the FLASH ROM, which
+    // costs one bus cycle and has no other effect.
+    busCycle();
+}
+
+static void hleReturn(void) {
+    hleFetch();
+
+    uint32_t l_spValue = M_CPU.generalRegisters[7].longWord;
+
+    M_CPU.registerPC = busRead16(l_spValue);
+    M_CPU.generalRegisters[7].longWord = l_spValue + 2U;
+    M_CPU.opcodeBuffer[0] = C_HLE_OPCODE_RTS;
+}
+
+static uint32_t hleSubtract32(uint32_t p_minuend, uint32_t p_subtrahend) {
+    uint32_t l_result = p_minuend - p_subtrahend;
+
+    M_CPU.flagsRegister.bitField.halfCarry =
+        (p_subtrahend & 0x0fffffffU) > (p_minuend & 0x0fffffffU);
+    M_CPU.flagsRegister.bitField.negative = (l_result & 0x80000000U) != 0U;
+    M_CPU.flagsRegister.bitField.zero = l_result == 0U;
+    M_CPU.flagsRegister.bitField.overflow =
+        (
+            ((p_minuend ^ p_subtrahend) & ~(p_subtrahend ^ l_result))
+            & 0x80000000U
+        ) != 0U;
+    M_CPU.flagsRegister.bitField.carry = p_subtrahend > p_minuend;
+
+    return l_result;
+}
+
+static void hleMemcpy8(void) {
+    uint32_t l_loopAddress = M_CPU.registerPC;
+
+    // MOV.B @ER1+, R3L
+    hleFetch();
+
+    uint32_t l_source = M_CPU.generalRegisters[1].longWord;
+    uint8_t l_value = busRead8(l_source);
+
+    M_CPU.generalRegisters[1].longWord = l_source + 1U;
+    M_CPU.generalRegisters[3].byte.rl = l_value;
+
+    // MOV.B R3L, @ER0
+    hleFetch();
+    busWrite8(M_CPU.generalRegisters[0].longWord, l_value);
+
+    // INC.L #1, ER0 (its flags are overwritten by DEC.W)
+    hleFetch();
+    M_CPU.generalRegisters[0].longWord++;
+
+    // DEC.W #1, R2
+    hleFetch();
+
+    uint16_t l_count = M_CPU.generalRegisters[2].word.r;
+    uint16_t l_newCount = l_count - 1U;
+
+    M_CPU.generalRegisters[2].word.r = l_newCount;
+    M_CPU.flagsRegister.bitField.negative = (l_newCount & 0x8000U) != 0U;
+    M_CPU.flagsRegister.bitField.zero = l_newCount == 0U;
+    M_CPU.flagsRegister.bitField.overflow =
+        ((l_count ^ l_newCount) & 0x8000U) != 0U;
+
+    // BNE loop
+    hleFetch();
+
+    if(l_newCount != 0U) {
+        M_CPU.registerPC = l_loopAddress;
+        M_CPU.opcodeBuffer[0] = 0x46f6U;
+    } else {
+        hleReturn();
+    }
+}
+
+static void hleMemset8(void) {
+    uint32_t l_loopAddress = M_CPU.registerPC;
+
+    // MOV.B R1L, @ER0 (its flags are overwritten by DEC.W)
+    hleFetch();
+    busWrite8(
+        M_CPU.generalRegisters[0].longWord,
+        M_CPU.generalRegisters[1].byte.rl
+    );
+
+    // INC.L #1, ER0
+    hleFetch();
+    M_CPU.generalRegisters[0].longWord++;
+
+    // DEC.W #1, R2
+    hleFetch();
+
+    uint16_t l_count = M_CPU.generalRegisters[2].word.r;
+    uint16_t l_newCount = l_count - 1U;
+
+    M_CPU.generalRegisters[2].word.r = l_newCount;
+    M_CPU.flagsRegister.bitField.negative = (l_newCount & 0x8000U) != 0U;
+    M_CPU.flagsRegister.bitField.zero = l_newCount == 0U;
+    M_CPU.flagsRegister.bitField.overflow =
+        ((l_count ^ l_newCount) & 0x8000U) != 0U;
+
+    // BNE loop
+    hleFetch();
+
+    if(l_newCount != 0U) {
+        M_CPU.registerPC = l_loopAddress;
+        M_CPU.opcodeBuffer[0] = 0x46f8U;
+    } else {
+        hleReturn();
+    }
+}
+
+static void hleDivideU32(void) {
+    uint32_t l_quotient = M_CPU.generalRegisters[0].longWord;
+    uint32_t l_divisor = M_CPU.generalRegisters[1].longWord;
+    uint32_t l_remainder;
+
+    // SUB.L ER2, ER2
+    hleFetch();
+    l_remainder = hleSubtract32(0U, 0U);
+
+    // MOV.B #32, R3L (its flags are overwritten by SHLL.L)
+    hleFetch();
+
+    for(uint8_t l_counter = 32U; l_counter != 0U; l_counter--) {
+        // SHLL.L ER0, then ROTXL.L ER2 (the flags are overwritten by CMP.L)
+        hleFetch();
+        hleFetch();
+
+        bool l_carry = (l_quotient & 0x80000000U) != 0U;
+
+        l_quotient <<= 1;
+        M_CPU.flagsRegister.bitField.carry = (l_remainder & 0x80000000U) != 0U;
+        l_remainder = (l_remainder << 1) | (l_carry ? 1U : 0U);
+
+        // CMP.L ER1, ER2, then BCS next
+        hleFetch();
+        hleSubtract32(l_remainder, l_divisor);
+        hleFetch();
+
+        if(!M_CPU.flagsRegister.bitField.carry) {
+            // SUB.L ER1, ER2
+            hleFetch();
+            l_remainder = hleSubtract32(l_remainder, l_divisor);
+
+            // INC.L #1, ER0 (its flags are overwritten by DEC.B)
+            hleFetch();
+            l_quotient++;
+        }
+
+        // DEC.B R3L, then BNE loop
+        hleFetch();
+        hleFetch();
+
+        uint8_t l_newCounter = l_counter - 1U;
+
+        M_CPU.flagsRegister.bitField.negative = (l_newCounter & 0x80U) != 0U;
+        M_CPU.flagsRegister.bitField.zero = l_newCounter == 0U;
+        M_CPU.flagsRegister.bitField.overflow = l_newCounter == 0x7fU;
+    }
+
+    M_CPU.generalRegisters[0].longWord = l_quotient;
+    M_CPU.generalRegisters[2].longWord = l_remainder;
+    M_CPU.generalRegisters[3].byte.rl = 0U;
+
+    hleReturn();
+}
+
+static void hleOnRomInvalidated(
+    uint16_t p_address,
+    uint16_t p_size,
+    void *p_context
+) {
+    M_UNUSED_PARAMETER(p_context);
+
+    if(romGetModifiedData() == NULL) {
+        memset(
+            M_HLE_INSTANCE.droppedUnits,
+            0,
+            sizeof(M_HLE_INSTANCE.droppedUnits)
+        );
+        return;
+    }
+
+    // A routine that starts before the area can still overlap it.
+    uint32_t l_address = 0U;
+    uint32_t l_endAddress = (uint32_t)p_address + p_size;
+
+    if(p_address >= s_hleMaxSignatureSize) {
+        l_address = (p_address - s_hleMaxSignatureSize + 1U) & ~1U;
+    }
+
+    for(; l_address < l_endAddress; l_address += 2U) {
+        unsigned int l_entry = s_hleRoutineAtAddress[l_address >> 1];
+
+        if(
+            (l_entry != 0U)
+            && ((l_address + s_hleRoutines[l_entry - 1U].signatureSize)
+                > p_address)
+        ) {
+            romMarkUnit(M_HLE_INSTANCE.droppedUnits, l_address);
+        }
+    }
+}
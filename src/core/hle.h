@@ -0,0 +1,80 @@
+#ifndef __INC_CORE_HLE_H__
+#define __INC_CORE_HLE_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "core/rom.h"
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure contains the HLE settings of a core instance. They are
+ *        not part of the emulated state: HLE routines have the same effects
+ *        as the firmware code that they replace.
+ */
+struct ts_hleInstance {
+    /**
+     * @brief This member contains one bit per HLE routine, set if the routine
+     *        is disabled for this instance.
+     */
+    uint32_t disabledRoutines;
+
+    /**
+     * @brief This member contains one bit per program unit of the FLASH ROM,
+     *        set if the routines that start in the unit were modified by
+     *        this instance.
+     */
+    uint8_t droppedUnits[C_ROM_UNIT_BITMAP_SIZE_BYTES];
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Looks for the known firmware routines in the given FLASH ROM buffer.
+ *
+ * @param[in] p_romBuffer A pointer to the FLASH ROM contents.
+ */
+void hleInit(const uint8_t *p_romBuffer);
+
+/**
+ * @brief Subscribes the current instance to the FLASH ROM modifications.
+ * @details This function shall only be called when an instance is created.
+ */
+void hleInitInstance(void);
+
+/**
+ * @brief Executes the recognized routine at PC natively, if there is one and
+ *        it is enabled. The memory accesses, the register and flag values and
+ *        the number of cycles are the same as if the routine was interpreted.
+ *
+ * @returns A boolean value that indicates whether a routine was executed.
+ */
+bool hleStep(void);
+
+/**
+ * @brief Enables or disables an HLE routine for the current instance.
+ *
+ * @param[in] p_name The name of the routine, or NULL for all the routines.
+ * @param[in] p_enabled true to enable the routine, false to disable it.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval 1 if there is no routine with this name.
+ */
+int hleSetRoutineEnabled(const char *p_name, bool p_enabled);
+
+/**
+ * @brief Gets the number of places where a routine was recognized in the
+ *        FLASH ROM.
+ *
+ * @returns The number of recognized routines.
+ */
+unsigned int hleGetMatchCount(void);
+
+#endif // __INC_CORE_HLE_H__
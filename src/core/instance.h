@@ -0,0 +1,100 @@
+#ifndef __INC_CORE_INSTANCE_H__
+#define __INC_CORE_INSTANCE_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include "common.h"
+#include "core/accuracy.h"
+#include "core/aot.h"
+#include "core/audio.h"
+#include "core/core.h"
+#include "core/cpu.h"
+#include "core/eeprom.h"
+#include "core/event.h"
+#include "core/hle.h"
+#include "core/lcd.h"
+#include "core/port.h"
+#include "core/ram.h"
+#include "core/rom.h"
+#include "core/run.h"
+#include "core/scheduler.h"
+#include "core/ssu.h"
+#include "core/timerw.h"
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the size of a cache line. Every module state
+ *        starts on its own cache line.
+ */
+#define C_INSTANCE_CACHE_LINE_SIZE 64
+
+/**
+ * @brief This macro aligns a member of ts_coreState on a cache line.
+ */
+#define M_INSTANCE_ALIGNED \
+    __attribute__((aligned(C_INSTANCE_CACHE_LINE_SIZE)))
+
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure contains all the mutable state of an instance. It is
+ *        saved and loaded as a single block, so it must not contain pointers.
+ *        The members are ordered from the most often accessed to the least
+ *        often accessed.
+ */
+struct ts_coreState {
+    struct ts_cpuState cpu M_INSTANCE_ALIGNED;
+    struct ts_schedulerState scheduler M_INSTANCE_ALIGNED;
+    struct ts_romState rom M_INSTANCE_ALIGNED;
+    struct ts_ssuState ssu M_INSTANCE_ALIGNED;
+    struct ts_portState port;
+    struct ts_timerWState timerW M_INSTANCE_ALIGNED;
+    struct ts_ramState ram M_INSTANCE_ALIGNED;
+    struct ts_lcdState lcd M_INSTANCE_ALIGNED;
+    struct ts_eepromState eeprom M_INSTANCE_ALIGNED;
+};
+
+/**
+ * @brief This structure describes an instance of the emulator. It is
+ *        allocated in one block aligned on a cache line.
+ */
+struct ts_coreInstance {
+    /**
+     * @brief These members are read on every bus cycle and every instruction
+     *        fetch, so they are placed in the first cache line of the
+     *        instance.
+     */
+    struct ts_accuracyInstance accuracy;
+    struct ts_romInstance rom;
+
+    struct ts_eepromInstance eeprom;
+    struct ts_hleInstance hle;
+    struct ts_aotInstance aot;
+    struct ts_runInstance run;
+    struct ts_eventInstance event;
+    struct ts_romInvalidationInstance romInvalidation;
+    struct ts_audioInstance audio;
+    struct ts_coreState state M_INSTANCE_ALIGNED;
+};
+
+M_STATIC_ASSERT(
+    instanceMemoryBudget,
+    (sizeof(struct ts_coreInstance) + C_EEPROM_SIZE_BYTES)
+        < C_CORE_INSTANCE_MEMORY_BUDGET_BYTES
+);
+
+// =============================================================================
+// Public variable declarations
+// =============================================================================
+/**
+ * @brief This variable contains a pointer to the instance used by the calling
+ *        thread. Every module accesses its state through this pointer.
+ */
+extern __thread struct ts_coreInstance *g_coreInstance;
+
+#endif // __INC_CORE_INSTANCE_H__
@@ -1,22 +1,98 @@
 // =============================================================================
 // File inclusion
 // =============================================================================
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
+
+#include "core/audio.h"
+#include "core/core.h"
+#include "core/event.h"
+#include "core/hash.h"
+#include "core/instance.h"
+#include "core/lcd.h"
+#include "core/metrics.h"
+#include "core/scheduler.h"
 
 // =============================================================================
-// Constants declaration
+// Private constant declarations
 // =============================================================================
-#define C_PW_SCREEN_WIDTH 96
-#define C_PW_SCREEN_HEIGHT 64
+/**
+ * @brief This macro gives access to the LCD state of the current instance.
+ */
+#define M_LCD (g_coreInstance->state.lcd)
 
 // =============================================================================
 // Private variable declarations
 // =============================================================================
-static uint32_t s_videoBuffer[C_PW_SCREEN_WIDTH * C_PW_SCREEN_HEIGHT];
+/**
+ * @brief This table contains the gray level of each pixel value.
+ */
+static const uint8_t s_lcdPalette[4] = {0xffU, 0xaaU, 0x55U, 0x00U};
+
+/**
+ * @brief This variable contains the image returned by coreGetVideoBuffer().
+ *        It is not part of the instance: it is only rendered when requested,
+ *        so one buffer per thread is enough.
+ */
+static __thread uint32_t
+    s_lcdVideoBuffer[C_LCD_SCREEN_WIDTH * C_LCD_SCREEN_HEIGHT];
 
 // =============================================================================
 // Public functions definitions
 // =============================================================================
-uint32_t *coreGetVideoBuffer(void) {
-    return s_videoBuffer;
+void lcdReset(void) {
+    memset(M_LCD.vram, 0, C_LCD_VRAM_SIZE_BYTES);
+    memset(M_LCD.frame, 0, C_LCD_VRAM_SIZE_BYTES);
+    schedulerSchedule(
+        E_SCHEDULER_EVENT_LCD_REFRESH,
+        C_LCD_REFRESH_PERIOD_CYCLES
+    );
+}
+
+void lcdOnRefreshEvent(void) {
+    memcpy(M_LCD.frame, M_LCD.vram, C_LCD_VRAM_SIZE_BYTES);
+    schedulerSchedule(
+        E_SCHEDULER_EVENT_LCD_REFRESH,
+        C_LCD_REFRESH_PERIOD_CYCLES
+    );
+    // The audio of the frame is sent before the frame itself.
+    audioEndBatch();
+    M_METRICS_ADD(frames, 1U);
+    eventRaise(E_CORE_EVENT_VBLANK, NULL);
+}
+
+void lcdRender(uint32_t *p_buffer, size_t p_pitch) {
+    for(int l_y = 0; l_y < C_LCD_SCREEN_HEIGHT; l_y++) {
+        const uint8_t *l_page =
+            &M_LCD.frame[(l_y / C_LCD_PAGE_HEIGHT) * C_LCD_SCREEN_WIDTH * 2];
+        int l_bit = l_y % C_LCD_PAGE_HEIGHT;
+        uint8_t *l_row = (uint8_t *)p_buffer + (size_t)l_y * p_pitch;
+
+        for(int l_x = 0; l_x < C_LCD_SCREEN_WIDTH; l_x++) {
+            int l_value = ((l_page[l_x * 2] >> l_bit) & 1)
+                | (((l_page[l_x * 2 + 1] >> l_bit) & 1) << 1);
+            uint8_t *l_pixel = &l_row[l_x * 4];
+
+            // The pixels are stored as R, G, B, A bytes.
+            l_pixel[0] = s_lcdPalette[l_value];
+            l_pixel[1] = s_lcdPalette[l_value];
+            l_pixel[2] = s_lcdPalette[l_value];
+            l_pixel[3] = 0xffU;
+        }
+    }
+}
+
+const uint32_t *coreGetVideoBuffer(void) {
+    lcdRender(s_lcdVideoBuffer, C_LCD_SCREEN_WIDTH * sizeof(uint32_t));
+
+    return s_lcdVideoBuffer;
+}
+
+void coreRenderVideo(uint32_t *p_buffer, size_t p_pitch) {
+    lcdRender(p_buffer, p_pitch);
+}
+
+uint64_t coreGetVideoHash(void) {
+    return hashCompute(M_LCD.frame, C_LCD_VRAM_SIZE_BYTES);
 }
@@ -0,0 +1,90 @@
+#ifndef __INC_CORE_LCD_H__
+#define __INC_CORE_LCD_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/core.h"
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+#define C_LCD_SCREEN_WIDTH 96
+#define C_LCD_SCREEN_HEIGHT 64
+
+/**
+ * @brief This constant defines the number of rows in a page of the LCD
+ *        display RAM.
+ */
+#define C_LCD_PAGE_HEIGHT 8
+
+/**
+ * @brief This constant defines the size of the LCD display RAM. Each pixel
+ *        is stored on 2 bits.
+ */
+#define C_LCD_VRAM_SIZE_BYTES (C_LCD_SCREEN_WIDTH * C_LCD_SCREEN_HEIGHT / 4)
+
+/**
+ * @brief This constant defines the refresh rate of the LCD panel in Hz.
+ */
+#define C_LCD_REFRESH_RATE_HZ 60U
+
+/**
+ * @brief This constant defines the number of cycles between two refreshes of
+ *        the LCD panel.
+ */
+#define C_LCD_REFRESH_PERIOD_CYCLES \
+    (C_CORE_CLOCK_RATE_HZ / C_LCD_REFRESH_RATE_HZ)
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure contains the state of the LCD.
+ */
+struct ts_lcdState {
+    /**
+     * @brief This member contains the display RAM of the LCD controller. It is
+     *        organized in pages of 8 rows. In a page, each column is described
+     *        by 2 bytes: the low bits of the 8 pixels, then their high bits.
+     */
+    uint8_t vram[C_LCD_VRAM_SIZE_BYTES];
+
+    /**
+     * @brief This member contains the frame displayed by the panel: the
+     *        display RAM as it was latched by the last refresh. It uses the
+     *        same layout as the display RAM.
+     */
+    uint8_t frame[C_LCD_VRAM_SIZE_BYTES];
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Resets the LCD module and schedules the first refresh.
+ * @details This function shall be called after the scheduler is reset.
+ */
+void lcdReset(void);
+
+/**
+ * @brief Handles the refresh event: the display RAM is latched as the
+ *        displayed frame, the next refresh is scheduled and the VBlank event
+ *        is raised.
+ * @details This function shall only be called by the scheduler module.
+ */
+void lcdOnRefreshEvent(void);
+
+/**
+ * @brief Renders the displayed frame of the current instance as RGBA pixels.
+ *
+ * @param[out] p_buffer The buffer to fill with C_LCD_SCREEN_HEIGHT rows of
+ *                      C_LCD_SCREEN_WIDTH pixels.
+ * @param[in] p_pitch The number of bytes between the start of two rows.
+ */
+void lcdRender(uint32_t *p_buffer, size_t p_pitch);
+
+#endif // __INC_CORE_LCD_H__
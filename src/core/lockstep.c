@@ -0,0 +1,366 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/core.h"
+#include "core/cpu.h"
+#include "core/instance.h"
+#include "core/lockstep.h"
+#include "core/rom.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This macro gives access to the CPU state of the current instance.
+ */
+#define M_CPU (g_coreInstance->state.cpu)
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+/**
+ * @brief This structure contains an entry of the decode cache.
+ */
+struct ts_lockstepDecodedInstruction {
+    bool decoded;
+    struct ts_cpuInstruction instruction;
+};
+
+/**
+ * @brief This structure contains the data of a lane.
+ */
+struct ts_lockstepLane {
+    /**
+     * @brief This member contains the cycle at which the lane stops.
+     */
+    uint64_t endCycle;
+
+    /**
+     * @brief This member contains one bit per program unit of the FLASH ROM,
+     *        set if the lane modified the unit or the end of the previous one.
+     *        The lane interprets its instructions there.
+     */
+    uint8_t droppedUnits[C_ROM_UNIT_BITMAP_SIZE_BYTES];
+};
+
+/**
+ * @brief This structure contains the data of a lockstep run.
+ */
+struct ts_lockstepContext {
+    /**
+     * @brief This member contains, for each word of the FLASH ROM, the
+     *        instruction that starts there, decoded the first time that the
+     *        lanes execute it together.
+     */
+    struct ts_lockstepDecodedInstruction *decodeCache;
+
+    /**
+     * @brief This member contains the instance used to decode instructions.
+     *        Decoding executes instructions, so it is never one of the lanes.
+     */
+    struct ts_coreInstance *scratchInstance;
+
+    /**
+     * @brief This member contains the data of each lane.
+     */
+    struct ts_lockstepLane *lanes;
+};
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Finds the PC shared by most lanes that have not reached their end
+ *        cycle, with a majority vote. If no PC is shared by more than half of
+ *        these lanes, the PC returned is one of theirs.
+ *
+ * @param[in] p_context The data of the run.
+ * @param[in] p_instances The lanes.
+ * @param[in] p_instanceCount The number of lanes.
+ * @param[out] p_pc The PC found.
+ *
+ * @returns A boolean value that indicates whether a lane has not reached its
+ *          end cycle.
+ */
+static bool lockstepFindLeadingPC(
+    const struct ts_lockstepContext *p_context,
+    struct ts_coreInstance *const *p_instances,
+    size_t p_instanceCount,
+    uint32_t *p_pc
+);
+
+/**
+ * @brief Returns the decoded instruction at the given address of the FLASH
+ *        ROM, decoding it on the scratch instance if needed.
+ *
+ * @param[in,out] p_context The data of the run.
+ * @param[in] p_address The address of the instruction.
+ * @param[in,out] p_statistics The statistics of the run.
+ *
+ * @returns The decoded instruction.
+ * @retval NULL if the scratch instance could not be created.
+ */
+static const struct ts_cpuInstruction *lockstepDecode(
+    struct ts_lockstepContext *p_context,
+    uint32_t p_address,
+    struct ts_lockstepStatistics *p_statistics
+);
+
+/**
+ * @brief Drops the decoded instructions that overlap a modified area of the
+ *        FLASH ROM of a lane, or restores all of them when the lane reads the
+ *        shared FLASH ROM buffer again.
+ *
+ * @param[in] p_address The address of the first modified byte.
+ * @param[in] p_size The number of modified bytes.
+ * @param[in,out] p_context The data of the lane.
+ */
+static void lockstepOnRomInvalidated(
+    uint16_t p_address,
+    uint16_t p_size,
+    void *p_context
+);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int lockstepRun(
+    struct ts_coreInstance *const *p_instances,
+    size_t p_instanceCount,
+    uint64_t p_cycles,
+    struct ts_lockstepStatistics *p_statistics
+) {
+    struct ts_coreInstance *l_callerInstance = g_coreInstance;
+    struct ts_lockstepContext l_context = {
+        .decodeCache = calloc(
+            C_ROM_SIZE_BYTES / 2U,
+            sizeof(struct ts_lockstepDecodedInstruction)
+        ),
+        .scratchInstance = NULL,
+        .lanes = calloc(p_instanceCount, sizeof(struct ts_lockstepLane))
+    };
+
+    p_statistics->roundCount = 0U;
+    p_statistics->laneStepCount = 0U;
+    p_statistics->sharedStepCount = 0U;
+    p_statistics->decodeCount = 0U;
+
+    if((l_context.decodeCache == NULL) || (l_context.lanes == NULL)) {
+        fprintf(stderr, "Error: failed to allocate the lockstep data.\n");
+        free(l_context.decodeCache);
+        free(l_context.lanes);
+        return 1;
+    }
+
+    int l_returnValue = 0;
+    size_t l_listenerCount = 0U;
+
+    for(
+        size_t l_index = 0U;
+        (l_returnValue == 0) && (l_index < p_instanceCount);
+        l_index++
+    ) {
+        struct ts_lockstepLane *l_lane = &l_context.lanes[l_index];
+
+        coreSelectInstance(p_instances[l_index]);
+        l_lane->endCycle = coreGetCycles() + p_cycles;
+
+        // The areas that the lane modified before the run are not known.
+        memset(
+            l_lane->droppedUnits,
+            (romGetModifiedData() != NULL) ? 0xff : 0x00,
+            sizeof(l_lane->droppedUnits)
+        );
+
+        if(romAddInvalidationListener(lockstepOnRomInvalidated, l_lane) != 0) {
+            fprintf(stderr, "Error: too many invalidation listeners.\n");
+            l_returnValue = 1;
+        } else {
+            l_listenerCount++;
+        }
+    }
+
+    uint32_t l_pc;
+
+    while(
+        (l_returnValue == 0)
+        && lockstepFindLeadingPC(
+            &l_context,
+            p_instances,
+            p_instanceCount,
+            &l_pc
+        )
+    ) {
+        // The instruction is decoded once for all the lanes at the leading PC.
+        // Code outside of the FLASH ROM is always interpreted.
+        const struct ts_cpuInstruction *l_instruction = NULL;
+
+        if(l_pc < C_ROM_SIZE_BYTES) {
+            l_instruction = lockstepDecode(&l_context, l_pc, p_statistics);
+
+            if(l_instruction == NULL) {
+                l_returnValue = 1;
+                break;
+            }
+        }
+
+        for(size_t l_index = 0U; l_index < p_instanceCount; l_index++) {
+            const struct ts_lockstepLane *l_lane = &l_context.lanes[l_index];
+
+            coreSelectInstance(p_instances[l_index]);
+
+            if(coreGetCycles() >= l_lane->endCycle) {
+                continue;
+            }
+
+            if(
+                (l_instruction != NULL)
+                && (M_CPU.registerPC == l_pc)
+                && !romIsUnitMarked(l_lane->droppedUnits, l_pc)
+            ) {
+                if(cpuStepDecoded(l_instruction)) {
+                    p_statistics->sharedStepCount++;
+                }
+            } else {
+                coreStep();
+            }
+
+            p_statistics->laneStepCount++;
+        }
+
+        p_statistics->roundCount++;
+    }
+
+    for(size_t l_index = 0U; l_index < l_listenerCount; l_index++) {
+        coreSelectInstance(p_instances[l_index]);
+        romRemoveInvalidationListener(
+            lockstepOnRomInvalidated,
+            &l_context.lanes[l_index]
+        );
+    }
+
+    if(l_context.scratchInstance != NULL) {
+        coreDestroyInstance(l_context.scratchInstance);
+    }
+
+    coreSelectInstance(l_callerInstance);
+    free(l_context.decodeCache);
+    free(l_context.lanes);
+
+    return l_returnValue;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static bool lockstepFindLeadingPC(
+    const struct ts_lockstepContext *p_context,
+    struct ts_coreInstance *const *p_instances,
+    size_t p_instanceCount,
+    uint32_t *p_pc
+) {
+    uint32_t l_candidate = 0U;
+    size_t l_count = 0U;
+    bool l_running = false;
+
+    for(size_t l_index = 0U; l_index < p_instanceCount; l_index++) {
+        coreSelectInstance(p_instances[l_index]);
+
+        if(coreGetCycles() >= p_context->lanes[l_index].endCycle) {
+            continue;
+        }
+
+        l_running = true;
+
+        if(l_count == 0U) {
+            l_candidate = M_CPU.registerPC;
+            l_count = 1U;
+        } else if(M_CPU.registerPC == l_candidate) {
+            l_count++;
+        } else {
+            l_count--;
+        }
+    }
+
+    *p_pc = l_candidate;
+
+    return l_running;
+}
+
+static const struct ts_cpuInstruction *lockstepDecode(
+    struct ts_lockstepContext *p_context,
+    uint32_t p_address,
+    struct ts_lockstepStatistics *p_statistics
+) {
+    struct ts_lockstepDecodedInstruction *l_entry =
+        &p_context->decodeCache[p_address >> 1];
+
+    if(l_entry->decoded) {
+        return &l_entry->instruction;
+    }
+
+    // Measuring an instruction may start a FLASH ROM operation on the scratch
+    // instance, which would make it read other contents: it is then replaced.
+    if(p_context->scratchInstance != NULL) {
+        coreSelectInstance(p_context->scratchInstance);
+
+        if(romGetModifiedData() != NULL) {
+            coreDestroyInstance(p_context->scratchInstance);
+            p_context->scratchInstance = NULL;
+        }
+    }
+
+    if(p_context->scratchInstance == NULL) {
+        p_context->scratchInstance = coreCreateInstance();
+
+        if(p_context->scratchInstance == NULL) {
+            return NULL;
+        }
+    }
+
+    coreSelectInstance(p_context->scratchInstance);
+    cpuDecodeInstruction(p_address, &l_entry->instruction);
+    l_entry->decoded = true;
+    p_statistics->decodeCount++;
+
+    return &l_entry->instruction;
+}
+
+static void lockstepOnRomInvalidated(
+    uint16_t p_address,
+    uint16_t p_size,
+    void *p_context
+) {
+    struct ts_lockstepLane *l_lane = p_context;
+
+    if(romGetModifiedData() == NULL) {
+        memset(l_lane->droppedUnits, 0, sizeof(l_lane->droppedUnits));
+        return;
+    }
+
+    // An instruction that starts before the area can still overlap it.
+    uint32_t l_address = 0U;
+    uint32_t l_endAddress = (uint32_t)p_address + p_size;
+
+    if(p_address >= C_CPU_MAX_INSTRUCTION_SIZE_BYTES) {
+        l_address = p_address - C_CPU_MAX_INSTRUCTION_SIZE_BYTES + 2U;
+    }
+
+    for(
+        uint32_t l_unit = l_address / C_ROM_PROGRAM_UNIT_SIZE_BYTES;
+        l_unit <= ((l_endAddress - 1U) / C_ROM_PROGRAM_UNIT_SIZE_BYTES);
+        l_unit++
+    ) {
+        romMarkUnit(
+            l_lane->droppedUnits,
+            l_unit * C_ROM_PROGRAM_UNIT_SIZE_BYTES
+        );
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef __INC_CORE_LOCKSTEP_H__
+#define __INC_CORE_LOCKSTEP_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/core.h"
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure contains the statistics of a lockstep run.
+ */
+struct ts_lockstepStatistics {
+    /**
+     * @brief This member contains the number of rounds. Every lane that has not
+     *        reached its end cycle executes one instruction per round.
+     */
+    uint64_t roundCount;
+
+    /**
+     * @brief This member contains the number of instructions executed by all
+     *        the lanes.
+     */
+    uint64_t laneStepCount;
+
+    /**
+     * @brief This member contains the number of instructions executed at the
+     *        PC shared by most lanes, with the instruction decoded once for
+     *        all of them. The lane utilization is the ratio of this member to
+     *        laneStepCount.
+     */
+    uint64_t sharedStepCount;
+
+    /**
+     * @brief This member contains the number of instructions decoded for the
+     *        lanes.
+     */
+    uint64_t decodeCount;
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Runs several instances in lockstep for the given number of cycles.
+ *        At each round, the lanes whose PC is the one shared by most lanes
+ *        execute the instruction decoded once for the round, and the diverged
+ *        lanes are interpreted on their own until they reach that PC again.
+ *        A lane that modified the FLASH ROM area of the instruction also
+ *        interprets it. Each instance ends up in the same state as if it was
+ *        run alone with coreStep().
+ * @details This is an experiment that measures how often the lanes share an
+ *          instruction: switching the selected instance at every instruction
+ *          makes it slower than running the instances one after the other.
+ *          The instance selected by the calling thread is selected again when
+ *          the function returns.
+ *
+ * @param[in] p_instances The instances to run (the lanes).
+ * @param[in] p_instanceCount The number of instances.
+ * @param[in] p_cycles The number of cycles to run each instance for.
+ * @param[out] p_statistics The statistics of the run.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+int lockstepRun(
+    struct ts_coreInstance *const *p_instances,
+    size_t p_instanceCount,
+    uint64_t p_cycles,
+    struct ts_lockstepStatistics *p_statistics
+);
+
+#endif // __INC_CORE_LOCKSTEP_H__
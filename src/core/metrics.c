@@ -0,0 +1,178 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "core/core.h"
+#include "core/metrics.h"
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+/**
+ * @brief This structure links the counters of a thread in the list of
+ *        registered threads.
+ */
+struct ts_metricsThread {
+    struct ts_coreMetrics *counters;
+    struct ts_metricsThread *next;
+};
+
+// =============================================================================
+// Public variable definitions
+// =============================================================================
+__thread struct ts_coreMetrics g_metrics;
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This variable contains the list entry of the calling thread. Its
+ *        counters are NULL until the thread is registered.
+ */
+static __thread struct ts_metricsThread s_metricsThread;
+
+/**
+ * @brief This variable protects the list of registered threads and the
+ *        counters of the threads that exited. The counters of the running
+ *        threads are not protected by it.
+ */
+static pthread_mutex_t s_metricsMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief These variables contain the key whose destructor removes a thread
+ *        from the list when it exits.
+ */
+static pthread_once_t s_metricsKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t s_metricsKey;
+
+/**
+ * @brief This variable contains the list of registered threads.
+ */
+static struct ts_metricsThread *s_metricsThreads;
+
+/**
+ * @brief This variable contains the sum of the counters of the threads that
+ *        exited.
+ */
+static struct ts_coreMetrics s_metricsExitedThreads;
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Creates the key whose destructor removes a thread from the list.
+ */
+static void metricsCreateKey(void);
+
+/**
+ * @brief Moves the counters of an exiting thread to the counters of the
+ *        threads that exited, and removes the thread from the list.
+ *
+ * @param[in] p_thread The list entry of the thread.
+ */
+static void metricsUnregisterThread(void *p_thread);
+
+/**
+ * @brief Adds counters to a sum. The counters can be written by their thread
+ *        at the same time.
+ *
+ * @param[in,out] p_sum The sum.
+ * @param[in] p_counters The counters to add.
+ */
+static void metricsAccumulate(
+    struct ts_coreMetrics *p_sum,
+    const struct ts_coreMetrics *p_counters
+);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+void metricsRegisterThread(void) {
+    if(s_metricsThread.counters != NULL) {
+        return;
+    }
+
+    pthread_once(&s_metricsKeyOnce, metricsCreateKey);
+
+    pthread_mutex_lock(&s_metricsMutex);
+    s_metricsThread.counters = &g_metrics;
+    s_metricsThread.next = s_metricsThreads;
+    s_metricsThreads = &s_metricsThread;
+    pthread_mutex_unlock(&s_metricsMutex);
+
+    // The value only makes the destructor run when the thread exits.
+    pthread_setspecific(s_metricsKey, &s_metricsThread);
+}
+
+void coreGetMetrics(struct ts_coreMetrics *p_metrics) {
+    pthread_mutex_lock(&s_metricsMutex);
+
+    memcpy(p_metrics, &s_metricsExitedThreads, sizeof(struct ts_coreMetrics));
+
+    for(
+        const struct ts_metricsThread *l_thread = s_metricsThreads;
+        l_thread != NULL;
+        l_thread = l_thread->next
+    ) {
+        metricsAccumulate(p_metrics, l_thread->counters);
+    }
+
+    pthread_mutex_unlock(&s_metricsMutex);
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static void metricsCreateKey(void) {
+    pthread_key_create(&s_metricsKey, metricsUnregisterThread);
+}
+
+static void metricsUnregisterThread(void *p_thread) {
+    struct ts_metricsThread *l_thread = (struct ts_metricsThread *)p_thread;
+
+    pthread_mutex_lock(&s_metricsMutex);
+
+    metricsAccumulate(&s_metricsExitedThreads, l_thread->counters);
+
+    struct ts_metricsThread **l_link = &s_metricsThreads;
+
+    while(*l_link != l_thread) {
+        l_link = &(*l_link)->next;
+    }
+
+    *l_link = l_thread->next;
+
+    pthread_mutex_unlock(&s_metricsMutex);
+}
+
+static void metricsAccumulate(
+    struct ts_coreMetrics *p_sum,
+    const struct ts_coreMetrics *p_counters
+) {
+    p_sum->cycles += __atomic_load_n(&p_counters->cycles, __ATOMIC_RELAXED);
+    p_sum->idleCycles +=
+        __atomic_load_n(&p_counters->idleCycles, __ATOMIC_RELAXED);
+    p_sum->instructions +=
+        __atomic_load_n(&p_counters->instructions, __ATOMIC_RELAXED);
+    p_sum->frames += __atomic_load_n(&p_counters->frames, __ATOMIC_RELAXED);
+    p_sum->schedulerEvents +=
+        __atomic_load_n(&p_counters->schedulerEvents, __ATOMIC_RELAXED);
+    p_sum->eepromBytesWritten +=
+        __atomic_load_n(&p_counters->eepromBytesWritten, __ATOMIC_RELAXED);
+
+    for(
+        unsigned int l_peripheral = 0U;
+        l_peripheral < E_CORE_BUS_PERIPHERAL_COUNT;
+        l_peripheral++
+    ) {
+        p_sum->busAccesses[l_peripheral] += __atomic_load_n(
+            &p_counters->busAccesses[l_peripheral],
+            __ATOMIC_RELAXED
+        );
+    }
+}
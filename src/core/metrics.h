@@ -0,0 +1,50 @@
+#ifndef __INC_CORE_METRICS_H__
+#define __INC_CORE_METRICS_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdint.h>
+
+#include "core/core.h"
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This macro adds a value to a counter of the calling thread. Only the
+ *        calling thread writes its counters, so the update does not need to
+ *        be atomic: the atomic store only guarantees that coreGetMetrics()
+ *        never reads a partially written value.
+ *
+ * @param[in] p_member The ts_coreMetrics member to add to.
+ * @param[in] p_value The value to add.
+ */
+#define M_METRICS_ADD(p_member, p_value) \
+    __atomic_store_n( \
+        &g_metrics.p_member, \
+        g_metrics.p_member + (p_value), \
+        __ATOMIC_RELAXED \
+    )
+
+// =============================================================================
+// Public variable declarations
+// =============================================================================
+/**
+ * @brief This variable contains the counters of the calling thread.
+ */
+extern __thread struct ts_coreMetrics g_metrics;
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Adds the counters of the calling thread to the ones summed by
+ *        coreGetMetrics(), if they are not already. When the thread exits,
+ *        its counters are kept in the sum.
+ * @details This function shall be called by every thread that selects an
+ *          instance.
+ */
+void metricsRegisterThread(void);
+
+#endif // __INC_CORE_METRICS_H__
@@ -0,0 +1,101 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "core/core.h"
+#include "core/eeprom.h"
+#include "core/instance.h"
+#include "core/port.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This constant contains the address of the PDR1 register.
+ */
+#define C_PORT_REGADDR_PDR1 0xffd4
+
+/**
+ * @brief This constant contains the address of the PDRB register.
+ */
+#define C_PORT_REGADDR_PDRB 0xffde
+
+/**
+ * @brief This constant defines the PDR1 bit that drives the chip select of
+ *        the EEPROM. The chip select is active low.
+ */
+#define C_PORT_PDR1_EEPROM_CS (1U << 2)
+
+/**
+ * @brief This macro gives access to the port state of the current instance.
+ */
+#define M_PORT (g_coreInstance->state.port)
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This table contains the PDRB bit that each input key is wired to.
+ *        The keys pull their pin low when they are pressed.
+ */
+static const uint8_t s_portInputBits[] = {
+    [E_CORE_INPUT_LEFT] = 1U << 2,
+    [E_CORE_INPUT_MIDDLE] = 1U << 0,
+    [E_CORE_INPUT_RIGHT] = 1U << 4
+};
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+void portReset(void) {
+    M_PORT.inputs = 0x00U;
+
+    // The chip selects are pulled up while the pins are still inputs.
+    M_PORT.pdr1 = 0xffU;
+}
+
+uint8_t portRead8(uint16_t p_address) {
+    if(p_address == C_PORT_REGADDR_PDR1) {
+        return M_PORT.pdr1;
+    } else if(p_address != C_PORT_REGADDR_PDRB) {
+        return 0xffU;
+    }
+
+    uint8_t l_value = 0xffU;
+
+    for(int l_input = 0; l_input <= E_CORE_INPUT_RIGHT; l_input++) {
+        if((M_PORT.inputs & (1U << l_input)) != 0U) {
+            l_value &= ~s_portInputBits[l_input];
+        }
+    }
+
+    return l_value;
+}
+
+uint16_t portRead16(uint16_t p_address) {
+    return (portRead8(p_address) << 8U) | portRead8(p_address | 0x0001U);
+}
+
+void portWrite8(uint16_t p_address, uint8_t p_value) {
+    if(p_address == C_PORT_REGADDR_PDR1) {
+        M_PORT.pdr1 = p_value;
+        eepromSetChipSelect((p_value & C_PORT_PDR1_EEPROM_CS) == 0U);
+    }
+}
+
+void portWrite16(uint16_t p_address, uint16_t p_value) {
+    uint16_t l_address = p_address & 0xfffeU;
+
+    portWrite8(l_address, p_value >> 8U);
+    portWrite8(l_address | 0x0001U, p_value);
+}
+
+void portSetInput(enum te_coreInput p_input, bool p_pressed) {
+    if(p_pressed) {
+        M_PORT.inputs |= 1U << p_input;
+    } else {
+        M_PORT.inputs &= ~(1U << p_input);
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef __INC_CORE_PORT_H__
+#define __INC_CORE_PORT_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "core/core.h"
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure contains the state of the I/O ports.
+ */
+struct ts_portState {
+    /**
+     * @brief This member contains one bit per te_coreInput, set when the key
+     *        is pressed.
+     */
+    uint8_t inputs;
+
+    /**
+     * @brief This member represents the PDR1 register. Its outputs drive the
+     *        chip selects of the serial bus.
+     */
+    uint8_t pdr1;
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Resets the I/O ports. The input keys and the chip selects are
+ *        released.
+ */
+void portReset(void);
+
+/**
+ * @brief Reads a byte from the I/O ports.
+ *
+ * @param[in] p_address The address to read the byte from.
+ *
+ * @returns The byte read.
+ */
+uint8_t portRead8(uint16_t p_address);
+
+/**
+ * @brief Reads a word from the I/O ports.
+ *
+ * @param[in] p_address The address to read the word from.
+ *
+ * @returns The word read.
+ */
+uint16_t portRead16(uint16_t p_address);
+
+/**
+ * @brief Writes a byte to the I/O ports.
+ *
+ * @param[in] p_address The address to write the byte to.
+ * @param[in] p_value The byte to write.
+ */
+void portWrite8(uint16_t p_address, uint8_t p_value);
+
+/**
+ * @brief Writes a word to the I/O ports.
+ *
+ * @param[in] p_address The address to write the word to.
+ * @param[in] p_value The word to write.
+ */
+void portWrite16(uint16_t p_address, uint16_t p_value);
+
+/**
+ * @brief Sets the state of an input key.
+ *
+ * @param[in] p_input The input key.
+ * @param[in] p_pressed A boolean value that indicates whether the key is
+ *                      pressed.
+ */
+void portSetInput(enum te_coreInput p_input, bool p_pressed);
+
+#endif // __INC_CORE_PORT_H__
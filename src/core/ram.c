@@ -4,38 +4,60 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "core/hash.h"
+#include "core/instance.h"
 #include "core/ram.h"
 
 // =============================================================================
 // Private constant declarations
 // =============================================================================
-#define C_RAM_SIZE 2048
+/**
+ * @brief This macro gives access to the RAM state of the current instance.
+ */
+#define M_RAM (g_coreInstance->state.ram)
 
 // =============================================================================
-// Private variable declarations
+// Private function declarations
 // =============================================================================
-static uint8_t s_ramData[C_RAM_SIZE];
+/**
+ * @brief Writes a byte to RAM and updates the hash of the RAM.
+ *
+ * @param[in] p_offset The offset of the byte in RAM.
+ * @param[in] p_value The byte to write.
+ */
+static inline void ramWriteByte(uint16_t p_offset, uint8_t p_value);
 
 // =============================================================================
 // Public functions definitions
 // =============================================================================
 void ramReset(void) {
-    memset(s_ramData, 0, C_RAM_SIZE);
+    memset(M_RAM.data, 0, C_RAM_SIZE);
+    M_RAM.hash = hashMemory(M_RAM.data, C_RAM_SIZE);
 }
 
 uint8_t ramRead8(uint16_t p_address) {
-    return s_ramData[p_address - 0xf780];
+    return M_RAM.data[p_address - 0xf780];
 }
 
 uint16_t ramRead16(uint16_t p_address) {
-    return (s_ramData[p_address - 0xf780] << 8) | s_ramData[p_address - 0xf77f];
+    return (M_RAM.data[p_address - 0xf780] << 8)
+        | M_RAM.data[p_address - 0xf77f];
 }
 
 void ramWrite8(uint16_t p_address, uint8_t p_value) {
-    s_ramData[p_address - 0xf780] = p_value;
+    ramWriteByte(p_address - 0xf780, p_value);
 }
 
 void ramWrite16(uint16_t p_address, uint16_t p_value) {
-    s_ramData[p_address - 0xf780] = p_value >> 8;
-    s_ramData[p_address - 0xf77f] = p_value;
+    ramWriteByte(p_address - 0xf780, p_value >> 8);
+    ramWriteByte(p_address - 0xf77f, p_value);
+}
+
+// =============================================================================
+// Private functions definitions
+// =============================================================================
+static inline void ramWriteByte(uint16_t p_offset, uint8_t p_value) {
+    M_RAM.hash ^= hashMemoryByte(p_offset, M_RAM.data[p_offset])
+        ^ hashMemoryByte(p_offset, p_value);
+    M_RAM.data[p_offset] = p_value;
 }
@@ -6,6 +6,30 @@
 // =============================================================================
 #include <stdint.h>
 
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the size of the RAM.
+ */
+#define C_RAM_SIZE 2048
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure contains the state of the RAM.
+ */
+struct ts_ramState {
+    /**
+     * @brief This member contains the hash of data, updated on every write.
+     *        See hashMemory().
+     */
+    uint64_t hash;
+
+    uint8_t data[C_RAM_SIZE];
+};
+
 // =============================================================================
 // Public functions declarations
 // =============================================================================
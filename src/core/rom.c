@@ -1,77 +1,93 @@
 // =============================================================================
 // File inclusion
 // =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "common.h"
+#include "core/aot.h"
+#include "core/core.h"
+#include "core/hash.h"
+#include "core/hle.h"
+#include "core/instance.h"
+#include "core/rom.h"
+#include "core/scheduler.h"
 
 // =============================================================================
 // Private constant declarations
 // =============================================================================
-#define C_ROM_SIZE_BYTES 49152U
-
-// =============================================================================
-// Private variable declarations
-// =============================================================================
-static uint8_t *s_romData;
+/**
+ * @brief This constant defines the number of erase blocks of the FLASH ROM.
+ */
+#define C_ROM_ERASE_BLOCK_COUNT 6
 
-// =============================================================================
-// Private type declarations
-// =============================================================================
-union tu_flashMemoryControlRegister1 {
-    uint8_t byte;
-
-    struct {
-        uint8_t program : 1;
-        uint8_t erase : 1;
-        uint8_t programVerify : 1;
-        uint8_t eraseVerify : 1;
-        uint8_t programSetup : 1;
-        uint8_t eraseSetup : 1;
-        uint8_t softwareWriteEnable : 1;
-        uint8_t reserved : 1;
-    } bitField;
-};
+/**
+ * @brief This constant defines the duration of a program operation in cycles
+ *        (200 us).
+ */
+#define C_ROM_PROGRAM_DURATION_CYCLES (C_CORE_CLOCK_RATE_HZ / 5000U)
 
-union tu_flashMemoryControlRegister2 {
-    uint8_t byte;
+/**
+ * @brief This constant defines the duration of an erase operation in cycles
+ *        (10 ms).
+ */
+#define C_ROM_ERASE_DURATION_CYCLES (C_CORE_CLOCK_RATE_HZ / 100U)
 
-    struct {
-        uint8_t reserved : 7;
-        uint8_t flashMemoryError : 1;
-    } bitField;
-};
+/**
+ * @brief This macro gives access to the FLASH ROM state of the current
+ *        instance.
+ */
+#define M_ROM (g_coreInstance->state.rom)
 
-union tu_eraseBlockRegister1 {
-    uint8_t byte;
-
-    struct {
-        uint8_t eraseBlock0 : 1;
-        uint8_t eraseBlock1 : 1;
-        uint8_t eraseBlock2 : 1;
-        uint8_t eraseBlock3 : 1;
-        uint8_t eraseBlock4 : 1;
-        uint8_t eraseBlock5 : 1;
-        uint8_t reserved : 2;
-    } bitField;
-};
+/**
+ * @brief This macro gives access to the FLASH ROM contents of the current
+ *        instance.
+ */
+#define M_ROM_INSTANCE (g_coreInstance->rom)
 
-union tu_flashMemoryPowerControlRegister {
-    uint8_t byte;
+/**
+ * @brief This macro gives access to the FLASH ROM invalidation listeners of
+ *        the current instance.
+ */
+#define M_ROM_INVALIDATION_INSTANCE (g_coreInstance->romInvalidation)
 
-    struct {
-        uint8_t reserved : 7;
-        uint8_t powerDownDisable : 1;
-    } bitField;
+// =============================================================================
+// Private type declarations
+// =============================================================================
+struct ts_romEraseBlock {
+    uint16_t address;
+    uint16_t size;
 };
 
-union tu_flashMemoryEnableRegister {
-    uint8_t byte;
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This variable contains the hash of the buffer given to romInit().
+ */
+static uint64_t s_romHash;
+
+/**
+ * @brief This variable contains a pointer to the buffer given to romInit().
+ */
+static const uint8_t *s_romSharedData;
 
-    struct {
-        uint8_t reserved : 7;
-        uint8_t flashMemoryControlRegisterEnable;
-    } bitField;
+/**
+ * @brief This table describes the erase blocks of the FLASH ROM, in the order
+ *        of the EBR1 bits.
+ */
+static const struct ts_romEraseBlock
+    s_romEraseBlocks[C_ROM_ERASE_BLOCK_COUNT] = {
+    {.address = 0x0000U, .size = 0x0400U},
+    {.address = 0x0400U, .size = 0x0400U},
+    {.address = 0x0800U, .size = 0x0400U},
+    {.address = 0x0c00U, .size = 0x0400U},
+    {.address = 0x1000U, .size = 0x7000U},
+    {.address = 0x8000U, .size = 0x4000U}
 };
 
 // =============================================================================
@@ -140,20 +156,89 @@ static inline void write8FlashMemoryPowerControlRegister(uint8_t p_value);
  */
 static inline void write8FlashMemoryEnableRegister(uint8_t p_value);
 
+/**
+ * @brief Stores a byte written to the FLASH ROM area in the program buffer.
+ *
+ * @param[in] p_address The address of the byte.
+ * @param[in] p_value The value of the byte.
+ */
+static void romLatchProgramData(uint16_t p_address, uint8_t p_value);
+
+/**
+ * @brief Returns a pointer to the private copy of the FLASH ROM contents, and
+ *        creates it if necessary.
+ *
+ * @returns A pointer to the private copy of the FLASH ROM contents.
+ * @retval NULL if the private copy could not be allocated.
+ */
+static uint8_t *romGetPrivateData(void);
+
+/**
+ * @brief Starts the given operation. The operation is completed by the FLASH
+ *        scheduler event, or when its bit in FLMCR1 is cleared.
+ *
+ * @param[in] p_operation The operation to start.
+ * @param[in] p_duration The duration of the operation in cycles.
+ */
+static void romStartOperation(
+    enum te_romOperation p_operation,
+    uint64_t p_duration
+);
+
+/**
+ * @brief Performs the pending program operation and completes the event.
+ */
+static void romProgram(void);
+
+/**
+ * @brief Performs the pending erase operation and completes the event.
+ */
+static void romErase(void);
+
+/**
+ * @brief Notifies the invalidation listeners of the current instance that an
+ *        area of the FLASH ROM was modified.
+ *
+ * @param[in] p_address The address of the first modified byte.
+ * @param[in] p_size The number of modified bytes.
+ */
+static void romInvalidate(uint16_t p_address, uint16_t p_size);
+
 // =============================================================================
 // Public function definitions
 // =============================================================================
-void romInit(uint8_t *p_romBuffer) {
-    s_romData = p_romBuffer;
+void romInit(const uint8_t *p_romBuffer) {
+    s_romSharedData = p_romBuffer;
+    s_romHash = hashCompute(p_romBuffer, C_ROM_SIZE_BYTES);
+    hleInit(p_romBuffer);
+    aotUninstall();
+
+    if(g_coreInstance != NULL) {
+        romDeinitInstance();
+        romInvalidate(0x0000U, C_ROM_SIZE_BYTES);
+    }
+}
+
+uint64_t romGetHash(void) {
+    return s_romHash;
 }
 
 void romReset(void) {
-    // TODO: reset registers
+    schedulerCancel(E_SCHEDULER_EVENT_FLASH);
+
+    M_ROM.pendingOperation = E_ROM_OPERATION_NONE;
+    M_ROM.flmcr1.byte = 0x00U;
+    M_ROM.flmcr2.byte = 0x00U;
+    M_ROM.ebr1.byte = 0x00U;
+    M_ROM.flpwcr.byte = 0x00U;
+    M_ROM.fenr.byte = 0x00U;
+    M_ROM.programAddress = 0x0000U;
+    M_ROM.programBufferUsed = false;
 }
 
 uint8_t romRead8(uint16_t p_address) {
     if((p_address & 0xc000U) != 0xc000U) {
-        return s_romData[p_address];
+        return M_ROM_INSTANCE.data[p_address];
     } else if(p_address == 0xf020U) {
         return read8FlashMemoryControlRegister1();
     } else if(p_address == 0xf021U) {
@@ -173,15 +258,16 @@ uint16_t romRead16(uint16_t p_address) {
     uint16_t l_address = p_address & 0xfffeU;
 
     if((l_address & 0xc000) != 0xc000) {
-        return (s_romData[l_address] << 8U) | s_romData[l_address | 0x0001U];
-    } else { // TODO: registers?
-        return 0xffff;
+        return (M_ROM_INSTANCE.data[l_address] << 8U)
+            | M_ROM_INSTANCE.data[l_address | 0x0001U];
+    } else {
+        return (romRead8(l_address) << 8U) | romRead8(l_address | 0x0001U);
     }
 }
 
 void romWrite8(uint16_t p_address, uint8_t p_value) {
     if((p_address & 0xc000U) != 0xc000U) {
-        // TODO: ROM programming
+        romLatchProgramData(p_address, p_value);
     } else if(p_address == 0xf020U) {
         write8FlashMemoryControlRegister1(p_value);
     } else if(p_address == 0xf022U) {
@@ -193,57 +279,349 @@ void romWrite8(uint16_t p_address, uint8_t p_value) {
     }
 }
 
-void romWrite16(uint16_t p_address, uint8_t p_value) {
-    M_UNUSED_PARAMETER(p_address);
-    M_UNUSED_PARAMETER(p_value);
+void romWrite16(uint16_t p_address, uint16_t p_value) {
+    uint16_t l_address = p_address & 0xfffeU;
+
+    romWrite8(l_address, p_value >> 8U);
+    romWrite8(l_address | 0x0001U, p_value);
+}
+
+int romAddInvalidationListener(
+    tf_romInvalidationListener p_listener,
+    void *p_context
+) {
+    if(
+        M_ROM_INVALIDATION_INSTANCE.listenerCount
+        == C_ROM_MAX_INVALIDATION_LISTENERS
+    ) {
+        return 1;
+    }
+
+    struct ts_romInvalidationListener *l_listener =
+        &M_ROM_INVALIDATION_INSTANCE.listeners[
+            M_ROM_INVALIDATION_INSTANCE.listenerCount++
+        ];
+
+    l_listener->function = p_listener;
+    l_listener->context = p_context;
+
+    return 0;
+}
+
+void romRemoveInvalidationListener(
+    tf_romInvalidationListener p_listener,
+    void *p_context
+) {
+    struct ts_romInvalidationListener *l_listeners =
+        M_ROM_INVALIDATION_INSTANCE.listeners;
+    unsigned int l_count = 0U;
+
+    // The remaining listeners keep their order.
+    for(
+        unsigned int l_index = 0U;
+        l_index < M_ROM_INVALIDATION_INSTANCE.listenerCount;
+        l_index++
+    ) {
+        if(
+            (l_listeners[l_index].function != p_listener)
+            || (l_listeners[l_index].context != p_context)
+        ) {
+            l_listeners[l_count++] = l_listeners[l_index];
+        }
+    }
+
+    M_ROM_INVALIDATION_INSTANCE.listenerCount = l_count;
+}
+
+void romOnFlashEvent(void) {
+    if(M_ROM.pendingOperation == E_ROM_OPERATION_PROGRAM) {
+        romProgram();
+    } else if(M_ROM.pendingOperation == E_ROM_OPERATION_ERASE) {
+        romErase();
+    }
+}
 
-    // TODO
+void romInitInstance(void) {
+    M_ROM_INSTANCE.data = s_romSharedData;
+    M_ROM_INSTANCE.privateData = NULL;
+}
+
+void romDeinitInstance(void) {
+    free(M_ROM_INSTANCE.privateData);
+
+    M_ROM_INSTANCE.data = s_romSharedData;
+    M_ROM_INSTANCE.privateData = NULL;
+}
+
+const uint8_t *romGetModifiedData(void) {
+    return M_ROM_INSTANCE.privateData;
+}
+
+int romSetModifiedData(const uint8_t *p_data) {
+    if(p_data != NULL) {
+        uint8_t *l_romData = romGetPrivateData();
+
+        if(l_romData == NULL) {
+            return 1;
+        }
+
+        // Only the program units that differ are invalidated, so that loading
+        // a state keeps the cached code of the other units.
+        for(
+            uint32_t l_address = 0U;
+            l_address < C_ROM_SIZE_BYTES;
+            l_address += C_ROM_PROGRAM_UNIT_SIZE_BYTES
+        ) {
+            if(
+                memcmp(
+                    &l_romData[l_address],
+                    &p_data[l_address],
+                    C_ROM_PROGRAM_UNIT_SIZE_BYTES
+                ) != 0
+            ) {
+                memcpy(
+                    &l_romData[l_address],
+                    &p_data[l_address],
+                    C_ROM_PROGRAM_UNIT_SIZE_BYTES
+                );
+                romInvalidate(l_address, C_ROM_PROGRAM_UNIT_SIZE_BYTES);
+            }
+        }
+    } else if(M_ROM_INSTANCE.privateData != NULL) {
+        // Go back to the shared buffer.
+        romDeinitInstance();
+        romInvalidate(0x0000U, C_ROM_SIZE_BYTES);
+    }
+
+    return 0;
 }
 
 // =============================================================================
 // Private function definitions
 // =============================================================================
 static inline uint8_t read8FlashMemoryControlRegister1(void) {
-    // TODO: implement register
-    return 0xff;
+    if(M_ROM.fenr.bitField.flashMemoryControlRegisterEnable == 0U) {
+        return 0xffU;
+    }
+
+    return M_ROM.flmcr1.byte & 0x7fU;
 }
 
 static inline uint8_t read8FlashMemoryControlRegister2(void) {
-    // TODO: implement register
-    return 0xff;
+    if(M_ROM.fenr.bitField.flashMemoryControlRegisterEnable == 0U) {
+        return 0xffU;
+    }
+
+    return M_ROM.flmcr2.byte & 0x80U;
 }
 
 static inline uint8_t read8EraseBlockRegister1(void) {
-    // TODO: implement register
-    return 0xff;
+    if(M_ROM.fenr.bitField.flashMemoryControlRegisterEnable == 0U) {
+        return 0xffU;
+    }
+
+    return M_ROM.ebr1.byte & 0x3fU;
 }
 
 static inline uint8_t read8FlashMemoryPowerControlRegister(void) {
-    // TODO: implement register
-    return 0xff;
+    if(M_ROM.fenr.bitField.flashMemoryControlRegisterEnable == 0U) {
+        return 0xffU;
+    }
+
+    return M_ROM.flpwcr.byte & 0x80U;
 }
 
 static inline uint8_t read8FlashMemoryEnableRegister(void) {
-    // TODO: implement register
-    return 0xff;
+    return M_ROM.fenr.byte & 0x80U;
 }
 
 static inline void write8FlashMemoryControlRegister1(uint8_t p_value) {
-    // TODO: implement register
-    M_UNUSED_PARAMETER(p_value);
+    if(M_ROM.fenr.bitField.flashMemoryControlRegisterEnable == 0U) {
+        return;
+    }
+
+    union tu_flashMemoryControlRegister1 l_oldValue = M_ROM.flmcr1;
+
+    M_ROM.flmcr1.byte = p_value & 0x7fU;
+
+    // Without SWE, the other bits cannot be set.
+    if(M_ROM.flmcr1.bitField.softwareWriteEnable == 0U) {
+        M_ROM.flmcr1.byte = 0x00U;
+        M_ROM.programBufferUsed = false;
+    }
+
+    if(M_ROM.pendingOperation != E_ROM_OPERATION_NONE) {
+        // Clearing the P or E bit ends the pulse: the operation completes
+        // immediately instead of waiting for the scheduled event.
+        if(
+            (l_oldValue.bitField.program == 1U)
+            && (M_ROM.flmcr1.bitField.program == 0U)
+        ) {
+            romProgram();
+        } else if(
+            (l_oldValue.bitField.erase == 1U)
+            && (M_ROM.flmcr1.bitField.erase == 0U)
+        ) {
+            romErase();
+        }
+    } else if(
+        (l_oldValue.bitField.program == 0U)
+        && (M_ROM.flmcr1.bitField.program == 1U)
+        && (M_ROM.flmcr1.bitField.programSetup == 1U)
+    ) {
+        romStartOperation(
+            E_ROM_OPERATION_PROGRAM,
+            C_ROM_PROGRAM_DURATION_CYCLES
+        );
+    } else if(
+        (l_oldValue.bitField.erase == 0U)
+        && (M_ROM.flmcr1.bitField.erase == 1U)
+        && (M_ROM.flmcr1.bitField.eraseSetup == 1U)
+    ) {
+        romStartOperation(
+            E_ROM_OPERATION_ERASE,
+            C_ROM_ERASE_DURATION_CYCLES
+        );
+    }
 }
 
 static inline void write8EraseBlockRegister1(uint8_t p_value) {
-    // TODO: implement register
-    M_UNUSED_PARAMETER(p_value);
+    if(M_ROM.fenr.bitField.flashMemoryControlRegisterEnable == 0U) {
+        return;
+    }
+
+    // Only one block can be erased at a time, otherwise EBR1 is cleared.
+    uint8_t l_value = p_value & 0x3fU;
+
+    if((l_value & (l_value - 1U)) != 0U) {
+        l_value = 0x00U;
+    }
+
+    M_ROM.ebr1.byte = l_value;
 }
 
 static inline void write8FlashMemoryPowerControlRegister(uint8_t p_value) {
-    // TODO: implement register
-    M_UNUSED_PARAMETER(p_value);
+    if(M_ROM.fenr.bitField.flashMemoryControlRegisterEnable == 0U) {
+        return;
+    }
+
+    M_ROM.flpwcr.byte = p_value & 0x80U;
 }
 
 static inline void write8FlashMemoryEnableRegister(uint8_t p_value) {
-    // TODO: implement register
-    M_UNUSED_PARAMETER(p_value);
+    M_ROM.fenr.byte = p_value & 0x80U;
+}
+
+static void romLatchProgramData(uint16_t p_address, uint8_t p_value) {
+    if(M_ROM.flmcr1.bitField.softwareWriteEnable == 0U) {
+        return;
+    }
+
+    uint16_t l_programAddress =
+        p_address & ~(C_ROM_PROGRAM_UNIT_SIZE_BYTES - 1U);
+
+    if(
+        !M_ROM.programBufferUsed
+        || (l_programAddress != M_ROM.programAddress)
+    ) {
+        memset(M_ROM.programBuffer, 0xff, C_ROM_PROGRAM_UNIT_SIZE_BYTES);
+        M_ROM.programAddress = l_programAddress;
+        M_ROM.programBufferUsed = true;
+    }
+
+    M_ROM.programBuffer[p_address & (C_ROM_PROGRAM_UNIT_SIZE_BYTES - 1U)] =
+        p_value;
+}
+
+static void romStartOperation(
+    enum te_romOperation p_operation,
+    uint64_t p_duration
+) {
+    M_ROM.pendingOperation = p_operation;
+    schedulerSchedule(E_SCHEDULER_EVENT_FLASH, p_duration);
+}
+
+static void romProgram(void) {
+    schedulerCancel(E_SCHEDULER_EVENT_FLASH);
+    M_ROM.pendingOperation = E_ROM_OPERATION_NONE;
+
+    if(!M_ROM.programBufferUsed) {
+        return;
+    }
+
+    uint8_t *l_romData = romGetPrivateData();
+
+    if(l_romData == NULL) {
+        return;
+    }
+
+    // Programming can only clear bits, erasing is required to set them.
+    for(
+        uint16_t l_index = 0U;
+        l_index < C_ROM_PROGRAM_UNIT_SIZE_BYTES;
+        l_index++
+    ) {
+        l_romData[M_ROM.programAddress + l_index] &=
+            M_ROM.programBuffer[l_index];
+    }
+
+    M_ROM.programBufferUsed = false;
+
+    romInvalidate(M_ROM.programAddress, C_ROM_PROGRAM_UNIT_SIZE_BYTES);
+}
+
+static void romErase(void) {
+    schedulerCancel(E_SCHEDULER_EVENT_FLASH);
+    M_ROM.pendingOperation = E_ROM_OPERATION_NONE;
+
+    uint8_t *l_romData = romGetPrivateData();
+
+    if(l_romData == NULL) {
+        return;
+    }
+
+    for(int l_block = 0; l_block < C_ROM_ERASE_BLOCK_COUNT; l_block++) {
+        if((M_ROM.ebr1.byte & (1U << l_block)) != 0U) {
+            const struct ts_romEraseBlock *l_eraseBlock =
+                &s_romEraseBlocks[l_block];
+
+            memset(
+                &l_romData[l_eraseBlock->address],
+                0xff,
+                l_eraseBlock->size
+            );
+
+            romInvalidate(l_eraseBlock->address, l_eraseBlock->size);
+        }
+    }
+}
+
+static uint8_t *romGetPrivateData(void) {
+    if(M_ROM_INSTANCE.privateData == NULL) {
+        uint8_t *l_privateData = (uint8_t *)malloc(C_ROM_SIZE_BYTES);
+
+        if(l_privateData == NULL) {
+            fprintf(stderr, "Error: failed to copy the FLASH ROM.\n");
+            return NULL;
+        }
+
+        memcpy(l_privateData, M_ROM_INSTANCE.data, C_ROM_SIZE_BYTES);
+        M_ROM_INSTANCE.privateData = l_privateData;
+        M_ROM_INSTANCE.data = l_privateData;
+    }
+
+    return M_ROM_INSTANCE.privateData;
+}
+
+static void romInvalidate(uint16_t p_address, uint16_t p_size) {
+    for(
+        unsigned int l_index = 0U;
+        l_index < M_ROM_INVALIDATION_INSTANCE.listenerCount;
+        l_index++
+    ) {
+        const struct ts_romInvalidationListener *l_listener =
+            &M_ROM_INVALIDATION_INSTANCE.listeners[l_index];
+
+        l_listener->function(p_address, p_size, l_listener->context);
+    }
 }
@@ -4,20 +4,209 @@
 // =============================================================================
 // File inclusion
 // =============================================================================
+#include <stdbool.h>
 #include <stdint.h>
 
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the size of the FLASH ROM.
+ */
+#define C_ROM_SIZE_BYTES 49152U
+
+/**
+ * @brief This constant defines the number of bytes that are programmed at once
+ *        by a program operation.
+ */
+#define C_ROM_PROGRAM_UNIT_SIZE_BYTES 128U
+
+/**
+ * @brief This constant defines the size of a bitmap with one bit per program
+ *        unit of the FLASH ROM (see romMarkUnit()).
+ */
+#define C_ROM_UNIT_BITMAP_SIZE_BYTES \
+    (C_ROM_SIZE_BYTES / C_ROM_PROGRAM_UNIT_SIZE_BYTES / 8U)
+
+/**
+ * @brief This constant defines the maximum number of invalidation listeners
+ *        in an instance.
+ */
+#define C_ROM_MAX_INVALIDATION_LISTENERS 4U
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+union tu_flashMemoryControlRegister1 {
+    uint8_t byte;
+
+    struct {
+        uint8_t program : 1;
+        uint8_t erase : 1;
+        uint8_t programVerify : 1;
+        uint8_t eraseVerify : 1;
+        uint8_t programSetup : 1;
+        uint8_t eraseSetup : 1;
+        uint8_t softwareWriteEnable : 1;
+        uint8_t reserved : 1;
+    } bitField;
+};
+
+union tu_flashMemoryControlRegister2 {
+    uint8_t byte;
+
+    struct {
+        uint8_t reserved : 7;
+        uint8_t flashMemoryError : 1;
+    } bitField;
+};
+
+union tu_eraseBlockRegister1 {
+    uint8_t byte;
+
+    struct {
+        uint8_t eraseBlock0 : 1;
+        uint8_t eraseBlock1 : 1;
+        uint8_t eraseBlock2 : 1;
+        uint8_t eraseBlock3 : 1;
+        uint8_t eraseBlock4 : 1;
+        uint8_t eraseBlock5 : 1;
+        uint8_t reserved : 2;
+    } bitField;
+};
+
+union tu_flashMemoryPowerControlRegister {
+    uint8_t byte;
+
+    struct {
+        uint8_t reserved : 7;
+        uint8_t powerDownDisable : 1;
+    } bitField;
+};
+
+union tu_flashMemoryEnableRegister {
+    uint8_t byte;
+
+    struct {
+        uint8_t reserved : 7;
+        uint8_t flashMemoryControlRegisterEnable : 1;
+    } bitField;
+};
+
+enum te_romOperation {
+    E_ROM_OPERATION_NONE,
+    E_ROM_OPERATION_PROGRAM,
+    E_ROM_OPERATION_ERASE
+};
+
+/**
+ * @brief This type describes a function that is called everytime the FLASH ROM
+ *        contents of an instance change, with the instance selected. When it
+ *        is called, romGetModifiedData() already returns the new contents.
+ *
+ * @param[in] p_address The address of the first modified byte.
+ * @param[in] p_size The number of bytes in the modified area.
+ * @param[in] p_context The context given to romAddInvalidationListener().
+ */
+typedef void (*tf_romInvalidationListener)(
+    uint16_t p_address,
+    uint16_t p_size,
+    void *p_context
+);
+
+/**
+ * @brief This structure contains the state of the FLASH memory controller.
+ */
+struct ts_romState {
+    union tu_flashMemoryControlRegister1 flmcr1;
+    union tu_flashMemoryControlRegister2 flmcr2;
+    union tu_eraseBlockRegister1 ebr1;
+    union tu_flashMemoryPowerControlRegister flpwcr;
+    union tu_flashMemoryEnableRegister fenr;
+
+    /**
+     * @brief This member contains the data written to the FLASH ROM while the
+     *        SWE bit is set. It is programmed when the P bit is set.
+     */
+    uint8_t programBuffer[C_ROM_PROGRAM_UNIT_SIZE_BYTES];
+
+    /**
+     * @brief This member contains the address of the area of the FLASH ROM
+     *        that programBuffer will be programmed to.
+     */
+    uint16_t programAddress;
+
+    /**
+     * @brief This member indicates whether programBuffer contains data.
+     */
+    bool programBufferUsed;
+
+    /**
+     * @brief This member contains the operation that will be completed by the
+     *        FLASH scheduler event.
+     */
+    enum te_romOperation pendingOperation;
+};
+
+/**
+ * @brief This structure contains the FLASH ROM contents of an instance. It is
+ *        not part of the saved state because it contains pointers.
+ */
+struct ts_romInstance {
+    /**
+     * @brief This member contains a pointer to the FLASH ROM contents used for
+     *        reading. It points either to the shared buffer given to romInit(),
+     *        or to privateData once the FLASH ROM was modified.
+     */
+    const uint8_t *data;
+
+    /**
+     * @brief This member contains a pointer to the private copy of the FLASH
+     *        ROM contents, or NULL if the FLASH ROM has never been modified.
+     */
+    uint8_t *privateData;
+};
+
+struct ts_romInvalidationListener {
+    tf_romInvalidationListener function;
+    void *context;
+};
+
+/**
+ * @brief This structure contains the invalidation listeners of an instance.
+ *        It is kept apart from ts_romInstance, which is read on every
+ *        instruction fetch.
+ */
+struct ts_romInvalidationInstance {
+    struct ts_romInvalidationListener
+        listeners[C_ROM_MAX_INVALIDATION_LISTENERS];
+    uint8_t listenerCount;
+};
+
 // =============================================================================
 // Public function declarations
 // =============================================================================
 /**
  * @brief Initializes the ROM buffer.
  * 
- * @param[in,out] p_romBuffer The ROM buffer to use. Note that this buffer must
- *                            not be freed after calling this function because
- *                            this function stores a pointer to it, and does not
- *                            make a copy.
+ * @param[in] p_romBuffer The ROM buffer to use. Note that this buffer must
+ *                        not be freed after calling this function because
+ *                        this function stores a pointer to it, and does not
+ *                        make a copy. The buffer is never modified: it can be
+ *                        a read-only mapping shared with other processes. When
+ *                        the FLASH ROM is programmed or erased, a private copy
+ *                        of the buffer is made first.
+ */
+void romInit(const uint8_t *p_romBuffer);
+
+/**
+ * @brief Returns the hash of the ROM buffer, computed once when romInit() was
+ *        called. Caches derived from the FLASH ROM contents can be keyed by
+ *        this value.
+ *
+ * @returns The hash of the ROM buffer.
  */
-void romInit(uint8_t *p_romBuffer);
+uint64_t romGetHash(void);
 
 /**
  * @brief Performs a reset of the FLASH ROM.
@@ -58,4 +247,107 @@ void romWrite8(uint16_t p_address, uint8_t p_value);
  */
 void romWrite16(uint16_t p_address, uint16_t p_value);
 
-#endif
+/**
+ * @brief Registers a function that will be called everytime an area of the
+ *        FLASH ROM of the current instance is programmed, erased or replaced.
+ *        Caches built from the shared FLASH ROM buffer (HLE routines, AOT code
+ *        and decoded instructions) subscribe to this event in order to drop
+ *        the entries that overlap the modified area.
+ *
+ * @param[in] p_listener The function to call.
+ * @param[in] p_context The value to pass to the function.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the listener was registered successfully.
+ * @retval Any other value if the maximum number of listeners was reached.
+ */
+int romAddInvalidationListener(
+    tf_romInvalidationListener p_listener,
+    void *p_context
+);
+
+/**
+ * @brief Removes a listener added with romAddInvalidationListener() from the
+ *        current instance.
+ *
+ * @param[in] p_listener The function given to romAddInvalidationListener().
+ * @param[in] p_context The context given to romAddInvalidationListener().
+ */
+void romRemoveInvalidationListener(
+    tf_romInvalidationListener p_listener,
+    void *p_context
+);
+
+/**
+ * @brief Completes the pending program or erase operation.
+ * @details This function shall only be called by the scheduler module.
+ */
+void romOnFlashEvent(void);
+
+/**
+ * @brief Makes the current instance read the shared FLASH ROM buffer.
+ * @details This function shall only be called when an instance is created.
+ */
+void romInitInstance(void);
+
+/**
+ * @brief Frees the private copy of the FLASH ROM of the current instance, if
+ *        any, and makes it read the shared FLASH ROM buffer again.
+ */
+void romDeinitInstance(void);
+
+/**
+ * @brief Returns the FLASH ROM contents of the current instance if they differ
+ *        from the shared buffer given to romInit().
+ * @details When this function returns NULL, every entry of the caches built
+ *          from the shared buffer is valid for the current instance again.
+ *
+ * @returns A pointer to the modified FLASH ROM contents.
+ * @retval NULL if the FLASH ROM was never programmed or erased.
+ */
+const uint8_t *romGetModifiedData(void);
+
+/**
+ * @brief Replaces the FLASH ROM contents of the current instance. The
+ *        invalidation listeners are notified of the program units that
+ *        changed, and of the whole FLASH ROM when going back to the shared
+ *        buffer.
+ *
+ * @param[in] p_data A pointer to C_ROM_SIZE_BYTES bytes to copy, or NULL to
+ *                   go back to the shared buffer given to romInit().
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if the private copy could not be allocated.
+ */
+int romSetModifiedData(const uint8_t *p_data);
+
+/**
+ * @brief Marks the program unit that contains the given address in a bitmap of
+ *        C_ROM_UNIT_BITMAP_SIZE_BYTES bytes.
+ *
+ * @param[in,out] p_bitmap The bitmap.
+ * @param[in] p_address An address in the FLASH ROM.
+ */
+static inline void romMarkUnit(uint8_t *p_bitmap, uint16_t p_address) {
+    p_bitmap[p_address >> 10] |= 1U << ((p_address >> 7) & 0x07U);
+}
+
+/**
+ * @brief Checks if the program unit that contains the given address is marked
+ *        in a bitmap of C_ROM_UNIT_BITMAP_SIZE_BYTES bytes.
+ *
+ * @param[in] p_bitmap The bitmap.
+ * @param[in] p_address An address in the FLASH ROM.
+ *
+ * @returns A boolean value that indicates whether the unit is marked.
+ */
+static inline bool romIsUnitMarked(
+    const uint8_t *p_bitmap,
+    uint16_t p_address
+) {
+    return (p_bitmap[p_address >> 10] & (1U << ((p_address >> 7) & 0x07U)))
+        != 0U;
+}
+
+#endif // __INC_CORE_ROM_H__
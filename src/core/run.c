@@ -0,0 +1,132 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/core.h"
+#include "core/instance.h"
+#include "core/run.h"
+#include "core/scheduler.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This macro gives access to the run settings of the current instance.
+ */
+#define M_RUN_INSTANCE (g_coreInstance->run)
+
+/**
+ * @brief This macro gives access to the CPU state of the current instance.
+ */
+#define M_CPU (g_coreInstance->state.cpu)
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Checks if there is a breakpoint at PC.
+ *
+ * @returns A boolean value that indicates whether there is a breakpoint at PC.
+ */
+static bool runIsAtBreakpoint(void);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+void coreRunUntil(
+    uint64_t p_cycleBudget,
+    uint32_t p_eventMask,
+    enum te_coreEvent *p_reason
+) {
+    M_RUN_INSTANCE.eventMask = p_eventMask | E_CORE_EVENT_BUDGET;
+    M_RUN_INSTANCE.stopReason = 0U;
+
+    // The budget is an event of the scheduler, which already compares the
+    // cycle counter with the closest deadline.
+    if(p_cycleBudget != 0U) {
+        schedulerSchedule(E_SCHEDULER_EVENT_RUN_BUDGET, p_cycleBudget);
+    }
+
+    // The PC checks are only done by a separate loop, so that runs without
+    // breakpoints do not pay for them.
+    if(
+        ((p_eventMask & E_CORE_EVENT_BREAKPOINT) != 0U)
+        && (M_RUN_INSTANCE.breakpointCount > 0U)
+    ) {
+        do {
+            coreStep();
+
+            if((M_RUN_INSTANCE.stopReason == 0U) && runIsAtBreakpoint()) {
+                M_RUN_INSTANCE.stopReason = E_CORE_EVENT_BREAKPOINT;
+            }
+        } while(M_RUN_INSTANCE.stopReason == 0U);
+    } else {
+        do {
+            coreStep();
+        } while(M_RUN_INSTANCE.stopReason == 0U);
+    }
+
+    schedulerCancel(E_SCHEDULER_EVENT_RUN_BUDGET);
+    M_RUN_INSTANCE.eventMask = 0U;
+
+    if(p_reason != NULL) {
+        *p_reason = (enum te_coreEvent)M_RUN_INSTANCE.stopReason;
+    }
+}
+
+int coreAddBreakpoint(uint16_t p_address) {
+    if(M_RUN_INSTANCE.breakpointCount == C_RUN_MAX_BREAKPOINTS) {
+        return 1;
+    }
+
+    M_RUN_INSTANCE.breakpoints[M_RUN_INSTANCE.breakpointCount++] = p_address;
+
+    return 0;
+}
+
+int coreRemoveBreakpoint(uint16_t p_address) {
+    struct ts_runInstance *l_run = &M_RUN_INSTANCE;
+
+    for(size_t l_index = 0U; l_index < l_run->breakpointCount; l_index++) {
+        if(l_run->breakpoints[l_index] == p_address) {
+            l_run->breakpointCount--;
+            l_run->breakpoints[l_index] =
+                l_run->breakpoints[l_run->breakpointCount];
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+void runNotifyEvent(enum te_coreEvent p_event) {
+    if(
+        ((M_RUN_INSTANCE.eventMask & p_event) != 0U)
+        && (M_RUN_INSTANCE.stopReason == 0U)
+    ) {
+        M_RUN_INSTANCE.stopReason = p_event;
+    }
+}
+
+void runOnBudgetEvent(void) {
+    runNotifyEvent(E_CORE_EVENT_BUDGET);
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static bool runIsAtBreakpoint(void) {
+    const struct ts_runInstance *l_run = &M_RUN_INSTANCE;
+
+    for(size_t l_index = 0U; l_index < l_run->breakpointCount; l_index++) {
+        if(l_run->breakpoints[l_index] == M_CPU.registerPC) {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,62 @@
+#ifndef __INC_CORE_RUN_H__
+#define __INC_CORE_RUN_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/core.h"
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the maximum number of breakpoints of an
+ *        instance.
+ */
+#define C_RUN_MAX_BREAKPOINTS 16U
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure contains the run settings of a core instance. They are
+ *        not part of the emulated state: they only exist while coreRunUntil()
+ *        runs, except for the breakpoints.
+ */
+struct ts_runInstance {
+    /**
+     * @brief This member contains the te_coreEvent values that end the current
+     *        run, or 0 outside of coreRunUntil().
+     */
+    uint32_t eventMask;
+
+    /**
+     * @brief This member contains the event that ended the current run, or 0
+     *        if the run goes on.
+     */
+    uint32_t stopReason;
+
+    uint16_t breakpoints[C_RUN_MAX_BREAKPOINTS];
+    size_t breakpointCount;
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Signals an event to the current run. The run stops at the end of the
+ *        current step if the event is in its event mask.
+ *
+ * @param[in] p_event The event that occurred.
+ */
+void runNotifyEvent(enum te_coreEvent p_event);
+
+/**
+ * @brief Handles the budget event of the scheduler.
+ */
+void runOnBudgetEvent(void);
+
+#endif // __INC_CORE_RUN_H__
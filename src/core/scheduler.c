@@ -0,0 +1,174 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/instance.h"
+#include "core/lcd.h"
+#include "core/metrics.h"
+#include "core/rom.h"
+#include "core/run.h"
+#include "core/scheduler.h"
+#include "core/timerw.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This macro gives access to the scheduler state of the current
+ *        instance.
+ */
+#define M_SCHEDULER (g_coreInstance->state.scheduler)
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+typedef void (*tf_schedulerCallback)(void);
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This table contains the handler of every event. The handlers are not
+ *        part of the event state so that the state can be saved.
+ */
+static const tf_schedulerCallback
+    s_schedulerCallbacks[E_SCHEDULER_EVENT_COUNT] = {
+    [E_SCHEDULER_EVENT_FLASH] = romOnFlashEvent,
+    [E_SCHEDULER_EVENT_RUN_BUDGET] = runOnBudgetEvent,
+    [E_SCHEDULER_EVENT_LCD_REFRESH] = lcdOnRefreshEvent,
+    [E_SCHEDULER_EVENT_TIMER_W] = timerWOnMatchEvent
+};
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Computes the next deadline from the pending events.
+ */
+static void schedulerUpdateNextDeadline(void);
+
+/**
+ * @brief Runs all the events whose deadline has been reached.
+ */
+static void schedulerRunEvents(void);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+void schedulerReset(void) {
+    M_SCHEDULER.cycles = 0U;
+    M_SCHEDULER.deferredCycles = 0U;
+
+    for(int l_event = 0; l_event < E_SCHEDULER_EVENT_COUNT; l_event++) {
+        M_SCHEDULER.events[l_event].pending = false;
+        M_SCHEDULER.events[l_event].deadline = UINT64_MAX;
+    }
+
+    M_SCHEDULER.nextDeadline = UINT64_MAX;
+}
+
+void schedulerCycle(void) {
+    M_SCHEDULER.cycles++;
+    M_METRICS_ADD(cycles, 1U);
+
+    if(M_SCHEDULER.cycles >= M_SCHEDULER.nextDeadline) {
+        schedulerRunEvents();
+    }
+}
+
+void schedulerDeferCycle(void) {
+    M_SCHEDULER.deferredCycles++;
+}
+
+uint64_t schedulerGetDeferredCycles(void) {
+    return M_SCHEDULER.deferredCycles;
+}
+
+uint64_t schedulerTakeDeferredCycles(void) {
+    uint64_t l_deferredCycles = M_SCHEDULER.deferredCycles;
+
+    M_SCHEDULER.deferredCycles = 0U;
+
+    return l_deferredCycles;
+}
+
+void schedulerAdvance(uint64_t p_cycles) {
+    M_SCHEDULER.cycles += p_cycles;
+    M_METRICS_ADD(cycles, p_cycles);
+
+    if(M_SCHEDULER.cycles >= M_SCHEDULER.nextDeadline) {
+        schedulerRunEvents();
+    }
+}
+
+uint64_t schedulerGetCyclesToNextEvent(void) {
+    if(M_SCHEDULER.nextDeadline == UINT64_MAX) {
+        return UINT64_MAX;
+    } else if(M_SCHEDULER.nextDeadline <= schedulerGetCycles()) {
+        return 0U;
+    } else {
+        return M_SCHEDULER.nextDeadline - schedulerGetCycles();
+    }
+}
+
+uint64_t schedulerGetCycles(void) {
+    return M_SCHEDULER.cycles + M_SCHEDULER.deferredCycles;
+}
+
+void schedulerSchedule(enum te_schedulerEvent p_event, uint64_t p_delay) {
+    M_SCHEDULER.events[p_event].pending = true;
+    M_SCHEDULER.events[p_event].deadline = schedulerGetCycles() + p_delay;
+
+    schedulerUpdateNextDeadline();
+}
+
+void schedulerCancel(enum te_schedulerEvent p_event) {
+    M_SCHEDULER.events[p_event].pending = false;
+    M_SCHEDULER.events[p_event].deadline = UINT64_MAX;
+
+    schedulerUpdateNextDeadline();
+}
+
+bool schedulerIsScheduled(enum te_schedulerEvent p_event) {
+    return M_SCHEDULER.events[p_event].pending;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static void schedulerUpdateNextDeadline(void) {
+    M_SCHEDULER.nextDeadline = UINT64_MAX;
+
+    for(int l_event = 0; l_event < E_SCHEDULER_EVENT_COUNT; l_event++) {
+        if(
+            M_SCHEDULER.events[l_event].pending
+            && (M_SCHEDULER.events[l_event].deadline < M_SCHEDULER.nextDeadline)
+        ) {
+            M_SCHEDULER.nextDeadline = M_SCHEDULER.events[l_event].deadline;
+        }
+    }
+}
+
+static void schedulerRunEvents(void) {
+    for(int l_event = 0; l_event < E_SCHEDULER_EVENT_COUNT; l_event++) {
+        struct ts_schedulerEvent *l_schedulerEvent =
+            &M_SCHEDULER.events[l_event];
+
+        if(
+            l_schedulerEvent->pending
+            && (l_schedulerEvent->deadline <= M_SCHEDULER.cycles)
+        ) {
+            // The event is marked as done before calling the callback so that
+            // the callback can reschedule it.
+            l_schedulerEvent->pending = false;
+            l_schedulerEvent->deadline = UINT64_MAX;
+            M_METRICS_ADD(schedulerEvents, 1U);
+            s_schedulerCallbacks[l_event]();
+        }
+    }
+
+    schedulerUpdateNextDeadline();
+}
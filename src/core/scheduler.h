@@ -0,0 +1,146 @@
+#ifndef __INC_CORE_SCHEDULER_H__
+#define __INC_CORE_SCHEDULER_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stdint.h>
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This enumeration lists the events that can be scheduled. Each event
+ *        can only be pending once at a time.
+ */
+enum te_schedulerEvent {
+    E_SCHEDULER_EVENT_FLASH,
+    E_SCHEDULER_EVENT_RUN_BUDGET,
+    E_SCHEDULER_EVENT_LCD_REFRESH,
+    E_SCHEDULER_EVENT_TIMER_W,
+    E_SCHEDULER_EVENT_COUNT
+};
+
+struct ts_schedulerEvent {
+    bool pending;
+    uint64_t deadline;
+};
+
+/**
+ * @brief This structure contains the state of the scheduler.
+ */
+struct ts_schedulerState {
+    /**
+     * @brief This member contains the number of cycles elapsed since the last
+     *        reset.
+     */
+    uint64_t cycles;
+
+    /**
+     * @brief This member contains the number of cycles counted on the bus but
+     *        not applied to the peripherals yet, when the accuracy profile
+     *        defers them (see busSync()).
+     */
+    uint64_t deferredCycles;
+
+    /**
+     * @brief This member contains the deadline of the closest pending event,
+     *        so that only one comparison is needed per cycle.
+     */
+    uint64_t nextDeadline;
+
+    struct ts_schedulerEvent events[E_SCHEDULER_EVENT_COUNT];
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Resets the scheduler. All the pending events are cancelled and the
+ *        cycle counter is set back to 0.
+ */
+void schedulerReset(void);
+
+/**
+ * @brief Advances the scheduler by one cycle and runs the events that are due.
+ * @details This function shall only be called by the bus module.
+ */
+void schedulerCycle(void);
+
+/**
+ * @brief Counts one cycle without advancing the scheduler. The deferred cycles
+ *        are applied later with schedulerAdvance().
+ * @details This function shall only be called by the bus module.
+ */
+void schedulerDeferCycle(void);
+
+/**
+ * @brief Returns the number of deferred cycles.
+ *
+ * @returns The number of cycles deferred since the last call to
+ *          schedulerTakeDeferredCycles().
+ */
+uint64_t schedulerGetDeferredCycles(void);
+
+/**
+ * @brief Returns the number of deferred cycles and resets it.
+ *
+ * @returns The number of cycles deferred since the last call.
+ */
+uint64_t schedulerTakeDeferredCycles(void);
+
+/**
+ * @brief Advances the scheduler by the given number of cycles at once and runs
+ *        the events that are due. The events are run at the end, so they can
+ *        be late by up to the given number of cycles.
+ * @details This function shall only be called by the bus module.
+ *
+ * @param[in] p_cycles The number of cycles to advance by.
+ */
+void schedulerAdvance(uint64_t p_cycles);
+
+/**
+ * @brief Returns the number of cycles before the closest pending event.
+ *
+ * @returns The number of cycles before the closest pending event.
+ * @retval UINT64_MAX if no event is pending.
+ */
+uint64_t schedulerGetCyclesToNextEvent(void);
+
+/**
+ * @brief Returns the number of cycles elapsed since the last reset, including
+ *        the deferred cycles.
+ *
+ * @returns The number of cycles elapsed since the last reset.
+ */
+uint64_t schedulerGetCycles(void);
+
+/**
+ * @brief Schedules the given event. If the event was already pending, it is
+ *        rescheduled. The delay counts from the current cycle, including the
+ *        deferred cycles. When the event is triggered, the handler of the
+ *        module that owns the event is called.
+ *
+ * @param[in] p_event The event to schedule.
+ * @param[in] p_delay The number of cycles after which the event is triggered.
+ */
+void schedulerSchedule(enum te_schedulerEvent p_event, uint64_t p_delay);
+
+/**
+ * @brief Cancels the given event. Nothing happens if the event is not pending.
+ *
+ * @param[in] p_event The event to cancel.
+ */
+void schedulerCancel(enum te_schedulerEvent p_event);
+
+/**
+ * @brief Checks if the given event is pending.
+ *
+ * @param[in] p_event The event to check.
+ *
+ * @returns A boolean value that indicates whether the event is pending.
+ */
+bool schedulerIsScheduled(enum te_schedulerEvent p_event);
+
+#endif // __INC_CORE_SCHEDULER_H__
@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "core/eeprom.h"
+#include "core/instance.h"
 #include "core/ssu.h"
 
 // =============================================================================
@@ -44,149 +46,31 @@
  */
 #define C_SSU_REGADDR_SSTDR 0xf0eb
 
-// =============================================================================
-// Private type declarations
-// =============================================================================
-union tu_ssuSscrh {
-    struct {
-        uint8_t css : 2;
-        uint8_t scks : 1;
-        uint8_t solp : 1;
-        uint8_t sol : 1;
-        uint8_t soos : 1;
-        uint8_t bide : 1;
-        uint8_t mss : 1;
-    } bitField;
-
-    uint8_t byte;
-};
-
-union tu_ssuSscrl {
-    struct {
-        uint8_t reserved : 3;
-        uint8_t csos : 1;
-        uint8_t sckos : 1;
-        uint8_t sres : 1;
-        uint8_t ssums : 1;
-        uint8_t reserved2 : 1;
-    } bitField;
-
-    uint8_t byte;
-};
-
-union tu_ssuSsmr {
-    struct {
-        uint8_t cks : 3;
-        uint8_t reserved : 2;
-        uint8_t cphs : 1;
-        uint8_t cpos : 1;
-        uint8_t mls : 1;
-    } bitField;
-
-    uint8_t byte;
-};
-
-union tu_ssuSser {
-    struct {
-        uint8_t ceie : 1;
-        uint8_t rie : 1;
-        uint8_t tie : 1;
-        uint8_t teie : 1;
-        uint8_t reserved : 1;
-        uint8_t rsstp : 1;
-        uint8_t re : 1;
-        uint8_t te : 1;
-    } bitField;
-
-    uint8_t byte;
-};
-
-union tu_ssuSssr {
-    struct {
-        uint8_t ce : 1;
-        uint8_t rdrf : 1;
-        uint8_t tdre : 1;
-        uint8_t tend : 1;
-        uint8_t reserved : 2;
-        uint8_t orer : 1;
-        uint8_t reserved2 : 1;
-    } bitField;
-
-    uint8_t byte;
-};
-
-// =============================================================================
-// Private variable declarations
-// =============================================================================
-/**
- * @brief This variable represents the SSCRH register. This register contains
- *        the first part of the SSU configuration. This register is ignored by
- *        this emulator because its value is always set to 0x8c by the
- *        pokéwalker ROM.
- */
-static union tu_ssuSscrh s_ssuSscrh;
-
-/**
- * @brief This variable represents the SSCRL register. This register contains
- *        the second part of the SSU configuration. This register is ignored by
- *        this emulator because its value is always set to 0x40 by the
- *        pokéwalker ROM.
- */
-static union tu_ssuSscrl s_ssuSscrl;
-
-/**
- * @brief This variable represents the SSMR register. This register contains the
- *        settings for serial data transmission.
- */
-static union tu_ssuSsmr s_ssuSsmr;
-
-/**
- * @brief This variable represents the SSER register. This register contains the
- *        transmit, receive and interrupt enable bits of the SSU.
- */
-static union tu_ssuSser s_ssuSser;
-
-/**
- * @brief This variable represents the SSSR register. This register contains the
- *        interrupt flags related to the SSU operation.
- */
-static union tu_ssuSssr s_ssuSssr;
-
-/**
- * @brief This variable represents the SSRDR register. This register contains
- *        the data copied from SSTRSR after one transaction.
- */
-static uint8_t s_ssuSsrdr;
-
 /**
- * @brief This variable represents the SSTDR register. This register contains
- *        the data to be copied into SSTRSR and sent.
+ * @brief This macro gives access to the SSU state of the current instance.
  */
-static uint8_t s_ssuSstdr;
+#define M_SSU (g_coreInstance->state.ssu)
 
 /**
- * @brief This variable represents the SSTRSR register. This register is a shift
- *        register that contains the data to be transmitted as well as the
- *        received data. Note that this register is an internal register that
- *        cannot be accessed by the CPU.
+ * @brief This constant defines the number of prescaler clocks in one SSU
+ *        clock.
  */
-static uint8_t s_ssuSstrsr;
+#define C_SSU_CLOCKS_PER_BIT 256
 
 /**
- * @brief This variable contains the clock counter for the prescaler.
- * @details One SSU clock occurs when this variable reaches a value >= 256.
+ * @brief This constant defines the number of bits in one transfer.
  */
-static int s_ssuClockCounter;
-
-/**
- * @brief This variable contains the bit counter for the current transfer.
- * @details The transfer ends when this variable reaches 8.
- */
-static int s_ssuBitCounter;
+#define C_SSU_BITS_PER_TRANSFER 8
 
 // =============================================================================
 // Private function declarations
 // =============================================================================
+/**
+ * @brief Ends the transfer of the byte in SSTRSR, and starts the transfer of
+ *        the next byte if SSTDR is full.
+ */
+static void ssuEndByteTransfer(void);
+
 /**
  * @brief Returns the value of the SSRDR register and performs side-effects.
  * @details Reading from SSRDR clears the SSSR.RDRF bit.
@@ -207,26 +91,27 @@ static void ssuWriteSstdr(uint8_t p_value);
 // Public functions definitions
 // =============================================================================
 void ssuReset(void) {
-    s_ssuSscrh.byte = 0x08;
-    s_ssuSscrl.byte = 0x00;
-    s_ssuSsmr.byte = 0x00;
-    s_ssuSser.byte = 0x00;
-    s_ssuSssr.byte = 0x04;
-    s_ssuSsrdr = 0x00;
-    s_ssuSstdr = 0x00;
-    s_ssuClockCounter = 0;
-    s_ssuBitCounter = 0;
+    M_SSU.sscrh.byte = 0x08;
+    M_SSU.sscrl.byte = 0x00;
+    M_SSU.ssmr.byte = 0x00;
+    M_SSU.sser.byte = 0x00;
+    M_SSU.sssr.byte = 0x04;
+    M_SSU.ssrdr = 0x00;
+    M_SSU.sstdr = 0x00;
+    M_SSU.transferring = false;
+    M_SSU.clockCounter = 0;
+    M_SSU.bitCounter = 0;
 }
 
 uint8_t ssuRead8(uint16_t p_address) {
     switch(p_address) {
-        case C_SSU_REGADDR_SSCRH: return s_ssuSscrh.byte;
-        case C_SSU_REGADDR_SSCRL: return s_ssuSscrl.byte & 0x78;
-        case C_SSU_REGADDR_SSMR: return s_ssuSsmr.byte & 0xe7;
-        case C_SSU_REGADDR_SSER: return s_ssuSser.byte & 0xef;
-        case C_SSU_REGADDR_SSSR: return s_ssuSssr.byte & 0x4f;
+        case C_SSU_REGADDR_SSCRH: return M_SSU.sscrh.byte;
+        case C_SSU_REGADDR_SSCRL: return M_SSU.sscrl.byte & 0x78;
+        case C_SSU_REGADDR_SSMR: return M_SSU.ssmr.byte & 0xe7;
+        case C_SSU_REGADDR_SSER: return M_SSU.sser.byte & 0xef;
+        case C_SSU_REGADDR_SSSR: return M_SSU.sssr.byte & 0x4f;
         case C_SSU_REGADDR_SSRDR: return ssuReadSsrdr();
-        case C_SSU_REGADDR_SSTDR: return s_ssuSstdr;
+        case C_SSU_REGADDR_SSTDR: return M_SSU.sstdr;
         default: return 0xff;
     }
 }
@@ -237,11 +122,11 @@ uint16_t ssuRead16(uint16_t p_address) {
 
 void ssuWrite8(uint16_t p_address, uint8_t p_value) {
     switch(p_address) {
-        case C_SSU_REGADDR_SSCRH: s_ssuSscrh.byte = p_value; break;
-        case C_SSU_REGADDR_SSCRL: s_ssuSscrl.byte = p_value; break;
-        case C_SSU_REGADDR_SSMR: s_ssuSsmr.byte = p_value; break;
-        case C_SSU_REGADDR_SSER: s_ssuSser.byte = p_value; break;
-        case C_SSU_REGADDR_SSSR: s_ssuSssr.byte &= p_value; break;
+        case C_SSU_REGADDR_SSCRH: M_SSU.sscrh.byte = p_value; break;
+        case C_SSU_REGADDR_SSCRL: M_SSU.sscrl.byte = p_value; break;
+        case C_SSU_REGADDR_SSMR: M_SSU.ssmr.byte = p_value; break;
+        case C_SSU_REGADDR_SSER: M_SSU.sser.byte = p_value; break;
+        case C_SSU_REGADDR_SSSR: M_SSU.sssr.byte &= p_value; break;
         case C_SSU_REGADDR_SSRDR: break;
         case C_SSU_REGADDR_SSTDR: ssuWriteSstdr(p_value); break;
         default: break;
@@ -254,59 +139,97 @@ void ssuWrite16(uint16_t p_address, uint16_t p_value) {
 
 void ssuCycle(void) {
     // If a transfer is in progress
-    if(s_ssuSssr.bitField.tend == 0) {
-        s_ssuClockCounter += 1 << s_ssuSsmr.bitField.cks;
-
-        if(s_ssuClockCounter >= 256) {
-            s_ssuClockCounter -= 256;
-
-            s_ssuBitCounter++;
-
-            if(s_ssuBitCounter == 8) {
-                // TODO: Actually perform the transfer
-
-                if(s_ssuSssr.bitField.tdre == 0) {
-                    // If there is data in the buffer, keep transferring data.
-                    s_ssuSstrsr = s_ssuSstdr;
-                    s_ssuSssr.bitField.tdre = 1;
-                } else {
-                    // Otherwise stop the transfer.
-                    s_ssuSssr.bitField.tend = 1;
-                }
-
-                if(s_ssuSssr.bitField.rdrf == 1) {
-                    // If there is still data left in SSRDR, then the new data
-                    // is lost, and an error flag is set.
-                    s_ssuSssr.bitField.orer = 1;
-                } else {
-                    // Otherwise SSRDR contains the received data.
-                    // TODO: Return the actual received data from the transfer.
-                    s_ssuSsrdr = 0xff;
-                }
-
-                s_ssuBitCounter = 0;
+    if(M_SSU.transferring) {
+        M_SSU.clockCounter += 1 << M_SSU.ssmr.bitField.cks;
+
+        if(M_SSU.clockCounter >= C_SSU_CLOCKS_PER_BIT) {
+            M_SSU.clockCounter -= C_SSU_CLOCKS_PER_BIT;
+
+            M_SSU.bitCounter++;
+
+            if(M_SSU.bitCounter == C_SSU_BITS_PER_TRANSFER) {
+                ssuEndByteTransfer();
             }
         }
     }
 }
 
+void ssuAdvance(uint64_t p_cycles) {
+    // The prescaler adds at most 128 clocks per cycle, so no more than one bit
+    // is shifted per cycle: the byte ends on the first cycle where the total
+    // number of clocks reaches the bits left, exactly like with ssuCycle().
+    while((p_cycles > 0U) && M_SSU.transferring) {
+        uint64_t l_clocksPerCycle = 1U << M_SSU.ssmr.bitField.cks;
+        uint64_t l_clocksLeft =
+            (uint64_t)(C_SSU_BITS_PER_TRANSFER - M_SSU.bitCounter)
+                * C_SSU_CLOCKS_PER_BIT
+            - M_SSU.clockCounter;
+        uint64_t l_cyclesLeft =
+            (l_clocksLeft + l_clocksPerCycle - 1U) / l_clocksPerCycle;
+
+        if(p_cycles < l_cyclesLeft) {
+            uint64_t l_clocks =
+                M_SSU.clockCounter + p_cycles * l_clocksPerCycle;
+
+            M_SSU.bitCounter += l_clocks / C_SSU_CLOCKS_PER_BIT;
+            M_SSU.clockCounter = l_clocks % C_SSU_CLOCKS_PER_BIT;
+            return;
+        }
+
+        M_SSU.clockCounter = l_cyclesLeft * l_clocksPerCycle - l_clocksLeft;
+        p_cycles -= l_cyclesLeft;
+        ssuEndByteTransfer();
+    }
+}
+
 // =============================================================================
 // Private functions definitions
 // =============================================================================
+static void ssuEndByteTransfer(void) {
+    // The EEPROM is the only device of the serial bus that is emulated: the
+    // bus reads 0xff while it is not selected.
+    uint8_t l_receivedData = eepromTransfer(M_SSU.sstrsr);
+
+    if(M_SSU.sssr.bitField.tdre == 0) {
+        // If there is data in the buffer, keep transferring data.
+        M_SSU.sstrsr = M_SSU.sstdr;
+        M_SSU.sssr.bitField.tdre = 1;
+    } else {
+        // Otherwise stop the transfer.
+        M_SSU.sssr.bitField.tend = 1;
+        M_SSU.transferring = false;
+    }
+
+    if(M_SSU.sser.bitField.re == 0) {
+        // The received data is ignored when the receiver is disabled.
+    } else if(M_SSU.sssr.bitField.rdrf == 1) {
+        // If there is still data left in SSRDR, then the new data is lost, and
+        // an error flag is set.
+        M_SSU.sssr.bitField.orer = 1;
+    } else {
+        // Otherwise SSRDR contains the received data.
+        M_SSU.ssrdr = l_receivedData;
+        M_SSU.sssr.bitField.rdrf = 1;
+    }
+
+    M_SSU.bitCounter = 0;
+}
+
 static uint8_t ssuReadSsrdr(void) {
-    s_ssuSssr.bitField.rdrf = 0;
-    return s_ssuSsrdr;
+    M_SSU.sssr.bitField.rdrf = 0;
+    return M_SSU.ssrdr;
 }
 
 static void ssuWriteSstdr(uint8_t p_value) {
-    s_ssuSstdr = p_value;
+    M_SSU.sstdr = p_value;
 
-    if(s_ssuSssr.bitField.tend == 1) {
+    if(!M_SSU.transferring) {
         // If no transfer is in progress, initiate a new transfer.
-        s_ssuSstrsr = s_ssuSstdr;
-        s_ssuSssr.bitField.tend = 0;
+        M_SSU.sstrsr = M_SSU.sstdr;
+        M_SSU.sssr.bitField.tend = 0;
+        M_SSU.transferring = true;
     } else {
         // If a transfer is already in progress, put the value in the buffer.
-        s_ssuSssr.bitField.tdre = 0;
+        M_SSU.sssr.bitField.tdre = 0;
     }
 }
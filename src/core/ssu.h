@@ -4,8 +4,158 @@
 // =============================================================================
 // File inclusion
 // =============================================================================
+#include <stdbool.h>
 #include <stdint.h>
 
+// =============================================================================
+// Public type declarations
+// =============================================================================
+union tu_ssuSscrh {
+    struct {
+        uint8_t css : 2;
+        uint8_t scks : 1;
+        uint8_t solp : 1;
+        uint8_t sol : 1;
+        uint8_t soos : 1;
+        uint8_t bide : 1;
+        uint8_t mss : 1;
+    } bitField;
+
+    uint8_t byte;
+};
+
+union tu_ssuSscrl {
+    struct {
+        uint8_t reserved : 3;
+        uint8_t csos : 1;
+        uint8_t sckos : 1;
+        uint8_t sres : 1;
+        uint8_t ssums : 1;
+        uint8_t reserved2 : 1;
+    } bitField;
+
+    uint8_t byte;
+};
+
+union tu_ssuSsmr {
+    struct {
+        uint8_t cks : 3;
+        uint8_t reserved : 2;
+        uint8_t cphs : 1;
+        uint8_t cpos : 1;
+        uint8_t mls : 1;
+    } bitField;
+
+    uint8_t byte;
+};
+
+union tu_ssuSser {
+    struct {
+        uint8_t ceie : 1;
+        uint8_t rie : 1;
+        uint8_t tie : 1;
+        uint8_t teie : 1;
+        uint8_t reserved : 1;
+        uint8_t rsstp : 1;
+        uint8_t re : 1;
+        uint8_t te : 1;
+    } bitField;
+
+    uint8_t byte;
+};
+
+union tu_ssuSssr {
+    struct {
+        uint8_t ce : 1;
+        uint8_t rdrf : 1;
+        uint8_t tdre : 1;
+        uint8_t tend : 1;
+        uint8_t reserved : 2;
+        uint8_t orer : 1;
+        uint8_t reserved2 : 1;
+    } bitField;
+
+    uint8_t byte;
+};
+
+/**
+ * @brief This structure contains the state of the SSU module.
+ */
+struct ts_ssuState {
+    /**
+     * @brief This member represents the SSCRH register. This register contains
+     *        the first part of the SSU configuration. This register is ignored
+     *        by this emulator because its value is always set to 0x8c by the
+     *        pokéwalker ROM.
+     */
+    union tu_ssuSscrh sscrh;
+
+    /**
+     * @brief This member represents the SSCRL register. This register contains
+     *        the second part of the SSU configuration. This register is ignored
+     *        by this emulator because its value is always set to 0x40 by the
+     *        pokéwalker ROM.
+     */
+    union tu_ssuSscrl sscrl;
+
+    /**
+     * @brief This member represents the SSMR register. This register contains
+     *        the settings for serial data transmission.
+     */
+    union tu_ssuSsmr ssmr;
+
+    /**
+     * @brief This member represents the SSER register. This register contains
+     *        the transmit, receive and interrupt enable bits of the SSU.
+     */
+    union tu_ssuSser sser;
+
+    /**
+     * @brief This member represents the SSSR register. This register contains
+     *        the interrupt flags related to the SSU operation.
+     */
+    union tu_ssuSssr sssr;
+
+    /**
+     * @brief This member represents the SSRDR register. This register contains
+     *        the data copied from SSTRSR after one transaction.
+     */
+    uint8_t ssrdr;
+
+    /**
+     * @brief This member represents the SSTDR register. This register contains
+     *        the data to be copied into SSTRSR and sent.
+     */
+    uint8_t sstdr;
+
+    /**
+     * @brief This member represents the SSTRSR register. This register is a
+     *        shift register that contains the data to be transmitted as well as
+     *        the received data. Note that this register is an internal register
+     *        that cannot be accessed by the CPU.
+     */
+    uint8_t sstrsr;
+
+    /**
+     * @brief This member indicates whether a byte is being transferred. The
+     *        SSSR.TEND bit is cleared at reset although no transfer is in
+     *        progress, so it cannot be used for this.
+     */
+    bool transferring;
+
+    /**
+     * @brief This member contains the clock counter for the prescaler.
+     * @details One SSU clock occurs when this member reaches a value >= 256.
+     */
+    int clockCounter;
+
+    /**
+     * @brief This member contains the bit counter for the current transfer.
+     * @details The transfer ends when this member reaches 8.
+     */
+    int bitCounter;
+};
+
 // =============================================================================
 // Public functions declarations
 // =============================================================================
@@ -19,6 +169,15 @@ void ssuReset(void);
  */
 void ssuCycle(void);
 
+/**
+ * @brief Performs the given number of cycles of the SSU module at once. The
+ *        state reached is the same as with as many calls to ssuCycle(), but it
+ *        is computed one byte at a time.
+ *
+ * @param[in] p_cycles The number of cycles to perform.
+ */
+void ssuAdvance(uint64_t p_cycles);
+
 /**
  * @brief Reads a byte from SSU.
  *
@@ -0,0 +1,450 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "core/audio.h"
+#include "core/instance.h"
+#include "core/scheduler.h"
+#include "core/timerw.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+#define C_TIMER_W_REGADDR_TMRW 0xf0f0
+#define C_TIMER_W_REGADDR_TCRW 0xf0f1
+#define C_TIMER_W_REGADDR_TIERW 0xf0f2
+#define C_TIMER_W_REGADDR_TSRW 0xf0f3
+#define C_TIMER_W_REGADDR_TIOR0 0xf0f4
+#define C_TIMER_W_REGADDR_TIOR1 0xf0f5
+#define C_TIMER_W_REGADDR_TCNT 0xf0f6
+#define C_TIMER_W_REGADDR_GRA 0xf0f8
+#define C_TIMER_W_REGADDR_GRB 0xf0fa
+#define C_TIMER_W_REGADDR_GRC 0xf0fc
+#define C_TIMER_W_REGADDR_GRD 0xf0fe
+
+/**
+ * @brief This constant defines the mask of the compare match flags and of the
+ *        overflow flag in TSRW.
+ */
+#define C_TIMER_W_TSRW_FLAGS 0x8fU
+
+/**
+ * @brief This constant defines the first CKS value that selects the external
+ *        clock. The external clock input is not connected, so the counter
+ *        does not count with it.
+ */
+#define C_TIMER_W_CKS_EXTERNAL 4U
+
+/**
+ * @brief These constants define the output actions of the IOx bits in TIOR0
+ *        and TIOR1 on a compare match. The values with IOx2 set select input
+ *        capture, which is not emulated.
+ */
+#define C_TIMER_W_IO_OUTPUT_0 1U
+#define C_TIMER_W_IO_OUTPUT_1 2U
+#define C_TIMER_W_IO_TOGGLE 3U
+
+/**
+ * @brief This constant defines the channel whose output drives the piezo
+ *        buzzer.
+ */
+#define C_TIMER_W_BUZZER_CHANNEL E_TIMER_W_CHANNEL_B
+
+/**
+ * @brief This macro gives access to the Timer W state of the current instance.
+ */
+#define M_TIMER_W (g_coreInstance->state.timerW)
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Checks if the counter is counting.
+ *
+ * @returns A boolean value that indicates whether the counter is counting.
+ */
+static inline bool timerWIsCounting(void);
+
+/**
+ * @brief Returns the number of cycles per count of the counter.
+ *
+ * @returns The number of cycles per count.
+ */
+static inline uint64_t timerWGetPrescaler(void);
+
+/**
+ * @brief Returns the value of the counter after the given number of counts.
+ *        With TCRW.CCLR set, the counter is cleared on the count after it
+ *        matches GRA.
+ *
+ * @param[in] p_value The value of the counter.
+ * @param[in] p_counts The number of counts.
+ *
+ * @returns The value of the counter after the counts.
+ */
+static uint16_t timerWAdvanceCount(uint16_t p_value, uint64_t p_counts);
+
+/**
+ * @brief Returns the number of counts after which the counter reaches the
+ *        given value.
+ *
+ * @param[in] p_from The value of the counter.
+ * @param[in] p_to The value to reach.
+ *
+ * @returns The number of counts, at least 1.
+ * @retval UINT64_MAX if the counter never reaches the value.
+ */
+static uint64_t timerWGetCountsTo(uint16_t p_from, uint16_t p_to);
+
+/**
+ * @brief Returns the value of the counter at the current cycle.
+ *
+ * @returns The value of the counter.
+ */
+static uint16_t timerWGetCount(void);
+
+/**
+ * @brief Brings the timer up to the current cycle: the compare matches that
+ *        are due are handled, and tcnt is updated. This function is called
+ *        before any register write, so that the new settings only apply from
+ *        the current cycle on.
+ */
+static void timerWSync(void);
+
+/**
+ * @brief Schedules the next compare match, or cancels it if the counter is
+ *        stopped.
+ */
+static void timerWScheduleMatch(void);
+
+/**
+ * @brief Returns the output action of a channel on a compare match, from its
+ *        IOx bits in TIOR0 or TIOR1.
+ *
+ * @param[in] p_channel The channel.
+ *
+ * @returns The IOx bits of the channel.
+ */
+static inline uint8_t timerWGetOutputAction(enum te_timerWChannel p_channel);
+
+/**
+ * @brief Sets the levels of the output pins, and records the edges of the
+ *        buzzer output.
+ *
+ * @param[in] p_outputs The new levels, one bit per te_timerWChannel.
+ * @param[in] p_cycle The cycle at which the levels change.
+ */
+static void timerWSetOutputs(uint8_t p_outputs, uint64_t p_cycle);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+void timerWReset(void) {
+    M_TIMER_W.tmrw.byte = 0x48U;
+    M_TIMER_W.tcrw.byte = 0x00U;
+    M_TIMER_W.tierw = 0x70U;
+    M_TIMER_W.tsrw = 0x70U;
+    M_TIMER_W.tior0 = 0x88U;
+    M_TIMER_W.tior1 = 0x88U;
+    M_TIMER_W.tcnt = 0x0000U;
+    M_TIMER_W.tcntCycle = schedulerGetCycles();
+
+    for(int l_channel = 0; l_channel < C_TIMER_W_CHANNEL_COUNT; l_channel++) {
+        M_TIMER_W.gr[l_channel] = 0xffffU;
+    }
+
+    timerWSetOutputs(0x00U, schedulerGetCycles());
+    timerWScheduleMatch();
+}
+
+void timerWOnMatchEvent(void) {
+    uint64_t l_cycle = M_TIMER_W.matchCycle;
+    uint16_t l_value = timerWAdvanceCount(
+        M_TIMER_W.tcnt,
+        (l_cycle - M_TIMER_W.tcntCycle) / timerWGetPrescaler()
+    );
+    uint8_t l_pwmChannels = (uint8_t)(M_TIMER_W.tmrw.byte & 0x07U) << 1;
+    uint8_t l_outputs = M_TIMER_W.outputs;
+
+    M_TIMER_W.tcnt = l_value;
+    M_TIMER_W.tcntCycle = l_cycle;
+
+    // Outside PWM mode, TIOR0 and TIOR1 select the action of the match on
+    // the output. In PWM mode, the outputs are set by the match with their own
+    // general register, and cleared by the match with GRA, which is the
+    // period.
+    for(int l_channel = 0; l_channel < C_TIMER_W_CHANNEL_COUNT; l_channel++) {
+        uint8_t l_mask = 1U << l_channel;
+
+        if(M_TIMER_W.gr[l_channel] != l_value) {
+            continue;
+        }
+
+        M_TIMER_W.tsrw |= l_mask;
+
+        if((l_pwmChannels & l_mask) != 0U) {
+            l_outputs |= l_mask;
+            continue;
+        }
+
+        switch(timerWGetOutputAction((enum te_timerWChannel)l_channel)) {
+            case C_TIMER_W_IO_OUTPUT_0: l_outputs &= ~l_mask; break;
+            case C_TIMER_W_IO_OUTPUT_1: l_outputs |= l_mask; break;
+            case C_TIMER_W_IO_TOGGLE: l_outputs ^= l_mask; break;
+            default: break;
+        }
+    }
+
+    if(M_TIMER_W.gr[E_TIMER_W_CHANNEL_A] == l_value) {
+        l_outputs &= ~l_pwmChannels;
+    }
+
+    timerWSetOutputs(l_outputs, l_cycle);
+    timerWScheduleMatch();
+}
+
+uint8_t timerWRead8(uint16_t p_address) {
+    switch(p_address) {
+        case C_TIMER_W_REGADDR_TMRW: return M_TIMER_W.tmrw.byte | 0x48U;
+        case C_TIMER_W_REGADDR_TCRW: return M_TIMER_W.tcrw.byte;
+        case C_TIMER_W_REGADDR_TIERW: return M_TIMER_W.tierw | 0x70U;
+        case C_TIMER_W_REGADDR_TSRW: return M_TIMER_W.tsrw | 0x70U;
+        case C_TIMER_W_REGADDR_TIOR0: return M_TIMER_W.tior0;
+        case C_TIMER_W_REGADDR_TIOR1: return M_TIMER_W.tior1;
+        default: break;
+    }
+
+    if(p_address < C_TIMER_W_REGADDR_TCNT) {
+        return 0xffU;
+    } else if((p_address & 0x0001U) == 0U) {
+        return timerWRead16(p_address) >> 8U;
+    } else {
+        return timerWRead16(p_address & 0xfffeU) & 0x00ffU;
+    }
+}
+
+uint16_t timerWRead16(uint16_t p_address) {
+    switch(p_address) {
+        case C_TIMER_W_REGADDR_TCNT: return timerWGetCount();
+        case C_TIMER_W_REGADDR_GRA: return M_TIMER_W.gr[E_TIMER_W_CHANNEL_A];
+        case C_TIMER_W_REGADDR_GRB: return M_TIMER_W.gr[E_TIMER_W_CHANNEL_B];
+        case C_TIMER_W_REGADDR_GRC: return M_TIMER_W.gr[E_TIMER_W_CHANNEL_C];
+        case C_TIMER_W_REGADDR_GRD: return M_TIMER_W.gr[E_TIMER_W_CHANNEL_D];
+        default:
+            return ((uint16_t)timerWRead8(p_address) << 8U)
+                | timerWRead8(p_address | 0x0001U);
+    }
+}
+
+void timerWWrite8(uint16_t p_address, uint8_t p_value) {
+    if(p_address >= C_TIMER_W_REGADDR_TCNT) {
+        // The 16-bit registers keep their other byte.
+        uint16_t l_address = p_address & 0xfffeU;
+        uint16_t l_value = timerWRead16(l_address);
+
+        if(l_address == p_address) {
+            l_value = (l_value & 0x00ffU) | ((uint16_t)p_value << 8U);
+        } else {
+            l_value = (l_value & 0xff00U) | p_value;
+        }
+
+        timerWWrite16(l_address, l_value);
+        return;
+    }
+
+    timerWSync();
+
+    switch(p_address) {
+        case C_TIMER_W_REGADDR_TMRW: M_TIMER_W.tmrw.byte = p_value; break;
+        case C_TIMER_W_REGADDR_TCRW:
+            M_TIMER_W.tcrw.byte = p_value;
+
+            // The TOx bits set the level of the outputs until the next match.
+            timerWSetOutputs(p_value & 0x0fU, schedulerGetCycles());
+            break;
+
+        case C_TIMER_W_REGADDR_TIERW: M_TIMER_W.tierw = p_value; break;
+        case C_TIMER_W_REGADDR_TSRW:
+            M_TIMER_W.tsrw &= p_value | ~C_TIMER_W_TSRW_FLAGS;
+            break;
+
+        case C_TIMER_W_REGADDR_TIOR0: M_TIMER_W.tior0 = p_value; break;
+        case C_TIMER_W_REGADDR_TIOR1: M_TIMER_W.tior1 = p_value; break;
+        default: break;
+    }
+
+    timerWScheduleMatch();
+}
+
+void timerWWrite16(uint16_t p_address, uint16_t p_value) {
+    if(p_address < C_TIMER_W_REGADDR_TCNT) {
+        timerWWrite8(p_address, p_value >> 8U);
+        timerWWrite8(p_address | 0x0001U, p_value & 0x00ffU);
+        return;
+    }
+
+    timerWSync();
+
+    switch(p_address) {
+        case C_TIMER_W_REGADDR_TCNT: M_TIMER_W.tcnt = p_value; break;
+        case C_TIMER_W_REGADDR_GRA:
+            M_TIMER_W.gr[E_TIMER_W_CHANNEL_A] = p_value;
+            break;
+
+        case C_TIMER_W_REGADDR_GRB:
+            M_TIMER_W.gr[E_TIMER_W_CHANNEL_B] = p_value;
+            break;
+
+        case C_TIMER_W_REGADDR_GRC:
+            M_TIMER_W.gr[E_TIMER_W_CHANNEL_C] = p_value;
+            break;
+
+        case C_TIMER_W_REGADDR_GRD:
+            M_TIMER_W.gr[E_TIMER_W_CHANNEL_D] = p_value;
+            break;
+
+        default: break;
+    }
+
+    timerWScheduleMatch();
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static inline bool timerWIsCounting(void) {
+    return (M_TIMER_W.tmrw.bitField.cts != 0U)
+        && (M_TIMER_W.tcrw.bitField.cks < C_TIMER_W_CKS_EXTERNAL);
+}
+
+static inline uint64_t timerWGetPrescaler(void) {
+    return 1U << M_TIMER_W.tcrw.bitField.cks;
+}
+
+static uint16_t timerWAdvanceCount(uint16_t p_value, uint64_t p_counts) {
+    uint16_t l_period = M_TIMER_W.gr[E_TIMER_W_CHANNEL_A];
+
+    if(M_TIMER_W.tcrw.bitField.cclr == 0U) {
+        return (uint16_t)(p_value + p_counts);
+    } else if(p_value <= l_period) {
+        return (p_value + p_counts) % ((uint64_t)l_period + 1U);
+    } else if(p_counts < 0x10000U - p_value) {
+        // The counter is above GRA: it only clears after it overflows.
+        return p_value + p_counts;
+    } else {
+        return (p_counts - (0x10000U - p_value)) % ((uint64_t)l_period + 1U);
+    }
+}
+
+static uint64_t timerWGetCountsTo(uint16_t p_from, uint16_t p_to) {
+    uint16_t l_period = M_TIMER_W.gr[E_TIMER_W_CHANNEL_A];
+    uint64_t l_counts;
+
+    if(M_TIMER_W.tcrw.bitField.cclr == 0U) {
+        l_counts = (uint16_t)(p_to - p_from);
+        return (l_counts == 0U) ? 0x10000U : l_counts;
+    } else if(p_from <= l_period) {
+        if(p_to > l_period) {
+            return UINT64_MAX;
+        }
+
+        l_counts = ((uint64_t)p_to + l_period + 1U - p_from)
+            % ((uint64_t)l_period + 1U);
+        return (l_counts == 0U) ? ((uint64_t)l_period + 1U) : l_counts;
+    } else if(p_to > p_from) {
+        return p_to - p_from;
+    } else if(p_to <= l_period) {
+        return 0x10000U - p_from + p_to;
+    } else {
+        return UINT64_MAX;
+    }
+}
+
+static uint16_t timerWGetCount(void) {
+    if(!timerWIsCounting()) {
+        return M_TIMER_W.tcnt;
+    }
+
+    return timerWAdvanceCount(
+        M_TIMER_W.tcnt,
+        (schedulerGetCycles() - M_TIMER_W.tcntCycle) / timerWGetPrescaler()
+    );
+}
+
+static void timerWSync(void) {
+    uint64_t l_cycle = schedulerGetCycles();
+
+    // The compare match event may not have run yet when the accuracy profile
+    // defers the cycles.
+    while(M_TIMER_W.matchCycle <= l_cycle) {
+        timerWOnMatchEvent();
+    }
+
+    if(timerWIsCounting()) {
+        uint64_t l_counts =
+            (l_cycle - M_TIMER_W.tcntCycle) / timerWGetPrescaler();
+
+        M_TIMER_W.tcnt = timerWAdvanceCount(M_TIMER_W.tcnt, l_counts);
+        M_TIMER_W.tcntCycle += l_counts * timerWGetPrescaler();
+    } else {
+        M_TIMER_W.tcntCycle = l_cycle;
+    }
+}
+
+static void timerWScheduleMatch(void) {
+    uint64_t l_counts = UINT64_MAX;
+
+    if(timerWIsCounting()) {
+        for(
+            int l_channel = 0;
+            l_channel < C_TIMER_W_CHANNEL_COUNT;
+            l_channel++
+        ) {
+            uint64_t l_channelCounts =
+                timerWGetCountsTo(M_TIMER_W.tcnt, M_TIMER_W.gr[l_channel]);
+
+            if(l_channelCounts < l_counts) {
+                l_counts = l_channelCounts;
+            }
+        }
+    }
+
+    if(l_counts == UINT64_MAX) {
+        M_TIMER_W.matchCycle = UINT64_MAX;
+        schedulerCancel(E_SCHEDULER_EVENT_TIMER_W);
+        return;
+    }
+
+    uint64_t l_cycle = schedulerGetCycles();
+
+    M_TIMER_W.matchCycle =
+        M_TIMER_W.tcntCycle + l_counts * timerWGetPrescaler();
+    schedulerSchedule(
+        E_SCHEDULER_EVENT_TIMER_W,
+        (M_TIMER_W.matchCycle > l_cycle)
+            ? (M_TIMER_W.matchCycle - l_cycle)
+            : 0U
+    );
+}
+
+static inline uint8_t timerWGetOutputAction(enum te_timerWChannel p_channel) {
+    // TIOR0 holds channels A and B, and TIOR1 channels C and D, with the
+    // second channel of each register in the upper nibble.
+    uint8_t l_tior = (p_channel < E_TIMER_W_CHANNEL_C)
+        ? M_TIMER_W.tior0
+        : M_TIMER_W.tior1;
+
+    return (l_tior >> (((unsigned int)p_channel & 1U) * 4U)) & 0x07U;
+}
+
+static void timerWSetOutputs(uint8_t p_outputs, uint64_t p_cycle) {
+    uint8_t l_buzzerMask = 1U << C_TIMER_W_BUZZER_CHANNEL;
+
+    if(((M_TIMER_W.outputs ^ p_outputs) & l_buzzerMask) != 0U) {
+        audioRecordEdge(p_cycle, (p_outputs & l_buzzerMask) != 0U);
+    }
+
+    M_TIMER_W.outputs = p_outputs;
+}
@@ -0,0 +1,178 @@
+#ifndef __INC_CORE_TIMERW_H__
+#define __INC_CORE_TIMERW_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdint.h>
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the number of channels of the timer. Each
+ *        channel has a general register (GRA to GRD) and an output pin
+ *        (FTIOA to FTIOD).
+ */
+#define C_TIMER_W_CHANNEL_COUNT 4
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+enum te_timerWChannel {
+    E_TIMER_W_CHANNEL_A,
+    E_TIMER_W_CHANNEL_B,
+    E_TIMER_W_CHANNEL_C,
+    E_TIMER_W_CHANNEL_D
+};
+
+union tu_timerWTmrw {
+    struct {
+        uint8_t pwmb : 1;
+        uint8_t pwmc : 1;
+        uint8_t pwmd : 1;
+        uint8_t reserved : 1;
+        uint8_t bufea : 1;
+        uint8_t bufeb : 1;
+        uint8_t reserved2 : 1;
+        uint8_t cts : 1;
+    } bitField;
+
+    uint8_t byte;
+};
+
+union tu_timerWTcrw {
+    struct {
+        uint8_t toa : 1;
+        uint8_t tob : 1;
+        uint8_t toc : 1;
+        uint8_t tod : 1;
+        uint8_t cks : 3;
+        uint8_t cclr : 1;
+    } bitField;
+
+    uint8_t byte;
+};
+
+/**
+ * @brief This structure contains the state of the Timer W module. The counter
+ *        is not incremented on every cycle: its value is computed from the
+ *        number of cycles elapsed since it was last synchronized, and a
+ *        scheduler event is only used for the compare matches.
+ */
+struct ts_timerWState {
+    /**
+     * @brief This member represents the TMRW register. This register starts
+     *        the counter and selects the channels in PWM mode.
+     */
+    union tu_timerWTmrw tmrw;
+
+    /**
+     * @brief This member represents the TCRW register. This register selects
+     *        the counter clock, the counter clearing and the initial level of
+     *        the outputs.
+     */
+    union tu_timerWTcrw tcrw;
+
+    /**
+     * @brief This member represents the TIERW register. The interrupts are not
+     *        emulated, so this register is only stored.
+     */
+    uint8_t tierw;
+
+    /**
+     * @brief This member represents the TSRW register. This register contains
+     *        the compare match flags (IMFA to IMFD).
+     */
+    uint8_t tsrw;
+
+    /**
+     * @brief These members represent the TIOR0 and TIOR1 registers. These
+     *        registers select the action of a compare match on the output of
+     *        the channels that are not in PWM mode. Input capture is not
+     *        emulated.
+     */
+    uint8_t tior0;
+    uint8_t tior1;
+
+    /**
+     * @brief This member contains the level of each output pin, one bit per
+     *        te_timerWChannel.
+     */
+    uint8_t outputs;
+
+    /**
+     * @brief This member represents the general registers GRA to GRD.
+     */
+    uint16_t gr[C_TIMER_W_CHANNEL_COUNT];
+
+    /**
+     * @brief This member represents the TCNT register, as it was at
+     *        tcntCycle.
+     */
+    uint16_t tcnt;
+
+    /**
+     * @brief This member contains the cycle at which the counter had the value
+     *        of tcnt. The next count happens one prescaler period later.
+     */
+    uint64_t tcntCycle;
+
+    /**
+     * @brief This member contains the cycle of the next compare match, or
+     *        UINT64_MAX if the counter is stopped.
+     */
+    uint64_t matchCycle;
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Resets the Timer W module.
+ * @details This function shall be called after the scheduler is reset.
+ */
+void timerWReset(void);
+
+/**
+ * @brief Handles the compare match event: the compare match flags and the
+ *        outputs are updated, and the next compare match is scheduled.
+ * @details This function shall only be called by the scheduler module.
+ */
+void timerWOnMatchEvent(void);
+
+/**
+ * @brief Reads a byte from Timer W.
+ *
+ * @param[in] p_address The address to read the byte from.
+ *
+ * @returns The byte read.
+ */
+uint8_t timerWRead8(uint16_t p_address);
+
+/**
+ * @brief Reads a word from Timer W.
+ *
+ * @param[in] p_address The address to read the word from.
+ *
+ * @returns The word read.
+ */
+uint16_t timerWRead16(uint16_t p_address);
+
+/**
+ * @brief Writes a byte to Timer W.
+ *
+ * @param[in] p_address The address to write the byte to.
+ * @param[in] p_value The byte to write.
+ */
+void timerWWrite8(uint16_t p_address, uint8_t p_value);
+
+/**
+ * @brief Writes a word to Timer W.
+ *
+ * @param[in] p_address The address to write the word to.
+ * @param[in] p_value The word to write.
+ */
+void timerWWrite16(uint16_t p_address, uint16_t p_value);
+
+#endif // __INC_CORE_TIMERW_H__
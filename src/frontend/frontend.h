@@ -13,10 +13,4 @@
  */
 int frontendInit(void);
 
-/**
- * @brief This function is called everytime the core outputs a video frame and
- *        enters VBlank state.
- */
-void frontendOnVBlank(void);
-
 #endif // __INC_FRONTEND_FRONTEND_H__
@@ -0,0 +1,245 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "core/core.h"
+#include "core/hash.h"
+#include "host/bootcache.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the magic number at the beginning of a boot
+ *        cache file ("EWBC").
+ */
+#define C_BOOTCACHE_MAGIC 0x43425745U
+
+/**
+ * @brief This constant defines the maximum length of a boot cache file path.
+ */
+#define C_BOOTCACHE_PATH_LENGTH 4096
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+struct ts_bootCacheHeader {
+    uint32_t magic;
+    uint64_t key;
+    uint64_t stateSize;
+};
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Computes the key of the boot cache entry that matches the files
+ *        loaded in the core.
+ *
+ * @param[in] p_bootCycles The number of cycles executed by the boot sequence.
+ *
+ * @returns The key of the boot cache entry.
+ */
+static uint64_t bootCacheGetKey(uint64_t p_bootCycles);
+
+/**
+ * @brief Restores the state stored in the given boot cache file.
+ *
+ * @param[in] p_filePath The path to the boot cache file.
+ * @param[in] p_key The expected key of the boot cache entry.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the state was restored.
+ * @retval Any other value if the file does not exist or is invalid.
+ */
+static int bootCacheLoad(const char *p_filePath, uint64_t p_key);
+
+/**
+ * @brief Stores the current state of the core in the given boot cache file.
+ *        The file is written under a temporary name and then renamed, so that
+ *        concurrent instances never read a partially written file.
+ *
+ * @param[in] p_filePath The path to the boot cache file.
+ * @param[in] p_key The key of the boot cache entry.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the state was stored.
+ * @retval Any other value if an error occurred.
+ */
+static int bootCacheSave(const char *p_filePath, uint64_t p_key);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int bootCacheBoot(const char *p_directory, uint64_t p_bootCycles) {
+    uint64_t l_key = bootCacheGetKey(p_bootCycles);
+    char l_filePath[C_BOOTCACHE_PATH_LENGTH];
+
+    int l_length = snprintf(
+        l_filePath,
+        sizeof(l_filePath),
+        "%s/%016llx.state",
+        p_directory,
+        (unsigned long long)l_key
+    );
+
+    if((l_length < 0) || ((size_t)l_length >= sizeof(l_filePath))) {
+        fprintf(stderr, "Error: boot cache path is too long.\n");
+        return 1;
+    }
+
+    if(bootCacheLoad(l_filePath, l_key) == 0) {
+        return 0;
+    }
+
+    // Cache miss: run the boot sequence.
+    if(coreReset() != 0) {
+        return 1;
+    }
+
+    if(p_bootCycles != 0U) {
+        coreRunUntil(p_bootCycles, 0U, NULL);
+    }
+
+    if(bootCacheSave(l_filePath, l_key) != 0) {
+        fprintf(
+            stderr,
+            "Warning: failed to write boot cache file \"%s\".\n",
+            l_filePath
+        );
+    }
+
+    return 0;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static uint64_t bootCacheGetKey(uint64_t p_bootCycles) {
+    uint64_t l_flashRomHash = coreGetFileHash(E_CORE_FILE_FLASH_ROM);
+    uint64_t l_eepromHash = coreGetFileHash(E_CORE_FILE_EEPROM);
+    uint32_t l_stateVersion = C_CORE_STATE_VERSION;
+    uint32_t l_accuracy = coreGetAccuracy();
+
+    uint64_t l_key = C_HASH_INITIAL_VALUE;
+
+    l_key = hashUpdate(l_key, &l_flashRomHash, sizeof(l_flashRomHash));
+    l_key = hashUpdate(l_key, &l_eepromHash, sizeof(l_eepromHash));
+    l_key = hashUpdate(l_key, C_CORE_VERSION, strlen(C_CORE_VERSION));
+    l_key = hashUpdate(l_key, &l_stateVersion, sizeof(l_stateVersion));
+    l_key = hashUpdate(l_key, &p_bootCycles, sizeof(p_bootCycles));
+
+    // The boot sequence reaches a different state with each accuracy profile.
+    l_key = hashUpdate(l_key, &l_accuracy, sizeof(l_accuracy));
+
+    return l_key;
+}
+
+static int bootCacheLoad(const char *p_filePath, uint64_t p_key) {
+    FILE *l_file = fopen(p_filePath, "rb");
+
+    if(l_file == NULL) {
+        return 1;
+    }
+
+    struct ts_bootCacheHeader l_header;
+
+    if(
+        (fread(&l_header, sizeof(l_header), 1, l_file) != 1)
+        || (l_header.magic != C_BOOTCACHE_MAGIC)
+        || (l_header.key != p_key)
+        || (l_header.stateSize > coreGetMaxStateSize())
+    ) {
+        fclose(l_file);
+        return 1;
+    }
+
+    uint8_t *l_state = (uint8_t *)malloc(l_header.stateSize);
+
+    if(l_state == NULL) {
+        fclose(l_file);
+        return 1;
+    }
+
+    int l_returnValue = 1;
+
+    if(fread(l_state, 1, l_header.stateSize, l_file) == l_header.stateSize) {
+        l_returnValue = coreLoadState(l_state, l_header.stateSize);
+    }
+
+    free(l_state);
+    fclose(l_file);
+
+    return l_returnValue;
+}
+
+static int bootCacheSave(const char *p_filePath, uint64_t p_key) {
+    char l_temporaryFilePath[C_BOOTCACHE_PATH_LENGTH];
+
+    int l_length = snprintf(
+        l_temporaryFilePath,
+        sizeof(l_temporaryFilePath),
+        "%s.%ld.tmp",
+        p_filePath,
+        (long)getpid()
+    );
+
+    if(
+        (l_length < 0)
+        || ((size_t)l_length >= sizeof(l_temporaryFilePath))
+    ) {
+        return 1;
+    }
+
+    struct ts_bootCacheHeader l_header = {
+        .magic = C_BOOTCACHE_MAGIC,
+        .key = p_key,
+        .stateSize = coreGetStateSize()
+    };
+
+    uint8_t *l_state = (uint8_t *)malloc(l_header.stateSize);
+
+    if(l_state == NULL) {
+        return 1;
+    }
+
+    if(coreSaveState(l_state, l_header.stateSize) != 0) {
+        free(l_state);
+        return 1;
+    }
+
+    FILE *l_file = fopen(l_temporaryFilePath, "wb");
+
+    if(l_file == NULL) {
+        free(l_state);
+        return 1;
+    }
+
+    bool l_error =
+        (fwrite(&l_header, sizeof(l_header), 1, l_file) != 1)
+        || (fwrite(l_state, 1, l_header.stateSize, l_file)
+            != l_header.stateSize);
+
+    l_error = (fclose(l_file) != 0) || l_error;
+    free(l_state);
+
+    if(l_error || (rename(l_temporaryFilePath, p_filePath) != 0)) {
+        remove(l_temporaryFilePath);
+        return 1;
+    }
+
+    return 0;
+}
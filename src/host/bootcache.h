@@ -0,0 +1,40 @@
+#ifndef __INC_HOST_BOOTCACHE_H__
+#define __INC_HOST_BOOTCACHE_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdint.h>
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the default number of cycles executed after a
+ *        reset before the state is considered "booted" (1 second).
+ */
+#define C_BOOTCACHE_DEFAULT_BOOT_CYCLES 3686400U
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Brings the core to its post-boot state. If the boot cache directory
+ *        contains a state for the loaded FLASH ROM and EEPROM, the emulator
+ *        version and the given number of boot cycles, this state is restored.
+ *        Otherwise, the core is reset and runs for the given number of cycles,
+ *        and the resulting state is stored in the cache.
+ * @details The FLASH ROM and the EEPROM must be loaded in the core before
+ *          calling this function. Writing the cache is best-effort: a failure
+ *          is reported but does not make the function fail.
+ *
+ * @param[in] p_directory The path to the boot cache directory.
+ * @param[in] p_bootCycles The number of cycles executed by the boot sequence.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the core was brought to its post-boot state.
+ * @retval Any other value if an error occurred.
+ */
+int bootCacheBoot(const char *p_directory, uint64_t p_bootCycles);
+
+#endif // __INC_HOST_BOOTCACHE_H__
@@ -0,0 +1,645 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/core.h"
+#include "host/explore.h"
+#include "host/pool.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the initial capacity of the visited state set.
+ *        It must be a power of 2.
+ */
+#define C_EXPLORE_INITIAL_SET_CAPACITY 1024U
+
+/**
+ * @brief This constant defines the value of an empty slot of the visited
+ *        state set.
+ */
+#define C_EXPLORE_EMPTY_HASH 0U
+
+/**
+ * @brief This constant defines the parent of the root node.
+ */
+#define C_EXPLORE_NO_PARENT SIZE_MAX
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+/**
+ * @brief This structure describes a visited state by the action that led to
+ *        it from its parent, so that the input sequence can be rebuilt.
+ */
+struct ts_exploreNode {
+    size_t parent;
+    size_t action;
+};
+
+/**
+ * @brief This structure describes a state whose successors have not been
+ *        explored yet.
+ */
+struct ts_exploreFrontierEntry {
+    size_t node;
+    uint8_t *state;
+    size_t stateSize;
+};
+
+/**
+ * @brief This structure contains the outcome of one action applied to one
+ *        frontier state.
+ */
+struct ts_exploreOutcome {
+    uint64_t hash;
+    uint8_t *state;
+    size_t stateSize;
+    bool matched;
+    bool failed;
+};
+
+/**
+ * @brief This structure contains the work shared by the threads while one
+ *        level of the exploration is explored. Work item i applies action
+ *        (i % actionCount) to frontier state (i / actionCount). Thread i of
+ *        the pool runs its work items on instance i.
+ */
+struct ts_exploreLevel {
+    const struct ts_exploreParameters *parameters;
+    struct ts_coreInstance **instances;
+    const struct ts_exploreFrontierEntry *frontier;
+    struct ts_exploreOutcome *outcomes;
+    size_t workCount;
+    size_t nextWork;
+    pthread_mutex_t mutex;
+};
+
+/**
+ * @brief This structure describes an open addressing set of state hashes.
+ */
+struct ts_exploreSet {
+    uint64_t *hashes;
+    size_t capacity;
+    size_t count;
+};
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Saves the state of the selected instance in a new buffer.
+ *
+ * @param[out] p_state The new buffer.
+ * @param[out] p_stateSize The size of the new buffer.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int exploreSaveState(uint8_t **p_state, size_t *p_stateSize);
+
+/**
+ * @brief Applies an action to the selected instance.
+ *
+ * @param[in] p_action The action to apply.
+ */
+static void exploreApplyAction(const struct ts_exploreAction *p_action);
+
+/**
+ * @brief Runs the work items of a level on one of the instances until there
+ *        are none left. This function is run once per thread of the pool.
+ *
+ * @param[in,out] p_level A pointer to the ts_exploreLevel structure.
+ * @param[in] p_instance The index of the instance to use.
+ */
+static void exploreWorker(void *p_level, size_t p_instance);
+
+/**
+ * @brief Inserts a hash in the set.
+ *
+ * @param[in,out] p_set The set.
+ * @param[in] p_hash The hash to insert.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the hash was inserted.
+ * @retval 1 if the hash was already in the set.
+ * @retval -1 if the set could not be grown.
+ */
+static int exploreSetInsert(struct ts_exploreSet *p_set, uint64_t p_hash);
+
+/**
+ * @brief Stores the input sequence that leads to the given node in the result.
+ *
+ * @param[in] p_nodes The visited nodes.
+ * @param[in] p_node The index of the node.
+ * @param[out] p_result The result to fill.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int exploreBuildSequence(
+    const struct ts_exploreNode *p_nodes,
+    size_t p_node,
+    struct ts_exploreResult *p_result
+);
+
+/**
+ * @brief Appends a node to the array of visited nodes.
+ *
+ * @param[in,out] p_nodes The array of nodes.
+ * @param[in,out] p_nodeCount The number of nodes in the array.
+ * @param[in,out] p_nodeCapacity The capacity of the array.
+ * @param[in] p_parent The parent of the new node.
+ * @param[in] p_action The action that leads from the parent to the new node.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if the array could not be grown.
+ */
+static int exploreAddNode(
+    struct ts_exploreNode **p_nodes,
+    size_t *p_nodeCount,
+    size_t *p_nodeCapacity,
+    size_t p_parent,
+    size_t p_action
+);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int exploreRun(
+    const struct ts_exploreParameters *p_parameters,
+    struct ts_exploreResult *p_result
+) {
+    memset(p_result, 0, sizeof(*p_result));
+
+    if((p_parameters->actionCount == 0U) || (p_parameters->predicate == NULL)) {
+        fprintf(stderr, "Error: invalid exploration parameters.\n");
+        return 1;
+    }
+
+    struct ts_exploreSet l_set = {
+        .hashes = (uint64_t *)calloc(
+            C_EXPLORE_INITIAL_SET_CAPACITY,
+            sizeof(uint64_t)
+        ),
+        .capacity = C_EXPLORE_INITIAL_SET_CAPACITY,
+        .count = 0U
+    };
+
+    struct ts_exploreNode *l_nodes = NULL;
+    size_t l_nodeCount = 0U;
+    size_t l_nodeCapacity = 0U;
+    struct ts_exploreFrontierEntry *l_frontier = NULL;
+    size_t l_frontierCount = 0U;
+    int l_returnValue = 0;
+
+    // The threads and their instances are created once for the whole
+    // exploration, and every level is handed to them as a batch.
+    unsigned int l_threadCount = p_parameters->threadCount;
+
+    if(l_threadCount == 0U) {
+        l_threadCount = 1U;
+    }
+
+    struct ts_pool *l_pool = poolCreate(l_threadCount);
+    struct ts_coreInstance **l_instances = (struct ts_coreInstance **)calloc(
+        l_threadCount,
+        sizeof(struct ts_coreInstance *)
+    );
+
+    if((l_set.hashes == NULL) || (l_pool == NULL) || (l_instances == NULL)) {
+        l_returnValue = 1;
+    } else {
+        for(unsigned int l_index = 0U; l_index < l_threadCount; l_index++) {
+            l_instances[l_index] = coreCreateInstance();
+
+            if(l_instances[l_index] == NULL) {
+                l_returnValue = 1;
+            }
+        }
+    }
+
+    // The root state is checked on the first instance so that the instance of
+    // the calling thread is left untouched.
+    struct ts_coreInstance *l_previousInstance = coreGetInstance();
+
+    if(l_returnValue == 0) {
+        coreSelectInstance(l_instances[0]);
+
+        if(
+            coreLoadState(
+                p_parameters->rootState,
+                p_parameters->rootStateSize
+            ) != 0
+        ) {
+            l_returnValue = 1;
+        } else if(
+            exploreAddNode(
+                &l_nodes,
+                &l_nodeCount,
+                &l_nodeCapacity,
+                C_EXPLORE_NO_PARENT,
+                0U
+            ) != 0
+        ) {
+            l_returnValue = 1;
+        } else {
+            exploreSetInsert(&l_set, coreGetStateHash());
+
+            if(p_parameters->predicate(p_parameters->predicateContext)) {
+                p_result->found = true;
+                l_returnValue = exploreSaveState(
+                    &p_result->state,
+                    &p_result->stateSize
+                );
+            }
+        }
+
+        coreSelectInstance(l_previousInstance);
+    }
+
+    if((l_returnValue == 0) && !p_result->found) {
+        l_frontier = (struct ts_exploreFrontierEntry *)malloc(
+            sizeof(struct ts_exploreFrontierEntry)
+        );
+
+        if(l_frontier == NULL) {
+            l_returnValue = 1;
+        } else {
+            // The root state belongs to the caller: it is never freed.
+            l_frontier[0].node = 0U;
+            l_frontier[0].state = (uint8_t *)p_parameters->rootState;
+            l_frontier[0].stateSize = p_parameters->rootStateSize;
+            l_frontierCount = 1U;
+        }
+    }
+
+    for(
+        unsigned int l_depth = 0U;
+        (l_returnValue == 0)
+        && !p_result->found
+        && (l_frontierCount > 0U)
+        && (l_depth < p_parameters->maxDepth);
+        l_depth++
+    ) {
+        struct ts_exploreLevel l_level = {
+            .parameters = p_parameters,
+            .instances = l_instances,
+            .frontier = l_frontier,
+            .workCount = l_frontierCount * p_parameters->actionCount,
+            .nextWork = 0U
+        };
+
+        l_level.outcomes = (struct ts_exploreOutcome *)calloc(
+            l_level.workCount,
+            sizeof(struct ts_exploreOutcome)
+        );
+
+        struct ts_exploreFrontierEntry *l_nextFrontier =
+            (struct ts_exploreFrontierEntry *)malloc(
+                l_level.workCount * sizeof(struct ts_exploreFrontierEntry)
+            );
+
+        size_t l_nextFrontierCount = 0U;
+
+        if(
+            (l_level.outcomes == NULL)
+            || (l_nextFrontier == NULL)
+            || (pthread_mutex_init(&l_level.mutex, NULL) != 0)
+        ) {
+            free(l_level.outcomes);
+            free(l_nextFrontier);
+            l_returnValue = 1;
+            break;
+        }
+
+        poolRun(l_pool, exploreWorker, &l_level, l_threadCount);
+        pthread_mutex_destroy(&l_level.mutex);
+
+        // The outcomes are merged in work item order, so that the visited
+        // nodes and the result do not depend on the thread scheduling.
+        for(size_t l_work = 0U; l_work < l_level.workCount; l_work++) {
+            struct ts_exploreOutcome *l_outcome = &l_level.outcomes[l_work];
+            bool l_keepState = false;
+
+            if(l_outcome->failed) {
+                l_returnValue = 1;
+            } else if(
+                (l_returnValue == 0)
+                && !p_result->found
+                && (
+                    (p_parameters->maxStateCount == 0U)
+                    || (l_set.count < p_parameters->maxStateCount)
+                )
+            ) {
+                int l_insertResult = exploreSetInsert(&l_set, l_outcome->hash);
+
+                if(l_insertResult < 0) {
+                    l_returnValue = 1;
+                } else if(l_insertResult == 0) {
+                    size_t l_parent =
+                        l_frontier[l_work / p_parameters->actionCount].node;
+
+                    if(
+                        exploreAddNode(
+                            &l_nodes,
+                            &l_nodeCount,
+                            &l_nodeCapacity,
+                            l_parent,
+                            l_work % p_parameters->actionCount
+                        ) != 0
+                    ) {
+                        l_returnValue = 1;
+                    } else if(l_outcome->matched) {
+                        p_result->found = true;
+                        p_result->state = l_outcome->state;
+                        p_result->stateSize = l_outcome->stateSize;
+                        l_keepState = true;
+
+                        l_returnValue = exploreBuildSequence(
+                            l_nodes,
+                            l_nodeCount - 1U,
+                            p_result
+                        );
+                    } else {
+                        l_nextFrontier[l_nextFrontierCount].node =
+                            l_nodeCount - 1U;
+                        l_nextFrontier[l_nextFrontierCount].state =
+                            l_outcome->state;
+                        l_nextFrontier[l_nextFrontierCount].stateSize =
+                            l_outcome->stateSize;
+                        l_nextFrontierCount++;
+                        l_keepState = true;
+                    }
+                }
+            }
+
+            if(!l_keepState) {
+                free(l_outcome->state);
+            }
+        }
+
+        free(l_level.outcomes);
+
+        for(size_t l_index = 0U; l_index < l_frontierCount; l_index++) {
+            if(l_frontier[l_index].state != p_parameters->rootState) {
+                free(l_frontier[l_index].state);
+            }
+        }
+
+        free(l_frontier);
+        l_frontier = l_nextFrontier;
+        l_frontierCount = l_nextFrontierCount;
+    }
+
+    for(size_t l_index = 0U; l_index < l_frontierCount; l_index++) {
+        if(l_frontier[l_index].state != p_parameters->rootState) {
+            free(l_frontier[l_index].state);
+        }
+    }
+
+    free(l_frontier);
+    free(l_nodes);
+    free(l_set.hashes);
+
+    if(l_instances != NULL) {
+        for(unsigned int l_index = 0U; l_index < l_threadCount; l_index++) {
+            coreDestroyInstance(l_instances[l_index]);
+        }
+    }
+
+    free(l_instances);
+    poolDestroy(l_pool);
+
+    p_result->visitedStateCount = l_set.count;
+
+    if(l_returnValue != 0) {
+        fprintf(stderr, "Error: the exploration failed.\n");
+        exploreFreeResult(p_result);
+    }
+
+    return l_returnValue;
+}
+
+void exploreFreeResult(struct ts_exploreResult *p_result) {
+    free(p_result->actions);
+    free(p_result->state);
+
+    p_result->found = false;
+    p_result->actions = NULL;
+    p_result->actionCount = 0U;
+    p_result->state = NULL;
+    p_result->stateSize = 0U;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static int exploreSaveState(uint8_t **p_state, size_t *p_stateSize) {
+    size_t l_stateSize = coreGetStateSize();
+    uint8_t *l_state = (uint8_t *)malloc(l_stateSize);
+
+    if(l_state == NULL) {
+        return 1;
+    }
+
+    if(coreSaveState(l_state, l_stateSize) != 0) {
+        free(l_state);
+        return 1;
+    }
+
+    *p_state = l_state;
+    *p_stateSize = l_stateSize;
+
+    return 0;
+}
+
+static void exploreApplyAction(const struct ts_exploreAction *p_action) {
+    if(p_action->pressed) {
+        coreSetInput(p_action->input, E_CORE_INPUT_PRESSED);
+    }
+
+    if(p_action->cycles != 0U) {
+        coreRunUntil(p_action->cycles, 0U, NULL);
+    }
+
+    if(p_action->pressed) {
+        coreSetInput(p_action->input, E_CORE_INPUT_RELEASED);
+    }
+}
+
+static void exploreWorker(void *p_level, size_t p_instance) {
+    struct ts_exploreLevel *l_level = (struct ts_exploreLevel *)p_level;
+    const struct ts_exploreParameters *l_parameters = l_level->parameters;
+    struct ts_coreInstance *l_previousInstance = coreGetInstance();
+
+    coreSelectInstance(l_level->instances[p_instance]);
+
+    while(true) {
+        pthread_mutex_lock(&l_level->mutex);
+
+        size_t l_work = l_level->nextWork;
+
+        if(l_work < l_level->workCount) {
+            l_level->nextWork++;
+        }
+
+        pthread_mutex_unlock(&l_level->mutex);
+
+        if(l_work >= l_level->workCount) {
+            break;
+        }
+
+        const struct ts_exploreFrontierEntry *l_entry =
+            &l_level->frontier[l_work / l_parameters->actionCount];
+        struct ts_exploreOutcome *l_outcome = &l_level->outcomes[l_work];
+
+        if(coreLoadState(l_entry->state, l_entry->stateSize) != 0) {
+            l_outcome->failed = true;
+            continue;
+        }
+
+        exploreApplyAction(
+            &l_parameters->actions[l_work % l_parameters->actionCount]
+        );
+
+        l_outcome->hash = coreGetStateHash();
+        l_outcome->matched =
+            l_parameters->predicate(l_parameters->predicateContext);
+
+        if(exploreSaveState(&l_outcome->state, &l_outcome->stateSize) != 0) {
+            l_outcome->failed = true;
+        }
+    }
+
+    coreSelectInstance(l_previousInstance);
+}
+
+static int exploreSetInsert(struct ts_exploreSet *p_set, uint64_t p_hash) {
+    // The empty slot value cannot be stored, so it is merged with another one.
+    if(p_hash == C_EXPLORE_EMPTY_HASH) {
+        p_hash = 1U;
+    }
+
+    // The set is kept at most half full.
+    if((p_set->count + 1U) * 2U > p_set->capacity) {
+        size_t l_capacity = p_set->capacity * 2U;
+        uint64_t *l_hashes = (uint64_t *)calloc(l_capacity, sizeof(uint64_t));
+
+        if(l_hashes == NULL) {
+            return -1;
+        }
+
+        for(size_t l_index = 0U; l_index < p_set->capacity; l_index++) {
+            uint64_t l_hash = p_set->hashes[l_index];
+
+            if(l_hash != C_EXPLORE_EMPTY_HASH) {
+                size_t l_slot = l_hash & (l_capacity - 1U);
+
+                while(l_hashes[l_slot] != C_EXPLORE_EMPTY_HASH) {
+                    l_slot = (l_slot + 1U) & (l_capacity - 1U);
+                }
+
+                l_hashes[l_slot] = l_hash;
+            }
+        }
+
+        free(p_set->hashes);
+        p_set->hashes = l_hashes;
+        p_set->capacity = l_capacity;
+    }
+
+    size_t l_slot = p_hash & (p_set->capacity - 1U);
+
+    while(p_set->hashes[l_slot] != C_EXPLORE_EMPTY_HASH) {
+        if(p_set->hashes[l_slot] == p_hash) {
+            return 1;
+        }
+
+        l_slot = (l_slot + 1U) & (p_set->capacity - 1U);
+    }
+
+    p_set->hashes[l_slot] = p_hash;
+    p_set->count++;
+
+    return 0;
+}
+
+static int exploreBuildSequence(
+    const struct ts_exploreNode *p_nodes,
+    size_t p_node,
+    struct ts_exploreResult *p_result
+) {
+    size_t l_actionCount = 0U;
+
+    for(
+        size_t l_node = p_node;
+        p_nodes[l_node].parent != C_EXPLORE_NO_PARENT;
+        l_node = p_nodes[l_node].parent
+    ) {
+        l_actionCount++;
+    }
+
+    p_result->actions = (size_t *)malloc(l_actionCount * sizeof(size_t));
+
+    if(p_result->actions == NULL) {
+        return 1;
+    }
+
+    p_result->actionCount = l_actionCount;
+
+    for(
+        size_t l_node = p_node;
+        p_nodes[l_node].parent != C_EXPLORE_NO_PARENT;
+        l_node = p_nodes[l_node].parent
+    ) {
+        p_result->actions[--l_actionCount] = p_nodes[l_node].action;
+    }
+
+    return 0;
+}
+
+static int exploreAddNode(
+    struct ts_exploreNode **p_nodes,
+    size_t *p_nodeCount,
+    size_t *p_nodeCapacity,
+    size_t p_parent,
+    size_t p_action
+) {
+    if(*p_nodeCount == *p_nodeCapacity) {
+        size_t l_capacity = 64U;
+
+        if(*p_nodeCapacity != 0U) {
+            l_capacity = *p_nodeCapacity * 2U;
+        }
+
+        struct ts_exploreNode *l_nodes = (struct ts_exploreNode *)realloc(
+            *p_nodes,
+            l_capacity * sizeof(struct ts_exploreNode)
+        );
+
+        if(l_nodes == NULL) {
+            return 1;
+        }
+
+        *p_nodes = l_nodes;
+        *p_nodeCapacity = l_capacity;
+    }
+
+    (*p_nodes)[*p_nodeCount].parent = p_parent;
+    (*p_nodes)[*p_nodeCount].action = p_action;
+    (*p_nodeCount)++;
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#ifndef __INC_HOST_EXPLORE_H__
+#define __INC_HOST_EXPLORE_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/core.h"
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure describes an action of the input alphabet: an input
+ *        key is held while the core runs for a number of cycles, then it is
+ *        released.
+ */
+struct ts_exploreAction {
+    /**
+     * @brief This member indicates whether an input key is held. If false, the
+     *        core just runs for the given number of cycles.
+     */
+    bool pressed;
+
+    enum te_coreInput input;
+    uint64_t cycles;
+};
+
+/**
+ * @brief This type describes a function that decides if the state of the
+ *        selected instance is the one being searched for. It can inspect the
+ *        instance with coreReadMemory(). It is called from several threads at
+ *        the same time.
+ *
+ * @param[in] p_context The context given in the parameters.
+ *
+ * @returns A boolean value that indicates whether the exploration must stop.
+ */
+typedef bool (*tf_explorePredicate)(void *p_context);
+
+struct ts_exploreParameters {
+    /**
+     * @brief This member contains the state that the exploration starts from,
+     *        as saved by coreSaveState().
+     */
+    const uint8_t *rootState;
+
+    size_t rootStateSize;
+    const struct ts_exploreAction *actions;
+    size_t actionCount;
+
+    /**
+     * @brief This member contains the maximum length of an input sequence.
+     */
+    unsigned int maxDepth;
+
+    /**
+     * @brief This member contains the maximum number of distinct states to
+     *        visit, or 0 for no limit.
+     */
+    size_t maxStateCount;
+
+    unsigned int threadCount;
+    tf_explorePredicate predicate;
+    void *predicateContext;
+};
+
+struct ts_exploreResult {
+    /**
+     * @brief This member indicates whether a state that satisfies the
+     *        predicate was found. The other members are only valid if it is
+     *        true.
+     */
+    bool found;
+
+    /**
+     * @brief This member contains the indexes in the alphabet of the actions
+     *        that lead from the root state to the state found. Among the
+     *        shortest sequences, the first one in breadth-first order is
+     *        returned, so the result does not depend on the number of threads.
+     */
+    size_t *actions;
+
+    size_t actionCount;
+
+    /**
+     * @brief This member contains the state found, as saved by
+     *        coreSaveState().
+     */
+    uint8_t *state;
+
+    size_t stateSize;
+
+    /**
+     * @brief This member contains the number of distinct states visited,
+     *        whether a state was found or not.
+     */
+    size_t visitedStateCount;
+};
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Explores the input sequences breadth-first from the root state until
+ *        a state satisfies the predicate. Each sequence is run by restoring the
+ *        state reached by its prefix, and states that were already visited
+ *        (according to coreGetStateHash()) are not explored again.
+ * @details The FLASH ROM and the EEPROM must be loaded in the core before
+ *          calling this function. Each thread runs its own instance, and the
+ *          instance selected by the calling thread is not modified.
+ *
+ * @param[in] p_parameters The parameters of the exploration.
+ * @param[out] p_result The result of the exploration. It must be freed with
+ *                      exploreFreeResult() if the function succeeds.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the exploration completed, whether a state was found or not.
+ * @retval Any other value if an error occurred.
+ */
+int exploreRun(
+    const struct ts_exploreParameters *p_parameters,
+    struct ts_exploreResult *p_result
+);
+
+/**
+ * @brief Frees the buffers of an exploration result.
+ *
+ * @param[in,out] p_result The result to free.
+ */
+void exploreFreeResult(struct ts_exploreResult *p_result);
+
+#endif // __INC_HOST_EXPLORE_H__
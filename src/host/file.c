@@ -0,0 +1,119 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "host/file.h"
+
+// =============================================================================
+// Public functions definitions
+// =============================================================================
+int fileRead(const char *p_filePath, void **p_buffer, size_t *p_size) {
+    FILE *l_file = fopen(p_filePath, "rb");
+
+    // Get file size
+    if(l_file == NULL) {
+        return 1;
+    }
+
+    fseek(l_file, 0L, SEEK_END);
+
+    size_t l_fileSize = ftell(l_file);
+
+    // Compare file size to the maximum file size
+    if(*p_size < l_fileSize) {
+        fclose(l_file);
+        return 1;
+    }
+
+    // Allocate a buffer for reading the file
+    uint8_t *l_buffer = (uint8_t *)malloc(l_fileSize);
+
+    if(l_buffer == NULL) {
+        fclose(l_file);
+        return 1;
+    }
+
+    // Read the file
+    fseek(l_file, 0L, SEEK_SET);
+
+    if(fread(l_buffer, 1, l_fileSize, l_file) != l_fileSize) {
+        fclose(l_file);
+        free(l_buffer);
+        return 1;
+    }
+
+    fclose(l_file);
+
+    *p_buffer = (void *)l_buffer;
+    *p_size = l_fileSize;
+
+    return 0;
+}
+
+int fileMap(const char *p_filePath, const void **p_buffer, size_t p_size) {
+#ifdef _WIN32
+    void *l_buffer;
+    size_t l_bufferSize = p_size;
+
+    if(fileRead(p_filePath, &l_buffer, &l_bufferSize) != 0) {
+        return 1;
+    }
+
+    if(l_bufferSize != p_size) {
+        free(l_buffer);
+        return 1;
+    }
+
+    *p_buffer = l_buffer;
+
+    return 0;
+#else
+    int l_fileDescriptor = open(p_filePath, O_RDONLY);
+
+    if(l_fileDescriptor < 0) {
+        return 1;
+    }
+
+    // Check the file size
+    struct stat l_fileStatus;
+
+    if(
+        (fstat(l_fileDescriptor, &l_fileStatus) != 0)
+        || ((size_t)l_fileStatus.st_size != p_size)
+    ) {
+        close(l_fileDescriptor);
+        return 1;
+    }
+
+    // Map the file. The mapping remains valid after closing the file.
+    void *l_mapping = mmap(
+        NULL,
+        p_size,
+        PROT_READ,
+        MAP_PRIVATE,
+        l_fileDescriptor,
+        0
+    );
+
+    close(l_fileDescriptor);
+
+    if(l_mapping == MAP_FAILED) {
+        return 1;
+    }
+
+    *p_buffer = l_mapping;
+
+    return 0;
+#endif
+}
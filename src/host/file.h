@@ -0,0 +1,44 @@
+#ifndef __INC_HOST_FILE_H__
+#define __INC_HOST_FILE_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stddef.h>
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Reads the given file.
+ *
+ * @param[in] p_filePath The path to the file to load.
+ * @param[out] p_buffer A pointer to the variable that will store the pointer to
+ *                      the buffer. The buffer must be freed with free().
+ * @param[in, out] p_size Contains the maximum file size on call, and will
+ *                        be replaced by the actual file size on return.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+int fileRead(const char *p_filePath, void **p_buffer, size_t *p_size);
+
+/**
+ * @brief Maps the given file in memory as read-only. On systems that do not
+ *        support memory mapping, the file is read in a buffer instead. The
+ *        mapping is never released and can be shared by every instance of the
+ *        core in the process.
+ *
+ * @param[in] p_filePath The path to the file to map.
+ * @param[out] p_buffer A pointer to the variable that will store the pointer to
+ *                      the mapping.
+ * @param[in] p_size The expected size of the file.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+int fileMap(const char *p_filePath, const void **p_buffer, size_t p_size);
+
+#endif // __INC_HOST_FILE_H__
@@ -0,0 +1,484 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common.h"
+#include "core/core.h"
+#include "host/metricsfile.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the suffix of the temporary file that is
+ *        renamed to the metrics file once it is complete.
+ */
+#define C_METRICSFILE_TEMPORARY_SUFFIX ".tmp"
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+struct ts_metricsFile {
+    /**
+     * @brief This member indicates whether the thread is started.
+     */
+    bool running;
+
+    /**
+     * @brief These members contain the path of the metrics file and of the
+     *        temporary file.
+     */
+    char *filePath;
+    char *temporaryFilePath;
+
+    unsigned int intervalMs;
+
+    /**
+     * @brief These members stop the thread. They are protected by mutex.
+     */
+    pthread_mutex_t mutex;
+    pthread_cond_t stop;
+    bool stopping;
+
+    /**
+     * @brief These members are only used by the thread.
+     */
+    pthread_t thread;
+    struct timespec startTime;
+    struct timespec lastTime;
+    struct ts_coreMetrics lastMetrics;
+    bool failed;
+};
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This variable contains the state of the metrics file.
+ */
+static struct ts_metricsFile s_metricsFile;
+
+/**
+ * @brief This table contains the label value of each te_coreBusPeripheral.
+ */
+static const char *const s_metricsFilePeripheralNames[
+    E_CORE_BUS_PERIPHERAL_COUNT
+] = {
+    [E_CORE_BUS_PERIPHERAL_OPEN_BUS] = "open_bus",
+    [E_CORE_BUS_PERIPHERAL_ROM] = "rom",
+    [E_CORE_BUS_PERIPHERAL_RAM] = "ram",
+    [E_CORE_BUS_PERIPHERAL_SSU] = "ssu",
+    [E_CORE_BUS_PERIPHERAL_PORT] = "port",
+    [E_CORE_BUS_PERIPHERAL_TIMER_W] = "timer_w"
+};
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Writes the metrics file at every interval until the thread is
+ *        stopped, then writes it a last time.
+ *
+ * @param[in] p_context Unused.
+ *
+ * @returns NULL.
+ */
+static void *metricsFileRun(void *p_context);
+
+/**
+ * @brief Writes the metrics file.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int metricsFileWrite(void);
+
+/**
+ * @brief Writes the HELP and TYPE lines of a metric.
+ *
+ * @param[in] p_file The file to write to.
+ * @param[in] p_name The name of the metric.
+ * @param[in] p_type The type of the metric.
+ * @param[in] p_help The description of the metric.
+ */
+static void metricsFileWriteHeader(
+    FILE *p_file,
+    const char *p_name,
+    const char *p_type,
+    const char *p_help
+);
+
+/**
+ * @brief Returns the number of seconds between two times.
+ *
+ * @param[in] p_start The earlier time.
+ * @param[in] p_end The later time.
+ *
+ * @returns The number of seconds.
+ */
+static double metricsFileGetSeconds(
+    const struct timespec *p_start,
+    const struct timespec *p_end
+);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int metricsFileStart(const char *p_filePath, unsigned int p_intervalMs) {
+    size_t l_pathLength = strlen(p_filePath);
+
+    s_metricsFile.filePath = strdup(p_filePath);
+    s_metricsFile.temporaryFilePath =
+        malloc(l_pathLength + sizeof(C_METRICSFILE_TEMPORARY_SUFFIX));
+
+    if(
+        (s_metricsFile.filePath == NULL)
+        || (s_metricsFile.temporaryFilePath == NULL)
+    ) {
+        free(s_metricsFile.filePath);
+        free(s_metricsFile.temporaryFilePath);
+        return 1;
+    }
+
+    memcpy(s_metricsFile.temporaryFilePath, p_filePath, l_pathLength);
+    memcpy(
+        &s_metricsFile.temporaryFilePath[l_pathLength],
+        C_METRICSFILE_TEMPORARY_SUFFIX,
+        sizeof(C_METRICSFILE_TEMPORARY_SUFFIX)
+    );
+
+    s_metricsFile.intervalMs = (p_intervalMs == 0U) ? 1U : p_intervalMs;
+    s_metricsFile.stopping = false;
+    s_metricsFile.failed = false;
+    clock_gettime(CLOCK_MONOTONIC, &s_metricsFile.startTime);
+    s_metricsFile.lastTime = s_metricsFile.startTime;
+    coreGetMetrics(&s_metricsFile.lastMetrics);
+
+    // The file is written once before the thread starts, so that an invalid
+    // path is reported immediately.
+    if(metricsFileWrite() != 0) {
+        fprintf(stderr, "Error: failed to write \"%s\".\n", p_filePath);
+        free(s_metricsFile.filePath);
+        free(s_metricsFile.temporaryFilePath);
+        return 1;
+    }
+
+    pthread_condattr_t l_conditionAttributes;
+
+    // The interval is measured on the monotonic clock, so that it does not
+    // change with the wall clock.
+    if(
+        (pthread_mutex_init(&s_metricsFile.mutex, NULL) != 0)
+        || (pthread_condattr_init(&l_conditionAttributes) != 0)
+        || (pthread_condattr_setclock(
+            &l_conditionAttributes,
+            CLOCK_MONOTONIC
+        ) != 0)
+        || (pthread_cond_init(
+            &s_metricsFile.stop,
+            &l_conditionAttributes
+        ) != 0)
+        || (pthread_create(
+            &s_metricsFile.thread,
+            NULL,
+            metricsFileRun,
+            NULL
+        ) != 0)
+    ) {
+        fprintf(stderr, "Error: failed to start the metrics thread.\n");
+        free(s_metricsFile.filePath);
+        free(s_metricsFile.temporaryFilePath);
+        return 1;
+    }
+
+    pthread_condattr_destroy(&l_conditionAttributes);
+    s_metricsFile.running = true;
+
+    return 0;
+}
+
+void metricsFileStop(void) {
+    if(!s_metricsFile.running) {
+        return;
+    }
+
+    pthread_mutex_lock(&s_metricsFile.mutex);
+    s_metricsFile.stopping = true;
+    pthread_cond_signal(&s_metricsFile.stop);
+    pthread_mutex_unlock(&s_metricsFile.mutex);
+
+    pthread_join(s_metricsFile.thread, NULL);
+    pthread_cond_destroy(&s_metricsFile.stop);
+    pthread_mutex_destroy(&s_metricsFile.mutex);
+
+    if(s_metricsFile.failed) {
+        fprintf(
+            stderr,
+            "Error: failed to write \"%s\".\n",
+            s_metricsFile.filePath
+        );
+    }
+
+    free(s_metricsFile.filePath);
+    free(s_metricsFile.temporaryFilePath);
+    s_metricsFile.running = false;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static void *metricsFileRun(void *p_context) {
+    M_UNUSED_PARAMETER(p_context);
+
+    struct timespec l_deadline = s_metricsFile.startTime;
+    bool l_stopping = false;
+
+    while(!l_stopping) {
+        l_deadline.tv_sec += s_metricsFile.intervalMs / 1000U;
+        l_deadline.tv_nsec += (long)(s_metricsFile.intervalMs % 1000U)
+            * 1000000L;
+
+        if(l_deadline.tv_nsec >= 1000000000L) {
+            l_deadline.tv_sec++;
+            l_deadline.tv_nsec -= 1000000000L;
+        }
+
+        pthread_mutex_lock(&s_metricsFile.mutex);
+
+        while(
+            (!s_metricsFile.stopping)
+            && (pthread_cond_timedwait(
+                &s_metricsFile.stop,
+                &s_metricsFile.mutex,
+                &l_deadline
+            ) == 0)
+        ) {
+            // Spurious wakeup: wait again until the deadline.
+        }
+
+        l_stopping = s_metricsFile.stopping;
+        pthread_mutex_unlock(&s_metricsFile.mutex);
+
+        // A failure is reported once, when the thread stops: a scraper may
+        // have removed or locked the file for a moment.
+        if(metricsFileWrite() != 0) {
+            s_metricsFile.failed = true;
+        }
+    }
+
+    return NULL;
+}
+
+static int metricsFileWrite(void) {
+    struct ts_coreMetrics l_metrics;
+    struct timespec l_time;
+
+    coreGetMetrics(&l_metrics);
+    clock_gettime(CLOCK_MONOTONIC, &l_time);
+
+    // The rates are computed over the last interval, as the scrapers may not
+    // compute them from the counters.
+    double l_intervalSeconds =
+        metricsFileGetSeconds(&s_metricsFile.lastTime, &l_time);
+    double l_mips = 0.0;
+    double l_speedRatio = 0.0;
+    double l_schedulerEventsPerSecond = 0.0;
+
+    if(l_intervalSeconds > 0.0) {
+        l_mips = (double)(
+            l_metrics.instructions - s_metricsFile.lastMetrics.instructions
+        ) / l_intervalSeconds / 1e6;
+        l_speedRatio = (double)(
+            l_metrics.cycles - s_metricsFile.lastMetrics.cycles
+        ) / C_CORE_CLOCK_RATE_HZ / l_intervalSeconds;
+        l_schedulerEventsPerSecond = (double)(
+            l_metrics.schedulerEvents
+                - s_metricsFile.lastMetrics.schedulerEvents
+        ) / l_intervalSeconds;
+    }
+
+    s_metricsFile.lastTime = l_time;
+    s_metricsFile.lastMetrics = l_metrics;
+
+    FILE *l_file = fopen(s_metricsFile.temporaryFilePath, "w");
+
+    if(l_file == NULL) {
+        return 1;
+    }
+
+    metricsFileWriteHeader(
+        l_file,
+        "emuwalker_uptime_seconds",
+        "gauge",
+        "Host time since the metrics started."
+    );
+    fprintf(
+        l_file,
+        "emuwalker_uptime_seconds %.3f\n",
+        metricsFileGetSeconds(&s_metricsFile.startTime, &l_time)
+    );
+
+    metricsFileWriteHeader(
+        l_file,
+        "emuwalker_cycles_total",
+        "counter",
+        "Emulated CPU cycles."
+    );
+    fprintf(
+        l_file,
+        "emuwalker_cycles_total %llu\n",
+        (unsigned long long)l_metrics.cycles
+    );
+
+    metricsFileWriteHeader(
+        l_file,
+        "emuwalker_emulated_seconds_total",
+        "counter",
+        "Emulated time, by CPU state. The CPU is asleep during the skipped "
+            "idle loops."
+    );
+    fprintf(
+        l_file,
+        "emuwalker_emulated_seconds_total{state=\"executing\"} %.6f\n"
+            "emuwalker_emulated_seconds_total{state=\"asleep\"} %.6f\n",
+        (double)(l_metrics.cycles - l_metrics.idleCycles)
+            / C_CORE_CLOCK_RATE_HZ,
+        (double)l_metrics.idleCycles / C_CORE_CLOCK_RATE_HZ
+    );
+
+    metricsFileWriteHeader(
+        l_file,
+        "emuwalker_instructions_total",
+        "counter",
+        "CPU instructions, interpreted or recompiled."
+    );
+    fprintf(
+        l_file,
+        "emuwalker_instructions_total %llu\n",
+        (unsigned long long)l_metrics.instructions
+    );
+
+    metricsFileWriteHeader(
+        l_file,
+        "emuwalker_frames_total",
+        "counter",
+        "Frames displayed by the LCD panels."
+    );
+    fprintf(
+        l_file,
+        "emuwalker_frames_total %llu\n",
+        (unsigned long long)l_metrics.frames
+    );
+
+    metricsFileWriteHeader(
+        l_file,
+        "emuwalker_scheduler_events_total",
+        "counter",
+        "Scheduler events run."
+    );
+    fprintf(
+        l_file,
+        "emuwalker_scheduler_events_total %llu\n",
+        (unsigned long long)l_metrics.schedulerEvents
+    );
+
+    metricsFileWriteHeader(
+        l_file,
+        "emuwalker_eeprom_bytes_written_total",
+        "counter",
+        "EEPROM bytes changed."
+    );
+    fprintf(
+        l_file,
+        "emuwalker_eeprom_bytes_written_total %llu\n",
+        (unsigned long long)l_metrics.eepromBytesWritten
+    );
+
+    metricsFileWriteHeader(
+        l_file,
+        "emuwalker_bus_accesses_total",
+        "counter",
+        "Bus accesses, by peripheral."
+    );
+
+    for(
+        unsigned int l_peripheral = 0U;
+        l_peripheral < E_CORE_BUS_PERIPHERAL_COUNT;
+        l_peripheral++
+    ) {
+        fprintf(
+            l_file,
+            "emuwalker_bus_accesses_total{peripheral=\"%s\"} %llu\n",
+            s_metricsFilePeripheralNames[l_peripheral],
+            (unsigned long long)l_metrics.busAccesses[l_peripheral]
+        );
+    }
+
+    metricsFileWriteHeader(
+        l_file,
+        "emuwalker_emulated_mips",
+        "gauge",
+        "CPU instructions per host second, in millions, over the last "
+            "interval."
+    );
+    fprintf(l_file, "emuwalker_emulated_mips %.3f\n", l_mips);
+
+    metricsFileWriteHeader(
+        l_file,
+        "emuwalker_speed_ratio",
+        "gauge",
+        "Emulated time per host time, over the last interval."
+    );
+    fprintf(l_file, "emuwalker_speed_ratio %.3f\n", l_speedRatio);
+
+    metricsFileWriteHeader(
+        l_file,
+        "emuwalker_scheduler_events_per_second",
+        "gauge",
+        "Scheduler events per host second, over the last interval."
+    );
+    fprintf(
+        l_file,
+        "emuwalker_scheduler_events_per_second %.1f\n",
+        l_schedulerEventsPerSecond
+    );
+
+    bool l_failed = (ferror(l_file) != 0);
+
+    if((fclose(l_file) != 0) || l_failed) {
+        return 1;
+    } else if(
+        rename(s_metricsFile.temporaryFilePath, s_metricsFile.filePath) != 0
+    ) {
+        return 1;
+    }
+
+    return 0;
+}
+
+static void metricsFileWriteHeader(
+    FILE *p_file,
+    const char *p_name,
+    const char *p_type,
+    const char *p_help
+) {
+    fprintf(p_file, "# HELP %s %s\n", p_name, p_help);
+    fprintf(p_file, "# TYPE %s %s\n", p_name, p_type);
+}
+
+static double metricsFileGetSeconds(
+    const struct timespec *p_start,
+    const struct timespec *p_end
+) {
+    return (double)(p_end->tv_sec - p_start->tv_sec)
+        + (double)(p_end->tv_nsec - p_start->tv_nsec) / 1e9;
+}
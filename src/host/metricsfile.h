@@ -0,0 +1,41 @@
+#ifndef __INC_HOST_METRICSFILE_H__
+#define __INC_HOST_METRICSFILE_H__
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the default interval between two writes of the
+ *        metrics file, in milliseconds.
+ */
+#define C_METRICSFILE_DEFAULT_INTERVAL_MS 1000U
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Starts a thread that writes the metrics of the core to a file in the
+ *        Prometheus text exposition format at a fixed interval, for a node
+ *        exporter textfile collector or any scraper that reads files. The
+ *        file is replaced atomically, so that a reader never sees a partial
+ *        file.
+ * @details The file contains the counters of coreGetMetrics(), and gauges
+ *          computed over the last interval: the emulated MIPS, the ratio of
+ *          emulated time to host time, and the scheduler events per second.
+ *
+ * @param[in] p_filePath The path of the metrics file.
+ * @param[in] p_intervalMs The interval between two writes in milliseconds.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+int metricsFileStart(const char *p_filePath, unsigned int p_intervalMs);
+
+/**
+ * @brief Writes the metrics file a last time and stops the thread. It does
+ *        nothing if the thread is not started.
+ */
+void metricsFileStop(void);
+
+#endif // __INC_HOST_METRICSFILE_H__
@@ -0,0 +1,362 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "core/core.h"
+#include "host/perfcounters.h"
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+enum te_perfCountersEvent {
+    E_PERFCOUNTERS_EVENT_CYCLES,
+    E_PERFCOUNTERS_EVENT_INSTRUCTIONS,
+    E_PERFCOUNTERS_EVENT_BRANCH_MISSES,
+    E_PERFCOUNTERS_EVENT_L1D_MISSES,
+    E_PERFCOUNTERS_EVENT_LLC_MISSES,
+
+    E_PERFCOUNTERS_EVENT_COUNT
+};
+
+struct ts_perfCounters {
+    /**
+     * @brief This member contains the file descriptor of each counter, or -1
+     *        if the host does not support it. The cycle counter leads the
+     *        group, so that all the counters are scheduled together.
+     */
+    int fileDescriptors[E_PERFCOUNTERS_EVENT_COUNT];
+
+    /**
+     * @brief This member contains the position of each counter in the values
+     *        read from the group.
+     */
+    unsigned int groupIndexes[E_PERFCOUNTERS_EVENT_COUNT];
+    unsigned int groupSize;
+
+    /**
+     * @brief This member contains the emulated instruction counter when the
+     *        counters were opened.
+     */
+    uint64_t startInstructions;
+};
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This variable contains the counters.
+ */
+static struct ts_perfCounters s_perfCounters = {
+    .fileDescriptors = {-1, -1, -1, -1, -1}
+};
+
+#ifdef __linux__
+/**
+ * @brief This table contains the type and configuration of each counter.
+ */
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} s_perfCountersEvents[E_PERFCOUNTERS_EVENT_COUNT] = {
+    [E_PERFCOUNTERS_EVENT_CYCLES] = {
+        PERF_TYPE_HARDWARE,
+        PERF_COUNT_HW_CPU_CYCLES
+    },
+    [E_PERFCOUNTERS_EVENT_INSTRUCTIONS] = {
+        PERF_TYPE_HARDWARE,
+        PERF_COUNT_HW_INSTRUCTIONS
+    },
+    [E_PERFCOUNTERS_EVENT_BRANCH_MISSES] = {
+        PERF_TYPE_HARDWARE,
+        PERF_COUNT_HW_BRANCH_MISSES
+    },
+    [E_PERFCOUNTERS_EVENT_L1D_MISSES] = {
+        PERF_TYPE_HW_CACHE,
+        PERF_COUNT_HW_CACHE_L1D
+            | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    },
+    [E_PERFCOUNTERS_EVENT_LLC_MISSES] = {
+        PERF_TYPE_HW_CACHE,
+        PERF_COUNT_HW_CACHE_LL
+            | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    }
+};
+#endif
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Reads the counts of the group, scaled if the kernel had to share the
+ *        hardware counters with other groups.
+ *
+ * @param[out] p_values The count of each counter.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int perfCountersRead(uint64_t p_values[E_PERFCOUNTERS_EVENT_COUNT]);
+
+/**
+ * @brief Prints the number of events of a counter per emulated instruction,
+ *        or "n/a" if the counter is not supported.
+ *
+ * @param[in] p_name The name of the counter.
+ * @param[in] p_values The count of each counter.
+ * @param[in] p_event The counter.
+ * @param[in] p_instructions The number of emulated instructions.
+ */
+static void perfCountersPrintRate(
+    const char *p_name,
+    const uint64_t p_values[E_PERFCOUNTERS_EVENT_COUNT],
+    enum te_perfCountersEvent p_event,
+    uint64_t p_instructions
+);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int perfCountersOpen(void) {
+#ifdef __linux__
+    struct ts_coreMetrics l_metrics;
+
+    s_perfCounters.groupSize = 0U;
+
+    for(
+        unsigned int l_event = 0U;
+        l_event < E_PERFCOUNTERS_EVENT_COUNT;
+        l_event++
+    ) {
+        struct perf_event_attr l_attributes;
+        int l_groupFileDescriptor =
+            s_perfCounters.fileDescriptors[E_PERFCOUNTERS_EVENT_CYCLES];
+
+        memset(&l_attributes, 0, sizeof(l_attributes));
+        l_attributes.size = sizeof(l_attributes);
+        l_attributes.type = s_perfCountersEvents[l_event].type;
+        l_attributes.config = s_perfCountersEvents[l_event].config;
+        l_attributes.read_format = PERF_FORMAT_GROUP
+            | PERF_FORMAT_TOTAL_TIME_ENABLED
+            | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        l_attributes.exclude_kernel = 1;
+        l_attributes.exclude_hv = 1;
+
+        // The members of the group follow the leader, which starts disabled.
+        l_attributes.disabled = (l_event == E_PERFCOUNTERS_EVENT_CYCLES);
+
+        int l_fileDescriptor = syscall(
+            SYS_perf_event_open,
+            &l_attributes,
+            0,
+            -1,
+            l_groupFileDescriptor,
+            0UL
+        );
+
+        s_perfCounters.fileDescriptors[l_event] = l_fileDescriptor;
+
+        if(l_fileDescriptor >= 0) {
+            s_perfCounters.groupIndexes[l_event] = s_perfCounters.groupSize;
+            s_perfCounters.groupSize++;
+        } else if(l_event == E_PERFCOUNTERS_EVENT_CYCLES) {
+            fprintf(
+                stderr,
+                "Error: failed to open the host performance counters (check "
+                "/proc/sys/kernel/perf_event_paranoid).\n"
+            );
+            return 1;
+        }
+    }
+
+    coreGetMetrics(&l_metrics);
+    s_perfCounters.startInstructions = l_metrics.instructions;
+
+    return 0;
+#else
+    fprintf(stderr, "Error: host performance counters are not supported.\n");
+
+    return 1;
+#endif
+}
+
+void perfCountersStart(void) {
+#ifdef __linux__
+    ioctl(
+        s_perfCounters.fileDescriptors[E_PERFCOUNTERS_EVENT_CYCLES],
+        PERF_EVENT_IOC_ENABLE,
+        PERF_IOC_FLAG_GROUP
+    );
+#endif
+}
+
+void perfCountersStop(void) {
+#ifdef __linux__
+    ioctl(
+        s_perfCounters.fileDescriptors[E_PERFCOUNTERS_EVENT_CYCLES],
+        PERF_EVENT_IOC_DISABLE,
+        PERF_IOC_FLAG_GROUP
+    );
+#endif
+}
+
+void perfCountersPrint(void) {
+    uint64_t l_values[E_PERFCOUNTERS_EVENT_COUNT];
+    struct ts_coreMetrics l_metrics;
+
+    if(perfCountersRead(l_values) != 0) {
+        fprintf(
+            stderr,
+            "Error: failed to read the host performance counters.\n"
+        );
+        return;
+    }
+
+    coreGetMetrics(&l_metrics);
+
+    uint64_t l_instructions =
+        l_metrics.instructions - s_perfCounters.startInstructions;
+
+    printf(
+        "host cycles %llu",
+        (unsigned long long)l_values[E_PERFCOUNTERS_EVENT_CYCLES]
+    );
+
+    if(s_perfCounters.fileDescriptors[E_PERFCOUNTERS_EVENT_INSTRUCTIONS] >= 0) {
+        printf(
+            " instructions %llu ipc %.3f",
+            (unsigned long long)l_values[E_PERFCOUNTERS_EVENT_INSTRUCTIONS],
+            (l_values[E_PERFCOUNTERS_EVENT_CYCLES] == 0U) ? 0.0
+                : (double)l_values[E_PERFCOUNTERS_EVENT_INSTRUCTIONS]
+                    / l_values[E_PERFCOUNTERS_EVENT_CYCLES]
+        );
+    }
+
+    printf(
+        "\nper emulated instruction (%llu):",
+        (unsigned long long)l_instructions
+    );
+    perfCountersPrintRate(
+        "cycles",
+        l_values,
+        E_PERFCOUNTERS_EVENT_CYCLES,
+        l_instructions
+    );
+    perfCountersPrintRate(
+        "instructions",
+        l_values,
+        E_PERFCOUNTERS_EVENT_INSTRUCTIONS,
+        l_instructions
+    );
+    perfCountersPrintRate(
+        "branch-misses",
+        l_values,
+        E_PERFCOUNTERS_EVENT_BRANCH_MISSES,
+        l_instructions
+    );
+    perfCountersPrintRate(
+        "l1d-misses",
+        l_values,
+        E_PERFCOUNTERS_EVENT_L1D_MISSES,
+        l_instructions
+    );
+    perfCountersPrintRate(
+        "llc-misses",
+        l_values,
+        E_PERFCOUNTERS_EVENT_LLC_MISSES,
+        l_instructions
+    );
+    printf("\n");
+}
+
+void perfCountersClose(void) {
+#ifdef __linux__
+    // The members are closed before the leader.
+    for(
+        unsigned int l_event = E_PERFCOUNTERS_EVENT_COUNT;
+        l_event > 0U;
+        l_event--
+    ) {
+        if(s_perfCounters.fileDescriptors[l_event - 1U] >= 0) {
+            close(s_perfCounters.fileDescriptors[l_event - 1U]);
+            s_perfCounters.fileDescriptors[l_event - 1U] = -1;
+        }
+    }
+#endif
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static int perfCountersRead(uint64_t p_values[E_PERFCOUNTERS_EVENT_COUNT]) {
+    memset(p_values, 0, E_PERFCOUNTERS_EVENT_COUNT * sizeof(uint64_t));
+
+#ifdef __linux__
+    // The group is read as its size, the time enabled, the time running and
+    // the value of each member.
+    uint64_t l_buffer[3U + E_PERFCOUNTERS_EVENT_COUNT];
+    size_t l_size = (3U + s_perfCounters.groupSize) * sizeof(uint64_t);
+
+    if(
+        read(
+            s_perfCounters.fileDescriptors[E_PERFCOUNTERS_EVENT_CYCLES],
+            l_buffer,
+            l_size
+        ) != (ssize_t)l_size
+    ) {
+        return 1;
+    }
+
+    double l_scale = 1.0;
+
+    if((l_buffer[2] != 0U) && (l_buffer[2] < l_buffer[1])) {
+        l_scale = (double)l_buffer[1] / l_buffer[2];
+    }
+
+    for(
+        unsigned int l_event = 0U;
+        l_event < E_PERFCOUNTERS_EVENT_COUNT;
+        l_event++
+    ) {
+        if(s_perfCounters.fileDescriptors[l_event] >= 0) {
+            p_values[l_event] = (uint64_t)(
+                l_buffer[3U + s_perfCounters.groupIndexes[l_event]] * l_scale
+            );
+        }
+    }
+
+    return 0;
+#else
+    return 1;
+#endif
+}
+
+static void perfCountersPrintRate(
+    const char *p_name,
+    const uint64_t p_values[E_PERFCOUNTERS_EVENT_COUNT],
+    enum te_perfCountersEvent p_event,
+    uint64_t p_instructions
+) {
+    if(
+        (s_perfCounters.fileDescriptors[p_event] < 0)
+        || (p_instructions == 0U)
+    ) {
+        printf(" %s n/a", p_name);
+    } else {
+        printf(" %s %.4f", p_name, (double)p_values[p_event] / p_instructions);
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef __INC_HOST_PERFCOUNTERS_H__
+#define __INC_HOST_PERFCOUNTERS_H__
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Opens the hardware performance counters of the host CPU for the
+ *        calling thread: cycles, instructions, branch misses, L1 data cache
+ *        misses and last level cache misses. They only count user space
+ *        code, and only between perfCountersStart() and perfCountersStop().
+ *        The counters that the host does not support are left out.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if the cycle counter could not be opened.
+ */
+int perfCountersOpen(void);
+
+/**
+ * @brief Starts counting. This is done before each run slice, so that the
+ *        work of the front-end between slices is not counted.
+ */
+void perfCountersStart(void);
+
+/**
+ * @brief Stops counting.
+ */
+void perfCountersStop(void);
+
+/**
+ * @brief Prints the counts since perfCountersOpen(): the host instructions
+ *        per cycle, and the host cycles, instructions, branch misses and
+ *        cache misses per emulated instruction (see
+ *        ts_coreMetrics.instructions).
+ */
+void perfCountersPrint(void);
+
+/**
+ * @brief Closes the counters. It does nothing if they are not open.
+ */
+void perfCountersClose(void);
+
+#endif // __INC_HOST_PERFCOUNTERS_H__
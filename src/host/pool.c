@@ -0,0 +1,208 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "host/pool.h"
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+struct ts_pool {
+    /**
+     * @brief This member contains the worker threads.
+     */
+    pthread_t *threads;
+    unsigned int threadCount;
+
+    /**
+     * @brief This member serializes the batches of different callers.
+     */
+    pthread_mutex_t batchMutex;
+
+    /**
+     * @brief These members contain the current batch. They are protected by
+     *        mutex.
+     */
+    pthread_mutex_t mutex;
+    pthread_cond_t workAvailable;
+    pthread_cond_t batchDone;
+    tf_poolTask task;
+    void *context;
+    size_t workCount;
+    size_t nextWork;
+    size_t pendingWorkCount;
+    bool stopping;
+};
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Runs work items of the current batch until there are none left. The
+ *        mutex of the pool must be locked, and it is locked on return.
+ *
+ * @param[in,out] p_pool The pool.
+ */
+static void poolRunWork(struct ts_pool *p_pool);
+
+/**
+ * @brief Waits for batches and runs their work items until the pool is
+ *        destroyed.
+ *
+ * @param[in,out] p_pool A pointer to the ts_pool structure.
+ *
+ * @returns NULL.
+ */
+static void *poolWorker(void *p_pool);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+struct ts_pool *poolCreate(unsigned int p_threadCount) {
+    struct ts_pool *l_pool = calloc(1U, sizeof(struct ts_pool));
+
+    if(l_pool == NULL) {
+        return NULL;
+    }
+
+    // The calling thread runs work items too.
+    unsigned int l_workerCount = (p_threadCount > 1U) ? p_threadCount - 1U : 0U;
+
+    l_pool->threads = calloc(l_workerCount + 1U, sizeof(pthread_t));
+
+    if(
+        (l_pool->threads == NULL)
+        || (pthread_mutex_init(&l_pool->batchMutex, NULL) != 0)
+        || (pthread_mutex_init(&l_pool->mutex, NULL) != 0)
+        || (pthread_cond_init(&l_pool->workAvailable, NULL) != 0)
+        || (pthread_cond_init(&l_pool->batchDone, NULL) != 0)
+    ) {
+        free(l_pool->threads);
+        free(l_pool);
+        return NULL;
+    }
+
+    while(
+        (l_pool->threadCount < l_workerCount)
+        && (
+            pthread_create(
+                &l_pool->threads[l_pool->threadCount],
+                NULL,
+                poolWorker,
+                l_pool
+            ) == 0
+        )
+    ) {
+        l_pool->threadCount++;
+    }
+
+    if(l_pool->threadCount < l_workerCount) {
+        poolDestroy(l_pool);
+        return NULL;
+    }
+
+    return l_pool;
+}
+
+void poolDestroy(struct ts_pool *p_pool) {
+    if(p_pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&p_pool->mutex);
+    p_pool->stopping = true;
+    pthread_cond_broadcast(&p_pool->workAvailable);
+    pthread_mutex_unlock(&p_pool->mutex);
+
+    for(unsigned int l_index = 0U; l_index < p_pool->threadCount; l_index++) {
+        pthread_join(p_pool->threads[l_index], NULL);
+    }
+
+    pthread_cond_destroy(&p_pool->batchDone);
+    pthread_cond_destroy(&p_pool->workAvailable);
+    pthread_mutex_destroy(&p_pool->mutex);
+    pthread_mutex_destroy(&p_pool->batchMutex);
+    free(p_pool->threads);
+    free(p_pool);
+}
+
+unsigned int poolGetThreadCount(const struct ts_pool *p_pool) {
+    return p_pool->threadCount + 1U;
+}
+
+void poolRun(
+    struct ts_pool *p_pool,
+    tf_poolTask p_task,
+    void *p_context,
+    size_t p_count
+) {
+    pthread_mutex_lock(&p_pool->batchMutex);
+    pthread_mutex_lock(&p_pool->mutex);
+
+    p_pool->task = p_task;
+    p_pool->context = p_context;
+    p_pool->workCount = p_count;
+    p_pool->nextWork = 0U;
+    p_pool->pendingWorkCount = p_count;
+
+    // A single work item is run by the calling thread alone.
+    if(p_count > 1U) {
+        pthread_cond_broadcast(&p_pool->workAvailable);
+    }
+
+    poolRunWork(p_pool);
+
+    while(p_pool->pendingWorkCount > 0U) {
+        pthread_cond_wait(&p_pool->batchDone, &p_pool->mutex);
+    }
+
+    pthread_mutex_unlock(&p_pool->mutex);
+    pthread_mutex_unlock(&p_pool->batchMutex);
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static void poolRunWork(struct ts_pool *p_pool) {
+    while(p_pool->nextWork < p_pool->workCount) {
+        size_t l_work = p_pool->nextWork;
+
+        p_pool->nextWork++;
+        pthread_mutex_unlock(&p_pool->mutex);
+
+        p_pool->task(p_pool->context, l_work);
+
+        pthread_mutex_lock(&p_pool->mutex);
+        p_pool->pendingWorkCount--;
+
+        if(p_pool->pendingWorkCount == 0U) {
+            pthread_cond_signal(&p_pool->batchDone);
+        }
+    }
+}
+
+static void *poolWorker(void *p_pool) {
+    struct ts_pool *l_pool = (struct ts_pool *)p_pool;
+
+    pthread_mutex_lock(&l_pool->mutex);
+
+    while(true) {
+        while((!l_pool->stopping) && (l_pool->nextWork >= l_pool->workCount)) {
+            pthread_cond_wait(&l_pool->workAvailable, &l_pool->mutex);
+        }
+
+        if(l_pool->stopping) {
+            break;
+        }
+
+        poolRunWork(l_pool);
+    }
+
+    pthread_mutex_unlock(&l_pool->mutex);
+
+    return NULL;
+}
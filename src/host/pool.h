@@ -0,0 +1,74 @@
+#ifndef __INC_HOST_POOL_H__
+#define __INC_HOST_POOL_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stddef.h>
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This type describes a function that runs one work item of a batch.
+ *
+ * @param[in] p_context The context given to poolRun().
+ * @param[in] p_index The index of the work item.
+ */
+typedef void (*tf_poolTask)(void *p_context, size_t p_index);
+
+/**
+ * @brief This structure contains a pool of worker threads.
+ */
+struct ts_pool;
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Creates a pool and starts its threads. The threads wait for work
+ *        until the pool is destroyed, so that a batch does not pay for their
+ *        creation.
+ *
+ * @param[in] p_threadCount The number of threads that run a batch, including
+ *                          the thread that calls poolRun(). 0 or 1 creates no
+ *                          thread.
+ *
+ * @returns A pointer to the pool, or NULL if an error occurred.
+ */
+struct ts_pool *poolCreate(unsigned int p_threadCount);
+
+/**
+ * @brief Stops the threads of a pool and destroys it.
+ *
+ * @param[in] p_pool The pool to destroy, or NULL.
+ */
+void poolDestroy(struct ts_pool *p_pool);
+
+/**
+ * @brief Returns the number of threads that run a batch.
+ *
+ * @param[in] p_pool The pool.
+ *
+ * @returns The number of threads, including the calling thread.
+ */
+unsigned int poolGetThreadCount(const struct ts_pool *p_pool);
+
+/**
+ * @brief Runs a batch of work items on the threads of a pool and on the
+ *        calling thread, and returns when all of them are done. Batches from
+ *        different threads are run one after the other.
+ *
+ * @param[in] p_pool The pool.
+ * @param[in] p_task The function that runs a work item.
+ * @param[in] p_context The value passed to the function.
+ * @param[in] p_count The number of work items.
+ */
+void poolRun(
+    struct ts_pool *p_pool,
+    tf_poolTask p_task,
+    void *p_context,
+    size_t p_count
+);
+
+#endif // __INC_HOST_POOL_H__
@@ -0,0 +1,735 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <process.h>
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "common.h"
+#include "core/aot.h"
+#include "core/core.h"
+#include "core/cpu.h"
+#include "core/hash.h"
+#include "core/rom.h"
+#include "host/recompiler.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the maximum length of a file path.
+ */
+#define C_RECOMPILER_PATH_LENGTH 4096
+
+/**
+ * @brief This constant defines the number of interrupt vectors used as entry
+ *        points. Entries that are not valid code addresses are ignored.
+ */
+#define C_RECOMPILER_VECTOR_COUNT 40U
+
+/**
+ * @brief This constant defines the maximum number of instructions in a block.
+ *        Longer straight-line code is split, so that a block never runs for
+ *        too long.
+ */
+#define C_RECOMPILER_MAX_BLOCK_LENGTH 64U
+
+/**
+ * @brief This constant defines the maximum number of successors of a block.
+ */
+#define C_RECOMPILER_MAX_SUCCESSORS 2U
+
+/**
+ * @brief This constant defines the number of words in the FLASH ROM.
+ */
+#define C_RECOMPILER_WORD_COUNT (C_ROM_SIZE_BYTES / 2U)
+
+M_STATIC_ASSERT(
+    recompilerMaxBlockSize,
+    (C_RECOMPILER_MAX_BLOCK_LENGTH * C_CPU_MAX_INSTRUCTION_SIZE_BYTES)
+        <= C_AOT_MAX_BLOCK_SIZE_BYTES
+);
+
+#ifdef _WIN32
+#define C_RECOMPILER_SHARED_OBJECT_EXTENSION "dll"
+#else
+#define C_RECOMPILER_SHARED_OBJECT_EXTENSION "so"
+#endif
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+/**
+ * @brief This structure describes a decoded basic block.
+ */
+struct ts_recompilerBlock {
+    struct ts_cpuInstruction instructions[C_RECOMPILER_MAX_BLOCK_LENGTH];
+    size_t instructionCount;
+
+    /**
+     * @brief This member contains the addresses where execution can continue
+     *        after the block, when they are known statically.
+     */
+    uint32_t successors[C_RECOMPILER_MAX_SUCCESSORS];
+    size_t successorCount;
+};
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This variable contains a copy of the FLASH ROM being recompiled.
+ */
+static uint8_t s_recompilerRom[C_ROM_SIZE_BYTES];
+
+/**
+ * @brief This variable contains the instance used to decode instructions.
+ *        Decoding executes instructions, so it is never the instance of the
+ *        caller.
+ */
+static struct ts_coreInstance *s_recompilerScratchInstance;
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Builds the path of the C or shared object file of the loaded FLASH
+ *        ROM. The file name contains the hash of the FLASH ROM and the hash of
+ *        the recompiler build (see recompilerGetBuildHash()), so that the
+ *        files made by another build of the emulator are never loaded.
+ *
+ * @param[out] p_buffer The buffer that receives the path.
+ * @param[in] p_directoryPath The path to the directory.
+ * @param[in] p_extension The extension of the file.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if the path is too long.
+ */
+static int recompilerGetPath(
+    char *p_buffer,
+    const char *p_directoryPath,
+    const char *p_extension
+);
+
+/**
+ * @brief Computes a hash of the recompiler build: the interface version, the
+ *        opcode table hash (see cpuGetOpcodeTableHash()) and the build time of
+ *        the recompiler.
+ *
+ * @returns The hash of the recompiler build.
+ */
+static uint64_t recompilerGetBuildHash(void);
+
+/**
+ * @brief Compiles the C file into a shared object. The compiler is the
+ *        program named by the CC environment variable, or cc. It is run
+ *        directly, without a shell.
+ *
+ * @param[in] p_sourcePath The path to the C file.
+ * @param[in] p_objectPath The path to the shared object file.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int recompilerCompile(
+    const char *p_sourcePath,
+    const char *p_objectPath
+);
+
+/**
+ * @brief Reads a big-endian word from the FLASH ROM copy.
+ *
+ * @param[in] p_address The address of the word.
+ *
+ * @returns The word, or 0xffff if the address is out of the FLASH ROM.
+ */
+static uint16_t recompilerRead16(uint32_t p_address);
+
+/**
+ * @brief Checks if an address can be the start of a block.
+ *
+ * @param[in] p_address The address to check.
+ *
+ * @returns A boolean value that indicates whether the address is valid.
+ */
+static bool recompilerIsCodeAddress(uint32_t p_address);
+
+/**
+ * @brief Decodes the basic block that starts at the given address, with the
+ *        scratch instance selected.
+ *
+ * @param[in] p_address The address of the block.
+ * @param[out] p_block The decoded block.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int recompilerDecodeBlock(
+    uint16_t p_address,
+    struct ts_recompilerBlock *p_block
+);
+
+/**
+ * @brief Computes the successors of a block that ends with a branch, a call,
+ *        a return or a trap.
+ *
+ * @param[in] p_address The address of the last instruction of the block.
+ * @param[in,out] p_block The block.
+ */
+static void recompilerAddBranchTargets(
+    uint32_t p_address,
+    struct ts_recompilerBlock *p_block
+);
+
+/**
+ * @brief Finds the basic blocks reachable from the interrupt vectors, with the
+ *        scratch instance selected.
+ *
+ * @param[out] p_isBlockStart For each word of the FLASH ROM, whether a block
+ *                            starts there.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int recompilerDiscover(bool *p_isBlockStart);
+
+/**
+ * @brief Writes the C code of the given blocks, with the scratch instance
+ *        selected.
+ *
+ * @param[in] p_filePath The path to the C file.
+ * @param[in] p_isBlockStart For each word of the FLASH ROM, whether a block
+ *                           starts there.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int recompilerWriteSource(
+    const char *p_filePath,
+    const bool *p_isBlockStart
+);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int recompilerBuild(const char *p_directoryPath) {
+    char l_sourcePath[C_RECOMPILER_PATH_LENGTH];
+    char l_objectPath[C_RECOMPILER_PATH_LENGTH];
+    bool *l_isBlockStart = calloc(C_RECOMPILER_WORD_COUNT, sizeof(bool));
+    struct ts_coreInstance *l_callerInstance = coreGetInstance();
+
+    s_recompilerScratchInstance = coreCreateInstance();
+
+    if((l_isBlockStart == NULL) || (s_recompilerScratchInstance == NULL)) {
+        fprintf(stderr, "Error: failed to allocate the recompiler data.\n");
+        free(l_isBlockStart);
+        coreDestroyInstance(s_recompilerScratchInstance);
+        return 1;
+    }
+
+    coreSelectInstance(s_recompilerScratchInstance);
+
+    int l_returnValue = coreSaveFile(
+        E_CORE_FILE_FLASH_ROM,
+        s_recompilerRom,
+        sizeof(s_recompilerRom)
+    );
+
+    if(l_returnValue != 0) {
+        fprintf(stderr, "Error: no FLASH ROM is loaded.\n");
+    } else if(
+        (recompilerGetPath(l_sourcePath, p_directoryPath, "c") != 0)
+        || (
+            recompilerGetPath(
+                l_objectPath,
+                p_directoryPath,
+                C_RECOMPILER_SHARED_OBJECT_EXTENSION
+            ) != 0
+        )
+    ) {
+        fprintf(stderr, "Error: the recompiler directory path is too long.\n");
+        l_returnValue = 1;
+    } else {
+        l_returnValue = recompilerDiscover(l_isBlockStart);
+    }
+
+    if(l_returnValue == 0) {
+        l_returnValue = recompilerWriteSource(l_sourcePath, l_isBlockStart);
+    }
+
+    coreDestroyInstance(s_recompilerScratchInstance);
+    s_recompilerScratchInstance = NULL;
+    coreSelectInstance(l_callerInstance);
+    free(l_isBlockStart);
+
+    if(l_returnValue != 0) {
+        return l_returnValue;
+    }
+
+    if(recompilerCompile(l_sourcePath, l_objectPath) != 0) {
+        fprintf(stderr, "Error: failed to compile \"%s\".\n", l_sourcePath);
+        return 1;
+    }
+
+    return 0;
+}
+
+int recompilerLoad(const char *p_directoryPath) {
+    char l_objectPath[C_RECOMPILER_PATH_LENGTH];
+    tf_aotGetImage l_getImage;
+
+    if(
+        recompilerGetPath(
+            l_objectPath,
+            p_directoryPath,
+            C_RECOMPILER_SHARED_OBJECT_EXTENSION
+        ) != 0
+    ) {
+        fprintf(stderr, "Error: the recompiler directory path is too long.\n");
+        return 1;
+    }
+
+    FILE *l_file = fopen(l_objectPath, "rb");
+
+    if(l_file == NULL) {
+        return 2;
+    }
+
+    fclose(l_file);
+
+    // The shared object is never unloaded: the core keeps pointers to it.
+#ifdef _WIN32
+    HMODULE l_module = LoadLibraryA(l_objectPath);
+    FARPROC l_symbol = NULL;
+
+    if(l_module != NULL) {
+        l_symbol = GetProcAddress(l_module, C_AOT_ENTRY_POINT_NAME);
+    }
+#else
+    void *l_module = dlopen(l_objectPath, RTLD_NOW | RTLD_LOCAL);
+    void *l_symbol = NULL;
+
+    if(l_module != NULL) {
+        l_symbol = dlsym(l_module, C_AOT_ENTRY_POINT_NAME);
+    }
+#endif
+
+    if(l_symbol == NULL) {
+        fprintf(stderr, "Error: failed to load \"%s\".\n", l_objectPath);
+        return 1;
+    }
+
+    // ISO C does not allow casting an object pointer to a function pointer.
+    memcpy(&l_getImage, &l_symbol, sizeof(l_getImage));
+
+    return aotInstall(l_getImage);
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static int recompilerGetPath(
+    char *p_buffer,
+    const char *p_directoryPath,
+    const char *p_extension
+) {
+    int l_length = snprintf(
+        p_buffer,
+        C_RECOMPILER_PATH_LENGTH,
+        "%s/%016llx-%016llx.%s",
+        p_directoryPath,
+        (unsigned long long)coreGetFileHash(E_CORE_FILE_FLASH_ROM),
+        (unsigned long long)recompilerGetBuildHash(),
+        p_extension
+    );
+
+    if((l_length < 0) || (l_length >= C_RECOMPILER_PATH_LENGTH)) {
+        return 1;
+    }
+
+    return 0;
+}
+
+static uint64_t recompilerGetBuildHash(void) {
+    static const char l_buildTime[] = __DATE__ " " __TIME__;
+    uint32_t l_interfaceVersion = C_AOT_INTERFACE_VERSION;
+    uint64_t l_opcodeTableHash = cpuGetOpcodeTableHash();
+    uint64_t l_hash = C_HASH_INITIAL_VALUE;
+
+    l_hash = hashUpdate(l_hash, &l_interfaceVersion, sizeof(uint32_t));
+    l_hash = hashUpdate(l_hash, &l_opcodeTableHash, sizeof(uint64_t));
+    l_hash = hashUpdate(l_hash, l_buildTime, sizeof(l_buildTime));
+
+    return l_hash;
+}
+
+static int recompilerCompile(
+    const char *p_sourcePath,
+    const char *p_objectPath
+) {
+    const char *l_compiler = getenv("CC");
+
+    if((l_compiler == NULL) || (l_compiler[0] == '\0')) {
+        l_compiler = "cc";
+    }
+
+    // The arguments are not modified by the compiler, but execvp() and
+    // _spawnvp() take an array of non-constant strings.
+    char *const l_arguments[] = {
+        (char *)l_compiler,
+        "-O2",
+        "-shared",
+        "-fPIC",
+        "-o",
+        (char *)p_objectPath,
+        (char *)p_sourcePath,
+        NULL
+    };
+
+#ifdef _WIN32
+    return (_spawnvp(_P_WAIT, l_compiler, l_arguments) == 0) ? 0 : 1;
+#else
+    pid_t l_pid = fork();
+
+    if(l_pid < 0) {
+        return 1;
+    } else if(l_pid == 0) {
+        execvp(l_compiler, l_arguments);
+        _exit(127);
+    }
+
+    int l_status;
+
+    while(waitpid(l_pid, &l_status, 0) < 0) {
+        if(errno != EINTR) {
+            return 1;
+        }
+    }
+
+    return (WIFEXITED(l_status) && (WEXITSTATUS(l_status) == 0)) ? 0 : 1;
+#endif
+}
+
+static uint16_t recompilerRead16(uint32_t p_address) {
+    if(p_address > (C_ROM_SIZE_BYTES - 2U)) {
+        return 0xffffU;
+    }
+
+    return (s_recompilerRom[p_address] << 8) | s_recompilerRom[p_address + 1];
+}
+
+static bool recompilerIsCodeAddress(uint32_t p_address) {
+    return (p_address < C_ROM_SIZE_BYTES) && ((p_address & 1U) == 0U);
+}
+
+static int recompilerDecodeBlock(
+    uint16_t p_address,
+    struct ts_recompilerBlock *p_block
+) {
+    uint32_t l_address = p_address;
+
+    p_block->instructionCount = 0U;
+    p_block->successorCount = 0U;
+
+    while(p_block->instructionCount < C_RECOMPILER_MAX_BLOCK_LENGTH) {
+        struct ts_cpuInstruction *l_instruction =
+            &p_block->instructions[p_block->instructionCount];
+
+        cpuDecodeInstruction(l_address, l_instruction);
+        p_block->instructionCount++;
+
+        // Measuring an instruction may have started a FLASH ROM operation on
+        // the scratch instance, which would make it read other contents.
+        if(romGetModifiedData() != NULL) {
+            coreDestroyInstance(s_recompilerScratchInstance);
+            s_recompilerScratchInstance = coreCreateInstance();
+
+            if(s_recompilerScratchInstance == NULL) {
+                fprintf(stderr, "Error: failed to create an instance.\n");
+                return 1;
+            }
+
+            coreSelectInstance(s_recompilerScratchInstance);
+        }
+
+        if(l_instruction->endsBlock) {
+            recompilerAddBranchTargets(l_address, p_block);
+            return 0;
+        }
+
+        l_address += l_instruction->size;
+
+        if(!recompilerIsCodeAddress(l_address)) {
+            return 0;
+        }
+    }
+
+    // The block was split: it continues with the next instruction.
+    p_block->successors[p_block->successorCount++] = l_address;
+
+    return 0;
+}
+
+static void recompilerAddBranchTargets(
+    uint32_t p_address,
+    struct ts_recompilerBlock *p_block
+) {
+    uint16_t l_opcode = recompilerRead16(p_address);
+    uint16_t l_extension = recompilerRead16(p_address + 2U);
+    uint32_t *l_successors = p_block->successors;
+    size_t l_count = 0U;
+
+    if((l_opcode & 0xf000U) == 0x4000U) { // Bcc d:8
+        l_successors[l_count++] = p_address + 2U + (int8_t)l_opcode;
+        l_successors[l_count++] = p_address + 2U;
+    } else if((l_opcode & 0xff0fU) == 0x5800U) { // Bcc d:16
+        l_successors[l_count++] = p_address + 4U + (int16_t)l_extension;
+        l_successors[l_count++] = p_address + 4U;
+    } else if((l_opcode & 0xff00U) == 0x5500U) { // BSR d:8
+        l_successors[l_count++] = p_address + 2U + (int8_t)l_opcode;
+        l_successors[l_count++] = p_address + 2U;
+    } else if(l_opcode == 0x5c00U) { // BSR d:16
+        l_successors[l_count++] = p_address + 4U + (int16_t)l_extension;
+        l_successors[l_count++] = p_address + 4U;
+    } else if((l_opcode & 0xfb00U) == 0x5a00U) { // JMP/JSR @aa:24
+        l_successors[l_count++] = ((l_opcode & 0x00ffU) << 16) | l_extension;
+
+        if((l_opcode & 0x0400U) != 0U) {
+            l_successors[l_count++] = p_address + 4U;
+        }
+    } else if((l_opcode & 0xfb00U) == 0x5b00U) { // JMP/JSR @@aa:8
+        l_successors[l_count++] = recompilerRead16(l_opcode & 0x00ffU);
+
+        if((l_opcode & 0x0400U) != 0U) {
+            l_successors[l_count++] = p_address + 2U;
+        }
+    } else if((l_opcode & 0xff00U) == 0x5d00U) { // JSR @ERn
+        l_successors[l_count++] = p_address + 2U;
+    } else if((l_opcode & 0xff00U) == 0x5700U) { // TRAPA #x
+        l_successors[l_count++] = 0x0010U + ((l_opcode & 0x0030U) >> 3);
+        l_successors[l_count++] = p_address + 2U;
+    } else if(l_opcode == 0x0180U) { // SLEEP
+        l_successors[l_count++] = p_address + 2U;
+    }
+
+    // JMP @ERn, RTS and RTE have no static successor, and undefined opcodes
+    // are most likely data.
+    p_block->successorCount = l_count;
+}
+
+static int recompilerDiscover(bool *p_isBlockStart) {
+    uint16_t *l_queue = malloc(C_RECOMPILER_WORD_COUNT * sizeof(uint16_t));
+    struct ts_recompilerBlock *l_block =
+        malloc(sizeof(struct ts_recompilerBlock));
+    size_t l_queueSize = 0U;
+    int l_returnValue = 0;
+
+    if((l_queue == NULL) || (l_block == NULL)) {
+        fprintf(stderr, "Error: failed to allocate the recompiler data.\n");
+        free(l_queue);
+        free(l_block);
+        return 1;
+    }
+
+    for(uint32_t l_index = 0U; l_index < C_RECOMPILER_VECTOR_COUNT; l_index++) {
+        uint16_t l_address = recompilerRead16(l_index * 2U);
+
+        if(
+            recompilerIsCodeAddress(l_address)
+            && !p_isBlockStart[l_address >> 1]
+        ) {
+            p_isBlockStart[l_address >> 1] = true;
+            l_queue[l_queueSize++] = l_address;
+        }
+    }
+
+    while((l_queueSize > 0U) && (l_returnValue == 0)) {
+        l_returnValue = recompilerDecodeBlock(l_queue[--l_queueSize], l_block);
+
+        for(size_t l_index = 0U; l_index < l_block->successorCount; l_index++) {
+            uint32_t l_address = l_block->successors[l_index];
+
+            if(
+                recompilerIsCodeAddress(l_address)
+                && !p_isBlockStart[l_address >> 1]
+            ) {
+                p_isBlockStart[l_address >> 1] = true;
+                l_queue[l_queueSize++] = l_address;
+            }
+        }
+    }
+
+    free(l_queue);
+    free(l_block);
+
+    return l_returnValue;
+}
+
+static int recompilerWriteSource(
+    const char *p_filePath,
+    const bool *p_isBlockStart
+) {
+    struct ts_recompilerBlock *l_block =
+        malloc(sizeof(struct ts_recompilerBlock));
+    uint16_t *l_blockSizes = calloc(C_RECOMPILER_WORD_COUNT, sizeof(uint16_t));
+    FILE *l_file = fopen(p_filePath, "w");
+    size_t l_blockCount = 0U;
+    int l_returnValue = 0;
+
+    if((l_block == NULL) || (l_blockSizes == NULL) || (l_file == NULL)) {
+        fprintf(stderr, "Error: failed to create \"%s\".\n", p_filePath);
+        free(l_block);
+        free(l_blockSizes);
+
+        if(l_file != NULL) {
+            fclose(l_file);
+        }
+
+        return 1;
+    }
+
+    // The generated file does not depend on the emulator headers, so it can
+    // be built anywhere. The types must match core/aot.h.
+    fprintf(
+        l_file,
+        "// Generated by emuwalker from the FLASH ROM %016llx.\n"
+        "#include <stdbool.h>\n"
+        "#include <stdint.h>\n\n"
+        "typedef bool (*tf_aotExecute)(uint16_t, uint16_t, uint8_t, "
+        "uint8_t);\n"
+        "typedef void (*tf_aotBlock)(void);\n\n"
+        "struct ts_aotBlock {\n"
+        "    uint16_t address;\n"
+        "    uint16_t size;\n"
+        "    tf_aotBlock function;\n"
+        "};\n\n"
+        "struct ts_aotImage {\n"
+        "    uint32_t interfaceVersion;\n"
+        "    uint64_t opcodeTableHash;\n"
+        "    uint64_t flashRomHash;\n"
+        "    uint32_t blockCount;\n"
+        "    const struct ts_aotBlock *blocks;\n"
+        "};\n\n"
+        "const struct ts_aotImage *%s(tf_aotExecute p_execute);\n\n"
+        "static tf_aotExecute s_execute;\n",
+        (unsigned long long)coreGetFileHash(E_CORE_FILE_FLASH_ROM),
+        C_AOT_ENTRY_POINT_NAME
+    );
+
+    for(uint32_t l_word = 0U; l_word < C_RECOMPILER_WORD_COUNT; l_word++) {
+        if(!p_isBlockStart[l_word]) {
+            continue;
+        }
+
+        l_returnValue = recompilerDecodeBlock(l_word * 2U, l_block);
+
+        if(l_returnValue != 0) {
+            break;
+        }
+
+        fprintf(l_file, "\nstatic void b%04x(void) {\n", l_word * 2U);
+
+        size_t l_count = l_block->instructionCount;
+        uint32_t l_size = 0U;
+
+        for(size_t l_index = 0U; l_index < l_count; l_index++) {
+            const struct ts_cpuInstruction *l_instruction =
+                &l_block->instructions[l_index];
+            bool l_last = l_index == (l_count - 1U);
+
+            // The size of an instruction that ends a block is not measured:
+            // the longest size is assumed.
+            if(l_instruction->endsBlock) {
+                l_size += C_CPU_MAX_INSTRUCTION_SIZE_BYTES;
+            } else {
+                l_size += l_instruction->size;
+            }
+
+            fprintf(
+                l_file,
+                "    %ss_execute(0x%04xU, 0x%04xU, %uU, %uU)%s\n",
+                l_last ? "" : "if(!",
+                l_instruction->opcode[0],
+                l_instruction->opcode[1],
+                l_instruction->decodeWordCount,
+                l_instruction->handlerIndex,
+                l_last ? ";" : ") {\n        return;\n    }"
+            );
+        }
+
+        if(l_size > (C_ROM_SIZE_BYTES - (l_word * 2U))) {
+            l_size = C_ROM_SIZE_BYTES - (l_word * 2U);
+        }
+
+        fprintf(l_file, "}\n");
+        l_blockSizes[l_word] = l_size;
+        l_blockCount++;
+    }
+
+    fprintf(l_file, "\nstatic const struct ts_aotBlock s_blocks[] = {\n");
+
+    for(uint32_t l_word = 0U; l_word < C_RECOMPILER_WORD_COUNT; l_word++) {
+        if(p_isBlockStart[l_word]) {
+            fprintf(
+                l_file,
+                "    {0x%04xU, %uU, b%04x},\n",
+                l_word * 2U,
+                l_blockSizes[l_word],
+                l_word * 2U
+            );
+        }
+    }
+
+    fprintf(
+        l_file,
+        "};\n\n"
+        "static const struct ts_aotImage s_image = {\n"
+        "    %uU,\n"
+        "    0x%016llxULL,\n"
+        "    0x%016llxULL,\n"
+        "    %zuU,\n"
+        "    s_blocks\n"
+        "};\n\n"
+        "const struct ts_aotImage *%s(tf_aotExecute p_execute) {\n"
+        "    s_execute = p_execute;\n\n"
+        "    return &s_image;\n"
+        "}\n",
+        C_AOT_INTERFACE_VERSION,
+        (unsigned long long)cpuGetOpcodeTableHash(),
+        (unsigned long long)coreGetFileHash(E_CORE_FILE_FLASH_ROM),
+        l_blockCount,
+        C_AOT_ENTRY_POINT_NAME
+    );
+
+    if(fclose(l_file) != 0) {
+        l_returnValue = 1;
+    }
+
+    free(l_block);
+    free(l_blockSizes);
+
+    if(l_returnValue != 0) {
+        fprintf(stderr, "Error: failed to write \"%s\".\n", p_filePath);
+    }
+
+    return l_returnValue;
+}
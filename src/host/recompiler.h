@@ -0,0 +1,35 @@
+#ifndef __INC_HOST_RECOMPILER_H__
+#define __INC_HOST_RECOMPILER_H__
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Recompiles the loaded FLASH ROM to C and builds a shared object with
+ *        the host compiler (the CC environment variable, or "cc"). The code is
+ *        discovered from the interrupt vectors by following branches and
+ *        calls, and each basic block becomes a C function. Both files are
+ *        named after the FLASH ROM hash, in the given directory.
+ *
+ * @param[in] p_directoryPath The path to the output directory.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+int recompilerBuild(const char *p_directoryPath);
+
+/**
+ * @brief Loads the shared object built by recompilerBuild() for the loaded
+ *        FLASH ROM from the given directory, and installs it in the core.
+ *
+ * @param[in] p_directoryPath The path to the directory.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval 2 if the directory has no shared object for the loaded FLASH ROM.
+ * @retval Any other value if an error occurred.
+ */
+int recompilerLoad(const char *p_directoryPath);
+
+#endif // __INC_HOST_RECOMPILER_H__
@@ -0,0 +1,931 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "core/core.h"
+#include "host/recorder.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief These constants define the size of the recorded frames in pixels.
+ */
+#define C_RECORDER_WIDTH 96U
+#define C_RECORDER_HEIGHT 64U
+
+/**
+ * @brief This constant defines the number of bytes of a row of pixels. The
+ *        display has 4 shades, so each pixel is stored on 2 bits.
+ */
+#define C_RECORDER_ROW_SIZE_BYTES (C_RECORDER_WIDTH / 4U)
+
+/**
+ * @brief This constant defines the size of a frame in bytes.
+ */
+#define C_RECORDER_FRAME_SIZE_BYTES \
+    (C_RECORDER_ROW_SIZE_BYTES * C_RECORDER_HEIGHT)
+
+/**
+ * @brief This constant defines the size of the image data of a frame before
+ *        it is compressed: each row starts with its PNG filter type.
+ */
+#define C_RECORDER_IMAGE_SIZE_BYTES \
+    ((C_RECORDER_ROW_SIZE_BYTES + 1U) * C_RECORDER_HEIGHT)
+
+/**
+ * @brief This constant defines the size of the buffer of a compressed frame.
+ *        A fixed Huffman code takes at most 9 bits per byte of image data.
+ */
+#define C_RECORDER_COMPRESSED_SIZE_BYTES (C_RECORDER_IMAGE_SIZE_BYTES * 2U)
+
+/**
+ * @brief This constant defines the number of frames that the queue holds.
+ *        The emulation waits when the queue is full, so no frame is lost.
+ */
+#define C_RECORDER_QUEUE_LENGTH 64U
+
+/**
+ * @brief This constant defines the refresh rate of the display in Hz, which
+ *        is the unit of the frame durations.
+ */
+#define C_RECORDER_FRAME_RATE_HZ 60U
+
+/**
+ * @brief This constant defines the maximum duration of a frame in refresh
+ *        periods. A longer frame is written as several identical frames.
+ */
+#define C_RECORDER_MAX_DELAY 65535U
+
+/**
+ * @brief These constants define the number of entries of the hash table used
+ *        to find repeated sequences, as a power of two and as a number.
+ */
+#define C_RECORDER_HASH_BITS 12
+#define C_RECORDER_HASH_SIZE (1U << C_RECORDER_HASH_BITS)
+
+/**
+ * @brief These constants define the minimum and maximum lengths of a
+ *        repeated sequence in the compressed data.
+ */
+#define C_RECORDER_MIN_MATCH 3U
+#define C_RECORDER_MAX_MATCH 258U
+
+/**
+ * @brief These constants define the number of DEFLATE length codes, and the
+ *        number of distance codes needed within a frame.
+ */
+#define C_RECORDER_LENGTH_CODE_COUNT 29U
+#define C_RECORDER_DISTANCE_CODE_COUNT 24U
+
+/**
+ * @brief This constant defines the PNG filter type that subtracts the row
+ *        above, so that the rows that did not change compress well.
+ */
+#define C_RECORDER_PNG_FILTER_UP 2U
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+struct ts_recorderFrame {
+    /**
+     * @brief This member contains the cycle at which the frame was displayed.
+     */
+    uint64_t cycle;
+
+    /**
+     * @brief This member contains the shade of each pixel, 2 bits per pixel,
+     *        leftmost pixel in the most significant bits.
+     */
+    uint8_t pixels[C_RECORDER_FRAME_SIZE_BYTES];
+};
+
+struct ts_recorderBitStream {
+    uint8_t *buffer;
+    size_t size;
+    uint32_t bits;
+    unsigned int bitCount;
+};
+
+struct ts_recorder {
+    /**
+     * @brief This member indicates whether a recording is in progress.
+     */
+    bool running;
+
+    /**
+     * @brief This member contains the instance whose frames are recorded.
+     */
+    struct ts_coreInstance *instance;
+
+    /**
+     * @brief This member contains the video hash of the last recorded frame.
+     */
+    uint64_t lastVideoHash;
+    bool hasFrame;
+
+    /**
+     * @brief These members contain the queue between the emulation and the
+     *        encoder thread. They are protected by mutex.
+     */
+    pthread_mutex_t mutex;
+    pthread_cond_t notEmpty;
+    pthread_cond_t notFull;
+    struct ts_recorderFrame queue[C_RECORDER_QUEUE_LENGTH];
+    size_t queueHead;
+    size_t queueCount;
+    bool stopping;
+
+    /**
+     * @brief This member contains the cycle of the recorded instance when the
+     *        recording stopped, at which the last frame ends.
+     */
+    uint64_t stopCycle;
+
+    /**
+     * @brief These members are only used by the encoder thread.
+     */
+    pthread_t thread;
+    FILE *file;
+    long frameCountOffset;
+    uint32_t frameCount;
+    uint32_t sequenceNumber;
+    bool failed;
+    struct ts_recorderFrame pendingFrame;
+    bool hasPendingFrame;
+};
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This variable contains the recorder state. It is large, so it is not
+ *        allocated on the stack.
+ */
+static struct ts_recorder s_recorder;
+
+/**
+ * @brief This variable contains the CRC-32 of each byte value, as used by
+ *        the PNG chunks.
+ */
+static uint32_t s_recorderCrcTable[256];
+
+/**
+ * @brief These variables contain the base lengths and distances of the
+ *        DEFLATE length and distance codes, and their numbers of extra bits.
+ */
+static const uint16_t s_recorderLengthBases[C_RECORDER_LENGTH_CODE_COUNT] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const uint8_t s_recorderLengthExtraBits[C_RECORDER_LENGTH_CODE_COUNT] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+static const uint16_t
+    s_recorderDistanceBases[C_RECORDER_DISTANCE_CODE_COUNT] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073
+};
+
+static const uint8_t
+    s_recorderDistanceExtraBits[C_RECORDER_DISTANCE_CODE_COUNT] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10
+};
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Queues the frame displayed by the recorded instance if it changed.
+ *
+ * @param[in] p_event The event (always E_CORE_EVENT_VBLANK).
+ * @param[in] p_data Unused.
+ * @param[in] p_context Unused.
+ */
+static void recorderOnVBlank(
+    enum te_coreEvent p_event,
+    const void *p_data,
+    void *p_context
+);
+
+/**
+ * @brief Encodes the queued frames until the recording stops.
+ *
+ * @param[in] p_argument Unused.
+ *
+ * @returns NULL.
+ */
+static void *recorderRun(void *p_argument);
+
+/**
+ * @brief Writes the pending frame, which lasts until the given frame is
+ *        displayed, and replaces it with the given frame.
+ *
+ * @param[in] p_frame The next frame, or NULL at the end of the recording,
+ *                    in which case the pending frame lasts until stopCycle.
+ */
+static void recorderFlushFrame(const struct ts_recorderFrame *p_frame);
+
+/**
+ * @brief Writes the PNG signature and the chunks that precede the frames.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int recorderWriteHeader(void);
+
+/**
+ * @brief Writes the number of frames to the animation control chunk and the
+ *        final chunk.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int recorderWriteTrailer(void);
+
+/**
+ * @brief Writes a PNG chunk.
+ *
+ * @param[in] p_type The 4-character type of the chunk.
+ * @param[in] p_prefix Data written before p_data, or NULL.
+ * @param[in] p_prefixSize The size of p_prefix in bytes.
+ * @param[in] p_data The data of the chunk, or NULL.
+ * @param[in] p_dataSize The size of p_data in bytes.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int recorderWriteChunk(
+    const char *p_type,
+    const uint8_t *p_prefix,
+    size_t p_prefixSize,
+    const uint8_t *p_data,
+    size_t p_dataSize
+);
+
+/**
+ * @brief Continues the computation of a CRC-32.
+ *
+ * @param[in] p_crc The CRC of the previous data.
+ * @param[in] p_buffer The data.
+ * @param[in] p_size The size of the data in bytes.
+ *
+ * @returns The CRC of the previous data and the given data.
+ */
+static uint32_t recorderUpdateCrc(
+    uint32_t p_crc,
+    const uint8_t *p_buffer,
+    size_t p_size
+);
+
+/**
+ * @brief Compresses the pixels of a frame as a zlib stream, with filtered
+ *        rows and a fixed Huffman code.
+ *
+ * @param[in] p_pixels The pixels of the frame.
+ * @param[out] p_buffer The buffer that receives the stream, of
+ *                      C_RECORDER_COMPRESSED_SIZE_BYTES bytes.
+ *
+ * @returns The size of the stream in bytes.
+ */
+static size_t recorderCompress(const uint8_t *p_pixels, uint8_t *p_buffer);
+
+/**
+ * @brief Writes bits to a bit stream, least significant bit first.
+ *
+ * @param[in,out] p_stream The bit stream.
+ * @param[in] p_value The bits to write.
+ * @param[in] p_count The number of bits to write.
+ */
+static void recorderWriteBits(
+    struct ts_recorderBitStream *p_stream,
+    uint32_t p_value,
+    unsigned int p_count
+);
+
+/**
+ * @brief Writes a Huffman code to a bit stream, most significant bit first.
+ *
+ * @param[in,out] p_stream The bit stream.
+ * @param[in] p_code The code to write.
+ * @param[in] p_length The length of the code in bits.
+ */
+static void recorderWriteCode(
+    struct ts_recorderBitStream *p_stream,
+    uint32_t p_code,
+    unsigned int p_length
+);
+
+/**
+ * @brief Writes a literal/length symbol with the fixed Huffman code.
+ *
+ * @param[in,out] p_stream The bit stream.
+ * @param[in] p_symbol The symbol to write.
+ */
+static void recorderWriteSymbol(
+    struct ts_recorderBitStream *p_stream,
+    unsigned int p_symbol
+);
+
+/**
+ * @brief Writes a repeated sequence with the fixed Huffman code.
+ *
+ * @param[in,out] p_stream The bit stream.
+ * @param[in] p_length The length of the sequence.
+ * @param[in] p_distance The distance to the previous occurrence.
+ */
+static void recorderWriteMatch(
+    struct ts_recorderBitStream *p_stream,
+    unsigned int p_length,
+    unsigned int p_distance
+);
+
+/**
+ * @brief Writes a 16-bit big-endian value to a buffer.
+ *
+ * @param[out] p_buffer The buffer.
+ * @param[in] p_value The value to write.
+ */
+static inline void recorderPut16(uint8_t *p_buffer, uint16_t p_value);
+
+/**
+ * @brief Writes a 32-bit big-endian value to a buffer.
+ *
+ * @param[out] p_buffer The buffer.
+ * @param[in] p_value The value to write.
+ */
+static inline void recorderPut32(uint8_t *p_buffer, uint32_t p_value);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int recorderStart(const char *p_filePath) {
+    if(s_recorder.running) {
+        fprintf(stderr, "Error: a recording is already in progress.\n");
+        return 1;
+    }
+
+    for(uint32_t l_value = 0U; l_value < 256U; l_value++) {
+        uint32_t l_crc = l_value;
+
+        for(int l_bit = 0; l_bit < 8; l_bit++) {
+            l_crc = (l_crc & 1U) ? (0xedb88320U ^ (l_crc >> 1)) : (l_crc >> 1);
+        }
+
+        s_recorderCrcTable[l_value] = l_crc;
+    }
+
+    s_recorder.file = fopen(p_filePath, "wb");
+
+    if(s_recorder.file == NULL) {
+        fprintf(stderr, "Error: failed to open \"%s\".\n", p_filePath);
+        return 1;
+    }
+
+    s_recorder.instance = coreGetInstance();
+    s_recorder.hasFrame = false;
+    s_recorder.queueHead = 0U;
+    s_recorder.queueCount = 0U;
+    s_recorder.stopping = false;
+    s_recorder.frameCount = 0U;
+    s_recorder.sequenceNumber = 0U;
+    s_recorder.failed = false;
+    s_recorder.hasPendingFrame = false;
+
+    if(recorderWriteHeader() != 0) {
+        fprintf(stderr, "Error: failed to write \"%s\".\n", p_filePath);
+        fclose(s_recorder.file);
+        return 1;
+    }
+
+    if(
+        (pthread_mutex_init(&s_recorder.mutex, NULL) != 0)
+        || (pthread_cond_init(&s_recorder.notEmpty, NULL) != 0)
+        || (pthread_cond_init(&s_recorder.notFull, NULL) != 0)
+        || (pthread_create(&s_recorder.thread, NULL, recorderRun, NULL) != 0)
+    ) {
+        fprintf(stderr, "Error: failed to start the encoder thread.\n");
+        fclose(s_recorder.file);
+        return 1;
+    }
+
+    if(coreAddEventListener(E_CORE_EVENT_VBLANK, recorderOnVBlank, NULL) != 0) {
+        fprintf(stderr, "Error: failed to add the recorder listener.\n");
+        s_recorder.running = true;
+        recorderStop();
+        return 1;
+    }
+
+    s_recorder.running = true;
+
+    return 0;
+}
+
+void recorderStop(void) {
+    if(!s_recorder.running) {
+        return;
+    }
+
+    struct ts_coreInstance *l_callerInstance = coreGetInstance();
+
+    coreSelectInstance(s_recorder.instance);
+    coreRemoveEventListener(recorderOnVBlank, NULL);
+
+    uint64_t l_stopCycle = coreGetCycles();
+
+    coreSelectInstance(l_callerInstance);
+
+    pthread_mutex_lock(&s_recorder.mutex);
+    s_recorder.stopCycle = l_stopCycle;
+    s_recorder.stopping = true;
+    pthread_cond_signal(&s_recorder.notEmpty);
+    pthread_mutex_unlock(&s_recorder.mutex);
+
+    pthread_join(s_recorder.thread, NULL);
+    pthread_cond_destroy(&s_recorder.notFull);
+    pthread_cond_destroy(&s_recorder.notEmpty);
+    pthread_mutex_destroy(&s_recorder.mutex);
+
+    if(
+        (recorderWriteTrailer() != 0)
+        || (fclose(s_recorder.file) != 0)
+        || s_recorder.failed
+    ) {
+        fprintf(stderr, "Error: failed to write the recording.\n");
+    }
+
+    s_recorder.running = false;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static void recorderOnVBlank(
+    enum te_coreEvent p_event,
+    const void *p_data,
+    void *p_context
+) {
+    M_UNUSED_PARAMETER(p_event);
+    M_UNUSED_PARAMETER(p_data);
+    M_UNUSED_PARAMETER(p_context);
+
+    uint64_t l_videoHash = coreGetVideoHash();
+
+    if(s_recorder.hasFrame && (l_videoHash == s_recorder.lastVideoHash)) {
+        return;
+    }
+
+    s_recorder.lastVideoHash = l_videoHash;
+    s_recorder.hasFrame = true;
+
+    // The shades are packed before the queue is locked. The video buffer
+    // holds gray pixels, from white (shade 0) to black (shade 3).
+    struct ts_recorderFrame l_frame;
+    const uint8_t *l_pixels = (const uint8_t *)coreGetVideoBuffer();
+
+    l_frame.cycle = coreGetCycles();
+    memset(l_frame.pixels, 0, sizeof(l_frame.pixels));
+
+    for(
+        size_t l_index = 0U;
+        l_index < C_RECORDER_WIDTH * C_RECORDER_HEIGHT;
+        l_index++
+    ) {
+        uint8_t l_shade = 3U - l_pixels[l_index * 4U] / 0x55U;
+
+        l_frame.pixels[l_index / 4U] |= l_shade << (6U - 2U * (l_index % 4U));
+    }
+
+    pthread_mutex_lock(&s_recorder.mutex);
+
+    while(s_recorder.queueCount == C_RECORDER_QUEUE_LENGTH) {
+        pthread_cond_wait(&s_recorder.notFull, &s_recorder.mutex);
+    }
+
+    size_t l_tail = (s_recorder.queueHead + s_recorder.queueCount)
+        % C_RECORDER_QUEUE_LENGTH;
+
+    s_recorder.queue[l_tail] = l_frame;
+    s_recorder.queueCount++;
+    pthread_cond_signal(&s_recorder.notEmpty);
+    pthread_mutex_unlock(&s_recorder.mutex);
+}
+
+static void *recorderRun(void *p_argument) {
+    M_UNUSED_PARAMETER(p_argument);
+
+    struct ts_recorderFrame l_frame;
+
+    while(true) {
+        pthread_mutex_lock(&s_recorder.mutex);
+
+        while((s_recorder.queueCount == 0U) && !s_recorder.stopping) {
+            pthread_cond_wait(&s_recorder.notEmpty, &s_recorder.mutex);
+        }
+
+        if(s_recorder.queueCount == 0U) {
+            pthread_mutex_unlock(&s_recorder.mutex);
+            break;
+        }
+
+        l_frame = s_recorder.queue[s_recorder.queueHead];
+        s_recorder.queueHead =
+            (s_recorder.queueHead + 1U) % C_RECORDER_QUEUE_LENGTH;
+        s_recorder.queueCount--;
+        pthread_cond_signal(&s_recorder.notFull);
+        pthread_mutex_unlock(&s_recorder.mutex);
+
+        recorderFlushFrame(&l_frame);
+    }
+
+    recorderFlushFrame(NULL);
+
+    return NULL;
+}
+
+static void recorderFlushFrame(const struct ts_recorderFrame *p_frame) {
+    if(s_recorder.hasPendingFrame && !s_recorder.failed) {
+        // The pending frame lasts until the next one is displayed, or until
+        // the recording stopped, rounded to refresh periods. It lasts at
+        // least one period.
+        uint64_t l_endCycle =
+            (p_frame != NULL) ? p_frame->cycle : s_recorder.stopCycle;
+        uint64_t l_delay = 1U;
+
+        if(l_endCycle > s_recorder.pendingFrame.cycle) {
+            l_delay = ((l_endCycle - s_recorder.pendingFrame.cycle)
+                * C_RECORDER_FRAME_RATE_HZ + C_CORE_CLOCK_RATE_HZ / 2U)
+                / C_CORE_CLOCK_RATE_HZ;
+
+            if(l_delay == 0U) {
+                l_delay = 1U;
+            }
+        }
+
+        uint8_t l_data[C_RECORDER_COMPRESSED_SIZE_BYTES];
+        size_t l_dataSize = recorderCompress(
+            s_recorder.pendingFrame.pixels,
+            l_data
+        );
+
+        while((l_delay > 0U) && !s_recorder.failed) {
+            uint16_t l_frameDelay = (l_delay > C_RECORDER_MAX_DELAY)
+                ? C_RECORDER_MAX_DELAY
+                : (uint16_t)l_delay;
+            uint8_t l_control[26];
+            uint8_t l_sequence[4];
+
+            recorderPut32(&l_control[0], s_recorder.sequenceNumber++);
+            recorderPut32(&l_control[4], C_RECORDER_WIDTH);
+            recorderPut32(&l_control[8], C_RECORDER_HEIGHT);
+            recorderPut32(&l_control[12], 0U);
+            recorderPut32(&l_control[16], 0U);
+            recorderPut16(&l_control[20], l_frameDelay);
+            recorderPut16(&l_control[22], C_RECORDER_FRAME_RATE_HZ);
+            l_control[24] = 0U;
+            l_control[25] = 0U;
+
+            // The first frame is also the default image.
+            if(recorderWriteChunk("fcTL", NULL, 0U, l_control, 26U) != 0) {
+                s_recorder.failed = true;
+            } else if(s_recorder.frameCount == 0U) {
+                s_recorder.failed =
+                    recorderWriteChunk("IDAT", NULL, 0U, l_data, l_dataSize)
+                    != 0;
+            } else {
+                recorderPut32(l_sequence, s_recorder.sequenceNumber++);
+                s_recorder.failed = recorderWriteChunk(
+                    "fdAT",
+                    l_sequence,
+                    sizeof(l_sequence),
+                    l_data,
+                    l_dataSize
+                ) != 0;
+            }
+
+            s_recorder.frameCount++;
+            l_delay -= l_frameDelay;
+        }
+    }
+
+    if(p_frame != NULL) {
+        s_recorder.pendingFrame = *p_frame;
+        s_recorder.hasPendingFrame = true;
+    }
+}
+
+static int recorderWriteHeader(void) {
+    static const uint8_t l_signature[] = {
+        0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'
+    };
+
+    uint8_t l_header[13];
+    uint8_t l_palette[12];
+    uint8_t l_animationControl[8];
+
+    // 2-bit indexed pixels, with one gray palette entry per shade
+    recorderPut32(&l_header[0], C_RECORDER_WIDTH);
+    recorderPut32(&l_header[4], C_RECORDER_HEIGHT);
+    l_header[8] = 2U;
+    l_header[9] = 3U;
+    l_header[10] = 0U;
+    l_header[11] = 0U;
+    l_header[12] = 0U;
+
+    for(size_t l_shade = 0U; l_shade < 4U; l_shade++) {
+        memset(&l_palette[l_shade * 3U], 0xff - 0x55 * l_shade, 3U);
+    }
+
+    // The number of frames is written when the recording stops.
+    recorderPut32(&l_animationControl[0], 0U);
+    recorderPut32(&l_animationControl[4], 0U);
+
+    if(
+        (fwrite(l_signature, sizeof(l_signature), 1U, s_recorder.file) != 1U)
+        || (recorderWriteChunk("IHDR", NULL, 0U, l_header, 13U) != 0)
+        || (recorderWriteChunk("PLTE", NULL, 0U, l_palette, 12U) != 0)
+    ) {
+        return 1;
+    }
+
+    s_recorder.frameCountOffset = ftell(s_recorder.file);
+
+    return recorderWriteChunk("acTL", NULL, 0U, l_animationControl, 8U);
+}
+
+static int recorderWriteTrailer(void) {
+    uint8_t l_animationControl[8];
+
+    recorderPut32(&l_animationControl[0], s_recorder.frameCount);
+    recorderPut32(&l_animationControl[4], 0U);
+
+    if(
+        (recorderWriteChunk("IEND", NULL, 0U, NULL, 0U) != 0)
+        || (s_recorder.frameCountOffset < 0)
+        || (fseek(s_recorder.file, s_recorder.frameCountOffset, SEEK_SET) != 0)
+    ) {
+        return 1;
+    }
+
+    return recorderWriteChunk("acTL", NULL, 0U, l_animationControl, 8U);
+}
+
+static int recorderWriteChunk(
+    const char *p_type,
+    const uint8_t *p_prefix,
+    size_t p_prefixSize,
+    const uint8_t *p_data,
+    size_t p_dataSize
+) {
+    uint8_t l_length[4];
+    uint8_t l_crcBytes[4];
+    uint32_t l_crc = 0xffffffffU;
+
+    recorderPut32(l_length, p_prefixSize + p_dataSize);
+    l_crc = recorderUpdateCrc(l_crc, (const uint8_t *)p_type, 4U);
+    l_crc = recorderUpdateCrc(l_crc, p_prefix, p_prefixSize);
+    l_crc = recorderUpdateCrc(l_crc, p_data, p_dataSize);
+    recorderPut32(l_crcBytes, l_crc ^ 0xffffffffU);
+
+    if(
+        (fwrite(l_length, 4U, 1U, s_recorder.file) != 1U)
+        || (fwrite(p_type, 4U, 1U, s_recorder.file) != 1U)
+        || (
+            (p_prefixSize != 0U)
+            && (fwrite(p_prefix, p_prefixSize, 1U, s_recorder.file) != 1U)
+        )
+        || (
+            (p_dataSize != 0U)
+            && (fwrite(p_data, p_dataSize, 1U, s_recorder.file) != 1U)
+        )
+        || (fwrite(l_crcBytes, 4U, 1U, s_recorder.file) != 1U)
+    ) {
+        return 1;
+    }
+
+    return 0;
+}
+
+static uint32_t recorderUpdateCrc(
+    uint32_t p_crc,
+    const uint8_t *p_buffer,
+    size_t p_size
+) {
+    for(size_t l_index = 0U; l_index < p_size; l_index++) {
+        p_crc = s_recorderCrcTable[(p_crc ^ p_buffer[l_index]) & 0xffU]
+            ^ (p_crc >> 8);
+    }
+
+    return p_crc;
+}
+
+static size_t recorderCompress(const uint8_t *p_pixels, uint8_t *p_buffer) {
+    uint8_t l_image[C_RECORDER_IMAGE_SIZE_BYTES];
+    int16_t l_hashTable[C_RECORDER_HASH_SIZE];
+    size_t l_imageSize = 0U;
+
+    // Each row is stored as its difference with the row above.
+    for(size_t l_y = 0U; l_y < C_RECORDER_HEIGHT; l_y++) {
+        const uint8_t *l_row = &p_pixels[l_y * C_RECORDER_ROW_SIZE_BYTES];
+
+        l_image[l_imageSize++] = C_RECORDER_PNG_FILTER_UP;
+
+        for(size_t l_x = 0U; l_x < C_RECORDER_ROW_SIZE_BYTES; l_x++) {
+            uint8_t l_above = (l_y == 0U)
+                ? 0U
+                : l_row[l_x - C_RECORDER_ROW_SIZE_BYTES];
+
+            l_image[l_imageSize++] = l_row[l_x] - l_above;
+        }
+    }
+
+    // zlib header: DEFLATE with a 32 KiB window, fastest compression
+    struct ts_recorderBitStream l_stream = {
+        .buffer = p_buffer,
+        .size = 0U,
+        .bits = 0U,
+        .bitCount = 0U
+    };
+
+    p_buffer[l_stream.size++] = 0x78U;
+    p_buffer[l_stream.size++] = 0x01U;
+
+    // A single final block with the fixed Huffman code
+    recorderWriteBits(&l_stream, 1U, 1U);
+    recorderWriteBits(&l_stream, 1U, 2U);
+
+    for(size_t l_index = 0U; l_index < C_RECORDER_HASH_SIZE; l_index++) {
+        l_hashTable[l_index] = -1;
+    }
+
+    size_t l_position = 0U;
+
+    while(l_position < l_imageSize) {
+        size_t l_matchLength = 0U;
+        size_t l_matchPosition = 0U;
+
+        // Only the last occurrence of the next 3 bytes is tried.
+        if(l_position + C_RECORDER_MIN_MATCH <= l_imageSize) {
+            uint32_t l_hash = ((l_image[l_position] << 16)
+                ^ (l_image[l_position + 1U] << 8)
+                ^ l_image[l_position + 2U]) * 2654435761U;
+            size_t l_bucket = l_hash >> (32 - C_RECORDER_HASH_BITS);
+            int16_t l_candidate = l_hashTable[l_bucket];
+
+            l_hashTable[l_bucket] = (int16_t)l_position;
+
+            if(l_candidate >= 0) {
+                l_matchPosition = (size_t)l_candidate;
+
+                while(
+                    (l_matchLength < C_RECORDER_MAX_MATCH)
+                    && (l_position + l_matchLength < l_imageSize)
+                    && (
+                        l_image[l_matchPosition + l_matchLength]
+                        == l_image[l_position + l_matchLength]
+                    )
+                ) {
+                    l_matchLength++;
+                }
+            }
+        }
+
+        if(l_matchLength >= C_RECORDER_MIN_MATCH) {
+            recorderWriteMatch(
+                &l_stream,
+                l_matchLength,
+                l_position - l_matchPosition
+            );
+            l_position += l_matchLength;
+        } else {
+            recorderWriteSymbol(&l_stream, l_image[l_position]);
+            l_position++;
+        }
+    }
+
+    // End of block, then the Adler-32 of the image data
+    recorderWriteSymbol(&l_stream, 256U);
+
+    if(l_stream.bitCount != 0U) {
+        recorderWriteBits(&l_stream, 0U, 8U - l_stream.bitCount);
+    }
+
+    uint32_t l_sum1 = 1U;
+    uint32_t l_sum2 = 0U;
+
+    for(size_t l_index = 0U; l_index < l_imageSize; l_index++) {
+        l_sum1 = (l_sum1 + l_image[l_index]) % 65521U;
+        l_sum2 = (l_sum2 + l_sum1) % 65521U;
+    }
+
+    recorderPut32(&p_buffer[l_stream.size], (l_sum2 << 16) | l_sum1);
+
+    return l_stream.size + 4U;
+}
+
+static void recorderWriteBits(
+    struct ts_recorderBitStream *p_stream,
+    uint32_t p_value,
+    unsigned int p_count
+) {
+    p_stream->bits |= p_value << p_stream->bitCount;
+    p_stream->bitCount += p_count;
+
+    while(p_stream->bitCount >= 8U) {
+        p_stream->buffer[p_stream->size++] = p_stream->bits & 0xffU;
+        p_stream->bits >>= 8;
+        p_stream->bitCount -= 8U;
+    }
+}
+
+static void recorderWriteCode(
+    struct ts_recorderBitStream *p_stream,
+    uint32_t p_code,
+    unsigned int p_length
+) {
+    uint32_t l_reversed = 0U;
+
+    for(unsigned int l_bit = 0U; l_bit < p_length; l_bit++) {
+        l_reversed = (l_reversed << 1) | ((p_code >> l_bit) & 1U);
+    }
+
+    recorderWriteBits(p_stream, l_reversed, p_length);
+}
+
+static void recorderWriteSymbol(
+    struct ts_recorderBitStream *p_stream,
+    unsigned int p_symbol
+) {
+    if(p_symbol < 144U) {
+        recorderWriteCode(p_stream, 0x30U + p_symbol, 8U);
+    } else if(p_symbol < 256U) {
+        recorderWriteCode(p_stream, 0x190U + p_symbol - 144U, 9U);
+    } else if(p_symbol < 280U) {
+        recorderWriteCode(p_stream, p_symbol - 256U, 7U);
+    } else {
+        recorderWriteCode(p_stream, 0xc0U + p_symbol - 280U, 8U);
+    }
+}
+
+static void recorderWriteMatch(
+    struct ts_recorderBitStream *p_stream,
+    unsigned int p_length,
+    unsigned int p_distance
+) {
+    unsigned int l_lengthCode = 0U;
+    unsigned int l_distanceCode = 0U;
+
+    while(
+        (l_lengthCode + 1U < C_RECORDER_LENGTH_CODE_COUNT)
+        && (s_recorderLengthBases[l_lengthCode + 1U] <= p_length)
+    ) {
+        l_lengthCode++;
+    }
+
+    while(
+        (l_distanceCode + 1U < C_RECORDER_DISTANCE_CODE_COUNT)
+        && (s_recorderDistanceBases[l_distanceCode + 1U] <= p_distance)
+    ) {
+        l_distanceCode++;
+    }
+
+    recorderWriteSymbol(p_stream, 257U + l_lengthCode);
+    recorderWriteBits(
+        p_stream,
+        p_length - s_recorderLengthBases[l_lengthCode],
+        s_recorderLengthExtraBits[l_lengthCode]
+    );
+    recorderWriteCode(p_stream, l_distanceCode, 5U);
+    recorderWriteBits(
+        p_stream,
+        p_distance - s_recorderDistanceBases[l_distanceCode],
+        s_recorderDistanceExtraBits[l_distanceCode]
+    );
+}
+
+static inline void recorderPut16(uint8_t *p_buffer, uint16_t p_value) {
+    p_buffer[0] = p_value >> 8;
+    p_buffer[1] = p_value;
+}
+
+static inline void recorderPut32(uint8_t *p_buffer, uint32_t p_value) {
+    p_buffer[0] = p_value >> 24;
+    p_buffer[1] = p_value >> 16;
+    p_buffer[2] = p_value >> 8;
+    p_buffer[3] = p_value;
+}
@@ -0,0 +1,28 @@
+#ifndef __INC_HOST_RECORDER_H__
+#define __INC_HOST_RECORDER_H__
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Starts recording the frames of the selected instance to the given
+ *        APNG file. A frame is recorded at each VBlank where the display
+ *        changed, and it lasts until the next change. The frames are queued
+ *        and encoded by a background thread.
+ *
+ * @param[in] p_filePath The path to the file to write.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the recording started.
+ * @retval Any other value if an error occurred.
+ */
+int recorderStart(const char *p_filePath);
+
+/**
+ * @brief Stops the recording, after the queued frames are encoded, and
+ *        closes the file. This function does nothing if no recording is in
+ *        progress.
+ */
+void recorderStop(void);
+
+#endif // __INC_HOST_RECORDER_H__
@@ -0,0 +1,369 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common.h"
+#include "core/core.h"
+#include "host/shmexport.h"
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+struct ts_shmExport {
+    /**
+     * @brief This member contains the instance that is exported.
+     */
+    struct ts_coreInstance *instance;
+
+    /**
+     * @brief This member contains the name of the shared memory object.
+     */
+    char *name;
+
+    /**
+     * @brief This member contains the mapping of the shared memory segment.
+     */
+    struct ts_shmExportSegment *segment;
+
+    /**
+     * @brief These members contain the counters, which are copied to the
+     *        segment at the next VBlank.
+     */
+    uint64_t frameCount;
+    uint64_t sleepCount;
+    uint64_t eepromWriteCount;
+
+    /**
+     * @brief This member contains the frame rendered before it is copied to
+     *        the segment.
+     */
+    uint32_t frame[C_SHMEXPORT_SCREEN_WIDTH * C_SHMEXPORT_SCREEN_HEIGHT];
+};
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Counts the events of the exported instance, and updates the segment
+ *        at each VBlank.
+ *
+ * @param[in] p_event The event.
+ * @param[in] p_data Unused.
+ * @param[in] p_context The export.
+ */
+static void shmExportOnEvent(
+    enum te_coreEvent p_event,
+    const void *p_data,
+    void *p_context
+);
+
+/**
+ * @brief Updates the segment with the current state of the instance.
+ *
+ * @param[in] p_export The export.
+ */
+static void shmExportUpdate(struct ts_shmExport *p_export);
+
+#ifndef _WIN32
+/**
+ * @brief Checks if a shared memory object is the segment of an export whose
+ *        process no longer exists, such as a process that was killed.
+ *
+ * @param[in] p_name The name of the shared memory object.
+ *
+ * @returns A boolean value that indicates whether the object can be removed.
+ */
+static bool shmExportIsStale(const char *p_name);
+#endif
+
+/**
+ * @brief Writes a 64-bit member of the segment with a relaxed atomic store,
+ *        so that a concurrent read is not a data race.
+ *
+ * @param[out] p_member The member to write.
+ * @param[in] p_value The value to write.
+ */
+#ifndef _WIN32
+static bool shmExportIsStale(const char *p_name) {
+    int l_fileDescriptor = shm_open(p_name, O_RDONLY, 0);
+    struct stat l_status;
+    void *l_mapping = MAP_FAILED;
+
+    if(l_fileDescriptor < 0) {
+        return false;
+    }
+
+    if(
+        (fstat(l_fileDescriptor, &l_status) == 0)
+        && (l_status.st_size == sizeof(struct ts_shmExportSegment))
+    ) {
+        l_mapping = mmap(
+            NULL,
+            sizeof(struct ts_shmExportSegment),
+            PROT_READ,
+            MAP_SHARED,
+            l_fileDescriptor,
+            0
+        );
+    }
+
+    close(l_fileDescriptor);
+
+    if(l_mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const struct ts_shmExportSegment *l_segment = l_mapping;
+    bool l_stale = false;
+
+    // A segment without the magic number may still be being created.
+    if(
+        (__atomic_load_n(&l_segment->magic, __ATOMIC_ACQUIRE)
+            == C_SHMEXPORT_MAGIC)
+        && (l_segment->version == C_SHMEXPORT_VERSION)
+        && (l_segment->ownerProcessId != 0U)
+    ) {
+        l_stale = (kill((pid_t)l_segment->ownerProcessId, 0) != 0)
+            && (errno == ESRCH);
+    }
+
+    munmap(l_mapping, sizeof(struct ts_shmExportSegment));
+
+    return l_stale;
+}
+#endif
+
+static inline void shmExportStore64(uint64_t *p_member, uint64_t p_value);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+struct ts_shmExport *shmExportCreate(const char *p_name) {
+#ifdef _WIN32
+    M_UNUSED_PARAMETER(p_name);
+
+    fprintf(stderr, "Error: shared memory export is not supported.\n");
+
+    return NULL;
+#else
+    struct ts_shmExport *l_export = calloc(1U, sizeof(struct ts_shmExport));
+
+    if(l_export == NULL) {
+        return NULL;
+    }
+
+    l_export->instance = coreGetInstance();
+    l_export->name = strdup(p_name);
+
+    if(l_export->name == NULL) {
+        free(l_export);
+        return NULL;
+    }
+
+    // An existing object is only replaced if its export is gone, as it may
+    // belong to another export or to another program.
+    int l_fileDescriptor =
+        shm_open(p_name, O_RDWR | O_CREAT | O_EXCL, 0644);
+
+    if(
+        (l_fileDescriptor < 0)
+        && (errno == EEXIST)
+        && shmExportIsStale(p_name)
+    ) {
+        shm_unlink(p_name);
+        l_fileDescriptor = shm_open(p_name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    }
+
+    if(l_fileDescriptor < 0) {
+        fprintf(
+            stderr,
+            (errno == EEXIST)
+                ? "Error: shared memory \"%s\" already exists.\n"
+                : "Error: failed to create shared memory \"%s\".\n",
+            p_name
+        );
+        free(l_export->name);
+        free(l_export);
+        return NULL;
+    }
+
+    // The mapping remains valid after closing the file.
+    void *l_mapping = MAP_FAILED;
+
+    if(
+        ftruncate(l_fileDescriptor, sizeof(struct ts_shmExportSegment)) == 0
+    ) {
+        l_mapping = mmap(
+            NULL,
+            sizeof(struct ts_shmExportSegment),
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED,
+            l_fileDescriptor,
+            0
+        );
+    }
+
+    close(l_fileDescriptor);
+
+    if(l_mapping == MAP_FAILED) {
+        fprintf(
+            stderr,
+            "Error: failed to map shared memory \"%s\".\n",
+            p_name
+        );
+        shm_unlink(p_name);
+        free(l_export->name);
+        free(l_export);
+        return NULL;
+    }
+
+    // The new segment is filled with zeros.
+    l_export->segment = l_mapping;
+    l_export->segment->width = C_SHMEXPORT_SCREEN_WIDTH;
+    l_export->segment->height = C_SHMEXPORT_SCREEN_HEIGHT;
+    l_export->segment->version = C_SHMEXPORT_VERSION;
+    l_export->segment->ownerProcessId = (uint32_t)getpid();
+    shmExportUpdate(l_export);
+
+    // The magic number is written last, so that readers only find a
+    // complete segment.
+    __atomic_store_n(
+        &l_export->segment->magic,
+        C_SHMEXPORT_MAGIC,
+        __ATOMIC_RELEASE
+    );
+
+    if(
+        coreAddEventListener(
+            E_CORE_EVENT_VBLANK
+                | E_CORE_EVENT_SLEEP
+                | E_CORE_EVENT_EEPROM_WRITE,
+            shmExportOnEvent,
+            l_export
+        ) != 0
+    ) {
+        fprintf(stderr, "Error: failed to add the export listener.\n");
+        shmExportDestroy(l_export);
+        return NULL;
+    }
+
+    return l_export;
+#endif
+}
+
+void shmExportDestroy(struct ts_shmExport *p_export) {
+    if(p_export == NULL) {
+        return;
+    }
+
+#ifndef _WIN32
+    struct ts_coreInstance *l_callerInstance = coreGetInstance();
+
+    coreSelectInstance(p_export->instance);
+    coreRemoveEventListener(shmExportOnEvent, p_export);
+    coreSelectInstance(l_callerInstance);
+
+    munmap(p_export->segment, sizeof(struct ts_shmExportSegment));
+    shm_unlink(p_export->name);
+#endif
+
+    free(p_export->name);
+    free(p_export);
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static void shmExportOnEvent(
+    enum te_coreEvent p_event,
+    const void *p_data,
+    void *p_context
+) {
+    M_UNUSED_PARAMETER(p_data);
+
+    struct ts_shmExport *l_export = p_context;
+
+    switch(p_event) {
+        case E_CORE_EVENT_VBLANK:
+            l_export->frameCount++;
+            shmExportUpdate(l_export);
+            break;
+
+        case E_CORE_EVENT_SLEEP:
+            l_export->sleepCount++;
+            break;
+
+        case E_CORE_EVENT_EEPROM_WRITE:
+            l_export->eepromWriteCount++;
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void shmExportUpdate(struct ts_shmExport *p_export) {
+    struct ts_shmExportSegment *l_segment = p_export->segment;
+    uint32_t l_sequence = l_segment->sequence;
+    uint64_t l_videoHash = coreGetVideoHash();
+
+    // Mark the segment as being updated before any member changes.
+    __atomic_store_n(&l_segment->sequence, l_sequence + 1U, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    // The members are written with relaxed atomic stores, as the readers
+    // may copy them at the same time.
+    shmExportStore64(&l_segment->cycles, coreGetCycles());
+    shmExportStore64(&l_segment->stateHash, coreGetStateHash());
+    shmExportStore64(&l_segment->frameCount, p_export->frameCount);
+    shmExportStore64(&l_segment->sleepCount, p_export->sleepCount);
+    shmExportStore64(
+        &l_segment->eepromWriteCount,
+        p_export->eepromWriteCount
+    );
+
+    // The frame is only rendered again when it changed.
+    if(
+        (l_videoHash != l_segment->videoHash)
+        || (p_export->frameCount == 0U)
+    ) {
+        shmExportStore64(&l_segment->videoHash, l_videoHash);
+        coreRenderVideo(
+            p_export->frame,
+            C_SHMEXPORT_SCREEN_WIDTH * sizeof(uint32_t)
+        );
+
+        for(
+            size_t l_index = 0U;
+            l_index < C_SHMEXPORT_SCREEN_WIDTH * C_SHMEXPORT_SCREEN_HEIGHT;
+            l_index++
+        ) {
+            __atomic_store_n(
+                &l_segment->frame[l_index],
+                p_export->frame[l_index],
+                __ATOMIC_RELAXED
+            );
+        }
+    }
+
+    __atomic_store_n(&l_segment->sequence, l_sequence + 2U, __ATOMIC_RELEASE);
+}
+
+static inline void shmExportStore64(uint64_t *p_member, uint64_t p_value) {
+    __atomic_store_n(p_member, p_value, __ATOMIC_RELAXED);
+}
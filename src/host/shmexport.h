@@ -0,0 +1,114 @@
+#ifndef __INC_HOST_SHMEXPORT_H__
+#define __INC_HOST_SHMEXPORT_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdint.h>
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the magic number at the beginning of a shared
+ *        memory segment ("EWSM").
+ */
+#define C_SHMEXPORT_MAGIC 0x4d535745U
+
+/**
+ * @brief This constant defines the version of the segment layout. It is
+ *        incremented when struct ts_shmExportSegment changes.
+ */
+#define C_SHMEXPORT_VERSION 2U
+
+/**
+ * @brief These constants define the size of the exported frame in pixels.
+ */
+#define C_SHMEXPORT_SCREEN_WIDTH 96U
+#define C_SHMEXPORT_SCREEN_HEIGHT 64U
+
+// =============================================================================
+// Public type declarations
+// =============================================================================
+/**
+ * @brief This structure describes the contents of the shared memory segment.
+ *        It is updated at every VBlank of the exported instance, and it is
+ *        protected by a sequence lock so that readers never block the
+ *        emulation:
+ *        1. Read sequence (with acquire semantics). Retry if it is odd, as
+ *           an update is in progress.
+ *        2. Copy the members needed, with relaxed atomic loads.
+ *        3. Issue an acquire fence and read sequence again. Retry if it
+ *           changed, as the copy may be inconsistent.
+ */
+struct ts_shmExportSegment {
+    uint32_t magic;
+    uint32_t version;
+
+    /**
+     * @brief This member contains the sequence number of the segment. It is
+     *        odd while the segment is updated.
+     */
+    uint32_t sequence;
+
+    uint32_t width;
+    uint32_t height;
+
+    /**
+     * @brief This member contains the process ID of the exporting process, so
+     *        that the segment of a process that was killed can be taken over.
+     */
+    uint32_t ownerProcessId;
+
+    /**
+     * @brief These members contain the number of cycles since the last
+     *        reset, the state hash and the hash of the displayed frame.
+     */
+    uint64_t cycles;
+    uint64_t stateHash;
+    uint64_t videoHash;
+
+    /**
+     * @brief These members contain the number of frames, SLEEP instructions
+     *        and changed EEPROM bytes since the export started.
+     */
+    uint64_t frameCount;
+    uint64_t sleepCount;
+    uint64_t eepromWriteCount;
+
+    /**
+     * @brief This member contains the displayed frame, as R, G, B, A bytes.
+     */
+    uint32_t frame[C_SHMEXPORT_SCREEN_WIDTH * C_SHMEXPORT_SCREEN_HEIGHT];
+};
+
+/**
+ * @brief This structure contains an export of an instance.
+ */
+struct ts_shmExport;
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Creates a POSIX shared memory segment and exports the selected
+ *        instance to it until shmExportDestroy() is called. The creation
+ *        fails if the shared memory object already exists, unless it is the
+ *        segment of an export whose process no longer exists.
+ *
+ * @param[in] p_name The name of the shared memory object, such as
+ *                   "/emuwalker".
+ *
+ * @returns A pointer to the export, or NULL if an error occurred.
+ */
+struct ts_shmExport *shmExportCreate(const char *p_name);
+
+/**
+ * @brief Stops an export and removes its shared memory segment. Processes
+ *        that mapped the segment keep their mapping.
+ *
+ * @param[in] p_export The export to destroy, or NULL.
+ */
+void shmExportDestroy(struct ts_shmExport *p_export);
+
+#endif // __INC_HOST_SHMEXPORT_H__
@@ -0,0 +1,72 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core/core.h"
+#include "host/file.h"
+#include "host/statefile.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the maximum size of a state file.
+ */
+#define C_STATEFILE_MAX_SIZE_BYTES 1048576U
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int stateFileSave(const char *p_filePath) {
+    size_t l_stateSize = coreGetStateSize();
+    uint8_t *l_state = (uint8_t *)malloc(l_stateSize);
+
+    if(l_state == NULL) {
+        return 1;
+    }
+
+    if(coreSaveState(l_state, l_stateSize) != 0) {
+        free(l_state);
+        return 1;
+    }
+
+    FILE *l_file = fopen(p_filePath, "wb");
+
+    if(l_file == NULL) {
+        free(l_state);
+        return 1;
+    }
+
+    int l_returnValue = 0;
+
+    if(fwrite(l_state, 1, l_stateSize, l_file) != l_stateSize) {
+        l_returnValue = 1;
+    }
+
+    if(fclose(l_file) != 0) {
+        l_returnValue = 1;
+    }
+
+    free(l_state);
+
+    return l_returnValue;
+}
+
+int stateFileLoad(const char *p_filePath) {
+    void *l_state;
+    size_t l_stateSize = C_STATEFILE_MAX_SIZE_BYTES;
+
+    if(fileRead(p_filePath, &l_state, &l_stateSize) != 0) {
+        return 1;
+    }
+
+    int l_returnValue = coreLoadState((const uint8_t *)l_state, l_stateSize);
+
+    free(l_state);
+
+    return l_returnValue;
+}
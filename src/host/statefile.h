@@ -0,0 +1,29 @@
+#ifndef __INC_HOST_STATEFILE_H__
+#define __INC_HOST_STATEFILE_H__
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Saves the state of the core to the given file.
+ *
+ * @param[in] p_filePath The path to the file to write.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+int stateFileSave(const char *p_filePath);
+
+/**
+ * @brief Loads the state of the core from the given file.
+ *
+ * @param[in] p_filePath The path to the file to read.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+int stateFileLoad(const char *p_filePath);
+
+#endif // __INC_HOST_STATEFILE_H__
@@ -0,0 +1,910 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <errno.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "controlserver.h"
+#include "core/core.h"
+#include "host/file.h"
+#include "host/statefile.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the maximum length of a request line.
+ */
+#define C_CONTROLSERVER_LINE_LENGTH 4096
+
+/**
+ * @brief This constant defines the maximum number of connected clients.
+ */
+#define C_CONTROLSERVER_MAX_CLIENTS 16U
+
+/**
+ * @brief This constant defines the maximum number of instances.
+ */
+#define C_CONTROLSERVER_MAX_INSTANCES 1024U
+
+/**
+ * @brief This constant defines the size of the response buffer. The
+ *        responses are sent when the requests of a read are processed, or
+ *        earlier if the buffer is full.
+ */
+#define C_CONTROLSERVER_RESPONSE_SIZE 65536U
+
+/**
+ * @brief This constant defines the maximum number of bytes read from the
+ *        memory of each instance by a request.
+ */
+#define C_CONTROLSERVER_MAX_READ_LENGTH 256U
+
+/**
+ * @brief This constant defines the maximum number of words of a request.
+ */
+#define C_CONTROLSERVER_MAX_WORDS 5U
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+enum te_controlServerCommand {
+    E_CONTROLSERVER_COMMAND_DELETE,
+    E_CONTROLSERVER_COMMAND_RESET,
+    E_CONTROLSERVER_COMMAND_LOAD,
+    E_CONTROLSERVER_COMMAND_SAVE,
+    E_CONTROLSERVER_COMMAND_RUN,
+    E_CONTROLSERVER_COMMAND_FRAME,
+    E_CONTROLSERVER_COMMAND_STEP,
+    E_CONTROLSERVER_COMMAND_INPUT,
+    E_CONTROLSERVER_COMMAND_READ,
+    E_CONTROLSERVER_COMMAND_HASH,
+    E_CONTROLSERVER_COMMAND_COUNT
+};
+
+struct ts_controlServerClient {
+    int fileDescriptor;
+    char line[C_CONTROLSERVER_LINE_LENGTH];
+    size_t lineLength;
+};
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This variable contains the name of each command, and the number of
+ *        words that follow the selector (minimum and maximum).
+ */
+static const struct {
+    const char *name;
+    size_t minArgumentCount;
+    size_t maxArgumentCount;
+} s_controlServerCommands[E_CONTROLSERVER_COMMAND_COUNT] = {
+    [E_CONTROLSERVER_COMMAND_DELETE] = {"delete", 0U, 0U},
+    [E_CONTROLSERVER_COMMAND_RESET] = {"reset", 0U, 0U},
+    [E_CONTROLSERVER_COMMAND_LOAD] = {"load", 1U, 1U},
+    [E_CONTROLSERVER_COMMAND_SAVE] = {"save", 1U, 1U},
+    [E_CONTROLSERVER_COMMAND_RUN] = {"run", 1U, 1U},
+    [E_CONTROLSERVER_COMMAND_FRAME] = {"frame", 0U, 1U},
+    [E_CONTROLSERVER_COMMAND_STEP] = {"step", 0U, 1U},
+    [E_CONTROLSERVER_COMMAND_INPUT] = {"input", 2U, 2U},
+    [E_CONTROLSERVER_COMMAND_READ] = {"read", 1U, 2U},
+    [E_CONTROLSERVER_COMMAND_HASH] = {"hash", 0U, 0U}
+};
+
+/**
+ * @brief This variable contains the instances, or NULL for the unused
+ *        numbers. Instance 0 is the instance that started the server.
+ */
+static struct ts_coreInstance
+    *s_controlServerInstances[C_CONTROLSERVER_MAX_INSTANCES];
+
+/**
+ * @brief These variables contain the state that new instances start from.
+ */
+static uint8_t *s_controlServerInitialState;
+static size_t s_controlServerInitialStateSize;
+
+/**
+ * @brief This variable contains the connected clients.
+ */
+static struct ts_controlServerClient
+    s_controlServerClients[C_CONTROLSERVER_MAX_CLIENTS];
+
+/**
+ * @brief This variable contains the number of connected clients.
+ */
+static size_t s_controlServerClientCount;
+
+/**
+ * @brief These variables contain the responses that are not sent yet, and
+ *        the socket of the client that they are sent to.
+ */
+static char s_controlServerResponse[C_CONTROLSERVER_RESPONSE_SIZE];
+static size_t s_controlServerResponseLength;
+static int s_controlServerResponseFileDescriptor;
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Reads the requests of a client and processes the complete lines.
+ *
+ * @param[in,out] p_client The client.
+ * @param[out] p_running A pointer to a variable that is set to false when
+ *                       the server must stop.
+ *
+ * @returns A boolean value that indicates whether the client is still
+ *          connected.
+ */
+static bool controlServerReadClient(
+    struct ts_controlServerClient *p_client,
+    bool *p_running
+);
+
+/**
+ * @brief Processes one request line and appends its response.
+ *
+ * @param[in,out] p_line The request line, without the line terminator. It is
+ *                       split into words in place.
+ *
+ * @returns A boolean value that indicates whether the server must keep
+ *          running.
+ */
+static bool controlServerProcessLine(char *p_line);
+
+/**
+ * @brief Creates instances in the initial state and appends their numbers to
+ *        the response.
+ *
+ * @param[in] p_count The number of instances to create.
+ */
+static void controlServerCreateInstances(size_t p_count);
+
+/**
+ * @brief Parses an instance selector, and checks that the instances that it
+ *        selects exist.
+ *
+ * @param[in] p_selector The selector.
+ * @param[out] p_first The number of the first selected instance.
+ * @param[out] p_last The number of the last selected instance.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the selector is valid.
+ * @retval Any other value if an error occurred. The error response is
+ *         appended.
+ */
+static int controlServerParseSelector(
+    const char *p_selector,
+    size_t *p_first,
+    size_t *p_last
+);
+
+/**
+ * @brief Parses an unsigned number argument, in decimal, hexadecimal ("0x")
+ *        or octal ("0").
+ *
+ * @param[in] p_word The argument.
+ * @param[out] p_value The value of the argument.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the argument is a valid number.
+ * @retval Any other value if an error occurred. The error response is
+ *         appended.
+ */
+static int controlServerParseNumber(
+    const char *p_word,
+    unsigned long long *p_value
+);
+
+/**
+ * @brief Appends formatted text to the response, sending the pending
+ *        responses first if the buffer is full.
+ *
+ * @param[in] p_format The printf-like format of the text.
+ */
+static void controlServerPrint(const char *p_format, ...)
+    __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Sends the pending responses.
+ */
+static void controlServerFlush(void);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int controlServerRun(const char *p_socketPath) {
+    struct sockaddr_un l_address;
+
+    if(strlen(p_socketPath) >= sizeof(l_address.sun_path)) {
+        fprintf(stderr, "Error: socket path is too long.\n");
+        return 1;
+    }
+
+    memset(&l_address, 0, sizeof(l_address));
+    l_address.sun_family = AF_UNIX;
+    strcpy(l_address.sun_path, p_socketPath);
+
+    s_controlServerInitialStateSize = coreGetStateSize();
+    s_controlServerInitialState = malloc(s_controlServerInitialStateSize);
+
+    if(
+        (s_controlServerInitialState == NULL)
+        || (
+            coreSaveState(
+                s_controlServerInitialState,
+                s_controlServerInitialStateSize
+            ) != 0
+        )
+    ) {
+        fprintf(stderr, "Error: failed to save the initial state.\n");
+        free(s_controlServerInitialState);
+        return 1;
+    }
+
+    // A socket left by a previous server is replaced, but any other file is
+    // kept.
+    struct stat l_status;
+
+    if(lstat(p_socketPath, &l_status) == 0) {
+        if(!S_ISSOCK(l_status.st_mode)) {
+            fprintf(
+                stderr,
+                "Error: cannot listen on \"%s\": address in use.\n",
+                p_socketPath
+            );
+            free(s_controlServerInitialState);
+            return 1;
+        }
+
+        unlink(p_socketPath);
+    }
+
+    int l_serverFileDescriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(
+        (l_serverFileDescriptor < 0)
+        || (
+            bind(
+                l_serverFileDescriptor,
+                (const struct sockaddr *)&l_address,
+                sizeof(l_address)
+            ) != 0
+        )
+        || (listen(l_serverFileDescriptor, C_CONTROLSERVER_MAX_CLIENTS) != 0)
+    ) {
+        fprintf(stderr, "Error: cannot listen on \"%s\".\n", p_socketPath);
+
+        if(l_serverFileDescriptor >= 0) {
+            close(l_serverFileDescriptor);
+        }
+
+        free(s_controlServerInitialState);
+        return 1;
+    }
+
+    memset(s_controlServerInstances, 0, sizeof(s_controlServerInstances));
+    s_controlServerInstances[0] = coreGetInstance();
+    s_controlServerClientCount = 0U;
+    s_controlServerResponseLength = 0U;
+
+    bool l_running = true;
+
+    while(l_running) {
+        struct pollfd l_pollFileDescriptors[C_CONTROLSERVER_MAX_CLIENTS + 1U];
+
+        for(
+            size_t l_index = 0U;
+            l_index < s_controlServerClientCount;
+            l_index++
+        ) {
+            l_pollFileDescriptors[l_index].fd =
+                s_controlServerClients[l_index].fileDescriptor;
+            l_pollFileDescriptors[l_index].events = POLLIN;
+            l_pollFileDescriptors[l_index].revents = 0;
+        }
+
+        // New clients are only accepted when there is room for them.
+        nfds_t l_pollCount = s_controlServerClientCount;
+
+        if(s_controlServerClientCount < C_CONTROLSERVER_MAX_CLIENTS) {
+            l_pollFileDescriptors[l_pollCount].fd = l_serverFileDescriptor;
+            l_pollFileDescriptors[l_pollCount].events = POLLIN;
+            l_pollFileDescriptors[l_pollCount].revents = 0;
+            l_pollCount++;
+        }
+
+        if(poll(l_pollFileDescriptors, l_pollCount, -1) < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+
+            break;
+        }
+
+        // Serve the clients from the last one, so that removing a client
+        // does not move the clients that are not served yet.
+        for(
+            size_t l_index = s_controlServerClientCount;
+            l_index > 0U;
+            l_index--
+        ) {
+            struct ts_controlServerClient *l_client =
+                &s_controlServerClients[l_index - 1U];
+
+            if(
+                !l_running
+                || (l_pollFileDescriptors[l_index - 1U].revents == 0)
+                || controlServerReadClient(l_client, &l_running)
+            ) {
+                continue;
+            }
+
+            close(l_client->fileDescriptor);
+            s_controlServerClientCount--;
+            *l_client = s_controlServerClients[s_controlServerClientCount];
+        }
+
+        if(
+            l_running
+            && (l_pollCount > s_controlServerClientCount)
+            && (l_pollFileDescriptors[l_pollCount - 1U].revents != 0)
+        ) {
+            int l_clientFileDescriptor =
+                accept(l_serverFileDescriptor, NULL, NULL);
+
+            if(l_clientFileDescriptor >= 0) {
+                struct ts_controlServerClient *l_client =
+                    &s_controlServerClients[s_controlServerClientCount++];
+
+                l_client->fileDescriptor = l_clientFileDescriptor;
+                l_client->lineLength = 0U;
+            }
+        }
+    }
+
+    for(size_t l_index = 0U; l_index < s_controlServerClientCount; l_index++) {
+        close(s_controlServerClients[l_index].fileDescriptor);
+    }
+
+    close(l_serverFileDescriptor);
+    unlink(p_socketPath);
+
+    coreSelectInstance(s_controlServerInstances[0]);
+
+    for(
+        size_t l_index = 1U;
+        l_index < C_CONTROLSERVER_MAX_INSTANCES;
+        l_index++
+    ) {
+        coreDestroyInstance(s_controlServerInstances[l_index]);
+    }
+
+    free(s_controlServerInitialState);
+
+    return 0;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static bool controlServerReadClient(
+    struct ts_controlServerClient *p_client,
+    bool *p_running
+) {
+    ssize_t l_readSize = read(
+        p_client->fileDescriptor,
+        &p_client->line[p_client->lineLength],
+        C_CONTROLSERVER_LINE_LENGTH - 1U - p_client->lineLength
+    );
+
+    if(l_readSize <= 0) {
+        // End of the connection
+        return false;
+    }
+
+    p_client->lineLength += l_readSize;
+    p_client->line[p_client->lineLength] = '\0';
+
+    // Process every complete line, then send all the responses at once
+    char *l_lineStart = p_client->line;
+    char *l_lineEnd;
+
+    s_controlServerResponseFileDescriptor = p_client->fileDescriptor;
+
+    while(*p_running && ((l_lineEnd = strchr(l_lineStart, '\n')) != NULL)) {
+        *l_lineEnd = '\0';
+        *p_running = controlServerProcessLine(l_lineStart);
+        l_lineStart = l_lineEnd + 1;
+    }
+
+    controlServerFlush();
+
+    p_client->lineLength -= l_lineStart - p_client->line;
+    memmove(p_client->line, l_lineStart, p_client->lineLength);
+
+    if(p_client->lineLength == C_CONTROLSERVER_LINE_LENGTH - 1U) {
+        fprintf(stderr, "Error: request line is too long.\n");
+        return false;
+    }
+
+    return true;
+}
+
+static bool controlServerProcessLine(char *p_line) {
+    char *l_words[C_CONTROLSERVER_MAX_WORDS];
+    size_t l_wordCount = 0U;
+    char *l_savePointer;
+
+    for(
+        char *l_word = strtok_r(p_line, " \t\r", &l_savePointer);
+        l_word != NULL;
+        l_word = strtok_r(NULL, " \t\r", &l_savePointer)
+    ) {
+        if(l_wordCount == C_CONTROLSERVER_MAX_WORDS) {
+            controlServerPrint("error too many arguments\n");
+            return true;
+        }
+
+        l_words[l_wordCount++] = l_word;
+    }
+
+    if(l_wordCount == 0U) {
+        controlServerPrint("error empty request\n");
+        return true;
+    } else if(strcmp(l_words[0], "quit") == 0) {
+        controlServerPrint("ok\n");
+        return false;
+    } else if(strcmp(l_words[0], "new") == 0) {
+        unsigned long long l_newCount = 1U;
+
+        if(
+            (l_wordCount <= 1U)
+            || (controlServerParseNumber(l_words[1], &l_newCount) == 0)
+        ) {
+            controlServerCreateInstances(
+                (l_newCount < C_CONTROLSERVER_MAX_INSTANCES)
+                    ? (size_t)l_newCount
+                    : C_CONTROLSERVER_MAX_INSTANCES
+            );
+        }
+
+        return true;
+    }
+
+    enum te_controlServerCommand l_command = 0;
+
+    while(
+        (l_command < E_CONTROLSERVER_COMMAND_COUNT)
+        && (strcmp(l_words[0], s_controlServerCommands[l_command].name) != 0)
+    ) {
+        l_command++;
+    }
+
+    if(l_command == E_CONTROLSERVER_COMMAND_COUNT) {
+        controlServerPrint("error unknown request \"%s\"\n", l_words[0]);
+        return true;
+    }
+
+    if(
+        (l_wordCount < 2U + s_controlServerCommands[l_command].minArgumentCount)
+        || (
+            l_wordCount
+            > 2U + s_controlServerCommands[l_command].maxArgumentCount
+        )
+    ) {
+        controlServerPrint("error invalid arguments\n");
+        return true;
+    }
+
+    size_t l_first;
+    size_t l_last;
+
+    if(controlServerParseSelector(l_words[1], &l_first, &l_last) != 0) {
+        return true;
+    }
+
+    // Check the arguments once for all the instances
+    unsigned long long l_count = 1U;
+    enum te_coreInput l_input = E_CORE_INPUT_LEFT;
+    enum te_coreInputState l_inputState = E_CORE_INPUT_PRESSED;
+    uint16_t l_address = 0U;
+    void *l_state = NULL;
+    size_t l_stateSize = s_controlServerInitialStateSize;
+
+    switch(l_command) {
+        case E_CONTROLSERVER_COMMAND_DELETE:
+            // Deleting all the instances keeps instance 0.
+            if(strcmp(l_words[1], "*") == 0) {
+                l_first = 1U;
+            } else if(l_first == 0U) {
+                controlServerPrint("error instance 0 cannot be deleted\n");
+                return true;
+            }
+
+            break;
+
+        case E_CONTROLSERVER_COMMAND_LOAD:
+            if(fileRead(l_words[2], &l_state, &l_stateSize) != 0) {
+                controlServerPrint("error cannot read \"%s\"\n", l_words[2]);
+                return true;
+            }
+
+            break;
+
+        case E_CONTROLSERVER_COMMAND_SAVE:
+            if(l_first != l_last) {
+                controlServerPrint("error select one instance\n");
+                return true;
+            }
+
+            break;
+
+        case E_CONTROLSERVER_COMMAND_INPUT:
+            if(strcmp(l_words[2], "left") == 0) {
+                l_input = E_CORE_INPUT_LEFT;
+            } else if(strcmp(l_words[2], "middle") == 0) {
+                l_input = E_CORE_INPUT_MIDDLE;
+            } else if(strcmp(l_words[2], "right") == 0) {
+                l_input = E_CORE_INPUT_RIGHT;
+            } else {
+                controlServerPrint("error unknown input \"%s\"\n", l_words[2]);
+                return true;
+            }
+
+            if(strcmp(l_words[3], "press") == 0) {
+                l_inputState = E_CORE_INPUT_PRESSED;
+            } else if(strcmp(l_words[3], "release") == 0) {
+                l_inputState = E_CORE_INPUT_RELEASED;
+            } else {
+                controlServerPrint("error unknown state \"%s\"\n", l_words[3]);
+                return true;
+            }
+
+            break;
+
+        case E_CONTROLSERVER_COMMAND_RUN:
+        case E_CONTROLSERVER_COMMAND_FRAME:
+        case E_CONTROLSERVER_COMMAND_STEP:
+            if(
+                (l_wordCount > 2U)
+                && (controlServerParseNumber(l_words[2], &l_count) != 0)
+            ) {
+                return true;
+            }
+
+            break;
+
+        case E_CONTROLSERVER_COMMAND_READ:
+            if(controlServerParseNumber(l_words[2], &l_count) != 0) {
+                return true;
+            } else if(l_count > 0xffffU) {
+                controlServerPrint(
+                    "error invalid address \"%s\"\n",
+                    l_words[2]
+                );
+                return true;
+            }
+
+            l_address = (uint16_t)l_count;
+            l_count = 1U;
+
+            if(
+                (l_wordCount > 3U)
+                && (controlServerParseNumber(l_words[3], &l_count) != 0)
+            ) {
+                return true;
+            } else if(l_count > C_CONTROLSERVER_MAX_READ_LENGTH) {
+                controlServerPrint("error length is too large\n");
+                return true;
+            }
+
+            break;
+
+        default:
+            break;
+    }
+
+    // The requests that return values cannot fail.
+    bool l_returnsValues = l_command >= E_CONTROLSERVER_COMMAND_RUN;
+    bool l_failed = false;
+
+    if(l_returnsValues) {
+        controlServerPrint("ok");
+    }
+
+    for(size_t l_index = l_first; l_index <= l_last; l_index++) {
+        struct ts_coreInstance *l_instance = s_controlServerInstances[l_index];
+
+        if(l_instance == NULL) {
+            continue;
+        }
+
+        coreSelectInstance(l_instance);
+
+        switch(l_command) {
+            case E_CONTROLSERVER_COMMAND_DELETE:
+                coreSelectInstance(s_controlServerInstances[0]);
+                coreDestroyInstance(l_instance);
+                s_controlServerInstances[l_index] = NULL;
+                break;
+
+            case E_CONTROLSERVER_COMMAND_RESET:
+                l_failed = coreReset() != 0;
+                break;
+
+            case E_CONTROLSERVER_COMMAND_LOAD:
+                l_failed = coreLoadState(l_state, l_stateSize) != 0;
+                break;
+
+            case E_CONTROLSERVER_COMMAND_SAVE:
+                l_failed = stateFileSave(l_words[2]) != 0;
+                break;
+
+            case E_CONTROLSERVER_COMMAND_RUN:
+                if(l_count != 0U) {
+                    coreRunUntil(l_count, 0U, NULL);
+                }
+
+                break;
+
+            case E_CONTROLSERVER_COMMAND_FRAME:
+                for(
+                    unsigned long long l_frame = 0U;
+                    l_frame < l_count;
+                    l_frame++
+                ) {
+                    coreFrameAdvance();
+                }
+
+                break;
+
+            case E_CONTROLSERVER_COMMAND_STEP:
+                for(
+                    unsigned long long l_step = 0U;
+                    l_step < l_count;
+                    l_step++
+                ) {
+                    coreStep();
+                }
+
+                break;
+
+            case E_CONTROLSERVER_COMMAND_INPUT:
+                coreSetInput(l_input, l_inputState);
+                break;
+
+            case E_CONTROLSERVER_COMMAND_READ:
+                controlServerPrint(" ");
+
+                for(size_t l_offset = 0U; l_offset < l_count; l_offset++) {
+                    controlServerPrint(
+                        "%02x",
+                        coreReadMemory((uint16_t)(l_address + l_offset))
+                    );
+                }
+
+                break;
+
+            case E_CONTROLSERVER_COMMAND_HASH:
+                controlServerPrint(
+                    " %016llx",
+                    (unsigned long long)coreGetStateHash()
+                );
+                break;
+
+            default:
+                break;
+        }
+
+        if(
+            (l_command >= E_CONTROLSERVER_COMMAND_RUN)
+            && (l_command <= E_CONTROLSERVER_COMMAND_STEP)
+        ) {
+            controlServerPrint(" %llu", (unsigned long long)coreGetCycles());
+        }
+
+        if(l_failed) {
+            controlServerPrint("error failed on instance %zu", l_index);
+            break;
+        }
+    }
+
+    coreSelectInstance(s_controlServerInstances[0]);
+    free(l_state);
+
+    if(!l_returnsValues && !l_failed) {
+        controlServerPrint("ok");
+    }
+
+    controlServerPrint("\n");
+
+    return true;
+}
+
+static void controlServerCreateInstances(size_t p_count) {
+    size_t l_ids[C_CONTROLSERVER_MAX_INSTANCES];
+    size_t l_createdCount = 0U;
+    int l_returnValue = 0;
+
+    for(
+        size_t l_index = 1U;
+        (l_index < C_CONTROLSERVER_MAX_INSTANCES)
+        && (l_createdCount < p_count);
+        l_index++
+    ) {
+        if(s_controlServerInstances[l_index] != NULL) {
+            continue;
+        }
+
+        struct ts_coreInstance *l_instance = coreCreateInstance();
+
+        if(l_instance == NULL) {
+            l_returnValue = 1;
+            break;
+        }
+
+        coreSelectInstance(l_instance);
+        l_returnValue = coreLoadState(
+            s_controlServerInitialState,
+            s_controlServerInitialStateSize
+        );
+        coreSelectInstance(s_controlServerInstances[0]);
+
+        if(l_returnValue != 0) {
+            coreDestroyInstance(l_instance);
+            break;
+        }
+
+        s_controlServerInstances[l_index] = l_instance;
+        l_ids[l_createdCount++] = l_index;
+    }
+
+    // All the instances are created, or none.
+    if((l_returnValue != 0) || (l_createdCount < p_count)) {
+        for(size_t l_index = 0U; l_index < l_createdCount; l_index++) {
+            coreDestroyInstance(s_controlServerInstances[l_ids[l_index]]);
+            s_controlServerInstances[l_ids[l_index]] = NULL;
+        }
+
+        controlServerPrint("error cannot create %zu instances\n", p_count);
+        return;
+    }
+
+    controlServerPrint("ok");
+
+    for(size_t l_index = 0U; l_index < l_createdCount; l_index++) {
+        controlServerPrint(" %zu", l_ids[l_index]);
+    }
+
+    controlServerPrint("\n");
+}
+
+static int controlServerParseSelector(
+    const char *p_selector,
+    size_t *p_first,
+    size_t *p_last
+) {
+    char *l_end;
+
+    if(strcmp(p_selector, "*") == 0) {
+        *p_first = 0U;
+        *p_last = C_CONTROLSERVER_MAX_INSTANCES - 1U;
+        return 0;
+    }
+
+    *p_first = strtoul(p_selector, &l_end, 0);
+    *p_last = *p_first;
+
+    if(*l_end == '-') {
+        *p_last = strtoul(l_end + 1, &l_end, 0);
+    }
+
+    if(
+        (l_end == p_selector)
+        || (*l_end != '\0')
+        || (*p_first > *p_last)
+        || (*p_last >= C_CONTROLSERVER_MAX_INSTANCES)
+    ) {
+        controlServerPrint("error invalid selector \"%s\"\n", p_selector);
+        return 1;
+    }
+
+    for(size_t l_index = *p_first; l_index <= *p_last; l_index++) {
+        if(s_controlServerInstances[l_index] == NULL) {
+            controlServerPrint("error no instance %zu\n", l_index);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int controlServerParseNumber(
+    const char *p_word,
+    unsigned long long *p_value
+) {
+    char *l_end;
+
+    errno = 0;
+    *p_value = strtoull(p_word, &l_end, 0);
+
+    // strtoull() accepts a sign, and negates the value.
+    if(
+        (l_end == p_word)
+        || (*l_end != '\0')
+        || (errno != 0)
+        || (*p_word == '-')
+        || (*p_word == '+')
+    ) {
+        controlServerPrint("error invalid number \"%s\"\n", p_word);
+        return 1;
+    }
+
+    return 0;
+}
+
+static void controlServerPrint(const char *p_format, ...) {
+    va_list l_arguments;
+    int l_length;
+
+    for(int l_try = 0; l_try < 2; l_try++) {
+        size_t l_room = C_CONTROLSERVER_RESPONSE_SIZE
+            - s_controlServerResponseLength;
+
+        va_start(l_arguments, p_format);
+        l_length = vsnprintf(
+            &s_controlServerResponse[s_controlServerResponseLength],
+            l_room,
+            p_format,
+            l_arguments
+        );
+        va_end(l_arguments);
+
+        if((l_length >= 0) && ((size_t)l_length < l_room)) {
+            s_controlServerResponseLength += l_length;
+            return;
+        }
+
+        controlServerFlush();
+    }
+}
+
+static void controlServerFlush(void) {
+    size_t l_sentLength = 0U;
+
+    // A client that went away is noticed when its socket is read again.
+    while(l_sentLength < s_controlServerResponseLength) {
+        ssize_t l_result = send(
+            s_controlServerResponseFileDescriptor,
+            &s_controlServerResponse[l_sentLength],
+            s_controlServerResponseLength - l_sentLength,
+            MSG_NOSIGNAL
+        );
+
+        if(l_result < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+
+            break;
+        }
+
+        l_sentLength += l_result;
+    }
+
+    s_controlServerResponseLength = 0U;
+}
@@ -0,0 +1,51 @@
+#ifndef __INC_CONTROLSERVER_H__
+#define __INC_CONTROLSERVER_H__
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Runs the control server. The core must be in the state that new
+ *        instances start from (usually right after the boot sequence); it
+ *        becomes instance 0.
+ * @details Requests are read line by line from the clients of a UNIX domain
+ *          socket, and each request gets one response line, in order. A
+ *          client can send many requests at once: their responses are sent
+ *          together once they are all processed.
+ *
+ *          Most requests take an instance selector, which is an instance
+ *          number, a range of instance numbers ("<first>-<last>") or "*" for
+ *          all the instances. The response is "ok", followed by one value per
+ *          selected instance for the requests that return values, or
+ *          "error <message>" if the request failed.
+ *          - "new [<count>]": creates instances in the initial state, and
+ *            returns their numbers.
+ *          - "delete <selector>": destroys instances. Instance 0 cannot be
+ *            destroyed, so "*" destroys all the other instances.
+ *          - "reset <selector>": resets instances.
+ *          - "load <selector> <state file>": loads a state file.
+ *          - "save <instance> <state file>": saves a state file.
+ *          - "run <selector> <cycles>": runs instances for a number of cycles,
+ *            and returns their cycle counters.
+ *          - "frame <selector> [<count>]": runs instances until the next
+ *            VBlank, count times, and returns their cycle counters.
+ *          - "step <selector> [<count>]": runs instances for a number of
+ *            instructions, and returns their cycle counters.
+ *          - "input <selector> <left|middle|right> <press|release>": sets the
+ *            state of an input key.
+ *          - "read <selector> <address> [<length>]": reads memory, and returns
+ *            the bytes in hexadecimal.
+ *          - "hash <selector>": returns the state hashes.
+ *          - "quit": stops the server.
+ *
+ * @param[in] p_socketPath The path to the socket to listen on. An existing
+ *                         socket at this path is replaced, but the server
+ *                         fails if any other file exists there.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the server stopped normally.
+ * @retval Any other value if an error occurred.
+ */
+int controlServerRun(const char *p_socketPath);
+
+#endif // __INC_CONTROLSERVER_H__
@@ -0,0 +1,1085 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "core/core.h"
+#include "controlserver.h"
+#include "core/lockstep.h"
+#include "forkserver.h"
+#include "frontend/frontend.h"
+#include "host/bootcache.h"
+#include "host/explore.h"
+#include "host/file.h"
+#include "host/metricsfile.h"
+#include "host/perfcounters.h"
+#include "host/recompiler.h"
+#include "host/recorder.h"
+#include "host/shmexport.h"
+#include "host/statefile.h"
+
+// =============================================================================
+// Private constants declaration
+// =============================================================================
+/**
+ * @brief This constant defines the size of the FLASH ROM.
+ */
+#define C_FLASH_ROM_SIZE_BYTES 49152
+
+/**
+ * @brief This constant defines the size of the EEPROM.
+ */
+#define C_EEPROM_SIZE_BYTES 65536
+
+/**
+ * @brief This constant defines the default maximum length of an explored
+ *        input sequence.
+ */
+#define C_EXPLORE_DEFAULT_DEPTH 8U
+
+/**
+ * @brief This constant defines the default number of cycles that an input key
+ *        is held for during the exploration (100 ms).
+ */
+#define C_EXPLORE_DEFAULT_BURST_CYCLES (C_CORE_CLOCK_RATE_HZ / 10U)
+
+// =============================================================================
+// Private variables declarations
+// =============================================================================
+/**
+ * @brief This variable stores a pointer to the FLASH ROM file path.
+ */
+static const char *s_flashRomFilePath;
+
+/**
+ * @brief This variable stores a pointer to the EEPROM file path.
+ */
+static const char *s_eepromFilePath;
+
+/**
+ * @brief This variable stores a pointer to the boot cache directory path, or
+ *        NULL if the boot cache is disabled.
+ */
+static const char *s_bootCacheDirectoryPath;
+
+/**
+ * @brief This variable stores a pointer to the recompiled code directory path,
+ *        or NULL if the FLASH ROM is only interpreted.
+ */
+static const char *s_aotDirectoryPath;
+
+/**
+ * @brief This variable stores a pointer to the name of the accuracy profile,
+ *        or NULL to use the default profile.
+ */
+static const char *s_accuracyName;
+
+/**
+ * @brief This variable stores the number of cycles of the boot sequence.
+ */
+static uint64_t s_bootCycles;
+
+/**
+ * @brief This variable stores the number of cycles to run, or 0 to run
+ *        forever.
+ */
+static uint64_t s_cycles;
+
+/**
+ * @brief This variable stores the number of cycles between two state hashes
+ *        printed on the standard output, or 0 to print no hash.
+ */
+static uint64_t s_hashInterval;
+
+/**
+ * @brief This variable stores a pointer to the path of the file to save the
+ *        state to when the execution ends, or NULL.
+ */
+static const char *s_stateOutputFilePath;
+
+/**
+ * @brief This variable stores a pointer to the path of the fork server pipe,
+ *        or NULL if the fork server is disabled.
+ */
+static const char *s_forkServerPipePath;
+
+/**
+ * @brief This variable stores a pointer to the path of the control server
+ *        socket, or NULL if the control server is disabled.
+ */
+static const char *s_controlSocketPath;
+
+/**
+ * @brief This variable stores a pointer to the name of the HLE routine to
+ *        disable, "all" to disable all of them, or NULL to keep them enabled.
+ */
+static const char *s_disabledHleRoutine;
+
+/**
+ * @brief This variable stores a pointer to the exploration goal, in the
+ *        "<address>=<value>" format, or NULL if the exploration is disabled.
+ */
+static const char *s_exploreGoal;
+
+/**
+ * @brief This variable stores the address of the byte that the exploration
+ *        waits for.
+ */
+static uint16_t s_exploreAddress;
+
+/**
+ * @brief This variable stores the value that the exploration waits for.
+ */
+static uint8_t s_exploreValue;
+
+/**
+ * @brief This variable stores the maximum length of an explored input
+ *        sequence.
+ */
+static unsigned int s_exploreDepth;
+
+/**
+ * @brief This variable stores the number of exploration worker threads.
+ */
+static unsigned int s_exploreThreadCount;
+
+/**
+ * @brief This variable stores the number of cycles that each explored action
+ *        lasts for.
+ */
+static uint64_t s_exploreBurstCycles;
+
+/**
+ * @brief This variable stores the number of instances to run in lockstep, or
+ *        0 to run the default instance alone.
+ */
+static unsigned int s_laneCount;
+
+/**
+ * @brief This variable stores the number of instances whose memory usage is
+ *        measured, or 0 if it is not measured.
+ */
+static unsigned int s_footprintInstanceCount;
+
+/**
+ * @brief This variable stores a pointer to the path of the APNG file to record
+ *        the frames to, or NULL if the frames are not recorded.
+ */
+static const char *s_recordFilePath;
+
+/**
+ * @brief This variable stores a pointer to the name of the shared memory
+ *        object to export the instance to, or NULL if it is not exported.
+ */
+static const char *s_shmName;
+
+/**
+ * @brief This variable stores a pointer to the path of the file to write the
+ *        metrics to, or NULL if the metrics are not written.
+ */
+static const char *s_metricsFilePath;
+
+/**
+ * @brief This variable stores the interval between two writes of the metrics
+ *        file, in milliseconds.
+ */
+static unsigned int s_metricsIntervalMs;
+
+/**
+ * @brief This variable indicates whether the host performance counters are
+ *        read around the run slices.
+ */
+static bool s_perf;
+
+// =============================================================================
+// Private functions declarations
+// =============================================================================
+/**
+ * @brief Parses the command-line parameters and checks that they are valid.
+ *
+ * @param[in] p_argc The number of command-line parameters.
+ * @param[in] p_argv The command line parameters.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int readCommandLineParameters(int p_argc, const char *p_argv[]);
+
+/**
+ * @brief Reads the FLASH ROM file and loads its contents into the core.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int loadFlashRom(void);
+
+/**
+ * @brief Reads the EEPROM file and loads its contents into the core.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int loadEeprom(void);
+
+/**
+ * @brief Loads the recompiled code of the FLASH ROM, after building it if the
+ *        recompiled code directory does not contain it yet.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int loadRecompiledCode(void);
+
+/**
+ * @brief Selects the accuracy profile given on the command line, if any.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int selectAccuracy(void);
+
+/**
+ * @brief Runs the core for the number of cycles given on the command line and
+ *        saves its state if requested.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int run(void);
+
+/**
+ * @brief Runs copies of the current state in lockstep for the number of cycles
+ *        given on the command line, and prints the lane utilization. The
+ *        lanes hold no input key, the left key, the middle key and the right
+ *        key in turn.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int runLockstep(void);
+
+/**
+ * @brief Creates copies of the current state, runs each of them for the
+ *        number of cycles given on the command line, and checks that the
+ *        growth of the resident memory of the process per instance is within
+ *        C_CORE_INSTANCE_MEMORY_BUDGET_BYTES.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the memory used by an instance is within the budget.
+ * @retval Any other value if it is not, or if an error occurred.
+ */
+static int measureFootprint(void);
+
+/**
+ * @brief Returns the resident memory of the process.
+ *
+ * @returns The resident memory in bytes.
+ * @retval 0 if it could not be read.
+ */
+static uint64_t getResidentMemory(void);
+
+/**
+ * @brief Disables the HLE routine given on the command line, if any.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int disableHleRoutine(void);
+
+/**
+ * @brief Explores the input sequences from the current state until the byte at
+ *        the goal address has the goal value, and prints the sequence found.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the exploration completed.
+ * @retval Any other value if an error occurred.
+ */
+static int explore(void);
+
+/**
+ * @brief Checks if the exploration goal is reached by the selected instance.
+ *
+ * @param[in] p_context Unused.
+ *
+ * @returns A boolean value that indicates whether the goal is reached.
+ */
+static bool exploreGoalReached(void *p_context);
+
+// =============================================================================
+// Public functions declarations
+// =============================================================================
+/**
+ * @brief Entry point of the application.
+ *
+ * @param[in] p_argc The number of command-line parameters.
+ * @param[in] p_argv The command line parameters.
+ *
+ * @returns An integer that indicates the result of the execution of the
+ *          application.
+ * @retval 0 if the execution was successful.
+ * @retval Any other value if an error occurred.
+ */
+int main(int p_argc, const char *p_argv[]);
+
+// =============================================================================
+// Public functions definitions
+// =============================================================================
+int main(int p_argc, const char *p_argv[]) {
+    int l_returnValue = EXIT_SUCCESS;
+    struct ts_shmExport *l_shmExport = NULL;
+
+    if(
+        (readCommandLineParameters(p_argc, p_argv) != 0)
+        || (corePreinit() != 0)
+        || (loadFlashRom() != 0)
+        || (loadEeprom() != 0)
+        || (coreInit() != 0)
+        || (selectAccuracy() != 0)
+        || (loadRecompiledCode() != 0)
+        || (disableHleRoutine() != 0)
+        || (frontendInit() != 0)
+    ) {
+        l_returnValue = EXIT_FAILURE;
+    }
+
+    // The metrics start before the boot sequence, so that they include it.
+    if((l_returnValue != EXIT_FAILURE) && (s_metricsFilePath != NULL)) {
+        if(metricsFileStart(s_metricsFilePath, s_metricsIntervalMs) != 0) {
+            l_returnValue = EXIT_FAILURE;
+        }
+    }
+
+    if(l_returnValue != EXIT_FAILURE) {
+        if(s_bootCacheDirectoryPath != NULL) {
+            if(bootCacheBoot(s_bootCacheDirectoryPath, s_bootCycles) != 0) {
+                l_returnValue = EXIT_FAILURE;
+            }
+        } else {
+            coreReset();
+        }
+    }
+
+    if((l_returnValue != EXIT_FAILURE) && (s_recordFilePath != NULL)) {
+        if(recorderStart(s_recordFilePath) != 0) {
+            l_returnValue = EXIT_FAILURE;
+        }
+    }
+
+    if((l_returnValue != EXIT_FAILURE) && (s_shmName != NULL)) {
+        l_shmExport = shmExportCreate(s_shmName);
+
+        if(l_shmExport == NULL) {
+            l_returnValue = EXIT_FAILURE;
+        }
+    }
+
+    // The counters are opened after the boot sequence, so that they only
+    // cover the run.
+    if((l_returnValue != EXIT_FAILURE) && s_perf) {
+        if(perfCountersOpen() != 0) {
+            l_returnValue = EXIT_FAILURE;
+        }
+    }
+
+    if(l_returnValue != EXIT_FAILURE) {
+        int l_result;
+
+        if(s_forkServerPipePath != NULL) {
+            l_result = forkServerRun(s_forkServerPipePath);
+        } else if(s_controlSocketPath != NULL) {
+            l_result = controlServerRun(s_controlSocketPath);
+        } else if(s_exploreGoal != NULL) {
+            l_result = explore();
+        } else if(s_laneCount != 0U) {
+            l_result = runLockstep();
+        } else if(s_footprintInstanceCount != 0U) {
+            l_result = measureFootprint();
+        } else {
+            l_result = run();
+        }
+
+        if(l_result != 0) {
+            l_returnValue = EXIT_FAILURE;
+        } else if(s_perf) {
+            perfCountersPrint();
+        }
+    }
+
+    perfCountersClose();
+    recorderStop();
+    shmExportDestroy(l_shmExport);
+    metricsFileStop();
+
+    return l_returnValue;
+}
+
+// =============================================================================
+// Private functions definitions
+// =============================================================================
+static int readCommandLineParameters(int p_argc, const char *p_argv[]) {
+    const char **l_pendingValue = NULL;
+    const char *l_pendingFlag = NULL;
+    const char *l_bootCycles = NULL;
+    const char *l_cycles = NULL;
+    const char *l_hashInterval = NULL;
+    const char *l_exploreDepth = NULL;
+    const char *l_exploreThreadCount = NULL;
+    const char *l_exploreBurstCycles = NULL;
+    const char *l_laneCount = NULL;
+    const char *l_footprintInstanceCount = NULL;
+    const char *l_metricsInterval = NULL;
+    int l_returnValue = 0;
+
+    s_flashRomFilePath = NULL;
+    s_eepromFilePath = NULL;
+    s_bootCacheDirectoryPath = NULL;
+    s_aotDirectoryPath = NULL;
+    s_accuracyName = NULL;
+    s_bootCycles = C_BOOTCACHE_DEFAULT_BOOT_CYCLES;
+    s_cycles = 0;
+    s_hashInterval = 0;
+    s_stateOutputFilePath = NULL;
+    s_forkServerPipePath = NULL;
+    s_controlSocketPath = NULL;
+    s_disabledHleRoutine = NULL;
+    s_exploreGoal = NULL;
+    s_exploreDepth = C_EXPLORE_DEFAULT_DEPTH;
+    s_exploreThreadCount = 1U;
+    s_exploreBurstCycles = C_EXPLORE_DEFAULT_BURST_CYCLES;
+    s_laneCount = 0U;
+    s_footprintInstanceCount = 0U;
+    s_recordFilePath = NULL;
+    s_shmName = NULL;
+    s_metricsFilePath = NULL;
+    s_metricsIntervalMs = C_METRICSFILE_DEFAULT_INTERVAL_MS;
+    s_perf = false;
+
+    for(int l_argIndex = 1; l_argIndex < p_argc; l_argIndex++) {
+        if(l_pendingValue != NULL) {
+            *l_pendingValue = p_argv[l_argIndex];
+            l_pendingValue = NULL;
+        } else if(strcmp(p_argv[l_argIndex], "--rom") == 0) {
+            l_pendingValue = &s_flashRomFilePath;
+        } else if(strcmp(p_argv[l_argIndex], "--eeprom") == 0) {
+            l_pendingValue = &s_eepromFilePath;
+        } else if(strcmp(p_argv[l_argIndex], "--boot-cache") == 0) {
+            l_pendingValue = &s_bootCacheDirectoryPath;
+        } else if(strcmp(p_argv[l_argIndex], "--aot") == 0) {
+            l_pendingValue = &s_aotDirectoryPath;
+        } else if(strcmp(p_argv[l_argIndex], "--accuracy") == 0) {
+            l_pendingValue = &s_accuracyName;
+        } else if(strcmp(p_argv[l_argIndex], "--boot-cycles") == 0) {
+            l_pendingValue = &l_bootCycles;
+        } else if(strcmp(p_argv[l_argIndex], "--cycles") == 0) {
+            l_pendingValue = &l_cycles;
+        } else if(strcmp(p_argv[l_argIndex], "--hash-interval") == 0) {
+            l_pendingValue = &l_hashInterval;
+        } else if(strcmp(p_argv[l_argIndex], "--state-out") == 0) {
+            l_pendingValue = &s_stateOutputFilePath;
+        } else if(strcmp(p_argv[l_argIndex], "--fork-server") == 0) {
+            l_pendingValue = &s_forkServerPipePath;
+        } else if(strcmp(p_argv[l_argIndex], "--control") == 0) {
+            l_pendingValue = &s_controlSocketPath;
+        } else if(strcmp(p_argv[l_argIndex], "--no-hle") == 0) {
+            l_pendingValue = &s_disabledHleRoutine;
+        } else if(strcmp(p_argv[l_argIndex], "--explore") == 0) {
+            l_pendingValue = &s_exploreGoal;
+        } else if(strcmp(p_argv[l_argIndex], "--explore-depth") == 0) {
+            l_pendingValue = &l_exploreDepth;
+        } else if(strcmp(p_argv[l_argIndex], "--explore-threads") == 0) {
+            l_pendingValue = &l_exploreThreadCount;
+        } else if(strcmp(p_argv[l_argIndex], "--explore-burst") == 0) {
+            l_pendingValue = &l_exploreBurstCycles;
+        } else if(strcmp(p_argv[l_argIndex], "--lanes") == 0) {
+            l_pendingValue = &l_laneCount;
+        } else if(strcmp(p_argv[l_argIndex], "--footprint") == 0) {
+            l_pendingValue = &l_footprintInstanceCount;
+        } else if(strcmp(p_argv[l_argIndex], "--record") == 0) {
+            l_pendingValue = &s_recordFilePath;
+        } else if(strcmp(p_argv[l_argIndex], "--shm") == 0) {
+            l_pendingValue = &s_shmName;
+        } else if(strcmp(p_argv[l_argIndex], "--metrics") == 0) {
+            l_pendingValue = &s_metricsFilePath;
+        } else if(strcmp(p_argv[l_argIndex], "--metrics-interval") == 0) {
+            l_pendingValue = &l_metricsInterval;
+        } else if(strcmp(p_argv[l_argIndex], "--perf") == 0) {
+            s_perf = true;
+        } else {
+            fprintf(
+                stderr,
+                "Error: unknown parameter \"%s\".\n",
+                p_argv[l_argIndex]
+            );
+
+            return 1;
+        }
+
+        if(l_pendingValue != NULL) {
+            l_pendingFlag = p_argv[l_argIndex];
+        }
+    }
+
+    if(l_bootCycles != NULL) {
+        s_bootCycles = strtoull(l_bootCycles, NULL, 0);
+    }
+
+    if(l_cycles != NULL) {
+        s_cycles = strtoull(l_cycles, NULL, 0);
+    }
+
+    if(l_hashInterval != NULL) {
+        s_hashInterval = strtoull(l_hashInterval, NULL, 0);
+    }
+
+    if(l_exploreDepth != NULL) {
+        s_exploreDepth = strtoul(l_exploreDepth, NULL, 0);
+    }
+
+    if(l_exploreThreadCount != NULL) {
+        s_exploreThreadCount = strtoul(l_exploreThreadCount, NULL, 0);
+    }
+
+    if(l_exploreBurstCycles != NULL) {
+        s_exploreBurstCycles = strtoull(l_exploreBurstCycles, NULL, 0);
+    }
+
+    if(l_laneCount != NULL) {
+        s_laneCount = strtoul(l_laneCount, NULL, 0);
+    }
+
+    if(l_footprintInstanceCount != NULL) {
+        s_footprintInstanceCount =
+            strtoul(l_footprintInstanceCount, NULL, 0);
+    }
+
+    if(l_metricsInterval != NULL) {
+        s_metricsIntervalMs = strtoul(l_metricsInterval, NULL, 0);
+    }
+
+    if(s_exploreGoal != NULL) {
+        char *l_end;
+
+        s_exploreAddress = strtoul(s_exploreGoal, &l_end, 0);
+
+        if(*l_end != '=') {
+            fprintf(stderr, "Error: expected <address>=<value> goal.\n");
+            return 1;
+        }
+
+        s_exploreValue = strtoul(l_end + 1, NULL, 0);
+    }
+
+    if(l_pendingValue != NULL) {
+        l_returnValue = 1;
+        fprintf(stderr, "Error: expected value after \"%s\".\n", l_pendingFlag);
+    } else if(s_flashRomFilePath == NULL) {
+        l_returnValue = 1;
+        fprintf(stderr, "Error: ROM file not specified.\n");
+    } else if(s_eepromFilePath == NULL) {
+        l_returnValue = 1;
+        fprintf(stderr, "Error: EEPROM file not specified.\n");
+    } else if(
+        ((s_aotDirectoryPath != NULL) || (s_disabledHleRoutine != NULL))
+        && ((s_accuracyName == NULL) || (strcmp(s_accuracyName, "fast") != 0))
+    ) {
+        // The recompiled code and the native routines are only run by the
+        // fast profile.
+        l_returnValue = 1;
+        fprintf(stderr, "Error: --aot and --no-hle require --accuracy fast.\n");
+    } else if((s_laneCount != 0U) && (s_cycles == 0U)) {
+        l_returnValue = 1;
+        fprintf(stderr, "Error: --lanes requires --cycles.\n");
+    } else if(
+        ((s_recordFilePath != NULL) || (s_shmName != NULL))
+        && (
+            (s_forkServerPipePath != NULL)
+            || (s_exploreGoal != NULL)
+            || (s_laneCount != 0U)
+            || (s_footprintInstanceCount != 0U)
+        )
+    ) {
+        // Only the default instance is recorded, and it only runs alone.
+        l_returnValue = 1;
+        fprintf(
+            stderr,
+            "Error: --record and --shm cannot be used with --fork-server, "
+            "--explore, --lanes or --footprint.\n"
+        );
+    } else if(
+        s_perf
+        && (
+            (s_forkServerPipePath != NULL)
+            || (s_controlSocketPath != NULL)
+            || (s_exploreGoal != NULL)
+        )
+    ) {
+        // The counters only follow the main thread, and these modes run the
+        // core in other processes or threads, or between requests.
+        l_returnValue = 1;
+        fprintf(
+            stderr,
+            "Error: --perf cannot be used with --fork-server, --control or "
+            "--explore.\n"
+        );
+    }
+
+    return l_returnValue;
+}
+
+static int loadFlashRom(void) {
+    const void *l_buffer;
+
+    // The mapping is never unmapped: the core keeps a pointer to it.
+    if(fileMap(s_flashRomFilePath, &l_buffer, C_FLASH_ROM_SIZE_BYTES) != 0) {
+        fprintf(stderr, "Error: failed to load the FLASH ROM file.\n");
+        return 1;
+    }
+
+    return coreLoadFile(
+        E_CORE_FILE_FLASH_ROM,
+        (const uint8_t *)l_buffer,
+        C_FLASH_ROM_SIZE_BYTES
+    );
+}
+
+static int loadEeprom(void) {
+    void *l_buffer;
+    size_t l_bufferSize = C_EEPROM_SIZE_BYTES;
+
+    if(fileRead(s_eepromFilePath, &l_buffer, &l_bufferSize) != 0) {
+        fprintf(stderr, "Error: failed to load the EEPROM file.\n");
+        return 1;
+    }
+
+    int l_returnValue =
+        coreLoadFile(E_CORE_FILE_EEPROM, (uint8_t *)l_buffer, l_bufferSize);
+
+    if(l_returnValue != 0) {
+        free(l_buffer);
+    }
+
+    return l_returnValue;
+}
+
+static int run(void) {
+    uint64_t l_endCycle = coreGetCycles() + s_cycles;
+    uint64_t l_nextHashCycle = coreGetCycles() + s_hashInterval;
+
+    while((s_cycles == 0) || (coreGetCycles() < l_endCycle)) {
+        // The core runs in slices that end on the next hash or at the end of
+        // the run. A budget of 0 runs forever.
+        uint64_t l_stopCycle = l_endCycle;
+
+        if(
+            (s_hashInterval != 0)
+            && ((s_cycles == 0) || (l_nextHashCycle < l_endCycle))
+        ) {
+            l_stopCycle = l_nextHashCycle;
+        }
+
+        if(s_perf) {
+            perfCountersStart();
+        }
+
+        if((s_cycles == 0) && (s_hashInterval == 0)) {
+            coreRunUntil(0U, 0U, NULL);
+        } else if(l_stopCycle > coreGetCycles()) {
+            coreRunUntil(l_stopCycle - coreGetCycles(), 0U, NULL);
+        } else {
+            coreStep();
+        }
+
+        if(s_perf) {
+            perfCountersStop();
+        }
+
+        // Printing the hash at a fixed interval lets two builds be compared
+        // to find where their executions diverge.
+        if((s_hashInterval != 0) && (coreGetCycles() >= l_nextHashCycle)) {
+            printf(
+                "%llu %016llx\n",
+                (unsigned long long)coreGetCycles(),
+                (unsigned long long)coreGetStateHash()
+            );
+
+            l_nextHashCycle += s_hashInterval;
+        }
+    }
+
+    if(s_stateOutputFilePath != NULL) {
+        if(stateFileSave(s_stateOutputFilePath) != 0) {
+            fprintf(
+                stderr,
+                "Error: failed to save the state to \"%s\".\n",
+                s_stateOutputFilePath
+            );
+
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int runLockstep(void) {
+    size_t l_stateSize = coreGetStateSize();
+    uint8_t *l_state = (uint8_t *)malloc(l_stateSize);
+    struct ts_coreInstance **l_instances =
+        calloc(s_laneCount, sizeof(struct ts_coreInstance *));
+    struct ts_coreInstance *l_callerInstance = coreGetInstance();
+    int l_returnValue = 0;
+
+    if(
+        (l_state == NULL)
+        || (l_instances == NULL)
+        || (coreSaveState(l_state, l_stateSize) != 0)
+    ) {
+        fprintf(stderr, "Error: failed to allocate the lanes.\n");
+        l_returnValue = 1;
+    }
+
+    for(
+        unsigned int l_index = 0U;
+        (l_returnValue == 0) && (l_index < s_laneCount);
+        l_index++
+    ) {
+        l_instances[l_index] = coreCreateInstance();
+
+        if(l_instances[l_index] == NULL) {
+            l_returnValue = 1;
+            break;
+        }
+
+        coreSelectInstance(l_instances[l_index]);
+        l_returnValue = coreLoadState(l_state, l_stateSize);
+
+        if((l_index % 4U) != 0U) {
+            coreSetInput(
+                (enum te_coreInput)(l_index % 4U - 1U),
+                E_CORE_INPUT_PRESSED
+            );
+        }
+    }
+
+    coreSelectInstance(l_callerInstance);
+
+    if(l_returnValue == 0) {
+        struct ts_lockstepStatistics l_statistics;
+
+        if(s_perf) {
+            perfCountersStart();
+        }
+
+        l_returnValue = lockstepRun(
+            l_instances,
+            s_laneCount,
+            s_cycles,
+            &l_statistics
+        );
+
+        if(s_perf) {
+            perfCountersStop();
+        }
+
+        if((l_returnValue == 0) && (l_statistics.laneStepCount != 0U)) {
+            printf(
+                "rounds %llu lane steps %llu decoded %llu "
+                "utilization %.1f%%\n",
+                (unsigned long long)l_statistics.roundCount,
+                (unsigned long long)l_statistics.laneStepCount,
+                (unsigned long long)l_statistics.decodeCount,
+                100.0 * l_statistics.sharedStepCount
+                    / l_statistics.laneStepCount
+            );
+        }
+    }
+
+    for(
+        unsigned int l_index = 0U;
+        (l_instances != NULL) && (l_index < s_laneCount);
+        l_index++
+    ) {
+        coreDestroyInstance(l_instances[l_index]);
+    }
+
+    free(l_instances);
+    free(l_state);
+
+    return l_returnValue;
+}
+
+static int measureFootprint(void) {
+    size_t l_stateSize = coreGetStateSize();
+    uint8_t *l_state = (uint8_t *)malloc(l_stateSize);
+    struct ts_coreInstance **l_instances =
+        calloc(s_footprintInstanceCount, sizeof(struct ts_coreInstance *));
+    struct ts_coreInstance *l_callerInstance = coreGetInstance();
+    uint64_t l_residentMemory = getResidentMemory();
+    int l_returnValue = 0;
+
+    if(
+        (l_state == NULL)
+        || (l_instances == NULL)
+        || (coreSaveState(l_state, l_stateSize) != 0)
+        || (l_residentMemory == 0U)
+    ) {
+        fprintf(stderr, "Error: failed to prepare the measurement.\n");
+        l_returnValue = 1;
+    }
+
+    for(
+        unsigned int l_index = 0U;
+        (l_returnValue == 0) && (l_index < s_footprintInstanceCount);
+        l_index++
+    ) {
+        l_instances[l_index] = coreCreateInstance();
+
+        if(l_instances[l_index] == NULL) {
+            l_returnValue = 1;
+            break;
+        }
+
+        // Running the instance makes it copy the EEPROM pages it writes to.
+        coreSelectInstance(l_instances[l_index]);
+        l_returnValue = coreLoadState(l_state, l_stateSize);
+
+        if((l_returnValue == 0) && (s_cycles != 0U)) {
+            coreRunUntil(s_cycles, 0U, NULL);
+        }
+    }
+
+    coreSelectInstance(l_callerInstance);
+
+    if(l_returnValue == 0) {
+        uint64_t l_instanceMemory =
+            (getResidentMemory() - l_residentMemory) / s_footprintInstanceCount;
+
+        printf(
+            "instances %u resident memory per instance %llu bytes "
+            "(budget %u)\n",
+            s_footprintInstanceCount,
+            (unsigned long long)l_instanceMemory,
+            C_CORE_INSTANCE_MEMORY_BUDGET_BYTES
+        );
+
+        if(l_instanceMemory > C_CORE_INSTANCE_MEMORY_BUDGET_BYTES) {
+            fprintf(
+                stderr,
+                "Error: an instance uses more memory than its budget.\n"
+            );
+            l_returnValue = 1;
+        }
+    }
+
+    for(
+        unsigned int l_index = 0U;
+        (l_instances != NULL) && (l_index < s_footprintInstanceCount);
+        l_index++
+    ) {
+        coreDestroyInstance(l_instances[l_index]);
+    }
+
+    free(l_instances);
+    free(l_state);
+
+    return l_returnValue;
+}
+
+static uint64_t getResidentMemory(void) {
+    FILE *l_file = fopen("/proc/self/statm", "r");
+    unsigned long long l_totalPageCount;
+    unsigned long long l_residentPageCount;
+    uint64_t l_residentMemory = 0U;
+
+    if(l_file == NULL) {
+        return 0U;
+    }
+
+    if(
+        fscanf(l_file, "%llu %llu", &l_totalPageCount, &l_residentPageCount)
+            == 2
+    ) {
+        l_residentMemory =
+            (uint64_t)l_residentPageCount * (uint64_t)sysconf(_SC_PAGESIZE);
+    }
+
+    fclose(l_file);
+
+    return l_residentMemory;
+}
+
+static int disableHleRoutine(void) {
+    if(s_disabledHleRoutine == NULL) {
+        return 0;
+    }
+
+    const char *l_name = s_disabledHleRoutine;
+
+    if(strcmp(l_name, "all") == 0) {
+        l_name = NULL;
+    }
+
+    if(coreSetHleRoutineEnabled(l_name, false) != 0) {
+        fprintf(
+            stderr,
+            "Error: unknown HLE routine \"%s\".\n",
+            s_disabledHleRoutine
+        );
+        return 1;
+    }
+
+    return 0;
+}
+
+static int explore(void) {
+    static const char *const l_actionNames[] = {
+        "left",
+        "middle",
+        "right",
+        "wait"
+    };
+
+    const struct ts_exploreAction l_actions[] = {
+        {
+            .pressed = true,
+            .input = E_CORE_INPUT_LEFT,
+            .cycles = s_exploreBurstCycles
+        },
+        {
+            .pressed = true,
+            .input = E_CORE_INPUT_MIDDLE,
+            .cycles = s_exploreBurstCycles
+        },
+        {
+            .pressed = true,
+            .input = E_CORE_INPUT_RIGHT,
+            .cycles = s_exploreBurstCycles
+        },
+        {
+            .pressed = false,
+            .input = E_CORE_INPUT_LEFT,
+            .cycles = s_exploreBurstCycles
+        }
+    };
+
+    size_t l_rootStateSize = coreGetStateSize();
+    uint8_t *l_rootState = (uint8_t *)malloc(l_rootStateSize);
+
+    if(
+        (l_rootState == NULL)
+        || (coreSaveState(l_rootState, l_rootStateSize) != 0)
+    ) {
+        free(l_rootState);
+        return 1;
+    }
+
+    struct ts_exploreParameters l_parameters = {
+        .rootState = l_rootState,
+        .rootStateSize = l_rootStateSize,
+        .actions = l_actions,
+        .actionCount = sizeof(l_actions) / sizeof(l_actions[0]),
+        .maxDepth = s_exploreDepth,
+        .maxStateCount = 0U,
+        .threadCount = s_exploreThreadCount,
+        .predicate = exploreGoalReached,
+        .predicateContext = NULL
+    };
+
+    struct ts_exploreResult l_result;
+    int l_returnValue = exploreRun(&l_parameters, &l_result);
+
+    free(l_rootState);
+
+    if(l_returnValue != 0) {
+        return l_returnValue;
+    }
+
+    if(l_result.found) {
+        printf("found");
+
+        for(size_t l_index = 0U; l_index < l_result.actionCount; l_index++) {
+            printf(" %s", l_actionNames[l_result.actions[l_index]]);
+        }
+
+        printf("\n");
+
+        // Continue from the state found, so that it can be saved.
+        l_returnValue = coreLoadState(l_result.state, l_result.stateSize);
+    } else {
+        printf("not found\n");
+    }
+
+    printf("visited %zu\n", l_result.visitedStateCount);
+    exploreFreeResult(&l_result);
+
+    if((l_returnValue == 0) && (s_stateOutputFilePath != NULL)) {
+        l_returnValue = stateFileSave(s_stateOutputFilePath);
+    }
+
+    return l_returnValue;
+}
+
+static bool exploreGoalReached(void *p_context) {
+    M_UNUSED_PARAMETER(p_context);
+
+    return coreReadMemory(s_exploreAddress) == s_exploreValue;
+}
+
+static int selectAccuracy(void) {
+    static const char *const l_accuracyNames[E_CORE_ACCURACY_COUNT] = {
+        [E_CORE_ACCURACY_CYCLE_EXACT] = "exact",
+        [E_CORE_ACCURACY_INSTRUCTION] = "instruction",
+        [E_CORE_ACCURACY_FAST] = "fast"
+    };
+
+    if(s_accuracyName == NULL) {
+        return 0;
+    }
+
+    for(int l_index = 0; l_index < E_CORE_ACCURACY_COUNT; l_index++) {
+        if(strcmp(s_accuracyName, l_accuracyNames[l_index]) == 0) {
+            return coreSetAccuracy((enum te_coreAccuracy)l_index);
+        }
+    }
+
+    fprintf(
+        stderr,
+        "Error: unknown accuracy profile \"%s\".\n",
+        s_accuracyName
+    );
+
+    return 1;
+}
+
+static int loadRecompiledCode(void) {
+    if(s_aotDirectoryPath == NULL) {
+        return 0;
+    }
+
+    int l_returnValue = recompilerLoad(s_aotDirectoryPath);
+
+    if(l_returnValue == 2) {
+        l_returnValue = recompilerBuild(s_aotDirectoryPath);
+
+        if(l_returnValue == 0) {
+            l_returnValue = recompilerLoad(s_aotDirectoryPath);
+        }
+    }
+
+    return l_returnValue;
+}
@@ -0,0 +1,249 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "core/core.h"
+#include "forkserver.h"
+#include "host/statefile.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the maximum length of a request line.
+ */
+#define C_FORKSERVER_LINE_LENGTH 4096
+
+/**
+ * @brief This constant defines how often finished jobs are reaped when no
+ *        request is received, in milliseconds.
+ */
+#define C_FORKSERVER_POLL_TIMEOUT_MS 100
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief This variable contains the request bytes that were read but do not
+ *        form a complete line yet.
+ */
+static char s_forkServerLine[C_FORKSERVER_LINE_LENGTH];
+
+/**
+ * @brief This variable contains the number of bytes in s_forkServerLine.
+ */
+static size_t s_forkServerLineLength;
+
+/**
+ * @brief This variable contains the number of jobs that have not been reaped.
+ */
+static int s_forkServerRunningJobs;
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Processes one request line.
+ *
+ * @param[in] p_line The request line, without the line terminator.
+ *
+ * @returns A boolean value that indicates whether the server must keep
+ *          running.
+ */
+static bool forkServerProcessLine(const char *p_line);
+
+/**
+ * @brief Starts a job in a child process.
+ *
+ * @param[in] p_cycles The number of cycles to run.
+ * @param[in] p_stateFilePath The path to the file to save the state to.
+ */
+static void forkServerStartJob(uint64_t p_cycles, const char *p_stateFilePath);
+
+/**
+ * @brief Reaps the finished jobs and reports their exit status.
+ *
+ * @param[in] p_wait If true, waits for all the running jobs to finish.
+ */
+static void forkServerReapJobs(bool p_wait);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int forkServerRun(const char *p_pipePath) {
+    int l_fileDescriptor;
+
+    if(strcmp(p_pipePath, "-") == 0) {
+        l_fileDescriptor = STDIN_FILENO;
+    } else {
+        struct stat l_fileStatus;
+
+        if(stat(p_pipePath, &l_fileStatus) != 0) {
+            fprintf(stderr, "Error: cannot access \"%s\".\n", p_pipePath);
+            return 1;
+        }
+
+        // A FIFO is opened for writing too, so that it does not reach the end
+        // of file when its writer goes away.
+        if(S_ISFIFO(l_fileStatus.st_mode)) {
+            l_fileDescriptor = open(p_pipePath, O_RDWR);
+        } else {
+            l_fileDescriptor = open(p_pipePath, O_RDONLY);
+        }
+
+        if(l_fileDescriptor < 0) {
+            fprintf(stderr, "Error: cannot open \"%s\".\n", p_pipePath);
+            return 1;
+        }
+    }
+
+    s_forkServerLineLength = 0;
+    s_forkServerRunningJobs = 0;
+
+    bool l_running = true;
+
+    while(l_running) {
+        struct pollfd l_pollFileDescriptor = {
+            .fd = l_fileDescriptor,
+            .events = POLLIN,
+            .revents = 0
+        };
+
+        int l_pollResult =
+            poll(&l_pollFileDescriptor, 1, C_FORKSERVER_POLL_TIMEOUT_MS);
+
+        forkServerReapJobs(false);
+
+        if(l_pollResult < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+
+            break;
+        } else if(l_pollResult == 0) {
+            continue;
+        }
+
+        ssize_t l_readSize = read(
+            l_fileDescriptor,
+            &s_forkServerLine[s_forkServerLineLength],
+            C_FORKSERVER_LINE_LENGTH - 1 - s_forkServerLineLength
+        );
+
+        if(l_readSize <= 0) {
+            // End of the input
+            break;
+        }
+
+        s_forkServerLineLength += l_readSize;
+        s_forkServerLine[s_forkServerLineLength] = '\0';
+
+        // Process every complete line
+        char *l_lineStart = s_forkServerLine;
+        char *l_lineEnd;
+
+        while(l_running && ((l_lineEnd = strchr(l_lineStart, '\n')) != NULL)) {
+            *l_lineEnd = '\0';
+            l_running = forkServerProcessLine(l_lineStart);
+            l_lineStart = l_lineEnd + 1;
+        }
+
+        s_forkServerLineLength -= l_lineStart - s_forkServerLine;
+        memmove(s_forkServerLine, l_lineStart, s_forkServerLineLength);
+
+        if(s_forkServerLineLength == C_FORKSERVER_LINE_LENGTH - 1) {
+            fprintf(stderr, "Error: request line is too long.\n");
+            s_forkServerLineLength = 0;
+        }
+    }
+
+    if(l_fileDescriptor != STDIN_FILENO) {
+        close(l_fileDescriptor);
+    }
+
+    forkServerReapJobs(true);
+
+    return 0;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static bool forkServerProcessLine(const char *p_line) {
+    unsigned long long l_cycles;
+    char l_stateFilePath[C_FORKSERVER_LINE_LENGTH];
+
+    if(strcmp(p_line, "quit") == 0) {
+        return false;
+    } else if(
+        sscanf(p_line, "run %llu %4095s", &l_cycles, l_stateFilePath) == 2
+    ) {
+        forkServerStartJob(l_cycles, l_stateFilePath);
+    } else if(p_line[0] != '\0') {
+        fprintf(stderr, "Error: invalid request \"%s\".\n", p_line);
+    }
+
+    return true;
+}
+
+static void forkServerStartJob(uint64_t p_cycles, const char *p_stateFilePath) {
+    // Buffered output must not be written twice.
+    fflush(stdout);
+    fflush(stderr);
+
+    pid_t l_pid = fork();
+
+    if(l_pid < 0) {
+        fprintf(stderr, "Error: fork() failed.\n");
+    } else if(l_pid == 0) {
+        // The child starts from the parked state, shared copy-on-write with
+        // the server.
+        if(p_cycles != 0U) {
+            coreRunUntil(p_cycles, 0U, NULL);
+        }
+
+        if(stateFileSave(p_stateFilePath) != 0) {
+            _exit(EXIT_FAILURE);
+        }
+
+        _exit(EXIT_SUCCESS);
+    } else {
+        s_forkServerRunningJobs++;
+        printf("started %ld\n", (long)l_pid);
+        fflush(stdout);
+    }
+}
+
+static void forkServerReapJobs(bool p_wait) {
+    while(s_forkServerRunningJobs > 0) {
+        int l_status;
+        pid_t l_pid = waitpid(-1, &l_status, p_wait ? 0 : WNOHANG);
+
+        if(l_pid <= 0) {
+            break;
+        }
+
+        s_forkServerRunningJobs--;
+
+        if(WIFSIGNALED(l_status)) {
+            printf("killed %ld %d\n", (long)l_pid, WTERMSIG(l_status));
+        } else {
+            printf("exited %ld %d\n", (long)l_pid, WEXITSTATUS(l_status));
+        }
+    }
+
+    fflush(stdout);
+}
@@ -0,0 +1,30 @@
+#ifndef __INC_FORKSERVER_H__
+#define __INC_FORKSERVER_H__
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Runs the fork server. The core must be in the state that every job
+ *        starts from (usually right after the boot sequence).
+ * @details Job requests are read line by line from the given pipe:
+ *          - "run <cycles> <state file>": forks a child process that runs the
+ *            core for the given number of cycles, starting from the parked
+ *            state, and saves its state to the given file.
+ *          - "quit": waits for the running jobs and returns.
+ *
+ *          The server writes "started <pid>" on the standard output for every
+ *          job, and "exited <pid> <status>" or "killed <pid> <signal>" when the
+ *          job ends. If the pipe is a FIFO, the server keeps it open between
+ *          writers, otherwise it stops at the end of the input.
+ *
+ * @param[in] p_pipePath The path to the pipe to read the requests from, or "-"
+ *                       for the standard input.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the server stopped normally.
+ * @retval Any other value if an error occurred.
+ */
+int forkServerRun(const char *p_pipePath);
+
+#endif // __INC_FORKSERVER_H__
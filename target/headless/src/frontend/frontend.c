@@ -0,0 +1,13 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include "frontend/frontend.h"
+
+// =============================================================================
+// Public functions definitions
+// =============================================================================
+int frontendInit(void) {
+    // Nothing is displayed by the headless front-end, so it does not listen
+    // to the VBlank event.
+    return 0;
+}
@@ -0,0 +1,1302 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+// Python.h must be included first, as it defines feature test macros.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "common.h"
+#include "core/core.h"
+#include "host/pool.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the size of the FLASH ROM file in bytes.
+ */
+#define C_FLASH_ROM_SIZE_BYTES 49152
+
+/**
+ * @brief This constant defines the size of the EEPROM file in bytes.
+ */
+#define C_EEPROM_SIZE_BYTES 65536
+
+/**
+ * @brief These constants define the size of the screen in pixels.
+ */
+#define C_SCREEN_WIDTH 96U
+#define C_SCREEN_HEIGHT 64U
+
+/**
+ * @brief This constant defines the size of a rendered frame in bytes.
+ */
+#define C_FRAME_SIZE_BYTES (C_SCREEN_WIDTH * C_SCREEN_HEIGHT * 4U)
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+/**
+ * @brief This structure describes an emuwalker.Instance object.
+ */
+struct ts_pythonInstance {
+    PyObject_HEAD
+
+    /**
+     * @brief This member contains the core instance.
+     */
+    struct ts_coreInstance *instance;
+
+    /**
+     * @brief This member indicates whether the instance is part of a batch
+     *        that is running without the GIL. The other methods fail until
+     *        the batch is done.
+     */
+    bool busy;
+};
+
+/**
+ * @brief This structure describes an emuwalker.MemoryRegion object, which
+ *        exports a memory region of an instance through the buffer protocol.
+ */
+struct ts_pythonRegion {
+    PyObject_HEAD
+
+    /**
+     * @brief This member contains the instance that owns the memory. It is
+     *        kept alive as long as the region is.
+     */
+    struct ts_pythonInstance *owner;
+
+    const uint8_t *data;
+    size_t size;
+};
+
+/**
+ * @brief This structure describes a batch of instances that is processed by
+ *        the pool.
+ */
+struct ts_pythonBatch {
+    /**
+     * @brief This member contains a tuple of the instances. It is a copy, so
+     *        that the instances stay alive and the same during the batch, even
+     *        if the sequence given by the caller changes.
+     */
+    PyObject *sequence;
+
+    struct ts_coreInstance **instances;
+    size_t count;
+
+    /**
+     * @brief These members contain the parameters of the operation.
+     */
+    uint64_t cycles;
+    unsigned long frames;
+    uint8_t *buffer;
+};
+
+// =============================================================================
+// Private variable declarations
+// =============================================================================
+/**
+ * @brief These variables contain the copies of the files loaded in the core,
+ *        which must remain valid as long as the instances exist.
+ */
+static uint8_t *s_flashRom;
+static uint8_t *s_eeprom;
+
+/**
+ * @brief This variable contains the pool that runs the batches. It is created
+ *        by emuwalker.init().
+ */
+static struct ts_pool *s_pool;
+
+/**
+ * @brief These variables contain the types of the module.
+ */
+static PyTypeObject s_instanceType;
+static PyTypeObject s_regionType;
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Checks that the instance is not part of a running batch, and selects
+ *        it on the calling thread.
+ *
+ * @param[in] p_self The instance.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the instance was selected.
+ * @retval 1 if a Python exception was raised.
+ */
+static int instanceSelect(struct ts_pythonInstance *p_self);
+
+/**
+ * @brief Creates an instance of the core in the reset state.
+ *
+ * @param[in] p_type The type to create.
+ * @param[in] p_args The positional arguments.
+ * @param[in] p_kwargs The keyword arguments: accuracy.
+ *
+ * @returns A new reference, or NULL if an exception was raised.
+ */
+static PyObject *instanceNew(
+    PyTypeObject *p_type,
+    PyObject *p_args,
+    PyObject *p_kwargs
+);
+
+/**
+ * @brief Destroys the core instance of an Instance object.
+ *
+ * @param[in] p_self The instance.
+ */
+static void instanceDealloc(PyObject *p_self);
+
+/**
+ * @brief Instance.reset(): resets the instance.
+ */
+static PyObject *instanceReset(PyObject *p_self, PyObject *p_args);
+
+/**
+ * @brief Instance.clone(): returns a new instance in the same state.
+ */
+static PyObject *instanceClone(PyObject *p_self, PyObject *p_args);
+
+/**
+ * @brief Instance.set_input(key, pressed): sets the state of an input key.
+ */
+static PyObject *instanceSetInput(PyObject *p_self, PyObject *p_args);
+
+/**
+ * @brief Instance.save_state(): returns the state of the instance.
+ */
+static PyObject *instanceSaveState(PyObject *p_self, PyObject *p_args);
+
+/**
+ * @brief Instance.load_state(state): loads a state from a bytes-like object.
+ */
+static PyObject *instanceLoadState(PyObject *p_self, PyObject *p_args);
+
+/**
+ * @brief Instance.state_hash(): returns the state hash.
+ */
+static PyObject *instanceStateHash(PyObject *p_self, PyObject *p_args);
+
+/**
+ * @brief Instance.video_hash(): returns the hash of the displayed frame.
+ */
+static PyObject *instanceVideoHash(PyObject *p_self, PyObject *p_args);
+
+/**
+ * @brief Instance.read_eeprom([buffer]): copies the EEPROM contents.
+ */
+static PyObject *instanceReadEeprom(PyObject *p_self, PyObject *p_args);
+
+/**
+ * @brief Instance.cycles: returns the cycle counter.
+ */
+static PyObject *instanceGetCycles(PyObject *p_self, void *p_closure);
+
+/**
+ * @brief Instance.accuracy: returns the accuracy profile.
+ */
+static PyObject *instanceGetAccuracy(PyObject *p_self, void *p_closure);
+
+/**
+ * @brief Instance.accuracy = value: selects the accuracy profile.
+ */
+static int instanceSetAccuracy(
+    PyObject *p_self,
+    PyObject *p_value,
+    void *p_closure
+);
+
+/**
+ * @brief Instance.ram and Instance.frame: return a read-only memoryview of a
+ *        memory region.
+ *
+ * @param[in] p_self The instance.
+ * @param[in] p_closure The te_coreMemoryRegion value, cast to a pointer.
+ *
+ * @returns A new reference, or NULL if an exception was raised.
+ */
+static PyObject *instanceGetRegion(PyObject *p_self, void *p_closure);
+
+/**
+ * @brief Releases the owner of a MemoryRegion object.
+ *
+ * @param[in] p_self The region.
+ */
+static void regionDealloc(PyObject *p_self);
+
+/**
+ * @brief Exports the memory of a MemoryRegion object, read-only.
+ *
+ * @param[in] p_self The region.
+ * @param[out] p_view The view to fill.
+ * @param[in] p_flags The buffer request flags.
+ *
+ * @returns 0 if the view was filled, -1 if an exception was raised.
+ */
+static int regionGetBuffer(PyObject *p_self, Py_buffer *p_view, int p_flags);
+
+/**
+ * @brief Collects the instances of a batch and marks them as busy.
+ *
+ * @param[in] p_instances The sequence of Instance objects.
+ * @param[out] p_batch The batch to fill.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval 1 if a Python exception was raised.
+ */
+static int batchOpen(PyObject *p_instances, struct ts_pythonBatch *p_batch);
+
+/**
+ * @brief Runs a function on each instance of a batch, on the threads of the
+ *        pool and without the GIL.
+ *
+ * @param[in,out] p_batch The batch.
+ * @param[in] p_task The function that processes one instance.
+ */
+static void batchRun(struct ts_pythonBatch *p_batch, tf_poolTask p_task);
+
+/**
+ * @brief Marks the instances of a batch as idle and releases the batch.
+ *
+ * @param[in,out] p_batch The batch.
+ */
+static void batchClose(struct ts_pythonBatch *p_batch);
+
+/**
+ * @brief Runs an instance of a batch for a number of cycles.
+ *
+ * @param[in] p_batch A pointer to the ts_pythonBatch structure.
+ * @param[in] p_index The index of the instance.
+ */
+static void batchRunCycles(void *p_batch, size_t p_index);
+
+/**
+ * @brief Runs an instance of a batch for a number of frames.
+ *
+ * @param[in] p_batch A pointer to the ts_pythonBatch structure.
+ * @param[in] p_index The index of the instance.
+ */
+static void batchRunFrames(void *p_batch, size_t p_index);
+
+/**
+ * @brief Renders the frame of an instance of a batch into its slot of the
+ *        buffer.
+ *
+ * @param[in] p_batch A pointer to the ts_pythonBatch structure.
+ * @param[in] p_index The index of the instance.
+ */
+static void batchRender(void *p_batch, size_t p_index);
+
+/**
+ * @brief emuwalker.init(flash_rom, eeprom, threads=0): loads the files and
+ *        creates the pool.
+ */
+static PyObject *moduleInit(
+    PyObject *p_module,
+    PyObject *p_args,
+    PyObject *p_kwargs
+);
+
+/**
+ * @brief emuwalker.run(instances, cycles): runs instances for a number of
+ *        cycles.
+ */
+static PyObject *moduleRun(PyObject *p_module, PyObject *p_args);
+
+/**
+ * @brief emuwalker.run_frames(instances, frames): runs instances until their
+ *        next VBlank, a number of times.
+ */
+static PyObject *moduleRunFrames(PyObject *p_module, PyObject *p_args);
+
+/**
+ * @brief emuwalker.render(instances, buffer): renders the frames of instances
+ *        into a writable buffer.
+ */
+static PyObject *moduleRender(PyObject *p_module, PyObject *p_args);
+
+/**
+ * @brief Creates the module.
+ *
+ * @returns A new reference, or NULL if an exception was raised.
+ */
+PyMODINIT_FUNC PyInit_emuwalker(void);
+
+// =============================================================================
+// Private variable definitions
+// =============================================================================
+static PyMethodDef s_instanceMethods[] = {
+    {
+        "reset",
+        instanceReset,
+        METH_NOARGS,
+        PyDoc_STR("reset()\n\nResets the instance.")
+    },
+    {
+        "clone",
+        instanceClone,
+        METH_NOARGS,
+        PyDoc_STR(
+            "clone() -> Instance\n\n"
+            "Returns a new instance in the same state."
+        )
+    },
+    {
+        "set_input",
+        instanceSetInput,
+        METH_VARARGS,
+        PyDoc_STR(
+            "set_input(key, pressed)\n\n"
+            "Sets the state of an input key (INPUT_LEFT, INPUT_MIDDLE or "
+            "INPUT_RIGHT)."
+        )
+    },
+    {
+        "save_state",
+        instanceSaveState,
+        METH_NOARGS,
+        PyDoc_STR("save_state() -> bytes\n\nReturns the state.")
+    },
+    {
+        "load_state",
+        instanceLoadState,
+        METH_VARARGS,
+        PyDoc_STR(
+            "load_state(state)\n\n"
+            "Loads a state returned by save_state() from a bytes-like object."
+        )
+    },
+    {
+        "state_hash",
+        instanceStateHash,
+        METH_NOARGS,
+        PyDoc_STR("state_hash() -> int\n\nReturns the state hash.")
+    },
+    {
+        "video_hash",
+        instanceVideoHash,
+        METH_NOARGS,
+        PyDoc_STR(
+            "video_hash() -> int\n\n"
+            "Returns the hash of the displayed frame."
+        )
+    },
+    {
+        "read_eeprom",
+        instanceReadEeprom,
+        METH_VARARGS,
+        PyDoc_STR(
+            "read_eeprom([buffer]) -> bytes or None\n\n"
+            "Copies the EEPROM contents into a writable buffer of at least "
+            "65536 bytes, or returns them if no buffer is given. The EEPROM "
+            "is shared between instances page by page until written, so it "
+            "is not contiguous and cannot be exported without a copy."
+        )
+    },
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef s_instanceGetSets[] = {
+    {
+        "cycles",
+        instanceGetCycles,
+        NULL,
+        PyDoc_STR("The number of cycles since the last reset."),
+        NULL
+    },
+    {
+        "accuracy",
+        instanceGetAccuracy,
+        instanceSetAccuracy,
+        PyDoc_STR("The accuracy profile (ACCURACY_*)."),
+        NULL
+    },
+    {
+        "ram",
+        instanceGetRegion,
+        NULL,
+        PyDoc_STR(
+            "A read-only memoryview of the 2048 bytes of RAM, from address "
+            "0xf780. It is not a copy: it changes as the instance runs."
+        ),
+        (void *)(uintptr_t)E_CORE_MEMORY_REGION_RAM
+    },
+    {
+        "frame",
+        instanceGetRegion,
+        NULL,
+        PyDoc_STR(
+            "A read-only memoryview of the 1536 bytes of the displayed frame, "
+            "in the LCD controller format: 8 pages of 8 rows, and in a page "
+            "2 bytes per column (the low bits of the 8 pixels, then their "
+            "high bits). It is not a copy: it changes at each VBlank."
+        ),
+        (void *)(uintptr_t)E_CORE_MEMORY_REGION_FRAME
+    },
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyBufferProcs s_regionBufferProcs = {
+    .bf_getbuffer = regionGetBuffer,
+    .bf_releasebuffer = NULL
+};
+
+static PyTypeObject s_instanceType = {
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "emuwalker.Instance",
+    .tp_doc = PyDoc_STR(
+        "Instance(accuracy=ACCURACY_CYCLE_EXACT)\n\n"
+        "An instance of the emulator, in the reset state."
+    ),
+    .tp_basicsize = sizeof(struct ts_pythonInstance),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = instanceNew,
+    .tp_dealloc = instanceDealloc,
+    .tp_methods = s_instanceMethods,
+    .tp_getset = s_instanceGetSets
+};
+
+static PyTypeObject s_regionType = {
+    .ob_base = PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "emuwalker.MemoryRegion",
+    .tp_doc = PyDoc_STR("A memory region of an instance."),
+    .tp_basicsize = sizeof(struct ts_pythonRegion),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = regionDealloc,
+    .tp_as_buffer = &s_regionBufferProcs
+};
+
+static PyMethodDef s_moduleMethods[] = {
+    {
+        "init",
+        (PyCFunction)(void (*)(void))moduleInit,
+        METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR(
+            "init(flash_rom, eeprom, threads=0)\n\n"
+            "Loads the FLASH ROM and EEPROM files from bytes-like objects, "
+            "and starts the threads that run the batches (0 for one per "
+            "processor). It must be called once, before any instance is "
+            "created."
+        )
+    },
+    {
+        "run",
+        moduleRun,
+        METH_VARARGS,
+        PyDoc_STR(
+            "run(instances, cycles)\n\n"
+            "Runs each instance of a sequence for a number of cycles. The "
+            "instances are spread over the threads, and the GIL is released "
+            "during the run."
+        )
+    },
+    {
+        "run_frames",
+        moduleRunFrames,
+        METH_VARARGS,
+        PyDoc_STR(
+            "run_frames(instances, frames)\n\n"
+            "Runs each instance of a sequence until its next VBlank, a number "
+            "of times. The GIL is released during the run."
+        )
+    },
+    {
+        "render",
+        moduleRender,
+        METH_VARARGS,
+        PyDoc_STR(
+            "render(instances, buffer)\n\n"
+            "Renders the displayed frame of each instance of a sequence into "
+            "a writable buffer, as 64 rows of 96 pixels stored as R, G, B, A "
+            "bytes, one frame after the other."
+        )
+    },
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef s_moduleDefinition = {
+    .m_base = PyModuleDef_HEAD_INIT,
+    .m_name = "emuwalker",
+    .m_doc = PyDoc_STR(
+        "Bindings to the emuwalker core, designed around batches of "
+        "instances."
+    ),
+    .m_size = -1,
+    .m_methods = s_moduleMethods
+};
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+PyMODINIT_FUNC PyInit_emuwalker(void) {
+    if(
+        (PyType_Ready(&s_instanceType) < 0)
+        || (PyType_Ready(&s_regionType) < 0)
+    ) {
+        return NULL;
+    }
+
+    PyObject *l_module = PyModule_Create(&s_moduleDefinition);
+
+    if(l_module == NULL) {
+        return NULL;
+    }
+
+    Py_INCREF(&s_instanceType);
+    Py_INCREF(&s_regionType);
+
+    if(
+        (PyModule_AddObject(
+            l_module,
+            "Instance",
+            (PyObject *)&s_instanceType
+        ) < 0)
+        || (PyModule_AddObject(
+            l_module,
+            "MemoryRegion",
+            (PyObject *)&s_regionType
+        ) < 0)
+        || (PyModule_AddIntConstant(
+            l_module,
+            "INPUT_LEFT",
+            E_CORE_INPUT_LEFT
+        ) < 0)
+        || (PyModule_AddIntConstant(
+            l_module,
+            "INPUT_MIDDLE",
+            E_CORE_INPUT_MIDDLE
+        ) < 0)
+        || (PyModule_AddIntConstant(
+            l_module,
+            "INPUT_RIGHT",
+            E_CORE_INPUT_RIGHT
+        ) < 0)
+        || (PyModule_AddIntConstant(
+            l_module,
+            "ACCURACY_CYCLE_EXACT",
+            E_CORE_ACCURACY_CYCLE_EXACT
+        ) < 0)
+        || (PyModule_AddIntConstant(
+            l_module,
+            "ACCURACY_INSTRUCTION",
+            E_CORE_ACCURACY_INSTRUCTION
+        ) < 0)
+        || (PyModule_AddIntConstant(
+            l_module,
+            "ACCURACY_FAST",
+            E_CORE_ACCURACY_FAST
+        ) < 0)
+    ) {
+        Py_DECREF(l_module);
+        return NULL;
+    }
+
+    return l_module;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static int instanceSelect(struct ts_pythonInstance *p_self) {
+    if(p_self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "the instance is running");
+        return 1;
+    }
+
+    coreSelectInstance(p_self->instance);
+
+    return 0;
+}
+
+static PyObject *instanceNew(
+    PyTypeObject *p_type,
+    PyObject *p_args,
+    PyObject *p_kwargs
+) {
+    static char *l_keywords[] = {"accuracy", NULL};
+    int l_accuracy = E_CORE_ACCURACY_CYCLE_EXACT;
+
+    if(
+        !PyArg_ParseTupleAndKeywords(
+            p_args,
+            p_kwargs,
+            "|i",
+            l_keywords,
+            &l_accuracy
+        )
+    ) {
+        return NULL;
+    }
+
+    if(s_pool == NULL) {
+        PyErr_SetString(
+            PyExc_RuntimeError,
+            "emuwalker.init() must be called first"
+        );
+        return NULL;
+    } else if((l_accuracy < 0) || (l_accuracy >= E_CORE_ACCURACY_COUNT)) {
+        PyErr_SetString(PyExc_ValueError, "invalid accuracy profile");
+        return NULL;
+    }
+
+    struct ts_pythonInstance *l_self =
+        (struct ts_pythonInstance *)p_type->tp_alloc(p_type, 0);
+
+    if(l_self == NULL) {
+        return NULL;
+    }
+
+    l_self->instance = coreCreateInstance();
+
+    if(l_self->instance == NULL) {
+        Py_DECREF(l_self);
+        return PyErr_NoMemory();
+    }
+
+    coreSelectInstance(l_self->instance);
+
+    if(coreSetAccuracy((enum te_coreAccuracy)l_accuracy) != 0) {
+        Py_DECREF(l_self);
+        PyErr_SetString(PyExc_RuntimeError, "failed to set the accuracy");
+        return NULL;
+    }
+
+    return (PyObject *)l_self;
+}
+
+static void instanceDealloc(PyObject *p_self) {
+    struct ts_pythonInstance *l_self = (struct ts_pythonInstance *)p_self;
+
+    coreDestroyInstance(l_self->instance);
+    Py_TYPE(p_self)->tp_free(p_self);
+}
+
+static PyObject *instanceReset(PyObject *p_self, PyObject *p_args) {
+    M_UNUSED_PARAMETER(p_args);
+
+    if(instanceSelect((struct ts_pythonInstance *)p_self) != 0) {
+        return NULL;
+    }
+
+    coreReset();
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *instanceClone(PyObject *p_self, PyObject *p_args) {
+    M_UNUSED_PARAMETER(p_args);
+
+    struct ts_pythonInstance *l_self = (struct ts_pythonInstance *)p_self;
+
+    if(instanceSelect(l_self) != 0) {
+        return NULL;
+    }
+
+    // The new instance inherits the accuracy profile of the selected one.
+    PyObject *l_state = instanceSaveState(p_self, NULL);
+
+    if(l_state == NULL) {
+        return NULL;
+    }
+
+    struct ts_pythonInstance *l_clone = (struct ts_pythonInstance *)
+        s_instanceType.tp_alloc(&s_instanceType, 0);
+
+    if(l_clone != NULL) {
+        coreSelectInstance(l_self->instance);
+        l_clone->instance = coreCreateInstance();
+    }
+
+    if((l_clone == NULL) || (l_clone->instance == NULL)) {
+        Py_XDECREF(l_clone);
+        Py_DECREF(l_state);
+        return PyErr_NoMemory();
+    }
+
+    coreSelectInstance(l_clone->instance);
+
+    int l_result = coreLoadState(
+        (const uint8_t *)PyBytes_AS_STRING(l_state),
+        (size_t)PyBytes_GET_SIZE(l_state)
+    );
+
+    Py_DECREF(l_state);
+
+    if(l_result != 0) {
+        Py_DECREF(l_clone);
+        PyErr_SetString(PyExc_RuntimeError, "failed to copy the state");
+        return NULL;
+    }
+
+    return (PyObject *)l_clone;
+}
+
+static PyObject *instanceSetInput(PyObject *p_self, PyObject *p_args) {
+    int l_input;
+    int l_pressed;
+
+    if(!PyArg_ParseTuple(p_args, "ip", &l_input, &l_pressed)) {
+        return NULL;
+    }
+
+    if(
+        (l_input != E_CORE_INPUT_LEFT)
+        && (l_input != E_CORE_INPUT_MIDDLE)
+        && (l_input != E_CORE_INPUT_RIGHT)
+    ) {
+        PyErr_SetString(PyExc_ValueError, "invalid input key");
+        return NULL;
+    }
+
+    if(instanceSelect((struct ts_pythonInstance *)p_self) != 0) {
+        return NULL;
+    }
+
+    coreSetInput(
+        (enum te_coreInput)l_input,
+        l_pressed ? E_CORE_INPUT_PRESSED : E_CORE_INPUT_RELEASED
+    );
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *instanceSaveState(PyObject *p_self, PyObject *p_args) {
+    M_UNUSED_PARAMETER(p_args);
+
+    if(instanceSelect((struct ts_pythonInstance *)p_self) != 0) {
+        return NULL;
+    }
+
+    size_t l_size = coreGetStateSize();
+    PyObject *l_state = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)l_size);
+
+    if(l_state == NULL) {
+        return NULL;
+    }
+
+    if(coreSaveState((uint8_t *)PyBytes_AS_STRING(l_state), l_size) != 0) {
+        Py_DECREF(l_state);
+        PyErr_SetString(PyExc_RuntimeError, "failed to save the state");
+        return NULL;
+    }
+
+    return l_state;
+}
+
+static PyObject *instanceLoadState(PyObject *p_self, PyObject *p_args) {
+    Py_buffer l_state;
+
+    if(!PyArg_ParseTuple(p_args, "y*", &l_state)) {
+        return NULL;
+    }
+
+    if(instanceSelect((struct ts_pythonInstance *)p_self) != 0) {
+        PyBuffer_Release(&l_state);
+        return NULL;
+    }
+
+    int l_result = coreLoadState(
+        (const uint8_t *)l_state.buf,
+        (size_t)l_state.len
+    );
+
+    PyBuffer_Release(&l_state);
+
+    if(l_result != 0) {
+        PyErr_SetString(PyExc_ValueError, "invalid state");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *instanceStateHash(PyObject *p_self, PyObject *p_args) {
+    M_UNUSED_PARAMETER(p_args);
+
+    if(instanceSelect((struct ts_pythonInstance *)p_self) != 0) {
+        return NULL;
+    }
+
+    return PyLong_FromUnsignedLongLong(coreGetStateHash());
+}
+
+static PyObject *instanceVideoHash(PyObject *p_self, PyObject *p_args) {
+    M_UNUSED_PARAMETER(p_args);
+
+    if(instanceSelect((struct ts_pythonInstance *)p_self) != 0) {
+        return NULL;
+    }
+
+    return PyLong_FromUnsignedLongLong(coreGetVideoHash());
+}
+
+static PyObject *instanceReadEeprom(PyObject *p_self, PyObject *p_args) {
+    PyObject *l_buffer = NULL;
+
+    if(!PyArg_ParseTuple(p_args, "|O", &l_buffer)) {
+        return NULL;
+    }
+
+    if(instanceSelect((struct ts_pythonInstance *)p_self) != 0) {
+        return NULL;
+    }
+
+    if((l_buffer == NULL) || (l_buffer == Py_None)) {
+        PyObject *l_eeprom =
+            PyBytes_FromStringAndSize(NULL, C_EEPROM_SIZE_BYTES);
+
+        if(l_eeprom != NULL) {
+            coreSaveFile(
+                E_CORE_FILE_EEPROM,
+                (uint8_t *)PyBytes_AS_STRING(l_eeprom),
+                C_EEPROM_SIZE_BYTES
+            );
+        }
+
+        return l_eeprom;
+    }
+
+    Py_buffer l_view;
+
+    if(PyObject_GetBuffer(l_buffer, &l_view, PyBUF_WRITABLE) != 0) {
+        return NULL;
+    }
+
+    int l_result = coreSaveFile(
+        E_CORE_FILE_EEPROM,
+        (uint8_t *)l_view.buf,
+        (size_t)l_view.len
+    );
+
+    PyBuffer_Release(&l_view);
+
+    if(l_result != 0) {
+        PyErr_SetString(PyExc_ValueError, "the buffer is too small");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *instanceGetCycles(PyObject *p_self, void *p_closure) {
+    M_UNUSED_PARAMETER(p_closure);
+
+    if(instanceSelect((struct ts_pythonInstance *)p_self) != 0) {
+        return NULL;
+    }
+
+    return PyLong_FromUnsignedLongLong(coreGetCycles());
+}
+
+static PyObject *instanceGetAccuracy(PyObject *p_self, void *p_closure) {
+    M_UNUSED_PARAMETER(p_closure);
+
+    if(instanceSelect((struct ts_pythonInstance *)p_self) != 0) {
+        return NULL;
+    }
+
+    return PyLong_FromLong(coreGetAccuracy());
+}
+
+static int instanceSetAccuracy(
+    PyObject *p_self,
+    PyObject *p_value,
+    void *p_closure
+) {
+    M_UNUSED_PARAMETER(p_closure);
+
+    if(p_value == NULL) {
+        PyErr_SetString(PyExc_AttributeError, "cannot delete accuracy");
+        return -1;
+    }
+
+    long l_accuracy = PyLong_AsLong(p_value);
+
+    if((l_accuracy == -1) && (PyErr_Occurred() != NULL)) {
+        return -1;
+    }
+
+    if(instanceSelect((struct ts_pythonInstance *)p_self) != 0) {
+        return -1;
+    }
+
+    if(
+        (l_accuracy < 0)
+        || (l_accuracy >= E_CORE_ACCURACY_COUNT)
+        || (coreSetAccuracy((enum te_coreAccuracy)l_accuracy) != 0)
+    ) {
+        PyErr_SetString(PyExc_ValueError, "invalid accuracy profile");
+        return -1;
+    }
+
+    return 0;
+}
+
+static PyObject *instanceGetRegion(PyObject *p_self, void *p_closure) {
+    struct ts_pythonInstance *l_self = (struct ts_pythonInstance *)p_self;
+
+    // The region pointers remain valid while the instance runs, so they can
+    // be taken from a busy instance.
+    coreSelectInstance(l_self->instance);
+
+    struct ts_pythonRegion *l_region = PyObject_New(
+        struct ts_pythonRegion,
+        &s_regionType
+    );
+
+    if(l_region == NULL) {
+        return NULL;
+    }
+
+    Py_INCREF(p_self);
+    l_region->owner = l_self;
+    l_region->data = coreGetMemoryRegion(
+        (enum te_coreMemoryRegion)(uintptr_t)p_closure,
+        &l_region->size
+    );
+
+    PyObject *l_view = PyMemoryView_FromObject((PyObject *)l_region);
+
+    Py_DECREF(l_region);
+
+    return l_view;
+}
+
+static void regionDealloc(PyObject *p_self) {
+    struct ts_pythonRegion *l_self = (struct ts_pythonRegion *)p_self;
+
+    Py_DECREF(l_self->owner);
+    PyObject_Free(p_self);
+}
+
+static int regionGetBuffer(PyObject *p_self, Py_buffer *p_view, int p_flags) {
+    struct ts_pythonRegion *l_self = (struct ts_pythonRegion *)p_self;
+
+    return PyBuffer_FillInfo(
+        p_view,
+        p_self,
+        (void *)l_self->data,
+        (Py_ssize_t)l_self->size,
+        1,
+        p_flags
+    );
+}
+
+static int batchOpen(PyObject *p_instances, struct ts_pythonBatch *p_batch) {
+    memset(p_batch, 0, sizeof(struct ts_pythonBatch));
+
+    if(s_pool == NULL) {
+        PyErr_SetString(
+            PyExc_RuntimeError,
+            "emuwalker.init() must be called first"
+        );
+        return 1;
+    }
+
+    if(!PySequence_Check(p_instances)) {
+        PyErr_SetString(
+            PyExc_TypeError,
+            "instances must be a sequence of emuwalker.Instance"
+        );
+        return 1;
+    }
+
+    p_batch->sequence = PySequence_Tuple(p_instances);
+
+    if(p_batch->sequence == NULL) {
+        return 1;
+    }
+
+    size_t l_count = (size_t)PyTuple_GET_SIZE(p_batch->sequence);
+
+    p_batch->instances = (struct ts_coreInstance **)malloc(
+        (l_count + 1U) * sizeof(struct ts_coreInstance *)
+    );
+
+    if(p_batch->instances == NULL) {
+        Py_DECREF(p_batch->sequence);
+        PyErr_NoMemory();
+        return 1;
+    }
+
+    // An instance that appears twice is busy the second time, as it cannot
+    // run on two threads.
+    while(p_batch->count < l_count) {
+        PyObject *l_item = PyTuple_GET_ITEM(p_batch->sequence, p_batch->count);
+
+        if(!PyObject_TypeCheck(l_item, &s_instanceType)) {
+            PyErr_SetString(
+                PyExc_TypeError,
+                "instances must be a sequence of emuwalker.Instance"
+            );
+            break;
+        }
+
+        struct ts_pythonInstance *l_instance =
+            (struct ts_pythonInstance *)l_item;
+
+        if(l_instance->busy) {
+            PyErr_SetString(
+                PyExc_RuntimeError,
+                "an instance is running or appears twice"
+            );
+            break;
+        }
+
+        l_instance->busy = true;
+        p_batch->instances[p_batch->count] = l_instance->instance;
+        p_batch->count++;
+    }
+
+    if(p_batch->count < l_count) {
+        for(size_t l_index = 0U; l_index < p_batch->count; l_index++) {
+            ((struct ts_pythonInstance *)
+                PyTuple_GET_ITEM(p_batch->sequence, l_index))->busy = false;
+        }
+
+        free(p_batch->instances);
+        Py_DECREF(p_batch->sequence);
+        return 1;
+    }
+
+    return 0;
+}
+
+static void batchRun(struct ts_pythonBatch *p_batch, tf_poolTask p_task) {
+    Py_BEGIN_ALLOW_THREADS
+    poolRun(s_pool, p_task, p_batch, p_batch->count);
+    Py_END_ALLOW_THREADS
+}
+
+static void batchClose(struct ts_pythonBatch *p_batch) {
+    for(size_t l_index = 0U; l_index < p_batch->count; l_index++) {
+        ((struct ts_pythonInstance *)
+            PyTuple_GET_ITEM(p_batch->sequence, l_index))->busy = false;
+    }
+
+    free(p_batch->instances);
+    Py_DECREF(p_batch->sequence);
+}
+
+static void batchRunCycles(void *p_batch, size_t p_index) {
+    struct ts_pythonBatch *l_batch = (struct ts_pythonBatch *)p_batch;
+
+    coreSelectInstance(l_batch->instances[p_index]);
+    coreRunUntil(l_batch->cycles, 0U, NULL);
+    coreSelectInstance(NULL);
+}
+
+static void batchRunFrames(void *p_batch, size_t p_index) {
+    struct ts_pythonBatch *l_batch = (struct ts_pythonBatch *)p_batch;
+
+    coreSelectInstance(l_batch->instances[p_index]);
+
+    for(unsigned long l_frame = 0U; l_frame < l_batch->frames; l_frame++) {
+        coreFrameAdvance();
+    }
+
+    coreSelectInstance(NULL);
+}
+
+static void batchRender(void *p_batch, size_t p_index) {
+    struct ts_pythonBatch *l_batch = (struct ts_pythonBatch *)p_batch;
+
+    coreSelectInstance(l_batch->instances[p_index]);
+    coreRenderVideo(
+        (uint32_t *)&l_batch->buffer[p_index * C_FRAME_SIZE_BYTES],
+        C_SCREEN_WIDTH * sizeof(uint32_t)
+    );
+    coreSelectInstance(NULL);
+}
+
+static PyObject *moduleInit(
+    PyObject *p_module,
+    PyObject *p_args,
+    PyObject *p_kwargs
+) {
+    M_UNUSED_PARAMETER(p_module);
+
+    static char *l_keywords[] = {"flash_rom", "eeprom", "threads", NULL};
+    Py_buffer l_flashRom;
+    Py_buffer l_eeprom;
+    unsigned int l_threadCount = 0U;
+
+    if(
+        !PyArg_ParseTupleAndKeywords(
+            p_args,
+            p_kwargs,
+            "y*y*|I",
+            l_keywords,
+            &l_flashRom,
+            &l_eeprom,
+            &l_threadCount
+        )
+    ) {
+        return NULL;
+    }
+
+    const char *l_error = NULL;
+
+    if(s_pool != NULL) {
+        l_error = "emuwalker.init() was already called";
+    } else if(l_flashRom.len != C_FLASH_ROM_SIZE_BYTES) {
+        l_error = "invalid FLASH ROM size";
+    } else if(l_eeprom.len != C_EEPROM_SIZE_BYTES) {
+        l_error = "invalid EEPROM size";
+    }
+
+    if(l_error == NULL) {
+        // The core keeps pointers to the files, so they are copied.
+        s_flashRom = malloc(C_FLASH_ROM_SIZE_BYTES);
+        s_eeprom = malloc(C_EEPROM_SIZE_BYTES);
+
+        if((s_flashRom == NULL) || (s_eeprom == NULL)) {
+            l_error = "failed to allocate the files";
+        } else {
+            memcpy(s_flashRom, l_flashRom.buf, C_FLASH_ROM_SIZE_BYTES);
+            memcpy(s_eeprom, l_eeprom.buf, C_EEPROM_SIZE_BYTES);
+        }
+    }
+
+    PyBuffer_Release(&l_flashRom);
+    PyBuffer_Release(&l_eeprom);
+
+    if(l_threadCount == 0U) {
+        long l_processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+        if(l_processorCount > 0) {
+            l_threadCount = (unsigned int)l_processorCount;
+        } else {
+            l_threadCount = 1U;
+        }
+    }
+
+    if(l_error != NULL) {
+        PyErr_SetString(PyExc_RuntimeError, l_error);
+        return NULL;
+    }
+
+    if(
+        (corePreinit() != 0)
+        || (coreLoadFile(
+            E_CORE_FILE_FLASH_ROM,
+            s_flashRom,
+            C_FLASH_ROM_SIZE_BYTES
+        ) != 0)
+        || (coreLoadFile(
+            E_CORE_FILE_EEPROM,
+            s_eeprom,
+            C_EEPROM_SIZE_BYTES
+        ) != 0)
+        || (coreInit() != 0)
+    ) {
+        l_error = "failed to initialize the core";
+    } else {
+        s_pool = poolCreate(l_threadCount);
+
+        if(s_pool == NULL) {
+            l_error = "failed to start the threads";
+        }
+    }
+
+    if(l_error != NULL) {
+        PyErr_SetString(PyExc_RuntimeError, l_error);
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *moduleRun(PyObject *p_module, PyObject *p_args) {
+    M_UNUSED_PARAMETER(p_module);
+
+    PyObject *l_instances;
+    unsigned long long l_cycles;
+    struct ts_pythonBatch l_batch;
+
+    if(!PyArg_ParseTuple(p_args, "OK", &l_instances, &l_cycles)) {
+        return NULL;
+    }
+
+    if(batchOpen(l_instances, &l_batch) != 0) {
+        return NULL;
+    }
+
+    // A budget of 0 means no limit for the core.
+    if(l_cycles != 0U) {
+        l_batch.cycles = l_cycles;
+        batchRun(&l_batch, batchRunCycles);
+    }
+
+    batchClose(&l_batch);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *moduleRunFrames(PyObject *p_module, PyObject *p_args) {
+    M_UNUSED_PARAMETER(p_module);
+
+    PyObject *l_instances;
+    unsigned long l_frames;
+    struct ts_pythonBatch l_batch;
+
+    if(!PyArg_ParseTuple(p_args, "Ok", &l_instances, &l_frames)) {
+        return NULL;
+    }
+
+    if(batchOpen(l_instances, &l_batch) != 0) {
+        return NULL;
+    }
+
+    l_batch.frames = l_frames;
+    batchRun(&l_batch, batchRunFrames);
+    batchClose(&l_batch);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *moduleRender(PyObject *p_module, PyObject *p_args) {
+    M_UNUSED_PARAMETER(p_module);
+
+    PyObject *l_instances;
+    Py_buffer l_buffer;
+    struct ts_pythonBatch l_batch;
+
+    if(!PyArg_ParseTuple(p_args, "Ow*", &l_instances, &l_buffer)) {
+        return NULL;
+    }
+
+    if(batchOpen(l_instances, &l_batch) != 0) {
+        PyBuffer_Release(&l_buffer);
+        return NULL;
+    }
+
+    if((size_t)l_buffer.len < l_batch.count * C_FRAME_SIZE_BYTES) {
+        batchClose(&l_batch);
+        PyBuffer_Release(&l_buffer);
+        PyErr_SetString(PyExc_ValueError, "the buffer is too small");
+        return NULL;
+    }
+
+    l_batch.buffer = (uint8_t *)l_buffer.buf;
+    batchRun(&l_batch, batchRender);
+    batchClose(&l_batch);
+    PyBuffer_Release(&l_buffer);
+
+    Py_RETURN_NONE;
+}
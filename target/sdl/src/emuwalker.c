@@ -11,6 +11,11 @@
 #include "common.h"
 #include "core/core.h"
 #include "frontend/frontend.h"
+#include "grid.h"
+#include "host/bootcache.h"
+#include "host/file.h"
+#include "host/recompiler.h"
+#include "host/recorder.h"
 
 // =============================================================================
 // Private constants declaration
@@ -38,6 +43,41 @@ static const char *s_flashRomFilePath;
  */
 static const char *s_eepromFilePath;
 
+/**
+ * @brief This variable stores a pointer to the boot cache directory path, or
+ *        NULL if the boot cache is disabled.
+ */
+static const char *s_bootCacheDirectoryPath;
+
+/**
+ * @brief This variable stores a pointer to the recompiled code directory path,
+ *        or NULL if the FLASH ROM is only interpreted.
+ */
+static const char *s_aotDirectoryPath;
+
+/**
+ * @brief This variable stores a pointer to the name of the accuracy profile,
+ *        or NULL to use the default profile.
+ */
+static const char *s_accuracyName;
+
+/**
+ * @brief This variable stores the number of cycles of the boot sequence.
+ */
+static uint64_t s_bootCycles;
+
+/**
+ * @brief This variable stores the number of instances shown by the grid
+ *        viewer, or 0 to run a single instance in the frontend window.
+ */
+static size_t s_gridInstanceCount;
+
+/**
+ * @brief This variable stores a pointer to the path of the APNG file to record
+ *        the frames to, or NULL if the frames are not recorded.
+ */
+static const char *s_recordFilePath;
+
 // =============================================================================
 // Private functions declarations
 // =============================================================================
@@ -72,19 +112,23 @@ static int loadFlashRom(void);
 static int loadEeprom(void);
 
 /**
- * @brief Reads the given file.
+ * @brief Loads the recompiled code of the FLASH ROM, after building it if the
+ *        recompiled code directory does not contain it yet.
  *
- * @param[in] p_filePath The path to the file to load.
- * @param[out] p_buffer A pointer to the variable that will store the pointer to
- *                      the buffer.
- * @param[in, out] p_size Contains the maximum file size on call, and will
- *                        be replaced by the actual file size on return.
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int loadRecompiledCode(void);
+
+/**
+ * @brief Selects the accuracy profile given on the command line, if any.
  *
  * @returns An integer that indicates the result of the operation.
  * @retval 0 if the operation was successful.
  * @retval Any other value if an error occurred.
  */
-static int readFile(const char *p_filePath, void **p_buffer, size_t *p_size);
+static int selectAccuracy(void);
 
 // =============================================================================
 // Public functions declarations
@@ -117,16 +161,43 @@ int main(int p_argc, const char *p_argv[]) {
         || (loadFlashRom() != 0)
         || (loadEeprom() != 0)
         || (coreInit() != 0)
-        || (frontendInit() != 0)
+        || (selectAccuracy() != 0)
+        || (loadRecompiledCode() != 0)
+        || ((s_gridInstanceCount == 0U) && (frontendInit() != 0))
     ) {
         l_returnValue = EXIT_FAILURE;
     }
 
-    coreReset();
+    if(l_returnValue != EXIT_FAILURE) {
+        if(s_bootCacheDirectoryPath != NULL) {
+            if(bootCacheBoot(s_bootCacheDirectoryPath, s_bootCycles) != 0) {
+                l_returnValue = EXIT_FAILURE;
+            }
+        } else {
+            coreReset();
+        }
+    }
+
+    if((l_returnValue != EXIT_FAILURE) && (s_recordFilePath != NULL)) {
+        // The frontend exits from its event handler, so the recording is
+        // finished when the process exits.
+        if(
+            (recorderStart(s_recordFilePath) != 0)
+            || (atexit(recorderStop) != 0)
+        ) {
+            l_returnValue = EXIT_FAILURE;
+        }
+    }
 
     if(l_returnValue != EXIT_FAILURE) {
-        while(true) {
-            coreStep();
+        if(s_gridInstanceCount != 0U) {
+            if(gridRun(s_gridInstanceCount) != 0) {
+                l_returnValue = EXIT_FAILURE;
+            }
+        } else {
+            while(true) {
+                coreFrameAdvance();
+            }
         }
     }
 
@@ -139,10 +210,22 @@ int main(int p_argc, const char *p_argv[]) {
 static int readCommandLineParameters(int p_argc, const char *p_argv[]) {
     bool l_flagRom = false;
     bool l_flagEeprom = false;
+    bool l_flagBootCache = false;
+    bool l_flagBootCycles = false;
+    bool l_flagAot = false;
+    bool l_flagAccuracy = false;
+    bool l_flagGrid = false;
+    bool l_flagRecord = false;
     int l_returnValue = 0;
 
     s_flashRomFilePath = NULL;
     s_eepromFilePath = NULL;
+    s_bootCacheDirectoryPath = NULL;
+    s_aotDirectoryPath = NULL;
+    s_accuracyName = NULL;
+    s_bootCycles = C_BOOTCACHE_DEFAULT_BOOT_CYCLES;
+    s_gridInstanceCount = 0U;
+    s_recordFilePath = NULL;
 
     for(int l_argIndex = 1; l_argIndex < p_argc; l_argIndex++) {
         if(l_flagRom) {
@@ -151,10 +234,40 @@ static int readCommandLineParameters(int p_argc, const char *p_argv[]) {
         } else if(l_flagEeprom) {
             s_eepromFilePath = p_argv[l_argIndex];
             l_flagEeprom = false;
+        } else if(l_flagBootCache) {
+            s_bootCacheDirectoryPath = p_argv[l_argIndex];
+            l_flagBootCache = false;
+        } else if(l_flagBootCycles) {
+            s_bootCycles = strtoull(p_argv[l_argIndex], NULL, 0);
+            l_flagBootCycles = false;
+        } else if(l_flagAot) {
+            s_aotDirectoryPath = p_argv[l_argIndex];
+            l_flagAot = false;
+        } else if(l_flagAccuracy) {
+            s_accuracyName = p_argv[l_argIndex];
+            l_flagAccuracy = false;
+        } else if(l_flagGrid) {
+            s_gridInstanceCount = strtoul(p_argv[l_argIndex], NULL, 0);
+            l_flagGrid = false;
+        } else if(l_flagRecord) {
+            s_recordFilePath = p_argv[l_argIndex];
+            l_flagRecord = false;
         } else if(strcmp(p_argv[l_argIndex], "--rom") == 0) {
             l_flagRom = true;
         } else if(strcmp(p_argv[l_argIndex], "--eeprom") == 0) {
             l_flagEeprom = true;
+        } else if(strcmp(p_argv[l_argIndex], "--boot-cache") == 0) {
+            l_flagBootCache = true;
+        } else if(strcmp(p_argv[l_argIndex], "--boot-cycles") == 0) {
+            l_flagBootCycles = true;
+        } else if(strcmp(p_argv[l_argIndex], "--aot") == 0) {
+            l_flagAot = true;
+        } else if(strcmp(p_argv[l_argIndex], "--accuracy") == 0) {
+            l_flagAccuracy = true;
+        } else if(strcmp(p_argv[l_argIndex], "--grid") == 0) {
+            l_flagGrid = true;
+        } else if(strcmp(p_argv[l_argIndex], "--record") == 0) {
+            l_flagRecord = true;
         }
     }
 
@@ -164,6 +277,33 @@ static int readCommandLineParameters(int p_argc, const char *p_argv[]) {
     } else if(l_flagEeprom) {
         l_returnValue = 1;
         fprintf(stderr, "Error: expected file path after \"--eeprom\".\n");
+    } else if(l_flagBootCache) {
+        l_returnValue = 1;
+        fprintf(
+            stderr,
+            "Error: expected directory path after \"--boot-cache\".\n"
+        );
+    } else if(l_flagBootCycles) {
+        l_returnValue = 1;
+        fprintf(stderr, "Error: expected number after \"--boot-cycles\".\n");
+    } else if(l_flagAot) {
+        l_returnValue = 1;
+        fprintf(
+            stderr,
+            "Error: expected directory path after \"--aot\".\n"
+        );
+    } else if(l_flagAccuracy) {
+        l_returnValue = 1;
+        fprintf(stderr, "Error: expected profile after \"--accuracy\".\n");
+    } else if(l_flagGrid) {
+        l_returnValue = 1;
+        fprintf(stderr, "Error: expected number after \"--grid\".\n");
+    } else if(l_flagRecord) {
+        l_returnValue = 1;
+        fprintf(stderr, "Error: expected file path after \"--record\".\n");
+    } else if((s_recordFilePath != NULL) && (s_gridInstanceCount != 0U)) {
+        l_returnValue = 1;
+        fprintf(stderr, "Error: --record cannot be used with --grid.\n");
     } else if(s_flashRomFilePath == NULL) {
         l_returnValue = 1;
         fprintf(stderr, "Error: ROM file not specified.\n");
@@ -176,32 +316,26 @@ static int readCommandLineParameters(int p_argc, const char *p_argv[]) {
 }
 
 static int loadFlashRom(void) {
-    void *l_buffer;
-    size_t l_bufferSize = C_FLASH_ROM_SIZE_BYTES;
-
-    if(readFile(s_flashRomFilePath, &l_buffer, &l_bufferSize) != 0) {
-        return 1;
-    }
+    const void *l_buffer;
 
-    if(l_bufferSize != C_FLASH_ROM_SIZE_BYTES) {
-        free(l_buffer);
+    // The mapping is never unmapped: the core keeps a pointer to it.
+    if(fileMap(s_flashRomFilePath, &l_buffer, C_FLASH_ROM_SIZE_BYTES) != 0) {
+        fprintf(stderr, "Error: failed to load the FLASH ROM file.\n");
         return 1;
     }
 
-    int l_returnValue = coreLoadFile(E_CORE_FILE_FLASH_ROM, (uint8_t *)l_buffer, l_bufferSize);
-
-    if(l_returnValue != 0) {
-        free(l_buffer);
-    }
-
-    return l_returnValue;
+    return coreLoadFile(
+        E_CORE_FILE_FLASH_ROM,
+        (const uint8_t *)l_buffer,
+        C_FLASH_ROM_SIZE_BYTES
+    );
 }
 
 static int loadEeprom(void) {
     void *l_buffer;
     size_t l_bufferSize = C_EEPROM_SIZE_BYTES;
 
-    if(readFile(s_eepromFilePath, &l_buffer, &l_bufferSize) != 0) {
+    if(fileRead(s_eepromFilePath, &l_buffer, &l_bufferSize) != 0) {
         return 1;
     }
 
@@ -214,45 +348,46 @@ static int loadEeprom(void) {
     return l_returnValue;
 }
 
-static int readFile(const char *p_filePath, void **p_buffer, size_t *p_size) {
-    FILE *l_file = fopen(p_filePath, "rb");
+static int selectAccuracy(void) {
+    static const char *const l_accuracyNames[E_CORE_ACCURACY_COUNT] = {
+        [E_CORE_ACCURACY_CYCLE_EXACT] = "exact",
+        [E_CORE_ACCURACY_INSTRUCTION] = "instruction",
+        [E_CORE_ACCURACY_FAST] = "fast"
+    };
 
-    // Get file size
-    if(l_file == NULL) {
-        return 1;
+    if(s_accuracyName == NULL) {
+        return 0;
     }
 
-    fseek(l_file, 0L, SEEK_END);
-
-    size_t l_fileSize = ftell(l_file);
-
-    // Compare file size to the maximum file size
-    if(*p_size < l_fileSize) {
-        fclose(l_file);
-        return 1;
+    for(int l_index = 0; l_index < E_CORE_ACCURACY_COUNT; l_index++) {
+        if(strcmp(s_accuracyName, l_accuracyNames[l_index]) == 0) {
+            return coreSetAccuracy((enum te_coreAccuracy)l_index);
+        }
     }
 
-    // Allocate a buffer for reading the file
-    uint8_t *l_buffer = (uint8_t *)malloc(l_fileSize);
-
-    if(l_buffer == NULL) {
-        fclose(l_file);
-        return 1;
-    }
+    fprintf(
+        stderr,
+        "Error: unknown accuracy profile \"%s\".\n",
+        s_accuracyName
+    );
 
-    // Read the file
-    fseek(l_file, 0L, SEEK_SET);
+    return 1;
+}
 
-    if(fread(l_buffer, 1, l_fileSize, l_file) != l_fileSize) {
-        fclose(l_file);
-        free(l_buffer);
-        return 1;
+static int loadRecompiledCode(void) {
+    if(s_aotDirectoryPath == NULL) {
+        return 0;
     }
 
-    fclose(l_file);
+    int l_returnValue = recompilerLoad(s_aotDirectoryPath);
 
-    *p_buffer = (void *)l_buffer;
-    *p_size = l_fileSize;
+    if(l_returnValue == 2) {
+        l_returnValue = recompilerBuild(s_aotDirectoryPath);
 
-    return 0;
+        if(l_returnValue == 0) {
+            l_returnValue = recompilerLoad(s_aotDirectoryPath);
+        }
+    }
+
+    return l_returnValue;
 }
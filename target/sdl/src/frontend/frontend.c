@@ -10,36 +10,61 @@
 
 #include <SDL2/SDL.h>
 
+#include "common.h"
 #include "core/core.h"
 #include "frontend/frontend.h"
 
 // =============================================================================
 // Constants declaration
 // =============================================================================
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-#define C_RGB_MASK_RED 0xff000000
-#define C_RGB_MASK_GREEN 0x00ff0000
-#define C_RGB_MASK_BLUE 0x0000ff00
-#define C_RGB_MASK_ALPHA 0x000000ff
-#define C_RGB_SHIFT_RED 24
-#define C_RGB_SHIFT_GREEN 16
-#define C_RGB_SHIFT_BLUE 8
-#define C_RGB_SHIFT_ALPHA 0
-#else
-#define C_RGB_MASK_RED 0x000000ff
-#define C_RGB_MASK_GREEN 0x0000ff00
-#define C_RGB_MASK_BLUE 0x00ff0000
-#define C_RGB_MASK_ALPHA 0xff000000
-#define C_RGB_SHIFT_RED 0
-#define C_RGB_SHIFT_GREEN 8
-#define C_RGB_SHIFT_BLUE 16
-#define C_RGB_SHIFT_ALPHA 24
-#endif
-
 #define C_PW_SCREEN_WIDTH 96
 #define C_PW_SCREEN_HEIGHT 64
 #define C_PW_SCREEN_SCALE 2
 
+/**
+ * @brief This constant defines the maximum number of frames emulated between
+ *        two waits while the walker sleeps and the display does not change
+ *        (250 ms). Waiting less often lets the host CPU sleep longer.
+ */
+#define C_FRONTEND_SLEEP_FRAMES_PER_WAIT 15U
+
+/**
+ * @brief This constant defines the timeout in milliseconds of each wait for
+ *        an event while the emulation is paused.
+ */
+#define C_FRONTEND_PAUSE_TIMEOUT_MS 1000
+
+/**
+ * @brief This constant defines the sample rate in Hz requested from the audio
+ *        device.
+ */
+#define C_FRONTEND_AUDIO_SAMPLE_RATE_HZ 48000
+
+/**
+ * @brief This constant defines the number of samples that the audio device
+ *        reads at once.
+ */
+#define C_FRONTEND_AUDIO_DEVICE_SAMPLES 512U
+
+/**
+ * @brief This constant defines the size of the audio ring buffer in samples.
+ *        It must be a power of two.
+ */
+#define C_FRONTEND_AUDIO_BUFFER_SAMPLES 16384U
+
+/**
+ * @brief This constant defines the number of buffered samples that the
+ *        emulation waits for before it runs the next frame, about 43 ms at
+ *        48 kHz.
+ */
+#define C_FRONTEND_AUDIO_TARGET_FILL 2048U
+
+/**
+ * @brief This constant defines the maximum deviation of the sample rate from
+ *        the rate of the audio device, in 1/10000 (0.5%).
+ */
+#define C_FRONTEND_AUDIO_MAX_RATE_DELTA 50
+
 // =============================================================================
 // Private variables declarations
 // =============================================================================
@@ -49,16 +74,180 @@
 static SDL_Window *s_window;
 
 /**
- * @brief This variable stores the pointer to the SDL_Surface object that
- *        contains the framebuffer of the window.
+ * @brief This variable stores the pointer to the SDL_Renderer object of the
+ *        window, which scales the frames to the window size.
+ */
+static SDL_Renderer *s_renderer;
+
+/**
+ * @brief This variable stores the pointer to the streaming SDL_Texture object
+ *        that the core renders its frames into.
+ */
+static SDL_Texture *s_texture;
+
+/**
+ * @brief This variable stores whether the emulation is paused by the user.
+ */
+static bool s_paused;
+
+/**
+ * @brief This variable stores whether the walker executed a SLEEP instruction
+ *        since the last VBlank.
+ */
+static bool s_asleep;
+
+/**
+ * @brief This variable stores the number of frames emulated since the last
+ *        wait.
+ */
+static unsigned int s_framesSinceWait;
+
+/**
+ * @brief This variable stores the hash of the last frame presented (see
+ *        coreGetVideoHash()).
+ */
+static uint64_t s_presentedVideoHash;
+
+/**
+ * @brief This variable stores the value of the core cycle counter at the last
+ *        VBlank.
+ */
+static uint64_t s_lastVBlankCycles;
+
+/**
+ * @brief This variable stores the value of the performance counter at which
+ *        the emulation catches up with real time.
+ */
+static uint64_t s_deadline;
+
+/**
+ * @brief This variable stores the ID of the audio device, or 0 if no audio
+ *        device is open.
+ */
+static SDL_AudioDeviceID s_audioDevice;
+
+/**
+ * @brief This variable stores the sample rate of the audio device in Hz.
  */
-static SDL_Surface *s_windowSurface;
+static int s_audioSampleRate;
 
 /**
- * @brief This variable stores the pointer to the SDL_Surface object that
- *        stores the video output of the core converted to SDL_Surface format.
+ * @brief This variable stores the ring buffer of samples between the core and
+ *        the audio callback.
  */
-static SDL_Surface *s_bufferSurface;
+static int16_t s_audioBuffer[C_FRONTEND_AUDIO_BUFFER_SAMPLES];
+
+/**
+ * @brief These variables store the number of samples read from and written
+ *        to the ring buffer since it was created. The core only writes
+ *        s_audioWriteIndex and the audio callback only writes
+ *        s_audioReadIndex, so the buffer needs no lock.
+ */
+static uint32_t s_audioReadIndex;
+static uint32_t s_audioWriteIndex;
+
+// =============================================================================
+// Private functions declarations
+// =============================================================================
+/**
+ * @brief Displays the video frame output by the core when it enters VBlank
+ *        state, and processes the window events.
+ *
+ * @param[in] p_event The event (always E_CORE_EVENT_VBLANK).
+ * @param[in] p_data Unused.
+ * @param[in] p_context Unused.
+ */
+static void frontendOnVBlank(
+    enum te_coreEvent p_event,
+    const void *p_data,
+    void *p_context
+);
+
+/**
+ * @brief Notes that the walker executed a SLEEP instruction.
+ *
+ * @param[in] p_event The event (always E_CORE_EVENT_SLEEP).
+ * @param[in] p_data Unused.
+ * @param[in] p_context Unused.
+ */
+static void frontendOnSleep(
+    enum te_coreEvent p_event,
+    const void *p_data,
+    void *p_context
+);
+
+/**
+ * @brief Writes the samples output by the core to the ring buffer. The
+ *        samples that do not fit are dropped.
+ *
+ * @param[in] p_event The event (always E_CORE_EVENT_AUDIO).
+ * @param[in] p_data The samples, as a struct ts_coreAudioEvent.
+ * @param[in] p_context Unused.
+ */
+static void frontendOnAudio(
+    enum te_coreEvent p_event,
+    const void *p_data,
+    void *p_context
+);
+
+/**
+ * @brief Fills the buffer of the audio device from the ring buffer. This
+ *        function is called by SDL on the audio thread. Silence is output if
+ *        the ring buffer runs empty.
+ *
+ * @param[in] p_userData Unused.
+ * @param[out] p_stream The buffer to fill.
+ * @param[in] p_length The size of the buffer in bytes.
+ */
+static void frontendAudioCallback(
+    void *p_userData,
+    Uint8 *p_stream,
+    int p_length
+);
+
+/**
+ * @brief Opens the audio device and listens to the audio event of the core.
+ *        The emulation is paced by the host timer if this fails.
+ */
+static void frontendInitAudio(void);
+
+/**
+ * @brief Returns the number of samples in the ring buffer.
+ *
+ * @returns The number of samples in the ring buffer.
+ */
+static uint32_t frontendGetAudioFill(void);
+
+/**
+ * @brief Adjusts the sample rate of the core from the number of samples in
+ *        the ring buffer, so that the core produces samples exactly as fast
+ *        as the audio device consumes them.
+ */
+static void frontendUpdateAudioRate(void);
+
+/**
+ * @brief Renders the frame displayed by the core and presents it.
+ */
+static void frontendPresent(void);
+
+/**
+ * @brief Blocks until the emulation is behind real time, while processing
+ *        the window events. Real time is given by the audio device when it
+ *        is open, and by the host timer otherwise. Nothing is emulated while
+ *        the emulation is paused. The wait ends early when a button of the
+ *        walker changes.
+ */
+static void frontendWait(void);
+
+/**
+ * @brief Processes a window event.
+ *
+ * @param[in] p_event The event to process.
+ *
+ * @returns A boolean value that indicates whether a button of the walker
+ *          changed.
+ */
+static bool frontendProcessEvent(const SDL_Event *p_event);
 
 // =============================================================================
 // Public functions definitions
@@ -98,85 +287,405 @@ int frontendInit(void) {
         return 1;
     }
 
-    // Create buffer surface
-    s_bufferSurface = SDL_CreateRGBSurface(
-        SDL_SWSURFACE,
-        C_PW_SCREEN_WIDTH,
-        C_PW_SCREEN_HEIGHT,
-        32,
-        C_RGB_MASK_RED,
-        C_RGB_MASK_GREEN,
-        C_RGB_MASK_BLUE,
-        C_RGB_MASK_ALPHA
-    );
+    // Create renderer
+    s_renderer = SDL_CreateRenderer(s_window, -1, 0);
 
-    if(s_bufferSurface == NULL) {
+    if(s_renderer == NULL) {
         fprintf(
             stderr,
-            "SDL_CreateRGBSurface returned error: %s\n",
+            "SDL_CreateRenderer() returned error: %s\n",
             SDL_GetError()
         );
 
         return 1;
     }
 
-    // Get window surface
-    s_windowSurface = SDL_GetWindowSurface(s_window);
+    // Scale the frames without filtering, keeping the aspect ratio
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+    SDL_RenderSetLogicalSize(s_renderer, C_PW_SCREEN_WIDTH, C_PW_SCREEN_HEIGHT);
 
-    if(s_windowSurface == NULL) {
+    // Create streaming texture. The core writes R, G, B, A bytes.
+    s_texture = SDL_CreateTexture(
+        s_renderer,
+        SDL_PIXELFORMAT_RGBA32,
+        SDL_TEXTUREACCESS_STREAMING,
+        C_PW_SCREEN_WIDTH,
+        C_PW_SCREEN_HEIGHT
+    );
+
+    if(s_texture == NULL) {
         fprintf(
             stderr,
-            "SDL_GetWindowSurface returned error: %s\n",
+            "SDL_CreateTexture() returned error: %s\n",
             SDL_GetError()
         );
 
         return 1;
     }
 
+    // Listen to the VBlank event of the core
+    if(
+        coreAddEventListener(E_CORE_EVENT_VBLANK, frontendOnVBlank, NULL)
+        != 0
+    ) {
+        fprintf(stderr, "Error: failed to add the VBlank listener.\n");
+        return 1;
+    }
+
+    if(coreAddEventListener(E_CORE_EVENT_SLEEP, frontendOnSleep, NULL) != 0) {
+        fprintf(stderr, "Error: failed to add the sleep listener.\n");
+        return 1;
+    }
+
+    s_paused = false;
+    s_asleep = false;
+    s_framesSinceWait = 0U;
+    s_presentedVideoHash = 0U;
+    s_lastVBlankCycles = coreGetCycles();
+    s_deadline = SDL_GetPerformanceCounter();
+
+    frontendInitAudio();
+
     return 0;
 }
 
-void frontendOnVBlank(void) {
-    // Get the pointer to the core video buffer
-    const uint32_t *l_coreFramebuffer = coreGetVideoBuffer();
+// =============================================================================
+// Private functions definitions
+// =============================================================================
+static void frontendOnVBlank(
+    enum te_coreEvent p_event,
+    const void *p_data,
+    void *p_context
+) {
+    M_UNUSED_PARAMETER(p_event);
+    M_UNUSED_PARAMETER(p_data);
+    M_UNUSED_PARAMETER(p_context);
+
+    // The emulation is due in real time once the cycles of the frame elapsed.
+    uint64_t l_cycles = coreGetCycles();
+
+    s_deadline += (l_cycles - s_lastVBlankCycles)
+        * SDL_GetPerformanceFrequency() / C_CORE_CLOCK_RATE_HZ;
+    s_lastVBlankCycles = l_cycles;
+    s_framesSinceWait++;
+
+    // While the walker sleeps, the frames that leave the display unchanged
+    // are emulated without waiting, so that the host CPU is woken up less
+    // often. A frame that changes the display is always presented on time.
+    bool l_asleep = s_asleep;
+
+    s_asleep = false;
+
+    if(
+        l_asleep
+        && !s_paused
+        && (s_framesSinceWait < C_FRONTEND_SLEEP_FRAMES_PER_WAIT)
+        && (coreGetVideoHash() == s_presentedVideoHash)
+    ) {
+        return;
+    }
+
+    s_framesSinceWait = 0U;
+    frontendPresent();
+    frontendWait();
+}
+
+static void frontendOnSleep(
+    enum te_coreEvent p_event,
+    const void *p_data,
+    void *p_context
+) {
+    M_UNUSED_PARAMETER(p_event);
+    M_UNUSED_PARAMETER(p_data);
+    M_UNUSED_PARAMETER(p_context);
+
+    s_asleep = true;
+}
+
+static void frontendOnAudio(
+    enum te_coreEvent p_event,
+    const void *p_data,
+    void *p_context
+) {
+    M_UNUSED_PARAMETER(p_event);
+    M_UNUSED_PARAMETER(p_context);
 
-    // Copy the core video buffer to the SDL surface
-    memcpy(
-        s_bufferSurface->pixels,
-        l_coreFramebuffer,
-        C_PW_SCREEN_WIDTH * C_PW_SCREEN_HEIGHT * 4
+    const struct ts_coreAudioEvent *l_event = p_data;
+    uint32_t l_readIndex = __atomic_load_n(&s_audioReadIndex, __ATOMIC_ACQUIRE);
+    uint32_t l_writeIndex = s_audioWriteIndex;
+    size_t l_free = C_FRONTEND_AUDIO_BUFFER_SAMPLES
+        - (l_writeIndex - l_readIndex);
+    size_t l_count = l_event->sampleCount;
+
+    if(l_count > l_free) {
+        l_count = l_free;
+    }
+
+    for(size_t l_index = 0U; l_index < l_count; l_index++) {
+        s_audioBuffer[(l_writeIndex + l_index)
+            & (C_FRONTEND_AUDIO_BUFFER_SAMPLES - 1U)] =
+            l_event->samples[l_index];
+    }
+
+    __atomic_store_n(
+        &s_audioWriteIndex,
+        l_writeIndex + l_count,
+        __ATOMIC_RELEASE
     );
+}
+
+static void frontendAudioCallback(
+    void *p_userData,
+    Uint8 *p_stream,
+    int p_length
+) {
+    M_UNUSED_PARAMETER(p_userData);
+
+    int16_t *l_samples = (int16_t *)p_stream;
+    size_t l_sampleCount = (size_t)p_length / sizeof(int16_t);
+    uint32_t l_readIndex = s_audioReadIndex;
+    uint32_t l_writeIndex =
+        __atomic_load_n(&s_audioWriteIndex, __ATOMIC_ACQUIRE);
+    size_t l_count = l_writeIndex - l_readIndex;
+
+    if(l_count > l_sampleCount) {
+        l_count = l_sampleCount;
+    }
+
+    for(size_t l_index = 0U; l_index < l_count; l_index++) {
+        l_samples[l_index] = s_audioBuffer[(l_readIndex + l_index)
+            & (C_FRONTEND_AUDIO_BUFFER_SAMPLES - 1U)];
+    }
 
-    // Blit the buffer to the window
-    SDL_BlitScaled(
-        s_bufferSurface,
+    for(size_t l_index = l_count; l_index < l_sampleCount; l_index++) {
+        l_samples[l_index] = 0;
+    }
+
+    __atomic_store_n(
+        &s_audioReadIndex,
+        l_readIndex + l_count,
+        __ATOMIC_RELEASE
+    );
+}
+
+static void frontendInitAudio(void) {
+    SDL_AudioSpec l_desired;
+    SDL_AudioSpec l_obtained;
+
+    s_audioDevice = 0U;
+    s_audioReadIndex = 0U;
+    s_audioWriteIndex = 0U;
+
+    if(SDL_InitSubSystem(SDL_INIT_AUDIO) != 0) {
+        fprintf(
+            stderr,
+            "Warning: SDL_InitSubSystem() returned error: %s\n",
+            SDL_GetError()
+        );
+
+        return;
+    }
+
+    memset(&l_desired, 0, sizeof(l_desired));
+    l_desired.freq = C_FRONTEND_AUDIO_SAMPLE_RATE_HZ;
+    l_desired.format = AUDIO_S16SYS;
+    l_desired.channels = 1;
+    l_desired.samples = C_FRONTEND_AUDIO_DEVICE_SAMPLES;
+    l_desired.callback = frontendAudioCallback;
+
+    // The rate of the device may differ, the core produces samples at any rate
+    s_audioDevice = SDL_OpenAudioDevice(
         NULL,
-        s_windowSurface,
-        NULL
+        0,
+        &l_desired,
+        &l_obtained,
+        SDL_AUDIO_ALLOW_FREQUENCY_CHANGE
+    );
+
+    if(s_audioDevice == 0U) {
+        fprintf(
+            stderr,
+            "Warning: SDL_OpenAudioDevice() returned error: %s\n",
+            SDL_GetError()
+        );
+
+        return;
+    }
+
+    s_audioSampleRate = l_obtained.freq;
+
+    if(
+        (coreSetAudioSampleRate(s_audioSampleRate) != 0)
+        || (coreAddEventListener(E_CORE_EVENT_AUDIO, frontendOnAudio, NULL)
+            != 0)
+    ) {
+        fprintf(stderr, "Warning: failed to add the audio listener.\n");
+        SDL_CloseAudioDevice(s_audioDevice);
+        s_audioDevice = 0U;
+        return;
+    }
+
+    SDL_PauseAudioDevice(s_audioDevice, 0);
+}
+
+static uint32_t frontendGetAudioFill(void) {
+    return __atomic_load_n(&s_audioWriteIndex, __ATOMIC_ACQUIRE)
+        - __atomic_load_n(&s_audioReadIndex, __ATOMIC_ACQUIRE);
+}
+
+static void frontendUpdateAudioRate(void) {
+    // The further the buffer is from the target, the more the rate deviates
+    // from the rate of the device, within a range that cannot be heard.
+    int64_t l_error =
+        (int64_t)C_FRONTEND_AUDIO_TARGET_FILL - frontendGetAudioFill();
+    int64_t l_delta = l_error * C_FRONTEND_AUDIO_MAX_RATE_DELTA
+        / (int64_t)C_FRONTEND_AUDIO_TARGET_FILL;
+
+    if(l_delta > C_FRONTEND_AUDIO_MAX_RATE_DELTA) {
+        l_delta = C_FRONTEND_AUDIO_MAX_RATE_DELTA;
+    } else if(l_delta < -C_FRONTEND_AUDIO_MAX_RATE_DELTA) {
+        l_delta = -C_FRONTEND_AUDIO_MAX_RATE_DELTA;
+    }
+
+    coreSetAudioSampleRate(
+        s_audioSampleRate + s_audioSampleRate * l_delta / 10000
     );
+}
+
+static void frontendPresent(void) {
+    // Render the frame directly into the texture
+    void *l_pixels;
+    int l_pitch;
 
-    // Refresh the window
-    SDL_UpdateWindowSurface(s_window);
+    if(SDL_LockTexture(s_texture, NULL, &l_pixels, &l_pitch) == 0) {
+        coreRenderVideo(l_pixels, (size_t)l_pitch);
+        SDL_UnlockTexture(s_texture);
+    }
 
-    // Process events
+    // Scale the texture to the window and present it
+    SDL_RenderClear(s_renderer);
+    SDL_RenderCopy(s_renderer, s_texture, NULL, NULL);
+    SDL_RenderPresent(s_renderer);
+
+    s_presentedVideoHash = coreGetVideoHash();
+}
+
+static void frontendWait(void) {
     SDL_Event l_event;
+    bool l_wakeUp = false;
 
+    // Process the pending events first, so that pausing takes effect now
     while(SDL_PollEvent(&l_event) != 0) {
-        switch(l_event.type) {
-            case SDL_WINDOWEVENT:
-                switch(l_event.window.type) {
-                    case SDL_WINDOWEVENT_CLOSE:
-                        exit(0);
-                        break;
-
-                    default:
-                        break;
-                }
+        l_wakeUp = frontendProcessEvent(&l_event) || l_wakeUp;
+    }
 
-                break;
+    while(!l_wakeUp) {
+        uint64_t l_now = SDL_GetPerformanceCounter();
+        int l_timeout;
 
-            default:
+        if(s_paused) {
+            l_timeout = C_FRONTEND_PAUSE_TIMEOUT_MS;
+        } else if(s_audioDevice != 0U) {
+            // Wait until the audio device consumed the samples above the
+            // target, rounding up.
+            uint32_t l_fill = frontendGetAudioFill();
+
+            if(l_fill <= C_FRONTEND_AUDIO_TARGET_FILL) {
                 break;
+            }
+
+            l_timeout = (int)(
+                ((l_fill - C_FRONTEND_AUDIO_TARGET_FILL) * 1000U
+                    + s_audioSampleRate - 1U)
+                / s_audioSampleRate
+            );
+        } else if(l_now >= s_deadline) {
+            break;
+        } else {
+            // Round up, so that the wait does not end just before the deadline
+            uint64_t l_frequency = SDL_GetPerformanceFrequency();
+
+            l_timeout = (int)(
+                ((s_deadline - l_now) * 1000U + l_frequency - 1U) / l_frequency
+            );
+        }
+
+        if(SDL_WaitEventTimeout(&l_event, l_timeout) != 0) {
+            l_wakeUp = frontendProcessEvent(&l_event);
         }
     }
+
+    // The time spent paused, asleep ahead of time or on a slow host is not
+    // caught up on.
+    uint64_t l_now = SDL_GetPerformanceCounter();
+
+    if(l_wakeUp || (l_now > s_deadline)) {
+        s_deadline = l_now;
+    }
+
+    if(s_audioDevice != 0U) {
+        frontendUpdateAudioRate();
+    }
+}
+
+static bool frontendProcessEvent(const SDL_Event *p_event) {
+    enum te_coreInput l_input;
+
+    switch(p_event->type) {
+        case SDL_QUIT:
+            exit(0);
+            break;
+
+        case SDL_WINDOWEVENT:
+            if(p_event->window.event == SDL_WINDOWEVENT_CLOSE) {
+                exit(0);
+            }
+
+            return false;
+
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            break;
+
+        default:
+            return false;
+    }
+
+    switch(p_event->key.keysym.sym) {
+        case SDLK_p:
+            if((p_event->type == SDL_KEYDOWN) && (p_event->key.repeat == 0)) {
+                s_paused = !s_paused;
+
+                if(s_audioDevice != 0U) {
+                    SDL_PauseAudioDevice(s_audioDevice, s_paused ? 1 : 0);
+                }
+            }
+
+            return false;
+
+        case SDLK_LEFT:
+            l_input = E_CORE_INPUT_LEFT;
+            break;
+
+        case SDLK_DOWN:
+            l_input = E_CORE_INPUT_MIDDLE;
+            break;
+
+        case SDLK_RIGHT:
+            l_input = E_CORE_INPUT_RIGHT;
+            break;
+
+        default:
+            return false;
+    }
+
+    coreSetInput(
+        l_input,
+        (p_event->type == SDL_KEYDOWN)
+            ? E_CORE_INPUT_PRESSED
+            : E_CORE_INPUT_RELEASED
+    );
+
+    // The buttons are only applied while the emulation runs
+    return !s_paused;
 }
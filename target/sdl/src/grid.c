@@ -0,0 +1,538 @@
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL2/SDL.h>
+
+#include "core/core.h"
+#include "host/pool.h"
+#include "grid.h"
+
+// =============================================================================
+// Private constant declarations
+// =============================================================================
+#define C_GRID_TILE_WIDTH 96
+#define C_GRID_TILE_HEIGHT 64
+
+/**
+ * @brief This constant defines the number of times per second that the
+ *        instances are sampled and the window is refreshed.
+ */
+#define C_GRID_REFRESH_RATE_HZ 10U
+
+/**
+ * @brief This constant defines the number of cycles that every instance runs
+ *        for between two refreshes.
+ */
+#define C_GRID_CYCLES_PER_REFRESH \
+    (C_CORE_CLOCK_RATE_HZ / C_GRID_REFRESH_RATE_HZ)
+
+// =============================================================================
+// Private type declarations
+// =============================================================================
+/**
+ * @brief This structure contains a tile of the grid.
+ */
+struct ts_gridTile {
+    struct ts_coreInstance *instance;
+
+    /**
+     * @brief This member contains the hash of the frame in the texture, so
+     *        that unchanged frames are not uploaded again.
+     */
+    uint64_t videoHash;
+
+    /**
+     * @brief This member contains the hash of the frame of the instance after
+     *        its last run.
+     */
+    uint64_t runVideoHash;
+
+    /**
+     * @brief This member indicates whether the texture contains a frame of
+     *        the instance.
+     */
+    bool uploaded;
+};
+
+/**
+ * @brief This structure contains the data of the grid viewer.
+ */
+struct ts_gridContext {
+    struct ts_gridTile *tiles;
+    size_t tileCount;
+    int columnCount;
+    int rowCount;
+    SDL_Window *window;
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;
+
+    /**
+     * @brief This member contains the threads that run the instances, one per
+     *        host processor.
+     */
+    struct ts_pool *pool;
+
+    /**
+     * @brief This member contains the index of the tile whose button is
+     *        pressed with the mouse, or tileCount if no button is pressed.
+     */
+    size_t pressedTile;
+
+    enum te_coreInput pressedInput;
+
+    /**
+     * @brief This member contains the value of the performance counter at
+     *        which the next refresh is due.
+     */
+    uint64_t deadline;
+};
+
+// =============================================================================
+// Private function declarations
+// =============================================================================
+/**
+ * @brief Creates the instances of the grid from the state of the current
+ *        instance.
+ *
+ * @param[in,out] p_context The grid viewer.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int gridCreateInstances(struct ts_gridContext *p_context);
+
+/**
+ * @brief Creates the window, its renderer, and the texture that contains all
+ *        the tiles.
+ *
+ * @param[in,out] p_context The grid viewer.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the operation was successful.
+ * @retval Any other value if an error occurred.
+ */
+static int gridInitVideo(struct ts_gridContext *p_context);
+
+/**
+ * @brief Runs every instance until the next refresh on the threads of the
+ *        pool, and uploads the frames that changed to the texture.
+ *
+ * @param[in,out] p_context The grid viewer.
+ */
+static void gridUpdateTiles(struct ts_gridContext *p_context);
+
+/**
+ * @brief Runs the instance of a tile until the next refresh, and saves the
+ *        hash of its frame. This function is run by the threads of the pool.
+ *
+ * @param[in,out] p_context A pointer to the ts_gridContext structure.
+ * @param[in] p_index The index of the tile.
+ */
+static void gridRunTile(void *p_context, size_t p_index);
+
+/**
+ * @brief Blocks until the next refresh is due, while processing the window
+ *        events.
+ *
+ * @param[in,out] p_context The grid viewer.
+ *
+ * @returns A boolean value that indicates whether the window is still open.
+ */
+static bool gridWait(struct ts_gridContext *p_context);
+
+/**
+ * @brief Processes a window event.
+ *
+ * @param[in,out] p_context The grid viewer.
+ * @param[in] p_event The event to process.
+ *
+ * @returns A boolean value that indicates whether the window is still open.
+ */
+static bool gridProcessEvent(
+    struct ts_gridContext *p_context,
+    const SDL_Event *p_event
+);
+
+/**
+ * @brief Destroys the instances and the window of the grid viewer.
+ *
+ * @param[in,out] p_context The grid viewer.
+ */
+static void gridDestroy(struct ts_gridContext *p_context);
+
+// =============================================================================
+// Public function definitions
+// =============================================================================
+int gridRun(size_t p_instanceCount) {
+    struct ts_coreInstance *l_callerInstance = coreGetInstance();
+    struct ts_gridContext l_context = {
+        .tiles = NULL,
+        .tileCount = p_instanceCount,
+        .window = NULL,
+        .renderer = NULL,
+        .texture = NULL,
+        .pool = NULL,
+        .pressedTile = p_instanceCount
+    };
+
+    if((p_instanceCount == 0U) || (p_instanceCount > C_GRID_MAX_INSTANCES)) {
+        fprintf(
+            stderr,
+            "Error: the grid must have 1 to %u instances.\n",
+            C_GRID_MAX_INSTANCES
+        );
+
+        return 1;
+    }
+
+    // The grid is as square as possible.
+    l_context.columnCount = 1;
+
+    while(
+        ((size_t)l_context.columnCount * (size_t)l_context.columnCount)
+        < p_instanceCount
+    ) {
+        l_context.columnCount++;
+    }
+
+    l_context.rowCount = (int)(
+        (p_instanceCount + (size_t)l_context.columnCount - 1U)
+        / (size_t)l_context.columnCount
+    );
+
+    int l_returnValue = gridCreateInstances(&l_context);
+
+    if(l_returnValue == 0) {
+        int l_processorCount = SDL_GetCPUCount();
+        unsigned int l_threadCount = (l_processorCount > 1)
+            ? (unsigned int)l_processorCount : 1U;
+
+        if(l_threadCount > p_instanceCount) {
+            l_threadCount = (unsigned int)p_instanceCount;
+        }
+
+        l_context.pool = poolCreate(l_threadCount);
+
+        if(l_context.pool == NULL) {
+            fprintf(stderr, "Error: failed to create the grid threads.\n");
+            l_returnValue = 1;
+        }
+    }
+
+    if(l_returnValue == 0) {
+        l_returnValue = gridInitVideo(&l_context);
+    }
+
+    if(l_returnValue == 0) {
+        l_context.deadline = SDL_GetPerformanceCounter();
+
+        do {
+            gridUpdateTiles(&l_context);
+            SDL_RenderClear(l_context.renderer);
+            SDL_RenderCopy(l_context.renderer, l_context.texture, NULL, NULL);
+            SDL_RenderPresent(l_context.renderer);
+        } while(gridWait(&l_context));
+    }
+
+    gridDestroy(&l_context);
+    coreSelectInstance(l_callerInstance);
+
+    return l_returnValue;
+}
+
+// =============================================================================
+// Private function definitions
+// =============================================================================
+static int gridCreateInstances(struct ts_gridContext *p_context) {
+    size_t l_stateSize = coreGetStateSize();
+    uint8_t *l_state = (uint8_t *)malloc(l_stateSize);
+    int l_returnValue = 0;
+
+    p_context->tiles =
+        calloc(p_context->tileCount, sizeof(struct ts_gridTile));
+
+    if(
+        (l_state == NULL)
+        || (p_context->tiles == NULL)
+        || (coreSaveState(l_state, l_stateSize) != 0)
+    ) {
+        fprintf(stderr, "Error: failed to allocate the grid.\n");
+        l_returnValue = 1;
+    }
+
+    struct ts_coreInstance *l_callerInstance = coreGetInstance();
+
+    for(
+        size_t l_index = 0U;
+        (l_returnValue == 0) && (l_index < p_context->tileCount);
+        l_index++
+    ) {
+        struct ts_gridTile *l_tile = &p_context->tiles[l_index];
+
+        l_tile->instance = coreCreateInstance();
+
+        if(l_tile->instance == NULL) {
+            l_returnValue = 1;
+            break;
+        }
+
+        coreSelectInstance(l_tile->instance);
+        l_returnValue = coreLoadState(l_state, l_stateSize);
+    }
+
+    coreSelectInstance(l_callerInstance);
+    free(l_state);
+
+    return l_returnValue;
+}
+
+static int gridInitVideo(struct ts_gridContext *p_context) {
+    int l_width = p_context->columnCount * C_GRID_TILE_WIDTH;
+    int l_height = p_context->rowCount * C_GRID_TILE_HEIGHT;
+
+    if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) != 0) {
+        fprintf(stderr, "SDL_Init() returned error: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    p_context->window = SDL_CreateWindow(
+        "Pokéwalker grid",
+        SDL_WINDOWPOS_UNDEFINED,
+        SDL_WINDOWPOS_UNDEFINED,
+        l_width,
+        l_height,
+        SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE
+    );
+
+    if(p_context->window == NULL) {
+        fprintf(
+            stderr,
+            "SDL_CreateWindow() returned error: %s\n",
+            SDL_GetError()
+        );
+
+        return 1;
+    }
+
+    p_context->renderer = SDL_CreateRenderer(p_context->window, -1, 0);
+
+    if(p_context->renderer == NULL) {
+        fprintf(
+            stderr,
+            "SDL_CreateRenderer() returned error: %s\n",
+            SDL_GetError()
+        );
+
+        return 1;
+    }
+
+    // The logical size also converts the mouse coordinates to texture pixels.
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+    SDL_RenderSetLogicalSize(p_context->renderer, l_width, l_height);
+
+    p_context->texture = SDL_CreateTexture(
+        p_context->renderer,
+        SDL_PIXELFORMAT_RGBA32,
+        SDL_TEXTUREACCESS_STREAMING,
+        l_width,
+        l_height
+    );
+
+    if(p_context->texture == NULL) {
+        fprintf(
+            stderr,
+            "SDL_CreateTexture() returned error: %s\n",
+            SDL_GetError()
+        );
+
+        return 1;
+    }
+
+    return 0;
+}
+
+static void gridUpdateTiles(struct ts_gridContext *p_context) {
+    struct ts_coreInstance *l_callerInstance = coreGetInstance();
+
+    poolRun(p_context->pool, gridRunTile, p_context, p_context->tileCount);
+
+    for(size_t l_index = 0U; l_index < p_context->tileCount; l_index++) {
+        struct ts_gridTile *l_tile = &p_context->tiles[l_index];
+
+        if(l_tile->uploaded && (l_tile->runVideoHash == l_tile->videoHash)) {
+            continue;
+        }
+
+        // Only the rectangle of the tile is locked and rendered into.
+        SDL_Rect l_rect = {
+            .x = (int)(l_index % (size_t)p_context->columnCount)
+                * C_GRID_TILE_WIDTH,
+            .y = (int)(l_index / (size_t)p_context->columnCount)
+                * C_GRID_TILE_HEIGHT,
+            .w = C_GRID_TILE_WIDTH,
+            .h = C_GRID_TILE_HEIGHT
+        };
+        void *l_pixels;
+        int l_pitch;
+        int l_result =
+            SDL_LockTexture(p_context->texture, &l_rect, &l_pixels, &l_pitch);
+
+        if(l_result == 0) {
+            coreSelectInstance(l_tile->instance);
+            coreRenderVideo(l_pixels, (size_t)l_pitch);
+            SDL_UnlockTexture(p_context->texture);
+            l_tile->videoHash = l_tile->runVideoHash;
+            l_tile->uploaded = true;
+        }
+    }
+
+    coreSelectInstance(l_callerInstance);
+}
+
+static void gridRunTile(void *p_context, size_t p_index) {
+    struct ts_gridContext *l_context = (struct ts_gridContext *)p_context;
+    struct ts_gridTile *l_tile = &l_context->tiles[p_index];
+    struct ts_coreInstance *l_previousInstance = coreGetInstance();
+    enum te_coreEvent l_reason;
+
+    coreSelectInstance(l_tile->instance);
+    coreRunUntil(C_GRID_CYCLES_PER_REFRESH, 0U, &l_reason);
+    l_tile->runVideoHash = coreGetVideoHash();
+    coreSelectInstance(l_previousInstance);
+}
+
+static bool gridWait(struct ts_gridContext *p_context) {
+    uint64_t l_frequency = SDL_GetPerformanceFrequency();
+    SDL_Event l_event;
+
+    p_context->deadline += l_frequency / C_GRID_REFRESH_RATE_HZ;
+
+    while(true) {
+        uint64_t l_now = SDL_GetPerformanceCounter();
+
+        if(l_now >= p_context->deadline) {
+            // A refresh that took too long is not caught up on.
+            p_context->deadline = l_now;
+            break;
+        }
+
+        // Round up, so that the wait does not end just before the deadline
+        int l_timeout = (int)(
+            ((p_context->deadline - l_now) * 1000U + l_frequency - 1U)
+            / l_frequency
+        );
+
+        if(
+            (SDL_WaitEventTimeout(&l_event, l_timeout) != 0)
+            && !gridProcessEvent(p_context, &l_event)
+        ) {
+            return false;
+        }
+    }
+
+    while(SDL_PollEvent(&l_event) != 0) {
+        if(!gridProcessEvent(p_context, &l_event)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool gridProcessEvent(
+    struct ts_gridContext *p_context,
+    const SDL_Event *p_event
+) {
+    struct ts_coreInstance *l_callerInstance = coreGetInstance();
+    int l_column;
+    size_t l_tileIndex;
+
+    switch(p_event->type) {
+        case SDL_QUIT:
+            return false;
+
+        case SDL_WINDOWEVENT:
+            return p_event->window.event != SDL_WINDOWEVENT_CLOSE;
+
+        case SDL_MOUSEBUTTONDOWN:
+            if(
+                (p_event->button.x < 0)
+                || (p_event->button.y < 0)
+                || (p_context->pressedTile != p_context->tileCount)
+            ) {
+                break;
+            }
+
+            l_column = p_event->button.x / C_GRID_TILE_WIDTH;
+            l_tileIndex = (size_t)(p_event->button.y / C_GRID_TILE_HEIGHT)
+                * (size_t)p_context->columnCount + (size_t)l_column;
+
+            if(
+                (l_column >= p_context->columnCount)
+                || (l_tileIndex >= p_context->tileCount)
+            ) {
+                break;
+            }
+
+            // The tile is split in three buttons from left to right.
+            p_context->pressedTile = l_tileIndex;
+            p_context->pressedInput = (enum te_coreInput)(
+                (p_event->button.x % C_GRID_TILE_WIDTH) * 3 / C_GRID_TILE_WIDTH
+            );
+            coreSelectInstance(p_context->tiles[l_tileIndex].instance);
+            coreSetInput(p_context->pressedInput, E_CORE_INPUT_PRESSED);
+            coreSelectInstance(l_callerInstance);
+            break;
+
+        case SDL_MOUSEBUTTONUP:
+            if(p_context->pressedTile == p_context->tileCount) {
+                break;
+            }
+
+            coreSelectInstance(
+                p_context->tiles[p_context->pressedTile].instance
+            );
+            coreSetInput(p_context->pressedInput, E_CORE_INPUT_RELEASED);
+            coreSelectInstance(l_callerInstance);
+            p_context->pressedTile = p_context->tileCount;
+            break;
+
+        default:
+            break;
+    }
+
+    return true;
+}
+
+static void gridDestroy(struct ts_gridContext *p_context) {
+    poolDestroy(p_context->pool);
+
+    if(p_context->texture != NULL) {
+        SDL_DestroyTexture(p_context->texture);
+    }
+
+    if(p_context->renderer != NULL) {
+        SDL_DestroyRenderer(p_context->renderer);
+    }
+
+    if(p_context->window != NULL) {
+        SDL_DestroyWindow(p_context->window);
+    }
+
+    for(
+        size_t l_index = 0U;
+        (p_context->tiles != NULL) && (l_index < p_context->tileCount);
+        l_index++
+    ) {
+        coreDestroyInstance(p_context->tiles[l_index].instance);
+    }
+
+    free(p_context->tiles);
+}
@@ -0,0 +1,41 @@
+#ifndef __INC_GRID_H__
+#define __INC_GRID_H__
+
+// =============================================================================
+// File inclusion
+// =============================================================================
+#include <stddef.h>
+
+// =============================================================================
+// Public constant declarations
+// =============================================================================
+/**
+ * @brief This constant defines the maximum number of instances shown by the
+ *        grid viewer.
+ */
+#define C_GRID_MAX_INSTANCES 1024U
+
+// =============================================================================
+// Public function declarations
+// =============================================================================
+/**
+ * @brief Runs the grid viewer: the given number of instances start from the
+ *        state of the current instance, and are shown as tiles of one window.
+ *        The instances run in real time on one thread per host processor,
+ *        but the window is only refreshed C_GRID_REFRESH_RATE_HZ times per
+ *        second, and only the tiles whose frame changed are uploaded.
+ *        Clicking the left, middle or right third of a tile presses the
+ *        matching button of its instance.
+ * @details The function returns when the window is closed. The frontend must
+ *          not be initialized.
+ *
+ * @param[in] p_instanceCount The number of instances, up to
+ *                            C_GRID_MAX_INSTANCES.
+ *
+ * @returns An integer that indicates the result of the operation.
+ * @retval 0 if the window was closed normally.
+ * @retval Any other value if an error occurred.
+ */
+int gridRun(size_t p_instanceCount);
+
+#endif // __INC_GRID_H__